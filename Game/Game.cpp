@@ -71,6 +71,9 @@ namespace GameDev2D
     {
         m_LoadStep = 0;
         m_Box2dObjectCreator = Box2dObjectCreator::GetInstance();
+        
+        //Batch the map sprites
+        SetSpriteBatchingEnabled(true);
     }
     
     Game::~Game()
@@ -129,13 +132,14 @@ namespace GameDev2D
                     ServiceLocator::GetShapeCache()->AddFixtures(map, MAP_COLLISION_BASE_NAME + index);
                     vec2 anchorPoint = ServiceLocator::GetShapeCache()->GetAnchorPoint(MAP_COLLISION_BASE_NAME + index);
                     
-                    Sprite* mapSprite = new Sprite(MAP_IMAGE_BASE_NAME + index);
-                    mapSprite->SetAnchorPoint(anchorPoint);
+                    //Sample the map tiles from mipmaps with a trilinear filter, so they stay smooth when the map is drawn scaled
+                    TileMap* mapTiles = new TileMap(MAP_IMAGE_BASE_NAME + index, "Images", TextureFilterTrilinear, true);
+                    mapTiles->SetAnchorPoint(anchorPoint);
                     
-                    map->AddChild(mapSprite, true);   //TODO: Fix the map. Add extra background on the top and bottom
+                    map->AddChild(mapTiles, true);   //TODO: Fix the map. Add extra background on the top and bottom
                     AddGameObject(map);
                     
-                    //m_MapSprites.push_back(mapSprite);
+                    //m_MapSprites.push_back(mapTiles);
                 }
             }
             break;
@@ -0,0 +1,86 @@
+//
+//  BoundingBox.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__BoundingBox__
+#define __GameDev2D__BoundingBox__
+
+#include <glm.hpp>
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    //Trivially copyable axis aligned bounding box. An empty bounding box has a min that
+    //is greater than its max, expanding an empty bounding box by a point results in a
+    //bounding box around that point
+    struct BoundingBox
+    {
+        vec2 min;
+        vec2 max;
+    };
+    
+    //Creates a BoundingBox from a min and max point
+    inline BoundingBox MakeBoundingBox(vec2 min, vec2 max)
+    {
+        BoundingBox boundingBox = { min, max };
+        return boundingBox;
+    }
+    
+    //Creates an empty BoundingBox
+    inline BoundingBox MakeEmptyBoundingBox()
+    {
+        return MakeBoundingBox(vec2(FLT_MAX, FLT_MAX), vec2(-FLT_MAX, -FLT_MAX));
+    }
+    
+    //Returns wether the BoundingBox is empty
+    inline bool IsBoundingBoxEmpty(const BoundingBox& boundingBox)
+    {
+        return boundingBox.min.x > boundingBox.max.x || boundingBox.min.y > boundingBox.max.y;
+    }
+    
+    //Expands the BoundingBox to contain a point
+    inline void ExpandBoundingBox(BoundingBox& boundingBox, vec2 point)
+    {
+        boundingBox.min.x = fminf(boundingBox.min.x, point.x);
+        boundingBox.min.y = fminf(boundingBox.min.y, point.y);
+        boundingBox.max.x = fmaxf(boundingBox.max.x, point.x);
+        boundingBox.max.y = fmaxf(boundingBox.max.y, point.y);
+    }
+    
+    //Expands the BoundingBox to contain another BoundingBox, empty BoundingBoxes are ignored
+    inline void ExpandBoundingBox(BoundingBox& boundingBox, const BoundingBox& other)
+    {
+        if(IsBoundingBoxEmpty(other) == false)
+        {
+            ExpandBoundingBox(boundingBox, other.min);
+            ExpandBoundingBox(boundingBox, other.max);
+        }
+    }
+    
+    //Returns the axis aligned BoundingBox around the four corners of a BoundingBox transformed by a matrix
+    inline BoundingBox TransformBoundingBox(const BoundingBox& boundingBox, const mat4& matrix)
+    {
+        BoundingBox transformed = MakeEmptyBoundingBox();
+        if(IsBoundingBoxEmpty(boundingBox) == false)
+        {
+            const vec2 corners[4] = { boundingBox.min, vec2(boundingBox.max.x, boundingBox.min.y), vec2(boundingBox.min.x, boundingBox.max.y), boundingBox.max };
+            for(unsigned int i = 0; i < 4; i++)
+            {
+                vec4 corner = matrix * vec4(corners[i].x, corners[i].y, 0.0f, 1.0f);
+                ExpandBoundingBox(transformed, vec2(corner.x, corner.y));
+            }
+        }
+        return transformed;
+    }
+    
+    //Returns wether two BoundingBoxes overlap, empty BoundingBoxes never overlap
+    inline bool DoBoundingBoxesIntersect(const BoundingBox& a, const BoundingBox& b)
+    {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+    }
+}
+
+#endif /* defined(__GameDev2D__BoundingBox__) */
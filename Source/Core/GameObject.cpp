@@ -7,6 +7,8 @@
 //
 
 #include "GameObject.h"
+#include "../Services/ServiceLocator.h"
+#include "../Services/Graphics/Graphics.h"
 
 
 
@@ -22,6 +24,9 @@ namespace GameDev2D
         m_IsEnabled(true),
         m_ResetModelMatrix(false),
         m_ForceUpdate(false),
+        m_WorldBounds(MakeEmptyBoundingBox()),
+        m_WorldBoundsAreKnown(false),
+        m_WorldBoundsAreDirty(true),
         m_TweenLocalX(),
         m_TweenLocalY(),
         m_TweenAngle(),
@@ -88,7 +93,7 @@ namespace GameDev2D
         //Cycle through the children and draw them, if they can be drawn
         for(unsigned int i = 0; i < GetNumberOfChildren(); i++)
         {
-            if(GetChildAtIndex(i)->CanDraw() == true)
+            if(GetChildAtIndex(i)->CanDraw() == true && ServiceLocator::GetGraphics()->IsCulled(GetChildAtIndex(i)) == false)
             {
                 //Get the child
                 GameObject* child = (GameObject*)GetChildAtIndex(i);
@@ -185,6 +190,9 @@ namespace GameDev2D
                 
                 //Erase the child object from the children vector
                 m_Children.erase(m_Children.begin() + i);
+                
+                //The world bounds no longer contain the child object
+                WorldBoundsAreDirty();
                 break;
             }
         }
@@ -389,7 +397,12 @@ namespace GameDev2D
 
     void GameObject::SetIsEnabled(bool aIsEnabled)
     {
-        m_IsEnabled = aIsEnabled;
+        //The parent's world bounds only contain the GameObject if it can be drawn
+        if(m_IsEnabled != aIsEnabled)
+        {
+            m_IsEnabled = aIsEnabled;
+            WorldBoundsAreDirty();
+        }
     }
     
     void GameObject::SetForceUpdate(bool aForceUpdate)
@@ -456,8 +469,71 @@ namespace GameDev2D
         return false;
     }
     
+    bool GameObject::GetLocalBounds(BoundingBox& aBounds)
+    {
+        //The bounds of what an inheriting class draws are unknown, so it isn't culled
+        aBounds = MakeEmptyBoundingBox();
+        return false;
+    }
+    
+    bool GameObject::GetWorldBounds(BoundingBox& aBounds)
+    {
+        //Make sure the model matrix is up to date, resetting it flags the world bounds as dirty
+        if(IsModelMatrixDirty() == true)
+        {
+            ResetModelMatrix();
+        }
+        
+        //Are the cached world bounds dirty?
+        if(m_WorldBoundsAreDirty == true)
+        {
+            //Get the local bounds and transform them into world space, if they are unknown so are the world bounds
+            BoundingBox localBounds;
+            m_WorldBoundsAreKnown = GetLocalBounds(localBounds);
+            m_WorldBounds = TransformBoundingBox(localBounds, m_ModelMatrix);
+        
+            //Cycle through the children and expand the bounds to contain the ones that can be drawn. Every child's world
+            //bounds are updated, even if they can't be drawn, so that none of the children are left with dirty bounds
+            for(unsigned int i = 0; i < GetNumberOfChildren(); i++)
+            {
+                BoundingBox childBounds;
+                bool isKnown = GetChildAtIndex(i)->GetWorldBounds(childBounds);
+                if(GetChildAtIndex(i)->CanDraw() == true)
+                {
+                    m_WorldBoundsAreKnown = m_WorldBoundsAreKnown == true && isKnown == true;
+                    ExpandBoundingBox(m_WorldBounds, childBounds);
+                }
+            }
+        
+            //The world bounds are no longer dirty
+            m_WorldBoundsAreDirty = false;
+        }
+        
+        //Set the cached world bounds
+        aBounds = m_WorldBounds;
+        return m_WorldBoundsAreKnown;
+    }
+    
+    void GameObject::WorldBoundsAreDirty()
+    {
+        //Flag the world bounds as dirty
+        m_WorldBoundsAreDirty = true;
+        
+        //The parents' world bounds contain this GameObject's, flag them as dirty too. If a parent's world
+        //bounds are already dirty, then so are its parents', so there is no need to go any further
+        GameObject* parent = m_Parent;
+        while(parent != nullptr && parent->m_WorldBoundsAreDirty == false)
+        {
+            parent->m_WorldBoundsAreDirty = true;
+            parent = parent->m_Parent;
+        }
+    }
+    
     void GameObject::ResetModelMatrix()
     {
+        //The world bounds depend on the model matrix
+        WorldBoundsAreDirty();
+        
         //Cycle through the children's model matrices and reset them
         for(unsigned int i = 0; i < GetNumberOfChildren(); i++)
         {
@@ -477,6 +553,7 @@ namespace GameDev2D
         else
         {
             m_ResetModelMatrix = true;
+            WorldBoundsAreDirty();
         }
     }
     
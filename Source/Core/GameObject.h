@@ -11,6 +11,7 @@
 
 #include "FrameworkConfig.h"
 #include "BaseObject.h"
+#include "BoundingBox.h"
 #include "../Animation/Tween.h"
 #include "../Animation/Easing.h"
 
@@ -117,6 +118,20 @@ namespace GameDev2D
         typedef void (GameObject::*DelayedMethod)();
         void DelayCallingMethod(DelayedMethod delayedMethod, double delay);
         
+        //Sets the local space bounding box of what the GameObject draws itself, NOT including its children, returns false if the
+        //bounds are unknown. By default the bounds are unknown, which disables culling. Inheriting classes that know what they
+        //draw in their Draw() method should override this method, classes that only draw their children can return empty bounds
+        virtual bool GetLocalBounds(BoundingBox& bounds);
+        
+        //Sets the world space bounding box of the GameObject and all the children that can be drawn, returns false if the
+        //bounds of the GameObject, or any of its children, are unknown. Used to cull GameObjects outside the Camera's view.
+        //The world bounds are cached until the model matrix is reset or WorldBoundsAreDirty() is called
+        bool GetWorldBounds(BoundingBox& bounds);
+        
+        //Flags the cached world bounds of the GameObject, and of its parents, as dirty. Inheriting classes MUST call this
+        //method when the bounds returned by GetLocalBounds() change without the model matrix being reset
+        void WorldBoundsAreDirty();
+        
         //Resets the model matrix, can be overridden.
         virtual void ResetModelMatrix();
         
@@ -170,6 +185,11 @@ namespace GameDev2D
         bool m_ForceUpdate;
         bool m_ResetModelMatrix;
         
+        //World bounds member variables
+        BoundingBox m_WorldBounds;
+        bool m_WorldBoundsAreKnown;
+        bool m_WorldBoundsAreDirty;
+        
         //Tween member variables
         Tween m_TweenLocalX;
         Tween m_TweenLocalY;
@@ -17,7 +17,10 @@ namespace GameDev2D
     Scene::Scene(const string& aType) : BaseObject(aType), EventHandler(),
         m_Camera(nullptr),
         m_SceneManagerResponsibleForDeletion(false),
-        m_IsLoaded(false)
+        m_IsLoaded(false),
+        m_SpriteBatchingEnabled(false),
+        m_SpriteBatchSortMode(SpriteBatchSortNone),
+        m_RenderQueueSortMode(RenderQueueSortNone)
     {
         //Create a new Camera object
         m_Camera = new Camera();
@@ -131,11 +134,22 @@ namespace GameDev2D
     
     void Scene::Draw()
     {
+        //Begin the RenderQueue, the GameObjects' draw calls are recorded as render commands and submitted at the end
+        RenderQueue* renderQueue = ServiceLocator::GetGraphics()->GetRenderQueue();
+        renderQueue->Begin(m_RenderQueueSortMode);
+        
+        //If sprite batching is enabled, begin the SpriteBatch
+        SpriteBatch* spriteBatch = ServiceLocator::GetGraphics()->GetSpriteBatch();
+        if(m_SpriteBatchingEnabled == true)
+        {
+            spriteBatch->Begin(m_SpriteBatchSortMode);
+        }
+    
         //Cycle through and Draw the GameObjects
         for(unsigned int i = 0; i < m_SceneObjects.size(); i++)
         {
-            //Can the GameObject be drawn?
-            if(m_SceneObjects.at(i).gameObject->CanDraw() == true)
+            //Can the GameObject be drawn? And is it inside the camera's view?
+            if(m_SceneObjects.at(i).gameObject->CanDraw() == true && ServiceLocator::GetGraphics()->IsCulled(m_SceneObjects.at(i).gameObject) == false)
             {
                 //This is only here to ENSURE that if the model matrix is dirty
                 //that it get reset before the draw call
@@ -144,11 +158,27 @@ namespace GameDev2D
                     //Reset the GameObject's Model Matrix
                     m_SceneObjects.at(i).gameObject->ResetModelMatrix();
                 }
+                
+                //The GameObject's depth is the layer of the render commands it adds, and of the quads if sprite batching is enabled
+                renderQueue->SetLayer(m_SceneObjects.at(i).depth);
+                if(m_SpriteBatchingEnabled == true)
+                {
+                    spriteBatch->SetLayer(m_SceneObjects.at(i).depth);
+                }
             
                 //Draw the GameObject
                 m_SceneObjects.at(i).gameObject->Draw();
             }
         }
+        
+        //End the SpriteBatch, this will draw any remaining batched sprites
+        if(m_SpriteBatchingEnabled == true)
+        {
+            spriteBatch->End();
+        }
+        
+        //End the RenderQueue, this will sort and submit the render commands
+        renderQueue->End();
     }
     
     void Scene::Reset()
@@ -293,6 +323,27 @@ namespace GameDev2D
         m_DelayedMethods.push_back(make_pair(aDelayedMethod, aDelay));
     }
     
+    void Scene::SetSpriteBatchingEnabled(bool aSpriteBatchingEnabled, SpriteBatchSortMode aSortMode)
+    {
+        m_SpriteBatchingEnabled = aSpriteBatchingEnabled;
+        m_SpriteBatchSortMode = aSortMode;
+    }
+    
+    bool Scene::IsSpriteBatchingEnabled()
+    {
+        return m_SpriteBatchingEnabled;
+    }
+    
+    void Scene::SetRenderQueueSortMode(RenderQueueSortMode aSortMode)
+    {
+        m_RenderQueueSortMode = aSortMode;
+    }
+    
+    RenderQueueSortMode Scene::GetRenderQueueSortMode()
+    {
+        return m_RenderQueueSortMode;
+    }
+    
     bool Scene::UpdateDelayedMethod(double aDelta, pair<DelayedMethod, double>& aDelayedMethodPair)
     {
         //Countdown the delay
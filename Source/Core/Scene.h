@@ -13,6 +13,8 @@
 #include "BaseObject.h"
 #include "GameObject.h"
 #include "../Events/EventHandler.h"
+#include "../Services/Graphics/SpriteBatch.h"
+#include "../Services/Graphics/RenderQueue.h"
 
 
 using namespace std;
@@ -91,6 +93,16 @@ namespace GameDev2D
         //Delayed method function pointer definition and method to initiate calling a delayed method
         void DelayCallingMethod(DelayedMethod delayedMethod, double delay);
         
+        //Enables or disables sprite batching for the Scene, when enabled all the Sprites drawn in
+        //the Scene's Draw() method are batched by the Graphics service's SpriteBatch, by default it is disabled
+        void SetSpriteBatchingEnabled(bool spriteBatchingEnabled, SpriteBatchSortMode sortMode = SpriteBatchSortNone);
+        bool IsSpriteBatchingEnabled();
+        
+        //Sets the sort mode of the render commands recorded by the Scene's Draw() method, by default the
+        //draw order is preserved. RenderQueueSortState regroups the commands to minimize state changes
+        void SetRenderQueueSortMode(RenderQueueSortMode sortMode);
+        RenderQueueSortMode GetRenderQueueSortMode();
+        
     protected:
         //Conveniance method used to sort the Scene's GameObjects, based on their 'depth'. Can be overridden.
         virtual void SortSceneObjects();
@@ -126,6 +138,9 @@ namespace GameDev2D
         vector<pair<DelayedMethod, double>> m_DelayedMethods;
         bool m_SceneManagerResponsibleForDeletion;
         bool m_IsLoaded;
+        bool m_SpriteBatchingEnabled;
+        SpriteBatchSortMode m_SpriteBatchSortMode;
+        RenderQueueSortMode m_RenderQueueSortMode;
     };
     
     //Struct to keep track the Scene's GameObjects, it manages the GameObject's depth
@@ -42,15 +42,33 @@
 
 //Physics
 #define BOX2D_DRAW_DEBUG_DATA 1
+#define BOX2D_DEBUG_DRAW_CULLING 1
 
 //Errors
 #define THROW_EXCEPTION_ON_ERROR 1
+#define SHADER_VALIDATE_EVERY_DRAW 0
+
+//Shaders
+#define SHADER_BINARY_CACHE_ENABLED 1
+#define SHADER_BINARY_CACHE_FILE "/ShaderCache.bin"
+#define SHADER_MAX_VALIDATED_STATES 64
 
 //Memory
 #define TRACK_MEMORY_USAGE 0
 #define PURGE_UNUSED_TEXTURES_IMMEDIATELY 0
 #define PURGE_UNUSED_SHADERS_IMMEDIATELY 0
 #define PURGE_UNUSED_FONTS_IMMEDIATELY 0
+#define TEXTURE_BUDGET (128 * 1024 * 1024)
+#define TEXTURE_STREAMING_BUDGET (64 * 1024 * 1024)
+#define RENDER_TARGET_POOL_MIN_SIZE 16
+#define RENDER_TARGET_POOL_MAX_FREE 8
+#define TILE_MAP_MAX_PREFETCH_LOADS_PER_FRAME 1
+#define TEXTURE_DECODE_THREAD_COUNT 2
+#define TEXTURE_UPLOAD_BUDGET_PER_FRAME (4 * 1024 * 1024)
+#define TEXTURE_ATLAS_MANIFEST "TextureAtlases"
+#define TEXTURE_DEFAULT_FILTER TextureFilterNearest
+#define TEXTURE_DEFAULT_ANISOTROPY 1.0f
+#define TEXTURE_GENERATE_MIPMAPS 0
 
 //Logging
 #define LOG_VERBOSITY_MASK VerbosityLevel_Debug | VerbosityLevel_Events
@@ -68,6 +86,26 @@
 //Draw
 #define DRAW_DEBUG_UI 1
 #define DEBUG_UI_FONT_COLOR Color::WhiteColor()
+#define DEBUG_UI_SPRITE_BATCH_STATS 0
+#define DEBUG_UI_RENDER_QUEUE_STATS 0
+#define DEBUG_UI_SHADER_VALIDATION_STATS 0
+#define DEBUG_UI_GRAPHICS_STATE_STATS 0
+#define DEBUG_UI_CULLING_STATS 0
+#define DEBUG_UI_TEXTURE_STREAMING_STATS 0
+#define DEBUG_UI_TEXTURE_UPLOAD_STATS 0
+#define DEBUG_UI_TEXTURE_MEMORY_STATS 0
+#define DEBUG_UI_TEXTURE_CACHE_STATS 0
+#define DEBUG_UI_RENDER_TARGET_POOL_STATS 0
+#define DEBUG_UI_LABEL_STATS 0
+
+#define SPRITE_BATCH_INSTANCING_ENABLED 1
+
+#define CAMERA_CULLING_ENABLED 1
+
+#define CIRCLE_AUTOMATIC_LINE_SEGMENTS 1
+#define CIRCLE_LINE_SEGMENT_LENGTH 8.0f
+#define CIRCLE_MIN_LINE_SEGMENTS 12
+#define CIRCLE_MAX_LINE_SEGMENTS 128
 
 #define DRAW_JOYSTICK_DATA 0
 
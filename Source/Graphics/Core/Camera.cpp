@@ -19,6 +19,7 @@ namespace GameDev2D
     Camera::Camera() : BaseObject("Camera"),
         m_ProjectionMatrix(mat4(1.0f)),
         m_ViewMatrix(mat4(1.0f)),
+        m_ViewBounds(MakeEmptyBoundingBox()),
         m_Position(vec2(0.0f, 0.0f)),
         m_Orientation(0.0f),
         m_Zoom(1.0f),
@@ -38,6 +39,9 @@ namespace GameDev2D
         //Randomize the shake random seed
         m_ShakeRandom.RandomizeSeed();
         
+        //Set the view bounds for the initial matrices
+        ResetViewBounds();
+        
         //Listener for the resize event, we need to know if the screen resizes to reset the matrices
         ServiceLocator::GetPlatformLayer()->AddEventListener(this, RESIZE_EVENT);
     }
@@ -116,6 +120,11 @@ namespace GameDev2D
     {
         return m_ViewMatrix;
     }
+    
+    BoundingBox Camera::GetViewBounds()
+    {
+        return m_ViewBounds;
+    }
 
     float Camera::GetViewWidth()
     {
@@ -256,6 +265,9 @@ namespace GameDev2D
             m_ProjectionMatrix = mat4(1.0f);
         }
         
+        //Reset the view bounds
+        ResetViewBounds();
+    
     #if LOG_PROJECTION_MATRIX
         LogMatrix(m_ProjectionMatrix, "Projection Matrix");
     #endif
@@ -294,11 +306,22 @@ namespace GameDev2D
             m_ViewMatrix = mat4(1.0f);
         }
         
+        //Reset the view bounds
+        ResetViewBounds();
+    
     #if LOG_VIEW_MATRIX
         LogMatrix(m_ViewMatrix, "View Matrix");
     #endif
     }
     
+    void Camera::ResetViewBounds()
+    {
+        //The inverse of the view projection matrix maps the corners of the normalized device coordinates back
+        //into world space, the bounding box around them contains everything the camera can see
+        mat4 inverseViewProjection = inverse(m_ProjectionMatrix * m_ViewMatrix);
+        m_ViewBounds = TransformBoundingBox(MakeBoundingBox(vec2(-1.0f, -1.0f), vec2(1.0f, 1.0f)), inverseViewProjection);
+    }
+    
     void Camera::UpdateTween(double aDelta, Tween* aTween, CameraTweenSetMethod aTweenSetMethod)
     {
         //Safety check the Tween and make sure it is running
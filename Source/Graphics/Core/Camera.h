@@ -10,6 +10,7 @@
 #define __GameDev2D__Camera__
 
 #include "../../Core/BaseObject.h"
+#include "../../Core/BoundingBox.h"
 #include "../../Events/EventHandler.h"
 #include "../../Animation/Random.h"
 #include "../../Animation/Tween.h"
@@ -40,6 +41,10 @@ namespace GameDev2D
         mat4 GetProjectionMatrix();
         mat4 GetViewMatrix();
         
+        //Returns the world space bounding box of the area the camera can see, it factors
+        //in the position, zoom and orientation of the camera, as well as any camera shake
+        BoundingBox GetViewBounds();
+        
         //Gets the view width and height, factors in the current zoom level
         float GetViewWidth();
         float GetViewHeight();
@@ -86,12 +91,16 @@ namespace GameDev2D
         //Conveniance method to randomize a camera shake
         float RandomShake(float magnitude);
         
+        //Conveniance method to reset the view bounds, called whenever the projection or view matrix is reset
+        void ResetViewBounds();
+        
         //Conveniance method to log the matrix data
         void LogMatrix(mat4 matrix, const char* name = nullptr);
     
         //Member variables
         mat4 m_ProjectionMatrix;
         mat4 m_ViewMatrix;
+        BoundingBox m_ViewBounds;
         vec2 m_Position;
         float m_Orientation;
         float m_Zoom;
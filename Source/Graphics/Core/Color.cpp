@@ -13,29 +13,34 @@
 
 namespace GameDev2D
 {
-    Color::Color() : BaseObject("Color")
+    //The color types are stored per object and per vertex, make sure they stay tightly packed
+    static_assert(sizeof(ColorRGBA) == 4 * sizeof(float), "ColorRGBA must be 4 floats");
+    static_assert(sizeof(ColorRGBA8) == 4, "ColorRGBA8 must be 4 bytes");
+    static_assert(sizeof(Color) == sizeof(ColorRGBA), "Color must not add any data to ColorRGBA");
+    
+    Color::Color()
     {
         Set(1.0f, 1.0f, 1.0f, 1.0f);
     }
     
-    Color::Color(float aRed, float aGreen, float aBlue, float aAlpha) : BaseObject("Color")
+    Color::Color(float aRed, float aGreen, float aBlue, float aAlpha)
     {
         Set(aRed, aGreen, aBlue, aAlpha);
     }
     
-    Color::Color(unsigned char aRed, unsigned char aGreen, unsigned char aBlue, unsigned char aAlpha) : BaseObject("Color")
+    Color::Color(unsigned char aRed, unsigned char aGreen, unsigned char aBlue, unsigned char aAlpha)
     {
         Set(aRed, aGreen, aBlue, aAlpha);
     }
     
-    Color::Color(unsigned int aColor) : BaseObject("Color")
+    Color::Color(unsigned int aColor)
     {
         Set(aColor);
     }
     
-    Color::~Color()
+    Color::Color(const ColorRGBA& aColor)
     {
-        
+        Set(aColor.r, aColor.g, aColor.b, aColor.a);
     }
     
     void Color::SetRed(float aRed)
@@ -82,12 +87,7 @@ namespace GameDev2D
     
     bool Color::operator==(const Color& aColor) const
     {
-    	if(m_RGBA.r == aColor.m_RGBA.r && m_RGBA.g == aColor.m_RGBA.g && m_RGBA.b == aColor.m_RGBA.b && m_RGBA.a == aColor.m_RGBA.a)
-        {
-            return true;
-        }
-
-        return false;
+        return m_RGBA == aColor.m_RGBA;
     }
     
     bool Color::operator!=(const Color& aColor) const
@@ -116,10 +116,20 @@ namespace GameDev2D
     }
     
     vec4 Color::Get()
+    {
+        return vec4(m_RGBA.r, m_RGBA.g, m_RGBA.b, m_RGBA.a);
+    }
+    
+    ColorRGBA Color::GetRGBA() const
     {
         return m_RGBA;
     }
     
+    ColorRGBA8 Color::GetRGBA8() const
+    {
+        return PackColorRGBA8(m_RGBA);
+    }
+    
     void Color::Invert(bool aInvertAlpha)
     {
         SetRed(1.0f - Red());
@@ -17,8 +17,63 @@ using namespace glm;
 
 namespace GameDev2D
 {
-    //Basic color class to manage RGBA color data
-    class Color : public BaseObject
+    //Trivially copyable RGBA color, float range: 0.0f - 1.0f. This is the color type that is
+    //stored by the render path (TextureFrame, Polygon, Sprite and Label)
+    struct ColorRGBA
+    {
+        float r, g, b, a;
+    };
+    
+    //Trivially copyable RGBA color packed into 4 bytes, unsigned char range: 0 - 255.
+    //Used for vertex colors, a quarter of the size of four floats
+    struct ColorRGBA8
+    {
+        unsigned char r, g, b, a;
+    };
+    
+    //Creates a ColorRGBA, float range: 0.0f - 1.0f
+    inline ColorRGBA MakeColorRGBA(float red, float green, float blue, float alpha = 1.0f)
+    {
+        ColorRGBA color = { red, green, blue, alpha };
+        return color;
+    }
+    
+    //Packs a float color channel into an unsigned char, the channel is clamped to 0.0f - 1.0f first,
+    //converting a float outside of the unsigned char range is undefined behaviour
+    inline unsigned char PackColorChannel(float channel)
+    {
+        float clamped = channel > 0.0f ? (channel < 1.0f ? channel : 1.0f) : 0.0f;
+        return (unsigned char)(clamped * 255.0f + 0.5f);
+    }
+    
+    //Packs a ColorRGBA into a ColorRGBA8
+    inline ColorRGBA8 PackColorRGBA8(const ColorRGBA& color)
+    {
+        ColorRGBA8 packed = { PackColorChannel(color.r), PackColorChannel(color.g), PackColorChannel(color.b), PackColorChannel(color.a) };
+        return packed;
+    }
+    
+    //Multiplies a ColorRGBA's red, green and blue by its alpha, used to tint premultiplied textures
+    inline ColorRGBA PremultiplyColorRGBA(const ColorRGBA& color)
+    {
+        ColorRGBA premultiplied = { color.r * color.a, color.g * color.a, color.b * color.a, color.a };
+        return premultiplied;
+    }
+    
+    //Overloaded operators for the ColorRGBA struct
+    inline bool operator==(const ColorRGBA& a, const ColorRGBA& b)
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+    
+    inline bool operator!=(const ColorRGBA& a, const ColorRGBA& b)
+    {
+        return !(a == b);
+    }
+    
+    //Basic color class to manage RGBA color data, it is a thin wrapper around the ColorRGBA struct,
+    //it doesn't inherit from BaseObject so it is cheap to construct, copy and compare
+    class Color
     {
     public:
         //Create the color white
@@ -33,7 +88,8 @@ namespace GameDev2D
         //Hexadecimal RGBA
         Color(unsigned int color);
         
-        ~Color();
+        //From a ColorRGBA struct, no clamping is applied
+        Color(const ColorRGBA& color);
         
         //Setter methods
         void SetRed(float red);
@@ -61,6 +117,10 @@ namespace GameDev2D
         float Alpha();
         vec4 Get();
         
+        //Returns the color as a ColorRGBA or ColorRGBA8 struct
+        ColorRGBA GetRGBA() const;
+        ColorRGBA8 GetRGBA8() const;
+        
         //Inverts the color
         void Invert(bool invertAlpha = false);
         
@@ -104,8 +164,8 @@ namespace GameDev2D
         static Color GhostWhiteColor(float alpha = 1.0f);
         
     private:
-        //Color array
-        vec4 m_RGBA;
+        //Color data
+        ColorRGBA m_RGBA;
     };
 }
 
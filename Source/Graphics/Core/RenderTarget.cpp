@@ -64,8 +64,8 @@ namespace GameDev2D
     
     void RenderTarget::SetClearColor(Color aClearColor)
     {
+        //The clear color is applied by the Graphics service when the render target is cleared
         m_ClearColor = aClearColor;
-        glClearColor(m_ClearColor.Red(), m_ClearColor.Green(), m_ClearColor.Blue(), m_ClearColor.Alpha());
     }
     
     Color RenderTarget::GetClearColor()
@@ -89,9 +89,6 @@ namespace GameDev2D
             glBindRenderbuffer(GL_RENDERBUFFER, m_FrameBuffer.renderBuffer);
         }
         
-        //
-        SetClearColor(m_ClearColor);
-        
         //
         m_IsBound = true;
     }
@@ -9,6 +9,12 @@
 
 #include "Shader.h"
 #include "../../IO/File.h"
+#include "../../Services/ServiceLocator.h"
+
+
+#ifndef SHADER_MAX_VALIDATED_STATES
+#define SHADER_MAX_VALIDATED_STATES 64
+#endif
 
 
 namespace GameDev2D
@@ -21,42 +27,19 @@ namespace GameDev2D
         m_TextureUniform(0),
         m_VertexShaderString(aVertexShader),
         m_FragmentShaderString(aFragmentShader),
-        m_Key("")
+        m_Key(""),
+        m_ValidatedDeletedObjectCount(0),
+        m_ValidateEveryDraw(false),
+        m_ValidationCount(0),
+        m_CachedValidationCount(0)
     {
-        //Create the shader program
+        //Create the shader program, the vertex and fragment shaders are only compiled when the program is
+        //linked, a program that is linked from a cached program binary doesn't need to compile them
         m_Program = glCreateProgram();
     
-        //If this assert is hit, that means the vertex shader that was passed in has no content
+        //If these asserts are hit, that means the vertex or fragment shader that was passed in has no content
         assert(m_VertexShaderString.length() > 0);
-
-        //Log the vertex shader
-        Log(VerbosityLevel_Shaders, "Vertex shader\n%s", m_VertexShaderString.c_str());
-        
-        //Compile the vertex shader, if successful, attach it to the program
-        if(Compile(GL_VERTEX_SHADER, &m_VertexShader, &aVertexShader) == false)
-        {
-            Error("Failed to compile %s.vsh", aVertexShader);
-        }
-        else
-        {
-            glAttachShader(m_Program, m_VertexShader);
-        }
-
-        //If this assert is hit, that means the fragment shader that was passed in has no content
         assert(m_FragmentShaderString.length() > 0);
-
-        //Log the fragment shader
-        Log(VerbosityLevel_Shaders, "Fragment shader\n%s", m_FragmentShaderString.c_str());
-
-        //Compile the fragment shader, if successful, attach it to the program
-        if(Compile(GL_FRAGMENT_SHADER, &m_FragmentShader, &aFragmentShader) == false)
-        {
-            Error("Failed to compile %s.fsh", aFragmentShader);
-        }
-        else
-        {
-            glAttachShader(m_Program, m_FragmentShader);
-        }
     }
     
     Shader::~Shader()
@@ -97,8 +80,42 @@ namespace GameDev2D
         return m_TextureUniform;
     }
     
-    void Shader::Link()
+    void Shader::Link(bool aIsBinaryRetrievable)
     {
+        //Log the vertex shader
+        const GLchar* vertexSource = m_VertexShaderString.c_str();
+        Log(VerbosityLevel_Shaders, "Vertex shader\n%s", vertexSource);
+        
+        //Compile the vertex shader, if successful, attach it to the program
+        if(Compile(GL_VERTEX_SHADER, &m_VertexShader, &vertexSource) == false)
+        {
+            Error("Failed to compile %s.vsh", vertexSource);
+        }
+        else
+        {
+            glAttachShader(m_Program, m_VertexShader);
+        }
+        
+        //Log the fragment shader
+        const GLchar* fragmentSource = m_FragmentShaderString.c_str();
+        Log(VerbosityLevel_Shaders, "Fragment shader\n%s", fragmentSource);
+        
+        //Compile the fragment shader, if successful, attach it to the program
+        if(Compile(GL_FRAGMENT_SHADER, &m_FragmentShader, &fragmentSource) == false)
+        {
+            Error("Failed to compile %s.fsh", fragmentSource);
+        }
+        else
+        {
+            glAttachShader(m_Program, m_FragmentShader);
+        }
+        
+        //Hint the driver that the program binary will be retrieved
+        if(aIsBinaryRetrievable == true)
+        {
+            glProgramParameteri(m_Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        
         //Link the program
         glLinkProgram(m_Program);
         
@@ -140,6 +157,52 @@ namespace GameDev2D
             m_FragmentShader = 0;
         }
         
+        //Get the uniform locations
+        DidLink();
+    }
+    
+    bool Shader::LinkProgramBinary(GLenum aFormat, const void* aBinary, GLsizei aLength)
+    {
+        //Load the program binary, the attribute locations are part of the binary
+        glProgramBinary(m_Program, aFormat, aBinary, aLength);
+        
+        //Get the link status of the program, the driver can reject a binary even if the format matches
+        GLint status = GL_FALSE;
+        glGetProgramiv(m_Program, GL_LINK_STATUS, &status);
+        if(status == GL_FALSE)
+        {
+            Log(VerbosityLevel_Shaders, "The program binary for shader %s was rejected", m_Key.c_str());
+            return false;
+        }
+        
+        //Get the uniform locations
+        DidLink();
+        return true;
+    }
+    
+    bool Shader::GetProgramBinary(GLenum& aFormat, vector<unsigned char>& aBinary)
+    {
+        //Get the length of the program binary
+        GLint length = 0;
+        glGetProgramiv(m_Program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if(length <= 0)
+        {
+            return false;
+        }
+        
+        //Get the program binary
+        aBinary.resize(length);
+        GLsizei binaryLength = 0;
+        glGetProgramBinary(m_Program, length, &binaryLength, &aFormat, &aBinary[0]);
+        aBinary.resize(binaryLength);
+        return binaryLength > 0;
+    }
+    
+    void Shader::DidLink()
+    {
+        //The program has been re-linked, any cached validation state is no longer valid
+        m_ValidatedStates.clear();
+        
         //Get the uniform location of the modelview matrix
         m_ModelViewProjectionUniform = glGetUniformLocation(m_Program, "u_modelViewProjection");
         
@@ -151,17 +214,40 @@ namespace GameDev2D
     {
         if(m_Program != 0)
         {
-            glUseProgram(m_Program);
+            ServiceLocator::GetGraphics()->UseProgram(m_Program);
         }
     }
     
     bool Shader::Validate()
     {
+        //The validation state depends on the bound vertex array and texture
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        pair<unsigned int, unsigned int> state = make_pair(graphics->GetBoundVertexArray(), graphics->GetBoundTextureId());
+        
+        //If a vertex array or texture was deleted, a new one can have the same name, discard the cached results
+        if(m_ValidatedDeletedObjectCount != graphics->GetDeletedObjectCount())
+        {
+            m_ValidatedStates.clear();
+            m_ValidatedDeletedObjectCount = graphics->GetDeletedObjectCount();
+        }
+        
+        //If the state has already been validated, return the cached result
+        if(m_ValidateEveryDraw == false)
+        {
+            map<pair<unsigned int, unsigned int>, bool>::iterator it = m_ValidatedStates.find(state);
+            if(it != m_ValidatedStates.end())
+            {
+                m_CachedValidationCount++;
+                return it->second;
+            }
+        }
+        
         //Validate the shader program
         if(m_Program != 0)
         {
             glValidateProgram(m_Program);
         }
+        m_ValidationCount++;
         
         //Check the program log, and log any info
         string programLog = GetProgramLog();
@@ -185,10 +271,38 @@ namespace GameDev2D
             Error(false, "Failed to validate shader program %d", m_Program);
         }
         
+        //Cache the validation result for the state, the cache is cleared if it is full
+        if(m_ValidatedStates.size() >= SHADER_MAX_VALIDATED_STATES)
+        {
+            m_ValidatedStates.clear();
+        }
+        m_ValidatedStates[state] = status != GL_FALSE;
+        
         //Return the status
         return status != GL_FALSE;
     }
     
+    void Shader::SetValidateEveryDraw(bool aValidateEveryDraw)
+    {
+        m_ValidateEveryDraw = aValidateEveryDraw;
+    }
+    
+    unsigned int Shader::GetValidationCount()
+    {
+        return m_ValidationCount;
+    }
+    
+    unsigned int Shader::GetCachedValidationCount()
+    {
+        return m_CachedValidationCount;
+    }
+    
+    void Shader::ResetValidationStats()
+    {
+        m_ValidationCount = 0;
+        m_CachedValidationCount = 0;
+    }
+    
     void Shader::SetKey(const string& aKey)
     {
         m_Key = string(aKey);
@@ -199,6 +313,11 @@ namespace GameDev2D
         return m_Key;
     }
     
+    GLuint Shader::GetProgram()
+    {
+        return m_Program;
+    }
+    
     bool Shader::Compile(GLenum aTarget, GLuint* aShader, const GLchar** aSources)
     {
         //Compile the shader
@@ -38,7 +38,10 @@ namespace GameDev2D
         //Call to use the shader program
         void Use();
         
-        //Validate the Shader, returns true is the validation was successful
+        //Validate the Shader, returns true is the validation was successful. The result is cached for
+        //the bound vertex array and texture, the program is only re-validated when they change or the
+        //Shader is re-linked, unless the Shader is set to validate on every draw. The cached results are
+        //discarded when a vertex array or texture is deleted, since open gl reuses the deleted names
         bool Validate();
         
         //Set a key to identify this shader from other shader
@@ -47,6 +50,9 @@ namespace GameDev2D
         //Returns the key for the shader
         string GetKey();
         
+        //Returns the open gl shader program
+        GLuint GetProgram();
+        
     protected:
         //Since the Shader is created
         Shader(const char* vertexShader, const char* fragmentShader);
@@ -58,15 +64,36 @@ namespace GameDev2D
         //Adds an attribute
         void AddAttribute(const char* attribute);
         
-        //Link the Shader program
-        void Link();
+        //Compiles the vertex and fragment shaders and links the Shader program. If the program binary is
+        //retrievable, the driver is hinted that GetProgramBinary() will be called after it is linked
+        void Link(bool isBinaryRetrievable = false);
+        
+        //Links the Shader program from a program binary, instead of compiling the vertex and fragment shaders.
+        //Returns false if the driver rejects the binary, the Shader then has to be linked with Link()
+        bool LinkProgramBinary(GLenum format, const void* binary, GLsizei length);
+        
+        //Gets the program binary of a linked Shader program, returns false if the driver doesn't return one
+        bool GetProgramBinary(GLenum& format, vector<unsigned char>& binary);
         
         //Shader log methods
         string GetShaderLog(GLuint *shader);
         string GetProgramLog();
         
+        //Gets the uniform locations and resets the cached validation state, after the program is linked
+        void DidLink();
+        
+        //Sets wether the Shader is validated on every draw, instead of using the cached validation state
+        void SetValidateEveryDraw(bool validateEveryDraw);
+        
+        //Returns the number of times the program was validated and the number of times the cached
+        //validation state was used, since the last call to ResetValidationStats()
+        unsigned int GetValidationCount();
+        unsigned int GetCachedValidationCount();
+        void ResetValidationStats();
+        
         //The ShaderManager needs to access the protected methods
         friend class ShaderManager;
+        friend class ShaderCache;
         
     private:
         //Member variables
@@ -79,6 +106,13 @@ namespace GameDev2D
         string m_VertexShaderString;
         string m_FragmentShaderString;
         string m_Key;
+        
+        //Validation member variables
+        map<pair<unsigned int, unsigned int>, bool> m_ValidatedStates;
+        unsigned int m_ValidatedDeletedObjectCount;
+        bool m_ValidateEveryDraw;
+        unsigned int m_ValidationCount;
+        unsigned int m_CachedValidationCount;
     };
 }
 
@@ -45,7 +45,7 @@ namespace GameDev2D
         //Cycle through and delete the character set
         while (m_CharacterData.size() > 0)
         {
-            SafeDelete(m_CharacterData.at(0));
+            SafeDelete(m_CharacterData.begin()->second);
             m_CharacterData.erase(m_CharacterData.begin());
         }
     }
@@ -66,6 +66,17 @@ namespace GameDev2D
         return textureFrame;
     }
     
+    Texture* BitmapFont::GetTextureForCharacter(char aCharacter)
+    {
+        //Get the texture for the page the character is on
+        CharacterData* characterData = m_CharacterData[aCharacter];
+        if(characterData != nullptr)
+        {
+            return m_TextureFrames[characterData->m_PageId]->GetTexture();
+        }
+        return nullptr;
+    }
+    
     SourceFrame BitmapFont::GetSourceFrameForCharacter(char aCharacter)
     {
         CharacterData* characterData = m_CharacterData[aCharacter];
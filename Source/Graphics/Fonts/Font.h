@@ -42,6 +42,10 @@ namespace GameDev2D
         //implemented by an inheriting class
         virtual TextureFrame* GetTextureFrameForCharacter(char character) = 0;
         
+        //Returns the Texture that holds the character, unlike GetTextureFrameForCharacter() it doesn't modify
+        //the TextureFrame's source frame. Method is abstract, must be implemented by an inheriting class
+        virtual Texture* GetTextureForCharacter(char character) = 0;
+        
         //Returns the source frame for the character on the TextureFrame. //Method is abstract, must be
         //implemented by an inheriting class
         virtual SourceFrame GetSourceFrameForCharacter(char character) = 0;
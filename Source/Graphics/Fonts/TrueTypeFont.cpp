@@ -70,8 +70,12 @@ namespace GameDev2D
             m_GlyphData.erase(m_GlyphData.begin());
         }
     
-        //Delete the Render Target
-        SafeDelete(m_RenderTarget);
+        //Return the Render Target to the pool
+        if(m_RenderTarget != nullptr)
+        {
+            ServiceLocator::GetGraphics()->GetRenderTargetPool()->ReleaseRenderTarget(m_RenderTarget);
+            m_RenderTarget = nullptr;
+        }
     
         //Cleanup the font face
         FT_Done_Face(m_Face);
@@ -94,6 +98,16 @@ namespace GameDev2D
         return textureFrame;
     }
     
+    Texture* TrueTypeFont::GetTextureForCharacter(char aCharacter)
+    {
+        //All the characters are on the render target's texture
+        if(m_RenderTarget != nullptr && m_RenderTarget->GetTextureFrame() != nullptr)
+        {
+            return m_RenderTarget->GetTextureFrame()->GetTexture();
+        }
+        return nullptr;
+    }
+    
     SourceFrame TrueTypeFont::GetSourceFrameForCharacter(char aCharacter)
     {
         GlyphData* glyphData = m_GlyphData[aCharacter];
@@ -244,19 +258,22 @@ namespace GameDev2D
         //Set the render target size
         vec2 renderTargetSize(cellWidth * cellsPerRow, cellHeight * cellsPerColumn);
         
-        //Delete the render target
-        SafeDelete(m_RenderTarget);
+        //Return the previous render target to the pool
+        if(m_RenderTarget != nullptr)
+        {
+            ServiceLocator::GetGraphics()->GetRenderTargetPool()->ReleaseRenderTarget(m_RenderTarget);
+            m_RenderTarget = nullptr;
+        }
         
-        //Create a new render target, if the assert is hit, that means the render target failed to be created
-        m_RenderTarget = new RenderTarget((int)renderTargetSize.x, (int)renderTargetSize.y);
+        //Acquire a render target from the pool, its frame buffer is already created. If the assert
+        //is hit, that means the render target failed to be created. The render target's size is
+        //rounded up to a power of two, so the glyphs only fill part of it
+        m_RenderTarget = ServiceLocator::GetGraphics()->GetRenderTargetPool()->AcquireRenderTarget((int)renderTargetSize.x, (int)renderTargetSize.y);
         assert(m_RenderTarget != nullptr);
 
         //Safety check the render target
         if(m_RenderTarget != nullptr)
         {
-            //Create the render target's frame buffer
-            m_RenderTarget->CreateFrameBuffer();
-            
             //Cache the render target
             RenderTarget* renderTarget = ServiceLocator::GetGraphics()->GetActiveRenderTarget();
             
@@ -297,7 +314,7 @@ namespace GameDev2D
 
                 //set the sourcce frame for the glyph
                 sourceFrame.position.x = (float)offsetX;
-                sourceFrame.position.y = renderTargetSize.y - offsetY - glyphData->height;
+                sourceFrame.position.y = m_RenderTarget->GetHeight() - offsetY - glyphData->height;
                 sourceFrame.size.x = glyphData->width;
                 sourceFrame.size.y = glyphData->height;
                 glyphData->sourceFrame = sourceFrame;
@@ -42,6 +42,9 @@ namespace GameDev2D
         //Returns the TextureFrame for a given character
         TextureFrame* GetTextureFrameForCharacter(char character);
         
+        //Returns the Texture for a given character
+        Texture* GetTextureForCharacter(char character);
+        
         //Methods to get the source frame, x advance and bearing data for a given character
         SourceFrame GetSourceFrameForCharacter(char character);
         unsigned short GetAdvanceXForCharacter(char character);
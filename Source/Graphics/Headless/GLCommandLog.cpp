@@ -0,0 +1,133 @@
+//
+//  GLCommandLog.cpp
+//  GameDev2D
+//
+
+#include "GLCommandLog.h"
+
+
+namespace GameDev2D
+{
+    //Initialize the static variables
+    vector<GLCommand> GLCommandLog::s_Commands;
+    bool GLCommandLog::s_IsEnabled = true;
+    map<unsigned int, vector<unsigned char>> GLCommandLog::s_BufferData;
+    
+    void GLCommandLog::Record(const GLCommand& aCommand)
+    {
+        if(s_IsEnabled == true)
+        {
+            s_Commands.push_back(aCommand);
+        }
+    }
+    
+    void GLCommandLog::Clear()
+    {
+        s_Commands.clear();
+    }
+    
+    void GLCommandLog::SetEnabled(bool aEnabled)
+    {
+        s_IsEnabled = aEnabled;
+    }
+    
+    bool GLCommandLog::IsEnabled()
+    {
+        return s_IsEnabled;
+    }
+    
+    const vector<GLCommand>& GLCommandLog::GetCommands()
+    {
+        return s_Commands;
+    }
+    
+    unsigned int GLCommandLog::GetCommandCount()
+    {
+        return (unsigned int)s_Commands.size();
+    }
+    
+    unsigned int GLCommandLog::GetCallCount(const string& aName)
+    {
+        unsigned int count = 0;
+        for(vector<GLCommand>::iterator it = s_Commands.begin(); it != s_Commands.end(); ++it)
+        {
+            if(it->name == aName)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+    
+    unsigned int GLCommandLog::GetDrawCallCount()
+    {
+        return GetCallCount("glDrawArrays") + GetCallCount("glDrawElements") + GetCallCount("glDrawArraysInstanced");
+    }
+    
+    unsigned int GLCommandLog::GetStateChangeCount()
+    {
+        unsigned int count = 0;
+        for(vector<GLCommand>::iterator it = s_Commands.begin(); it != s_Commands.end(); ++it)
+        {
+            if(IsStateChange(it->name) == true)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+    
+    unsigned long GLCommandLog::GetUploadBytes()
+    {
+        unsigned long bytes = 0;
+        for(vector<GLCommand>::iterator it = s_Commands.begin(); it != s_Commands.end(); ++it)
+        {
+            bytes += it->bytes;
+        }
+        return bytes;
+    }
+    
+    void GLCommandLog::SetBufferData(unsigned int aBuffer, unsigned long aSize, const void* aData)
+    {
+        //The buffer's storage is reallocated, without any data it is left zeroed
+        vector<unsigned char>& bufferData = s_BufferData[aBuffer];
+        bufferData.assign(aSize, 0);
+        if(aData != nullptr && aSize > 0)
+        {
+            memcpy(&bufferData[0], aData, aSize);
+        }
+    }
+    
+    void GLCommandLog::SetBufferSubData(unsigned int aBuffer, unsigned long aOffset, unsigned long aSize, const void* aData)
+    {
+        //Safety check that the data fits in the buffer's storage, GL wouldn't upload it either
+        vector<unsigned char>& bufferData = s_BufferData[aBuffer];
+        if(aData != nullptr && aSize > 0 && aOffset + aSize <= bufferData.size())
+        {
+            memcpy(&bufferData[aOffset], aData, aSize);
+        }
+    }
+    
+    void GLCommandLog::DeleteBufferData(unsigned int aBuffer)
+    {
+        s_BufferData.erase(aBuffer);
+    }
+    
+    const map<unsigned int, vector<unsigned char>>& GLCommandLog::GetBufferData()
+    {
+        return s_BufferData;
+    }
+    
+    bool GLCommandLog::IsStateChange(const string& aName)
+    {
+        //Any bind call is a state change, except for binding an attribute location which is part of the program
+        if(aName.compare(0, 6, "glBind") == 0 && aName != "glBindAttribLocation")
+        {
+            return true;
+        }
+        
+        //Other calls that change the GL state
+        return aName == "glEnable" || aName == "glDisable" || aName == "glBlendFunc" || aName == "glActiveTexture" ||
+               aName == "glUseProgram" || aName == "glScissor" || aName == "glViewport" || aName == "glClearColor";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+//
+//  GLCommandLog.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__GLCommandLog__
+#define __GameDev2D__GLCommandLog__
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //A single recorded OpenGL call, the arguments are stored in the order they were passed in,
+    //pointer arguments are not stored. The bytes member holds the amount of data that was
+    //uploaded to the GPU by the call (buffers, textures and uniforms), zero for all other calls.
+    struct GLCommand
+    {
+        GLCommand(const string& name, unsigned long bytes = 0) :
+            name(name),
+            bytes(bytes)
+        {
+        }
+        
+        string name;
+        vector<double> arguments;
+        unsigned long bytes;
+    };
+    
+    //The GLCommandLog holds every OpenGL call made by the headless OpenGL implementation, a test or
+    //benchmark would typically Clear() the log, run a frame through the ServiceLocator and then
+    //inspect the recorded commands, draw calls, upload bytes and state changes.
+    class GLCommandLog
+    {
+    public:
+        //Adds a command to the log, called by the headless OpenGL implementation
+        static void Record(const GLCommand& command);
+        
+        //Removes all the recorded commands
+        static void Clear();
+        
+        //Enables or disables recording, enabled by default
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+        
+        //Returns all the commands that were recorded since the last Clear()
+        static const vector<GLCommand>& GetCommands();
+        
+        //Returns the number of recorded commands
+        static unsigned int GetCommandCount();
+        
+        //Returns the number of times a specific GL call was recorded, ie: "glBindTexture"
+        static unsigned int GetCallCount(const string& name);
+        
+        //Returns the number of glDrawArrays, glDrawElements and glDrawArraysInstanced calls
+        static unsigned int GetDrawCallCount();
+        
+        //Returns the number of calls that changed the GL state (binds, enables, blend functions, etc)
+        static unsigned int GetStateChangeCount();
+        
+        //Returns the total number of bytes uploaded to the GPU
+        static unsigned long GetUploadBytes();
+        
+        //Keeps a copy of the data uploaded to the array buffers, so that a check can compare what the GPU would draw. Called by the headless
+        //OpenGL implementation, glBufferData() replaces a buffer's data, glBufferSubData() overwrites part of it and glDeleteBuffers() removes it
+        static void SetBufferData(unsigned int buffer, unsigned long size, const void* data);
+        static void SetBufferSubData(unsigned int buffer, unsigned long offset, unsigned long size, const void* data);
+        static void DeleteBufferData(unsigned int buffer);
+        
+        //Returns the data of every array buffer, keyed by the buffer's name. Unlike the commands, the data isn't removed by Clear()
+        static const map<unsigned int, vector<unsigned char>>& GetBufferData();
+    
+    private:
+        //Returns wether the GL call changes the GL state
+        static bool IsStateChange(const string& name);
+        
+        //Static member variables
+        static vector<GLCommand> s_Commands;
+        static bool s_IsEnabled;
+        static map<unsigned int, vector<unsigned char>> s_BufferData;
+    };
+}
+
+#endif /* defined(__GameDev2D__GLCommandLog__) */
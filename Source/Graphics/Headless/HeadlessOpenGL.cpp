@@ -0,0 +1,619 @@
+//
+//  HeadlessOpenGL.cpp
+//  GameDev2D
+//
+
+#include "../OpenGL.h"
+
+#if HEADLESS_OPENGL
+
+#include "GLCommandLog.h"
+
+
+using namespace GameDev2D;
+
+//Simulated GL state, only what the framework queries back from GL is tracked
+static GLuint s_NextObjectName = 1;
+static GLuint s_BoundFramebuffer = 0;
+static GLuint s_BoundArrayBuffer = 0;
+static GLuint s_BoundTexture = 0;
+static GLuint s_ActiveProgram = 0;
+static GLint s_UnpackAlignment = 4;
+static map<pair<GLuint, string>, GLint> s_UniformLocations;
+static map<GLuint, GLint> s_LinkStatus;
+
+//The headless program binary, every linked program returns the same binary in the same format. A program binary
+//with a different format or different data is rejected, the same way a driver rejects a binary from another driver
+static const GLenum HEADLESS_PROGRAM_BINARY_FORMAT = 0x4844;
+static const char HEADLESS_PROGRAM_BINARY[] = "GameDev2D headless program binary";
+
+//Conveniance function to record a GL call in the GLCommandLog
+static void RecordCommand(const char* aName, initializer_list<double> aArguments, unsigned long aBytes = 0)
+{
+    GLCommand command(aName, aBytes);
+    command.arguments.assign(aArguments.begin(), aArguments.end());
+    GLCommandLog::Record(command);
+}
+
+//Conveniance function to generate object names for the glGen*() calls
+static void GenerateNames(const char* aName, GLsizei aCount, GLuint* aNames)
+{
+    for(GLsizei i = 0; i < aCount; i++)
+    {
+        aNames[i] = s_NextObjectName++;
+    }
+    RecordCommand(aName, {(double)aCount});
+}
+
+//Conveniance function to record the glDelete*() calls
+static void DeleteNames(const char* aName, GLsizei aCount, const GLuint* aNames)
+{
+    GLCommand command(aName);
+    command.arguments.push_back((double)aCount);
+    for(GLsizei i = 0; i < aCount; i++)
+    {
+        command.arguments.push_back((double)aNames[i]);
+    }
+    GLCommandLog::Record(command);
+}
+
+//Returns the number of bytes per pixel for a texture format
+static unsigned long BytesPerPixel(GLenum aFormat, GLenum aType)
+{
+    unsigned long components = 4;
+    switch(aFormat)
+    {
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+            components = 1;
+            break;
+        case GL_LUMINANCE_ALPHA:
+            components = 2;
+            break;
+        case GL_RGB:
+            components = 3;
+            break;
+        default:
+            break;
+    }
+    return aType == GL_FLOAT ? components * sizeof(GLfloat) : components;
+}
+
+//State
+void glEnable(GLenum aCap)
+{
+    RecordCommand("glEnable", {(double)aCap});
+}
+
+void glDisable(GLenum aCap)
+{
+    RecordCommand("glDisable", {(double)aCap});
+}
+
+void glBlendFunc(GLenum aSourceFactor, GLenum aDestinationFactor)
+{
+    RecordCommand("glBlendFunc", {(double)aSourceFactor, (double)aDestinationFactor});
+}
+
+void glViewport(GLint aX, GLint aY, GLsizei aWidth, GLsizei aHeight)
+{
+    RecordCommand("glViewport", {(double)aX, (double)aY, (double)aWidth, (double)aHeight});
+}
+
+void glScissor(GLint aX, GLint aY, GLsizei aWidth, GLsizei aHeight)
+{
+    RecordCommand("glScissor", {(double)aX, (double)aY, (double)aWidth, (double)aHeight});
+}
+
+void glClearColor(GLclampf aRed, GLclampf aGreen, GLclampf aBlue, GLclampf aAlpha)
+{
+    RecordCommand("glClearColor", {aRed, aGreen, aBlue, aAlpha});
+}
+
+void glClear(GLbitfield aMask)
+{
+    RecordCommand("glClear", {(double)aMask});
+}
+
+GLenum glGetError()
+{
+    return GL_NO_ERROR;
+}
+
+void glGetIntegerv(GLenum aName, GLint* aParams)
+{
+    RecordCommand("glGetIntegerv", {(double)aName});
+    switch(aName)
+    {
+        case GL_FRAMEBUFFER_BINDING:
+            *aParams = (GLint)s_BoundFramebuffer;
+            break;
+        case GL_ARRAY_BUFFER_BINDING:
+            *aParams = (GLint)s_BoundArrayBuffer;
+            break;
+        case GL_TEXTURE_BINDING_2D:
+            *aParams = (GLint)s_BoundTexture;
+            break;
+        case GL_CURRENT_PROGRAM:
+            *aParams = (GLint)s_ActiveProgram;
+            break;
+        case GL_MAX_TEXTURE_SIZE:
+            *aParams = 4096;
+            break;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+            *aParams = 16;
+            break;
+        case GL_NUM_PROGRAM_BINARY_FORMATS:
+            *aParams = 1;
+            break;
+        case GL_PROGRAM_BINARY_FORMATS:
+            *aParams = (GLint)HEADLESS_PROGRAM_BINARY_FORMAT;
+            break;
+        default:
+            *aParams = 0;
+            break;
+    }
+}
+
+void glGetFloatv(GLenum aName, GLfloat* aParams)
+{
+    RecordCommand("glGetFloatv", {(double)aName});
+    switch(aName)
+    {
+        case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT:
+            *aParams = 16.0f;
+            break;
+        default:
+            *aParams = 0.0f;
+            break;
+    }
+}
+
+const GLubyte* glGetString(GLenum aName)
+{
+    RecordCommand("glGetString", {(double)aName});
+    switch(aName)
+    {
+        case GL_SHADING_LANGUAGE_VERSION:
+            return (const GLubyte*)"1.50 Headless";
+        case GL_VERSION:
+            return (const GLubyte*)"3.3 Headless";
+        default:
+            return (const GLubyte*)"Headless";
+    }
+}
+
+void glFlush()
+{
+    RecordCommand("glFlush", {});
+}
+
+//Textures
+void glGenTextures(GLsizei aCount, GLuint* aTextures)
+{
+    GenerateNames("glGenTextures", aCount, aTextures);
+}
+
+void glDeleteTextures(GLsizei aCount, const GLuint* aTextures)
+{
+    DeleteNames("glDeleteTextures", aCount, aTextures);
+}
+
+void glActiveTexture(GLenum aTexture)
+{
+    RecordCommand("glActiveTexture", {(double)aTexture});
+}
+
+void glBindTexture(GLenum aTarget, GLuint aTexture)
+{
+    s_BoundTexture = aTexture;
+    RecordCommand("glBindTexture", {(double)aTarget, (double)aTexture});
+}
+
+void glTexParameteri(GLenum aTarget, GLenum aName, GLint aParam)
+{
+    RecordCommand("glTexParameteri", {(double)aTarget, (double)aName, (double)aParam});
+}
+
+void glTexParameterf(GLenum aTarget, GLenum aName, GLfloat aParam)
+{
+    RecordCommand("glTexParameterf", {(double)aTarget, (double)aName, (double)aParam});
+}
+
+void glPixelStorei(GLenum aName, GLint aParam)
+{
+    if(aName == GL_UNPACK_ALIGNMENT)
+    {
+        s_UnpackAlignment = aParam;
+    }
+    RecordCommand("glPixelStorei", {(double)aName, (double)aParam});
+}
+
+void glTexImage2D(GLenum aTarget, GLint aLevel, GLint aInternalFormat, GLsizei aWidth, GLsizei aHeight, GLint aBorder, GLenum aFormat, GLenum aType, const GLvoid* aPixels)
+{
+    //The bytes GL reads from the pixels, every row but the last is padded to the unpack alignment
+    unsigned long bytes = 0;
+    if(aPixels != nullptr && aWidth > 0 && aHeight > 0)
+    {
+        unsigned long rowBytes = (unsigned long)aWidth * BytesPerPixel(aFormat, aType);
+        unsigned long rowStride = (rowBytes + s_UnpackAlignment - 1) / s_UnpackAlignment * s_UnpackAlignment;
+        bytes = rowStride * (unsigned long)(aHeight - 1) + rowBytes;
+    }
+    RecordCommand("glTexImage2D", {(double)aTarget, (double)aLevel, (double)aInternalFormat, (double)aWidth, (double)aHeight, (double)aBorder, (double)aFormat, (double)aType}, bytes);
+}
+
+void glCompressedTexImage2D(GLenum aTarget, GLint aLevel, GLenum aInternalFormat, GLsizei aWidth, GLsizei aHeight, GLint aBorder, GLsizei aImageSize, const GLvoid* aData)
+{
+    RecordCommand("glCompressedTexImage2D", {(double)aTarget, (double)aLevel, (double)aInternalFormat, (double)aWidth, (double)aHeight, (double)aBorder, (double)aImageSize}, aData != nullptr ? (unsigned long)aImageSize : 0);
+}
+
+void glGenerateMipmap(GLenum aTarget)
+{
+    RecordCommand("glGenerateMipmap", {(double)aTarget});
+}
+
+//Buffers and vertex arrays
+void glGenBuffers(GLsizei aCount, GLuint* aBuffers)
+{
+    GenerateNames("glGenBuffers", aCount, aBuffers);
+}
+
+void glDeleteBuffers(GLsizei aCount, const GLuint* aBuffers)
+{
+    for(GLsizei i = 0; i < aCount; i++)
+    {
+        GLCommandLog::DeleteBufferData(aBuffers[i]);
+    }
+    DeleteNames("glDeleteBuffers", aCount, aBuffers);
+}
+
+void glBindBuffer(GLenum aTarget, GLuint aBuffer)
+{
+    if(aTarget == GL_ARRAY_BUFFER)
+    {
+        s_BoundArrayBuffer = aBuffer;
+    }
+    RecordCommand("glBindBuffer", {(double)aTarget, (double)aBuffer});
+}
+
+void glBufferData(GLenum aTarget, GLsizeiptr aSize, const GLvoid* aData, GLenum aUsage)
+{
+    if(aTarget == GL_ARRAY_BUFFER)
+    {
+        GLCommandLog::SetBufferData(s_BoundArrayBuffer, (unsigned long)aSize, aData);
+    }
+    RecordCommand("glBufferData", {(double)aTarget, (double)aSize, (double)aUsage}, aData != nullptr ? (unsigned long)aSize : 0);
+}
+
+void glBufferSubData(GLenum aTarget, GLintptr aOffset, GLsizeiptr aSize, const GLvoid* aData)
+{
+    if(aTarget == GL_ARRAY_BUFFER)
+    {
+        GLCommandLog::SetBufferSubData(s_BoundArrayBuffer, (unsigned long)aOffset, (unsigned long)aSize, aData);
+    }
+    RecordCommand("glBufferSubData", {(double)aTarget, (double)aOffset, (double)aSize}, (unsigned long)aSize);
+}
+
+void glGenVertexArrays(GLsizei aCount, GLuint* aArrays)
+{
+    GenerateNames("glGenVertexArrays", aCount, aArrays);
+}
+
+void glDeleteVertexArrays(GLsizei aCount, const GLuint* aArrays)
+{
+    DeleteNames("glDeleteVertexArrays", aCount, aArrays);
+}
+
+void glBindVertexArray(GLuint aArray)
+{
+    RecordCommand("glBindVertexArray", {(double)aArray});
+}
+
+void glEnableVertexAttribArray(GLuint aIndex)
+{
+    RecordCommand("glEnableVertexAttribArray", {(double)aIndex});
+}
+
+void glDisableVertexAttribArray(GLuint aIndex)
+{
+    RecordCommand("glDisableVertexAttribArray", {(double)aIndex});
+}
+
+void glVertexAttribPointer(GLuint aIndex, GLint aSize, GLenum aType, GLboolean aNormalized, GLsizei aStride, const GLvoid* aPointer)
+{
+    RecordCommand("glVertexAttribPointer", {(double)aIndex, (double)aSize, (double)aType, (double)aNormalized, (double)aStride, (double)(size_t)aPointer});
+}
+
+void glVertexAttrib1f(GLuint aIndex, GLfloat aX)
+{
+    RecordCommand("glVertexAttrib1f", {(double)aIndex, aX});
+}
+
+void glVertexAttrib4f(GLuint aIndex, GLfloat aX, GLfloat aY, GLfloat aZ, GLfloat aW)
+{
+    RecordCommand("glVertexAttrib4f", {(double)aIndex, aX, aY, aZ, aW});
+}
+
+void glVertexAttribDivisor(GLuint aIndex, GLuint aDivisor)
+{
+    RecordCommand("glVertexAttribDivisor", {(double)aIndex, (double)aDivisor});
+}
+
+//Draw calls
+void glDrawArrays(GLenum aMode, GLint aFirst, GLsizei aCount)
+{
+    RecordCommand("glDrawArrays", {(double)aMode, (double)aFirst, (double)aCount});
+}
+
+void glDrawElements(GLenum aMode, GLsizei aCount, GLenum aType, const GLvoid* aIndices)
+{
+    RecordCommand("glDrawElements", {(double)aMode, (double)aCount, (double)aType, (double)(size_t)aIndices});
+}
+
+void glDrawArraysInstanced(GLenum aMode, GLint aFirst, GLsizei aCount, GLsizei aInstanceCount)
+{
+    RecordCommand("glDrawArraysInstanced", {(double)aMode, (double)aFirst, (double)aCount, (double)aInstanceCount});
+}
+
+//Shaders and programs
+GLuint glCreateShader(GLenum aType)
+{
+    GLuint shader = s_NextObjectName++;
+    RecordCommand("glCreateShader", {(double)aType, (double)shader});
+    return shader;
+}
+
+void glDeleteShader(GLuint aShader)
+{
+    RecordCommand("glDeleteShader", {(double)aShader});
+}
+
+void glShaderSource(GLuint aShader, GLsizei aCount, const GLchar* const* aStrings, const GLint* aLengths)
+{
+    unsigned long bytes = 0;
+    for(GLsizei i = 0; i < aCount; i++)
+    {
+        bytes += aLengths != nullptr && aLengths[i] >= 0 ? (unsigned long)aLengths[i] : (unsigned long)string(aStrings[i]).length();
+    }
+    RecordCommand("glShaderSource", {(double)aShader, (double)aCount}, bytes);
+}
+
+void glCompileShader(GLuint aShader)
+{
+    RecordCommand("glCompileShader", {(double)aShader});
+}
+
+void glGetShaderiv(GLuint aShader, GLenum aName, GLint* aParams)
+{
+    RecordCommand("glGetShaderiv", {(double)aShader, (double)aName});
+    *aParams = aName == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void glGetShaderInfoLog(GLuint aShader, GLsizei aBufferSize, GLsizei* aLength, GLchar* aInfoLog)
+{
+    RecordCommand("glGetShaderInfoLog", {(double)aShader, (double)aBufferSize});
+    if(aLength != nullptr)
+    {
+        *aLength = 0;
+    }
+    if(aInfoLog != nullptr && aBufferSize > 0)
+    {
+        aInfoLog[0] = '\0';
+    }
+}
+
+GLuint glCreateProgram()
+{
+    GLuint program = s_NextObjectName++;
+    RecordCommand("glCreateProgram", {(double)program});
+    return program;
+}
+
+void glDeleteProgram(GLuint aProgram)
+{
+    //Remove the program's uniform locations
+    for(map<pair<GLuint, string>, GLint>::iterator it = s_UniformLocations.begin(); it != s_UniformLocations.end();)
+    {
+        if(it->first.first == aProgram)
+        {
+            s_UniformLocations.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    
+    s_LinkStatus.erase(aProgram);
+    RecordCommand("glDeleteProgram", {(double)aProgram});
+}
+
+void glAttachShader(GLuint aProgram, GLuint aShader)
+{
+    RecordCommand("glAttachShader", {(double)aProgram, (double)aShader});
+}
+
+void glBindAttribLocation(GLuint aProgram, GLuint aIndex, const GLchar* aName)
+{
+    RecordCommand("glBindAttribLocation", {(double)aProgram, (double)aIndex});
+}
+
+void glLinkProgram(GLuint aProgram)
+{
+    s_LinkStatus[aProgram] = GL_TRUE;
+    RecordCommand("glLinkProgram", {(double)aProgram});
+}
+
+void glValidateProgram(GLuint aProgram)
+{
+    RecordCommand("glValidateProgram", {(double)aProgram});
+}
+
+void glGetProgramiv(GLuint aProgram, GLenum aName, GLint* aParams)
+{
+    RecordCommand("glGetProgramiv", {(double)aProgram, (double)aName});
+    
+    //Programs are linked unless a program binary was rejected, only linked programs have a program binary
+    map<GLuint, GLint>::iterator it = s_LinkStatus.find(aProgram);
+    GLint linkStatus = it != s_LinkStatus.end() ? it->second : GL_TRUE;
+    switch(aName)
+    {
+        case GL_LINK_STATUS:
+            *aParams = linkStatus;
+            break;
+        case GL_VALIDATE_STATUS:
+            *aParams = GL_TRUE;
+            break;
+        case GL_PROGRAM_BINARY_LENGTH:
+            *aParams = linkStatus == GL_TRUE ? (GLint)sizeof(HEADLESS_PROGRAM_BINARY) : 0;
+            break;
+        default:
+            *aParams = 0;
+            break;
+    }
+}
+
+void glGetProgramInfoLog(GLuint aProgram, GLsizei aBufferSize, GLsizei* aLength, GLchar* aInfoLog)
+{
+    RecordCommand("glGetProgramInfoLog", {(double)aProgram, (double)aBufferSize});
+    if(aLength != nullptr)
+    {
+        *aLength = 0;
+    }
+    if(aInfoLog != nullptr && aBufferSize > 0)
+    {
+        aInfoLog[0] = '\0';
+    }
+}
+
+void glGetProgramBinary(GLuint aProgram, GLsizei aBufferSize, GLsizei* aLength, GLenum* aBinaryFormat, GLvoid* aBinary)
+{
+    RecordCommand("glGetProgramBinary", {(double)aProgram, (double)aBufferSize});
+    
+    //Copy the program binary, nothing is copied if it doesn't fit in the buffer
+    GLsizei length = aBufferSize >= (GLsizei)sizeof(HEADLESS_PROGRAM_BINARY) ? (GLsizei)sizeof(HEADLESS_PROGRAM_BINARY) : 0;
+    if(length > 0 && aBinary != nullptr)
+    {
+        memcpy(aBinary, HEADLESS_PROGRAM_BINARY, length);
+    }
+    if(aBinaryFormat != nullptr)
+    {
+        *aBinaryFormat = HEADLESS_PROGRAM_BINARY_FORMAT;
+    }
+    if(aLength != nullptr)
+    {
+        *aLength = length;
+    }
+}
+
+void glProgramBinary(GLuint aProgram, GLenum aBinaryFormat, const GLvoid* aBinary, GLsizei aLength)
+{
+    RecordCommand("glProgramBinary", {(double)aProgram, (double)aBinaryFormat, (double)aLength}, (unsigned long)aLength);
+    
+    //The program is only linked if the program binary is the headless program binary
+    bool isValid = aBinaryFormat == HEADLESS_PROGRAM_BINARY_FORMAT && aLength == (GLsizei)sizeof(HEADLESS_PROGRAM_BINARY) && aBinary != nullptr && memcmp(aBinary, HEADLESS_PROGRAM_BINARY, aLength) == 0;
+    s_LinkStatus[aProgram] = isValid == true ? GL_TRUE : GL_FALSE;
+}
+
+void glProgramParameteri(GLuint aProgram, GLenum aName, GLint aValue)
+{
+    RecordCommand("glProgramParameteri", {(double)aProgram, (double)aName, (double)aValue});
+}
+
+void glUseProgram(GLuint aProgram)
+{
+    s_ActiveProgram = aProgram;
+    RecordCommand("glUseProgram", {(double)aProgram});
+}
+
+GLint glGetUniformLocation(GLuint aProgram, const GLchar* aName)
+{
+    //Hand out a unique location for every uniform name, per program
+    pair<GLuint, string> key(aProgram, aName);
+    map<pair<GLuint, string>, GLint>::iterator it = s_UniformLocations.find(key);
+    GLint location = 0;
+    if(it != s_UniformLocations.end())
+    {
+        location = it->second;
+    }
+    else
+    {
+        for(it = s_UniformLocations.begin(); it != s_UniformLocations.end(); ++it)
+        {
+            if(it->first.first == aProgram)
+            {
+                location++;
+            }
+        }
+        s_UniformLocations[key] = location;
+    }
+    
+    RecordCommand("glGetUniformLocation", {(double)aProgram, (double)location});
+    return location;
+}
+
+void glUniform1i(GLint aLocation, GLint aValue)
+{
+    RecordCommand("glUniform1i", {(double)aLocation, (double)aValue}, sizeof(GLint));
+}
+
+void glUniformMatrix4fv(GLint aLocation, GLsizei aCount, GLboolean aTranspose, const GLfloat* aValue)
+{
+    RecordCommand("glUniformMatrix4fv", {(double)aLocation, (double)aCount, (double)aTranspose}, (unsigned long)aCount * 16 * sizeof(GLfloat));
+}
+
+//Framebuffers and renderbuffers
+void glGenFramebuffers(GLsizei aCount, GLuint* aFramebuffers)
+{
+    GenerateNames("glGenFramebuffers", aCount, aFramebuffers);
+}
+
+void glDeleteFramebuffers(GLsizei aCount, const GLuint* aFramebuffers)
+{
+    DeleteNames("glDeleteFramebuffers", aCount, aFramebuffers);
+}
+
+void glBindFramebuffer(GLenum aTarget, GLuint aFramebuffer)
+{
+    s_BoundFramebuffer = aFramebuffer;
+    RecordCommand("glBindFramebuffer", {(double)aTarget, (double)aFramebuffer});
+}
+
+GLenum glCheckFramebufferStatus(GLenum aTarget)
+{
+    RecordCommand("glCheckFramebufferStatus", {(double)aTarget});
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void glFramebufferTexture2D(GLenum aTarget, GLenum aAttachment, GLenum aTextureTarget, GLuint aTexture, GLint aLevel)
+{
+    RecordCommand("glFramebufferTexture2D", {(double)aTarget, (double)aAttachment, (double)aTextureTarget, (double)aTexture, (double)aLevel});
+}
+
+void glFramebufferRenderbuffer(GLenum aTarget, GLenum aAttachment, GLenum aRenderbufferTarget, GLuint aRenderbuffer)
+{
+    RecordCommand("glFramebufferRenderbuffer", {(double)aTarget, (double)aAttachment, (double)aRenderbufferTarget, (double)aRenderbuffer});
+}
+
+void glGenRenderbuffers(GLsizei aCount, GLuint* aRenderbuffers)
+{
+    GenerateNames("glGenRenderbuffers", aCount, aRenderbuffers);
+}
+
+void glDeleteRenderbuffers(GLsizei aCount, const GLuint* aRenderbuffers)
+{
+    DeleteNames("glDeleteRenderbuffers", aCount, aRenderbuffers);
+}
+
+void glBindRenderbuffer(GLenum aTarget, GLuint aRenderbuffer)
+{
+    RecordCommand("glBindRenderbuffer", {(double)aTarget, (double)aRenderbuffer});
+}
+
+void glGetRenderbufferParameteriv(GLenum aTarget, GLenum aName, GLint* aParams)
+{
+    RecordCommand("glGetRenderbufferParameteriv", {(double)aTarget, (double)aName});
+    *aParams = 0;
+}
+
+#endif
\ No newline at end of file
@@ -9,7 +9,11 @@
 #ifndef GameDev2D_OpenGL_h
 #define GameDev2D_OpenGL_h
 
-#if __APPLE__
+//Add HEADLESS_OPENGL=1 to the preprocessor definitions to replace the platform's OpenGL implementation
+//with the headless OpenGL implementation, which records every GL call in the GLCommandLog instead
+#if HEADLESS_OPENGL
+    #include "Headless/HeadlessOpenGL.h"
+#elif __APPLE__
     #include "TargetConditionals.h"
 
     #if TARGET_OS_IPHONE
@@ -7,14 +7,36 @@
 //
 
 #include "Circle.h"
+#include "../../Services/ServiceLocator.h"
 #include "../../Services/Graphics/Graphics.h"
 
 
+#ifndef CIRCLE_AUTOMATIC_LINE_SEGMENTS
+#define CIRCLE_AUTOMATIC_LINE_SEGMENTS 1
+#endif
+
+#ifndef CIRCLE_LINE_SEGMENT_LENGTH
+#define CIRCLE_LINE_SEGMENT_LENGTH 8.0f
+#endif
+
+#ifndef CIRCLE_MIN_LINE_SEGMENTS
+#define CIRCLE_MIN_LINE_SEGMENTS 12
+#endif
+
+#ifndef CIRCLE_MAX_LINE_SEGMENTS
+#define CIRCLE_MAX_LINE_SEGMENTS 128
+#endif
+
+
 namespace GameDev2D
 {
+    //Initialize the static vars
+    map<unsigned int, vector<vec2>> Circle::s_UnitCircles;
+    
     Circle::Circle() : Polygon("Circle"),
         m_Radius(0.0f),
         m_LineSegments(DEFAULT_LINE_SEGMENTS),
+        m_AutomaticLineSegments(CIRCLE_AUTOMATIC_LINE_SEGMENTS),
         m_TweenRadius()
     {
         SetLocalPosition(0.0f, 0.0f);
@@ -26,6 +48,7 @@ namespace GameDev2D
     Circle::Circle(float aX, float aY, float aRadius) : Polygon("Circle"),
         m_Radius(aRadius),
         m_LineSegments(DEFAULT_LINE_SEGMENTS),
+        m_AutomaticLineSegments(CIRCLE_AUTOMATIC_LINE_SEGMENTS),
         m_TweenRadius()
     {
         SetLocalPosition(aX, aY);
@@ -37,6 +60,7 @@ namespace GameDev2D
     Circle::Circle(vec2 aPosition, float aRadius) : Polygon("Circle"),
         m_Radius(aRadius),
         m_LineSegments(DEFAULT_LINE_SEGMENTS),
+        m_AutomaticLineSegments(CIRCLE_AUTOMATIC_LINE_SEGMENTS),
         m_TweenRadius()
     {
         SetLocalPosition(aPosition);
@@ -54,12 +78,28 @@ namespace GameDev2D
         Polygon::Update(aDelta);
     }
     
+    void Circle::Draw()
+    {
+        //Pick the number of line segments for the radius on screen, the vertices are only reset if it changed
+        if(m_AutomaticLineSegments == true)
+        {
+            unsigned int lineSegments = CalculateLineSegments();
+            if(lineSegments != m_LineSegments)
+            {
+                m_LineSegments = lineSegments;
+                ResetPolygonData();
+            }
+        }
+        
+        //Call the Polygon's Draw() method
+        Polygon::Draw();
+    }
+    
     void Circle::SetRadius(float aRadius, double aDuration, EasingFunction aEasingFunction, bool aReverse, int aRepeatCount)
     {
         if(aDuration == 0.0)
         {
             m_Radius = fmaxf(aRadius, 0.0f);
-            ResetPolygonData();
             ModelMatrixIsDirty();
         }
         else
@@ -76,6 +116,7 @@ namespace GameDev2D
     void Circle::SetLineSegments(unsigned int aLineSegments)
     {
         m_LineSegments = aLineSegments;
+        m_AutomaticLineSegments = false;
         ResetPolygonData();
     }
     
@@ -84,10 +125,39 @@ namespace GameDev2D
         return m_LineSegments;
     }
     
+    void Circle::SetAutomaticLineSegments(bool aAutomaticLineSegments)
+    {
+        m_AutomaticLineSegments = aAutomaticLineSegments;
+    }
+    
+    bool Circle::HasAutomaticLineSegments()
+    {
+        return m_AutomaticLineSegments;
+    }
+    
+    const vector<vec2>& Circle::GetUnitCircle(unsigned int aLineSegments)
+    {
+        //Is there already a table for the number of line segments?
+        map<unsigned int, vector<vec2>>::iterator it = s_UnitCircles.find(aLineSegments);
+        if(it != s_UnitCircles.end())
+        {
+            return it->second;
+        }
+        
+        //Calculate the table, the first vertex is at an angle of zero
+        vector<vec2>& unitCircle = s_UnitCircles[aLineSegments];
+        for(unsigned int i = 0; i < aLineSegments; i++)
+        {
+            float angle = 2.0f * (float)M_PI * (float)i / (float)aLineSegments;
+            unitCircle.push_back(vec2(cosf(angle), sinf(angle)));
+        }
+        return unitCircle;
+    }
+    
     void Circle::ResetPolygonData()
     {
-        //Safety check the radius
-        if(GetRadius() == 0.0f)
+        //Safety check the line segments
+        if(GetLineSegments() == 0)
         {
             return;
         }
@@ -98,22 +168,56 @@ namespace GameDev2D
         //Clear the colors vector
         m_Colors.clear();
     
-        //Calculate the rotation amount
-        float rotationAmount = (360.0f / (float)GetLineSegments());
-        
-        //Set the vertices
-        vec2 vertex;
-        for (float i = 0; i < 359.99f; i+= rotationAmount)
+        //Set the vertices from the unit circle table, with a radius of one, the model matrix scales them by the radius
+        const vector<vec2>& unitCircle = GetUnitCircle(GetLineSegments());
+        for(unsigned int i = 0; i < unitCircle.size(); i++)
         {
-            vertex.x = GetRadius() - (cosf(((float)M_PI * i / 180.0f)) * GetRadius());
-            vertex.y = GetRadius() - (sinf(((float)M_PI * i / 180.0f)) * GetRadius());
-            AddVertex(vertex);
+            AddVertex(vec2(1.0f - unitCircle.at(i).x, 1.0f - unitCircle.at(i).y));
         }
         
         //Set the render mode
         SetRenderMode(m_IsFilled ? GL_TRIANGLE_FAN : GL_LINE_LOOP);
         
-        //Update the vertex buffer
-        UpdateVertexBuffer();
+        //Set the vertex buffer to dirty
+        VertexBufferIsDirty();
+    }
+    
+    void Circle::ResetModelMatrix()
+    {
+        //Translate the position, the circle rotates around its anchor point
+        mat4 viewTranslate = translate(mat4(1.0f), vec3(GetWorldPosition().x, GetWorldPosition().y, 0.0f));
+    
+    #if DRAW_POLYGON_ANCHOR_POINT
+        m_AnchorLocation = GetWorldPosition();
+    #endif
+        
+        //Rotate, then scale the unit circle by the radius
+        mat4 viewRotation = rotate(viewTranslate, GetWorldAngle(), vec3(0.0f, 0.0f, 1.0f));
+        mat4 viewScale = scale(viewRotation, vec3(GetWorldScale().x * m_Radius, GetWorldScale().y * m_Radius, 0.0f));
+        
+        //Lastly translate the anchor, the unit circle's vertices are two units wide and high
+        m_ModelMatrix = translate(viewScale, vec3(-2.0f * GetAnchorPoint().x, -2.0f * GetAnchorPoint().y, 0.0f));
+        
+        //Reset the model matrix
+        GameObject::ResetModelMatrix();
+    }
+    
+    unsigned int Circle::CalculateLineSegments()
+    {
+        //Get the radius on screen, under the active camera's zoom
+        float radius = m_Radius * fmaxf(fabsf(GetWorldScale().x), fabsf(GetWorldScale().y));
+        Camera* camera = ServiceLocator::GetGraphics()->GetActiveCamera();
+        if(camera != nullptr)
+        {
+            radius *= camera->GetZoom();
+        }
+        
+        //One line segment for every CIRCLE_LINE_SEGMENT_LENGTH pixels of circumference, rounded up to a multiple
+        //of four, so that small changes in the radius don't change the line segments (and the shared tables stay few)
+        unsigned int lineSegments = (unsigned int)ceilf(2.0f * (float)M_PI * radius / CIRCLE_LINE_SEGMENT_LENGTH);
+        lineSegments = (lineSegments + 3) / 4 * 4;
+        lineSegments = lineSegments < CIRCLE_MIN_LINE_SEGMENTS ? CIRCLE_MIN_LINE_SEGMENTS : lineSegments;
+        lineSegments = lineSegments > CIRCLE_MAX_LINE_SEGMENTS ? CIRCLE_MAX_LINE_SEGMENTS : lineSegments;
+        return lineSegments;
     }
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define __GameDev2D__Circle__
 
 #include "Polygon.h"
+#include <map>
 
 
 using namespace glm;
@@ -19,8 +20,9 @@ namespace GameDev2D
     //Circle Constants
     const unsigned int DEFAULT_LINE_SEGMENTS = 36;
 
-    //The Circle class inherits from the Polygon class, it sets up the
-    //Polygon's vertices based on the position and radius of the Circle
+    //The Circle class inherits from the Polygon class, it sets up the Polygon's vertices from a shared
+    //unit circle table, the radius is applied by the model matrix so changing it never rebuilds the vertices.
+    //By default the number of line segments is picked from the radius on screen, under the camera's zoom
     class Circle : public Polygon
     {
     public:
@@ -34,6 +36,9 @@ namespace GameDev2D
         //Updates the circle radius tween
         void Update(double delta);
         
+        //Draws the circle, picks the number of line segments first if they are automatic
+        void Draw();
+        
         //Sets the radius of circle, can be set to animate over a duration,
         //an easing function can be applied, can be revered and repeated
         void SetRadius(float radius, double duration = 0.0, EasingFunction easingFunction = Linear::Interpolation, bool reverse = false, int repeatCount = 0);
@@ -42,18 +47,37 @@ namespace GameDev2D
         float GetRadius();
         
         //Line segment getter and setter methods, represents
-        //how many lines segments are used to draw the circle
+        //how many lines segments are used to draw the circle,
+        //setting the line segments turns off automatic line segments
         void SetLineSegments(unsigned int lineSegments);
         unsigned int GetLineSegments();
         
+        //Sets wether the number of line segments is picked from the radius on screen
+        void SetAutomaticLineSegments(bool automaticLineSegments);
+        bool HasAutomaticLineSegments();
+        
+        //Returns the unit circle vertices (cos, sin) for a number of line segments, the
+        //tables are calculated once and shared by all the circles that use the same count
+        static const vector<vec2>& GetUnitCircle(unsigned int lineSegments);
+        
     private:
         //Resets the polygon data for a Circle, inherited from Polygon
         void ResetPolygonData();
     
+        //Resets the model matrix for a Circle, scales the unit circle by the radius
+        void ResetModelMatrix();
+        
+        //Returns the number of line segments for the radius on screen
+        unsigned int CalculateLineSegments();
+        
         //Member variables
         float m_Radius;
         unsigned int m_LineSegments;
+        bool m_AutomaticLineSegments;
         Tween m_TweenRadius;
+        
+        //The shared unit circle tables, keyed by the number of line segments
+        static map<unsigned int, vector<vec2>> s_UnitCircles;
     };
 }
 
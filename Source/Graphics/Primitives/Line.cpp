@@ -133,7 +133,7 @@ namespace GameDev2D
         //Set the render mode
         SetRenderMode(GL_LINES);
         
-        //Update the vertex buffer
-        UpdateVertexBuffer();
+        //Set the vertex buffer to dirty
+        VertexBufferIsDirty();
     }
 }
\ No newline at end of file
@@ -44,7 +44,7 @@ namespace GameDev2D
         //Set the render mode
         SetRenderMode(GL_POINTS);
         
-        //Update the vertex buffer
-        UpdateVertexBuffer();
+        //Set the vertex buffer to dirty
+        VertexBufferIsDirty();
     }
 }
\ No newline at end of file
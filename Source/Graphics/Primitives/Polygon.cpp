@@ -18,7 +18,7 @@ namespace GameDev2D
         m_Shader(nullptr),
         m_AnchorPoint(0.0f, 0.0f),
         m_AnchorLocation(0.0f, 0.0f),
-        m_Color(Color::BlueColor()),
+        m_Color(Color::BlueColor().GetRGBA()),
         m_RenderMode(GL_TRIANGLE_FAN),
         m_IsFilled(true),
         m_PointSize(1.0f),
@@ -26,7 +26,10 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_VertexArrayObject(0),
-        m_VertexBufferObject(0)
+        m_VertexBufferObject(0),
+        m_VertexBufferCapacity(0),
+        m_VertexData(),
+        m_IsVertexBufferDirty(true)
     {
         //Set the shader as the default passthrough shader
         SetShader(ServiceLocator::GetShaderManager()->GetPassthroughShader());
@@ -43,7 +46,7 @@ namespace GameDev2D
         m_Shader(nullptr),
         m_AnchorPoint(0.0f, 0.0f),
         m_AnchorLocation(0.0f, 0.0f),
-        m_Color(Color::BlueColor()),
+        m_Color(Color::BlueColor().GetRGBA()),
         m_RenderMode(GL_TRIANGLE_FAN),
         m_IsFilled(true),
         m_PointSize(1.0f),
@@ -51,7 +54,10 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_VertexArrayObject(0),
-        m_VertexBufferObject(0)
+        m_VertexBufferObject(0),
+        m_VertexBufferCapacity(0),
+        m_VertexData(),
+        m_IsVertexBufferDirty(true)
     {
         //Set the shader as the default passthrough shader
         SetShader(ServiceLocator::GetShaderManager()->GetPassthroughShader());
@@ -71,7 +77,7 @@ namespace GameDev2D
         m_Shader(aShader),
         m_AnchorPoint(0.0f, 0.0f),
         m_AnchorLocation(0.0f, 0.0f),
-        m_Color(Color::BlackColor()),
+        m_Color(Color::BlackColor().GetRGBA()),
         m_RenderMode(GL_TRIANGLE_FAN),
         m_IsFilled(true),
         m_PointSize(1.0f),
@@ -79,7 +85,10 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_VertexArrayObject(0),
-        m_VertexBufferObject(0)
+        m_VertexBufferObject(0),
+        m_VertexBufferCapacity(0),
+        m_VertexData(),
+        m_IsVertexBufferDirty(true)
     {
         //Set the vertices
         SetVertices(aVertices, aCount);
@@ -100,6 +109,12 @@ namespace GameDev2D
         //Delete the VBO
         if(m_VertexBufferObject != 0)
         {
+            //If the VBO we are about to delete is bound, we need to unbind it
+            if(m_VertexBufferObject == ServiceLocator::GetGraphics()->GetBoundArrayBuffer())
+            {
+                ServiceLocator::GetGraphics()->BindArrayBuffer(0);
+            }
+            
             glDeleteBuffers(1, &m_VertexBufferObject);
             m_VertexBufferObject = 0;
         }
@@ -107,8 +122,7 @@ namespace GameDev2D
         //Delete the VAO
         if(m_VertexArrayObject != 0)
         {
-            glDeleteVertexArrays(1, &m_VertexArrayObject);
-            m_VertexArrayObject = 0;
+            ServiceLocator::GetGraphics()->DeleteVertexArray(m_VertexArrayObject);
         }
         
         //Clear the vertices vector
@@ -142,51 +156,41 @@ namespace GameDev2D
         {
             ResetModelMatrix();
         }
-    
-        //Use the shader
-        m_Shader->Use();
         
-        //Set the point size attribute
-        #ifdef GL_VERTEX_PROGRAM_POINT_SIZE
-        int pointSizeIndex = m_Shader->GetAttribute("a_pointSize");
-        glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
-        glVertexAttrib1f(pointSizeIndex, m_PointSize);
-        #endif
+        //If the vertex buffer is dirty, update it. Any pending render commands for the VAO still need the old vertices, submit them first
+        if(IsVertexBufferDirty() == true)
+        {
+            if(ServiceLocator::GetGraphics()->GetRenderQueue()->HasPendingCommands(m_VertexArrayObject) == true)
+            {
+                ServiceLocator::GetGraphics()->GetRenderQueue()->Submit();
+            }
+            UpdateVertexBuffer();
+        }
         
         //Cache the graphics service
         Graphics* graphics = ServiceLocator::GetGraphics();
-    
-        //Bind the vertex array object
-        graphics->BindVertexArray(m_VertexArrayObject);
-
-        //Set the model view projection matrix
-        mat4 mvp = graphics->GetProjectionMatrix() * graphics->GetViewMatrix() * m_ModelMatrix;
-        glUniformMatrix4fv(m_Shader->GetModelViewProjectionUniform(), 1, 0, &mvp[0][0]);
         
-        //Validate the shader
-        if(m_Shader->Validate() == false)
-        {
-            Error(false, "Can't draw Polygon, shader failed to validate");
-            return;
-        }
+        //Setup the render command for the polygon's vertices
+        RenderCommand command = MakeRenderCommand(m_Shader, nullptr, m_VertexArrayObject, m_RenderMode, 0, (unsigned int)m_Vertices.size());
         
-        //Disable blending, if we did in fact have it enabled
-        if(m_Color.Alpha() != 1.0f)
-        {
-            graphics->EnableBlending();
-        }
+        //Set the point size attribute
+        #ifdef GL_VERTEX_PROGRAM_POINT_SIZE
+        glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+        command.pointSizeAttribute = m_Shader->GetAttribute("a_pointSize");
+        command.pointSize = m_PointSize;
+        #endif
         
-        //Render the polygon
-        glDrawArrays(m_RenderMode, 0, (GLsizei)m_Vertices.size());
+        //Set the model view projection matrix
+        command.modelViewProjection = graphics->GetProjectionMatrix() * graphics->GetViewMatrix() * m_ModelMatrix;
         
-        //Disable blending, if we did in fact have it enabled
-        if(m_Color.Alpha() != 1.0f)
+        //Enable blending if the color has transparency
+        if(m_Color.a != 1.0f)
         {
-            graphics->DisableBlending();
+            command.blending = RenderCommandBlendingAlpha;
         }
         
-        //Unbind the vertex array
-        ServiceLocator::GetGraphics()->BindVertexArray(0);
+        //Add the render command, it is submitted by the Graphics service's RenderQueue
+        graphics->GetRenderQueue()->AddCommand(command);
         
         //Draw the debug anchor point
         #if DRAW_POLYGON_ANCHOR_POINT
@@ -214,7 +218,10 @@ namespace GameDev2D
         m_Vertices.push_back(aVertex);
         
         //Add color for the vertex to the colors vector
-        m_Colors.push_back(vec4(m_Color.Red(), m_Color.Green(), m_Color.Blue(), m_Color.Alpha()));
+        m_Colors.push_back(m_Color);
+        
+        //Set the vertex buffer to dirty
+        VertexBufferIsDirty();
     }
         
     void Polygon::SetVertices(vec2* aVertices, unsigned int aCount)
@@ -239,6 +246,9 @@ namespace GameDev2D
         
         //Clear the colors vector
         m_Colors.clear();
+        
+        //Set the vertex buffer to dirty
+        VertexBufferIsDirty();
     }
     
     void Polygon::SetShader(Shader* aShader)
@@ -247,6 +257,7 @@ namespace GameDev2D
         if(aShader != nullptr)
         {
             m_Shader = aShader;
+            VertexBufferIsDirty();
         }
     }
     
@@ -306,17 +317,14 @@ namespace GameDev2D
     void Polygon::SetColor(Color aColor, bool aUpdateVector)
     {
         //Set the color
-        m_Color = aColor;
+        m_Color = aColor.GetRGBA();
         
         //Cycle through and update the colors vector
         if(aUpdateVector == true)
         {
             for(unsigned int i = 0; i < m_Colors.size(); i++)
             {
-                m_Colors.at(i).r = m_Color.Red();
-                m_Colors.at(i).g = m_Color.Green();
-                m_Colors.at(i).b = m_Color.Blue();
-                m_Colors.at(i).a = m_Color.Alpha();
+                m_Colors.at(i) = m_Color;
             }
             
             ResetPolygonData();
@@ -325,7 +333,7 @@ namespace GameDev2D
     
     Color Polygon::GetColor()
     {
-        return m_Color;
+        return Color(m_Color);
     }
     
     void Polygon::SetAlpha(float aAlpha, double aDuration, EasingFunction aEasingFunction, bool aReverse, int aRepeatCount)
@@ -333,28 +341,28 @@ namespace GameDev2D
         if(aDuration == 0.0)
         {
             //Set the alpha
-            m_Color.SetAlpha(aAlpha);
+            m_Color.a = fminf(fmaxf(aAlpha, 0.0f), 1.0f);
             
             //Cycle through all the vertices and set the color for them
             for(unsigned int i = 0; i < m_Colors.size(); i++)
             {
-                m_Colors.at(i).a = m_Color.Alpha();
+                m_Colors.at(i).a = m_Color.a;
             }
             
             ResetPolygonData();
         }
         else
         {
-            if(m_Color.Alpha() != aAlpha)
+            if(m_Color.a != aAlpha)
             {
-                m_TweenAlpha.Set(m_Color.Alpha(), aAlpha, aDuration, aEasingFunction, aReverse, aRepeatCount);
+                m_TweenAlpha.Set(m_Color.a, aAlpha, aDuration, aEasingFunction, aReverse, aRepeatCount);
             }
         }
     }
     
     float Polygon::GetAlpha()
     {
-        return m_Color.Alpha();
+        return m_Color.a;
     }
     
     void Polygon::SetIsFilled(bool aIsFilled)
@@ -371,6 +379,7 @@ namespace GameDev2D
     void Polygon::SetRenderMode(unsigned int aRenderMode)
     {
         m_RenderMode = aRenderMode;
+        WorldBoundsAreDirty();
     }
     
     void Polygon::CancelTweens()
@@ -383,7 +392,7 @@ namespace GameDev2D
     void Polygon::SetPointSize(float aPointSize)
     {
         m_PointSize = aPointSize;
-        UpdateVertexBuffer();
+        WorldBoundsAreDirty();
     }
     
     float Polygon::GetPointSize()
@@ -391,13 +400,44 @@ namespace GameDev2D
         return m_PointSize;
     }
     
+    bool Polygon::GetLocalBounds(BoundingBox& aBounds)
+    {
+        //Cycle through and expand the bounds by the vertices
+        aBounds = MakeEmptyBoundingBox();
+        for(unsigned int i = 0; i < m_Vertices.size(); i++)
+        {
+            ExpandBoundingBox(aBounds, m_Vertices.at(i));
+        }
+        
+        //Points are drawn centered on the vertices, expand the bounds by half the point size
+        if(m_RenderMode == GL_POINTS && IsBoundingBoxEmpty(aBounds) == false)
+        {
+            aBounds.min -= vec2(m_PointSize * 0.5f, m_PointSize * 0.5f);
+            aBounds.max += vec2(m_PointSize * 0.5f, m_PointSize * 0.5f);
+        }
+        
+        return true;
+    }
+    
     void Polygon::ResetPolygonData()
     {
         //Set the render mode
         SetRenderMode(m_IsFilled ? GL_TRIANGLE_FAN : GL_LINE_LOOP);
         
-        //And update the vertex buffer
-        UpdateVertexBuffer();
+        //And set the vertex buffer to dirty
+        VertexBufferIsDirty();
+    }
+    
+    void Polygon::VertexBufferIsDirty()
+    {
+        //The vertices changed, so did the bounds
+        m_IsVertexBufferDirty = true;
+        WorldBoundsAreDirty();
+    }
+    
+    bool Polygon::IsVertexBufferDirty()
+    {
+        return m_IsVertexBufferDirty;
     }
     
     void Polygon::UpdateVertexBuffer()
@@ -414,47 +454,52 @@ namespace GameDev2D
             return;
         }
     
-        //If the VAO hasn't been generated, generate one
+        //The vertex buffer is up to date
+        m_IsVertexBufferDirty = false;
+        
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //Interleaved vertex format
+        const long vertexSize = 2;
+        const long colorSize = 4;
+        const long stride = sizeof(float) * (vertexSize + colorSize);
+        
+        //If the VAO and VBO haven't been generated, generate them
         if(m_VertexArrayObject == 0)
         {
             glGenVertexArrays(1, &m_VertexArrayObject);
-        }
-        
-        //Bind the VAO
-        ServiceLocator::GetGraphics()->BindVertexArray(m_VertexArrayObject);
-
-        //Use the shader
-        m_Shader->Use();
-
-        //If the VBO hasn't been generated, generate one
-        if(m_VertexBufferObject == 0)
-        {
             glGenBuffers(1, &m_VertexBufferObject);
         }
         
-        //Bind the VBO
-        glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+        //Bind the VAO and the VBO
+        graphics->BindVertexArray(m_VertexArrayObject);
+        graphics->BindArrayBuffer(m_VertexBufferObject);
 
-        //Create an array to hold the vertices
+        //Reuse the vertex data vector to hold the vertices
         const long vertexCount = m_Vertices.size();
-        const long vertexSize = 2;
-        const long colorSize = 4;
-        float* vertices = new float[vertexCount * (vertexSize + colorSize)];
+        m_VertexData.resize(vertexCount * (vertexSize + colorSize));
         
         //Cycle through and set the vertices and their colors
         for(int i = 0; i < vertexCount; i++)
         {
             int offset = i * (vertexSize + colorSize);
-            vertices[offset] = m_Vertices.at(i).x;      //X vertex
-            vertices[offset+1] = m_Vertices.at(i).y;    //Y vertex
-            vertices[offset+2] = m_Color.Red();         //Red color
-            vertices[offset+3] = m_Color.Green();       //Green color
-            vertices[offset+4] = m_Color.Blue();        //Blue color
-            vertices[offset+5] = m_Color.Alpha();       //Alpha color
+            m_VertexData[offset] = m_Vertices.at(i).x;      //X vertex
+            m_VertexData[offset+1] = m_Vertices.at(i).y;    //Y vertex
+            m_VertexData[offset+2] = m_Color.r;             //Red color
+            m_VertexData[offset+3] = m_Color.g;             //Green color
+            m_VertexData[offset+4] = m_Color.b;             //Blue color
+            m_VertexData[offset+5] = m_Color.a;             //Alpha color
         }
         
-        //Set the vertex data
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertexCount * (vertexSize + colorSize), vertices, GL_STATIC_DRAW);
+        //Orphan the vertex buffer and upload the vertex data, the buffer only grows
+        unsigned int size = (unsigned int)(sizeof(float) * m_VertexData.size());
+        m_VertexBufferCapacity = size > m_VertexBufferCapacity ? size : m_VertexBufferCapacity;
+        glBufferData(GL_ARRAY_BUFFER, m_VertexBufferCapacity, nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, &m_VertexData[0]);
+        
+        //Use the shader
+        m_Shader->Use();
         
         //Enable the shader's vertices attribute
         int verticesIndex = m_Shader->GetAttribute("a_vertices");
@@ -462,7 +507,7 @@ namespace GameDev2D
 
         //Set the shader's vertices attribute
         long verticesOffset = 0;
-        glVertexAttribPointer(verticesIndex, vertexSize, GL_FLOAT, GL_FALSE, sizeof(float) * (vertexSize + colorSize), (const GLvoid*)verticesOffset);
+        glVertexAttribPointer(verticesIndex, vertexSize, GL_FLOAT, GL_FALSE, stride, (const GLvoid*)verticesOffset);
         
         //Enable the shader's color attribute
         int colorIndex = m_Shader->GetAttribute("a_sourceColor");
@@ -470,13 +515,10 @@ namespace GameDev2D
         
         //Set the shader's colors attribute
         long colorOffset = vertexSize * sizeof(float);
-        glVertexAttribPointer(colorIndex, colorSize, GL_FLOAT, GL_FALSE, sizeof(float) * (vertexSize + colorSize), (const GLvoid*)colorOffset);
-        
-        //Delete the vertices array
-        SafeDeleteArray(vertices);
+        glVertexAttribPointer(colorIndex, colorSize, GL_FLOAT, GL_FALSE, stride, (const GLvoid*)colorOffset);
         
         //Unbind the VAO
-        ServiceLocator::GetGraphics()->BindVertexArray(0);
+        graphics->BindVertexArray(0);
     }
     
     void Polygon::ResetModelMatrix()
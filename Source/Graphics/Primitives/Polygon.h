@@ -93,6 +93,9 @@ namespace GameDev2D
         //Returns the point size of the polygon
         float GetPointSize();
         
+        //Sets the local bounds of the polygon's vertices, used to cull the polygon
+        virtual bool GetLocalBounds(BoundingBox& bounds);
+        
         //Set the open gl render mode of the polygon
         void SetRenderMode(unsigned int renderMode);
         
@@ -106,6 +109,11 @@ namespace GameDev2D
         //Used to reset the model matrix for the polygon
         virtual void ResetModelMatrix();
     
+        //Sets the vertex buffer to dirty, it is updated the next time the polygon is drawn. Changes to the
+        //position, angle and scale only affect the model matrix and never update the vertex buffer
+        void VertexBufferIsDirty();
+        bool IsVertexBufferDirty();
+        
         //Used to update the vertex buffer
         void UpdateVertexBuffer();
     
@@ -114,8 +122,8 @@ namespace GameDev2D
         Shader* m_Shader;
         vec2 m_AnchorPoint;
         vec2 m_AnchorLocation;
-        Color m_Color;
-        vector<vec4> m_Colors;
+        ColorRGBA m_Color;
+        vector<ColorRGBA> m_Colors;
         unsigned int m_RenderMode;
         bool m_IsFilled;
         float m_PointSize;
@@ -124,6 +132,9 @@ namespace GameDev2D
         Tween m_TweenAlpha;
         unsigned int m_VertexArrayObject;
         unsigned int m_VertexBufferObject;
+        unsigned int m_VertexBufferCapacity;
+        vector<float> m_VertexData;
+        bool m_IsVertexBufferDirty;
     };
 }
 
@@ -130,7 +130,7 @@ namespace GameDev2D
         //Set the render mode
         SetRenderMode(m_IsFilled ? GL_TRIANGLE_FAN : GL_LINE_LOOP);
         
-        //Update the vertex buffer
-        UpdateVertexBuffer();
+        //Set the vertex buffer to dirty
+        VertexBufferIsDirty();
     }
 }
@@ -0,0 +1,276 @@
+//
+//  AnimationClip.cpp
+//  GameDev2D
+//
+
+#include "AnimationClip.h"
+#include "Texture.h"
+#include "../Core/Shader.h"
+#include "../../Platforms/PlatformLayer.h"
+#include "../../Services/ServiceLocator.h"
+
+
+namespace GameDev2D
+{
+    AnimationClip::AnimationClip(const string& aImageFile, const string& aJsonFile) : BaseObject("AnimationClip"),
+        m_ImageFile(aImageFile),
+        m_TextureFrame(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_AttributeLocations(-1, -1, -1)
+    {
+        //Load the texture via a TextureFrame, the TextureManager will ensure only one texture with this filename will be loaded
+        m_TextureFrame = new TextureFrame(aImageFile, "", "Images");
+        
+        //Load the animation frames
+        LoadFrames(aJsonFile);
+        
+        //Create the vertex buffer for all the frames
+        CreateVertexBuffer();
+    }
+    
+    AnimationClip::~AnimationClip()
+    {
+        //Delete the TextureFrame, this will remove the texture from the TextureManager
+        SafeDelete(m_TextureFrame);
+        
+        //If the buffer we are about to delete is bound, we need to unbind it
+        if(m_VertexBufferObject != 0)
+        {
+            if(ServiceLocator::GetGraphics()->GetBoundArrayBuffer() == m_VertexBufferObject)
+            {
+                ServiceLocator::GetGraphics()->BindArrayBuffer(0);
+            }
+            
+            //Delete the VBO
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+        }
+        
+        //Delete the VAO
+        if(m_VertexArrayObject != 0)
+        {
+            ServiceLocator::GetGraphics()->DeleteVertexArray(m_VertexArrayObject);
+        }
+    }
+    
+    void AnimationClip::Draw(unsigned int aFrameIndex, mat4 aModelMatrix, Shader* aShader, const ColorRGBA& aColor)
+    {
+        //Safety check the frame index, shader and texture
+        if(aFrameIndex >= GetFrameCount() || aShader == nullptr || GetTexture() == nullptr)
+        {
+            return;
+        }
+        
+        //Get the Graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //Setup the vertex array for the shader, this will also bind the vertex array object
+        SetVertexAttributes(aShader);
+        
+        //Setup the render command, each frame has four vertices in the vertex buffer
+        RenderCommand command = MakeRenderCommand(aShader, GetTexture(), m_VertexArrayObject, GL_TRIANGLE_STRIP, aFrameIndex * TEXTURE_FRAME_VERTEX_COUNT, TEXTURE_FRAME_VERTEX_COUNT);
+        
+        //Set the model view projection matrix, the vertices are for a unit quad, scale it by the frame's size
+        SourceFrame sourceFrame = m_SourceFrames.at(aFrameIndex);
+        command.modelViewProjection = graphics->GetProjectionMatrix() * graphics->GetViewMatrix() * scale(aModelMatrix, vec3(sourceFrame.size.x, sourceFrame.size.y, 1.0f));
+        
+        //Set the color, the color attribute array is disabled so the constant attribute value is used. A premultiplied texture needs a premultiplied color
+        bool isPremultiplied = GetTexture()->IsPremultiplied();
+        command.colorAttribute = aShader->GetAttribute("a_textureColor");
+        command.color = isPremultiplied == true ? PremultiplyColorRGBA(aColor) : aColor;
+        
+        //Enable blending if the texture has an alpha channel, a premultiplied texture's color is already multiplied by its alpha
+        if(GetTexture()->GetFormat() == GL_RGBA || aColor.a != 1.0f)
+        {
+            command.blending = isPremultiplied == true ? RenderCommandBlendingPremultiplied : RenderCommandBlendingAlpha;
+        }
+        
+        //Add the render command, it is submitted by the Graphics service's RenderQueue
+        graphics->GetRenderQueue()->AddCommand(command);
+    }
+    
+    unsigned long AnimationClip::GetFrameCount()
+    {
+        return m_SourceFrames.size();
+    }
+    
+    SourceFrame AnimationClip::GetSourceFrame(unsigned int aFrameIndex)
+    {
+        if(aFrameIndex < m_SourceFrames.size())
+        {
+            return m_SourceFrames.at(aFrameIndex);
+        }
+        return SourceFrame();
+    }
+    
+    string AnimationClip::GetAtlasKey(unsigned int aFrameIndex)
+    {
+        if(aFrameIndex < m_AtlasKeys.size())
+        {
+            return m_AtlasKeys.at(aFrameIndex);
+        }
+        return "";
+    }
+    
+    string AnimationClip::GetImageFile()
+    {
+        return m_ImageFile;
+    }
+    
+    Texture* AnimationClip::GetTexture()
+    {
+        if(m_TextureFrame != nullptr)
+        {
+            return m_TextureFrame->GetTexture();
+        }
+        return nullptr;
+    }
+    
+    void AnimationClip::LoadFrames(const string& aJsonFile)
+    {
+        //Append the filename to the directory
+        string jsonFile = aJsonFile;
+        
+        //Was .json appended to the filename? If it was, remove it
+        size_t found = jsonFile.find(".json");
+        if(found != std::string::npos)
+        {
+            jsonFile.erase(found, 5);
+        }
+        
+        //Get the json path
+        string jsonPath = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(jsonFile.c_str(), "json", "Images");
+        
+        //Does the json file exist, if the assert is hit it means the json file doesn't exist
+        bool doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(jsonPath);
+        assert(doesExist == true);
+        
+        //Does the file exist, load the json data
+        if(doesExist == true)
+        {
+            //Open the input stream
+            std::ifstream inputStream;
+            inputStream.open(jsonPath, std::ifstream::in);
+            
+            //Parse the json file
+            Json::Value root;
+            Json::Reader reader;
+            if(reader.parse(inputStream, root, false) == true)
+            {
+                //Get the frames data
+                const Json::Value frames = root["frames"];
+                
+                //Cycle through and load the source frame for each frame in the animation
+                for(unsigned int index = 0; index < frames.size(); index++)
+                {
+                    //Get the atlas key
+                    string atlasKey = frames[index]["filename"].asString();
+                    
+                    //Load the atlas frame, the TextureManager caches the atlas data
+                    SourceFrame* sourceFrame = ServiceLocator::GetTextureManager()->LoadAtlasFrame(m_ImageFile, atlasKey, "Images");
+                    if(sourceFrame == nullptr)
+                    {
+                        Error(false, "Failed to load the frame with atlas key: %s, for the animation: %s", atlasKey.c_str(), m_ImageFile.c_str());
+                        continue;
+                    }
+                    
+                    //Add the frame
+                    m_AtlasKeys.push_back(atlasKey);
+                    m_SourceFrames.push_back(*sourceFrame);
+                }
+            }
+            
+            //Close the input stream
+            inputStream.close();
+        }
+    }
+    
+    void AnimationClip::CreateVertexBuffer()
+    {
+        //Safety check the texture and the frames
+        Texture* texture = GetTexture();
+        if(texture == nullptr || m_SourceFrames.size() == 0)
+        {
+            return;
+        }
+        
+        //Create the vertices for all the frames, four vertices per frame
+        vector<TextureFrameVertex> vertices;
+        vertices.reserve(m_SourceFrames.size() * TEXTURE_FRAME_VERTEX_COUNT);
+        
+        //Cycle through the frames and build the vertices, the same way the TextureFrame does
+        for(unsigned int i = 0; i < m_SourceFrames.size(); i++)
+        {
+            //Build the UV Coordinates
+            SourceFrame sourceFrame = m_SourceFrames.at(i);
+            float x1 = sourceFrame.position.x / (float)texture->GetSize().x;
+            float y1 = 1.0f - ((sourceFrame.position.y + sourceFrame.size.y) / (float)texture->GetSize().y);
+            float x2 = (sourceFrame.position.x + sourceFrame.size.x) / (float)texture->GetSize().x;
+            float y2 = 1.0f - (sourceFrame.position.y / (float)texture->GetSize().y);
+            
+            //Add the vertices, in triangle strip order
+            const TextureFrameVertex frameVertices[TEXTURE_FRAME_VERTEX_COUNT] =
+            {
+                { 0.0f, 0.0f, x1, y1 },
+                { 1.0f, 0.0f, x2, y1 },
+                { 0.0f, 1.0f, x1, y2 },
+                { 1.0f, 1.0f, x2, y2 }
+            };
+            vertices.insert(vertices.end(), frameVertices, frameVertices + TEXTURE_FRAME_VERTEX_COUNT);
+        }
+        
+        //Generate the VBO and upload the vertices, they will never change
+        glGenBuffers(1, &m_VertexBufferObject);
+        ServiceLocator::GetGraphics()->BindArrayBuffer(m_VertexBufferObject);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(TextureFrameVertex) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
+    }
+    
+    void AnimationClip::SetVertexAttributes(Shader* aShader)
+    {
+        //Get the Graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //If the VAO hasn't been generated yet, generate one
+        if(m_VertexArrayObject == 0)
+        {
+            glGenVertexArrays(1, &m_VertexArrayObject);
+        }
+        
+        //Bind the VAO
+        graphics->BindVertexArray(m_VertexArrayObject);
+        
+        //If the shader's attribute locations are the same as last time, the VAO is already setup
+        ivec3 attributeLocations(aShader->GetAttribute("a_vertices"), aShader->GetAttribute("a_textureCoordinates"), aShader->GetAttribute("a_textureColor"));
+        if(attributeLocations == m_AttributeLocations)
+        {
+            return;
+        }
+        
+        //Any pending render commands for the VAO were added with the previous attribute locations, submit them first
+        if(graphics->GetRenderQueue()->HasPendingCommands(m_VertexArrayObject) == true)
+        {
+            graphics->GetRenderQueue()->Submit();
+            graphics->BindVertexArray(m_VertexArrayObject);
+        }
+        
+        //Set the attribute locations
+        m_AttributeLocations = attributeLocations;
+        
+        //Bind the VBO
+        graphics->BindArrayBuffer(m_VertexBufferObject);
+        
+        //Enable and set the shader's vertices attribute
+        glEnableVertexAttribArray(m_AttributeLocations.x);
+        long verticesOffset = 0;
+        glVertexAttribPointer(m_AttributeLocations.x, 2, GL_FLOAT, GL_FALSE, sizeof(TextureFrameVertex), (const GLvoid*)verticesOffset);
+        
+        //Enable and set the shader's texture coordinates attribute
+        glEnableVertexAttribArray(m_AttributeLocations.y);
+        long uvOffset = 2 * sizeof(float);
+        glVertexAttribPointer(m_AttributeLocations.y, 2, GL_FLOAT, GL_FALSE, sizeof(TextureFrameVertex), (const GLvoid*)uvOffset);
+        
+        //Disable the shader's color attribute array, the color is set when the frame is drawn
+        glDisableVertexAttribArray(m_AttributeLocations.z);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+//
+//  AnimationClip.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__AnimationClip__
+#define __GameDev2D__AnimationClip__
+
+#include "../../Core/BaseObject.h"
+#include "TextureFrame.h"
+
+
+using namespace glm;
+using namespace std;
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class Shader;
+    class Texture;
+    
+    //The AnimationClip holds the frames of an animation loaded from an image and a json file. The source frames of
+    //every frame are baked into a single vertex buffer, four vertices per frame, that is shared by all the Sprites
+    //that play the animation. The AnimationClip doesn't hold any per Sprite state (frame index, elapsed time, color).
+    //AnimationClips are reference counted by the TextureManager, use AddAnimationClip() and RemoveAnimationClip()
+    class AnimationClip : public BaseObject
+    {
+    public:
+        AnimationClip(const string& imageFile, const string& jsonFile);
+        ~AnimationClip();
+        
+        //Draws a frame of the animation, for a given model matrix, Shader and color
+        void Draw(unsigned int frameIndex, mat4 modelMatrix, Shader* shader, const ColorRGBA& color);
+        
+        //Returns the number of frames in the animation
+        unsigned long GetFrameCount();
+        
+        //Returns the source frame for a frame in the animation
+        SourceFrame GetSourceFrame(unsigned int frameIndex);
+        
+        //Returns the atlas key for a frame in the animation
+        string GetAtlasKey(unsigned int frameIndex);
+        
+        //Returns the image filename the animation was loaded from
+        string GetImageFile();
+        
+        //Returns the Texture that holds the animation frames
+        Texture* GetTexture();
+    
+    private:
+        //Conveniance method to load the atlas keys and source frames from the json file
+        void LoadFrames(const string& jsonFile);
+        
+        //Conveniance method to create the vertex buffer, with the uv coordinates for every frame
+        void CreateVertexBuffer();
+        
+        //Conveniance method to setup the vertex array for a shader, the vertex array is only updated
+        //if the shader's attribute locations are different than the last shader it was setup for
+        void SetVertexAttributes(Shader* shader);
+        
+        //Member variables
+        string m_ImageFile;
+        TextureFrame* m_TextureFrame;
+        vector<string> m_AtlasKeys;
+        vector<SourceFrame> m_SourceFrames;
+        
+        //VAO and VBO member variables
+        unsigned int m_VertexArrayObject;
+        unsigned int m_VertexBufferObject;
+        ivec3 m_AttributeLocations;
+    };
+}
+
+#endif /* defined(__GameDev2D__AnimationClip__) */
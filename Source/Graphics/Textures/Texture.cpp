@@ -7,38 +7,93 @@
 //
 
 #include "Texture.h"
+#include "TextureContainer.h"
+#include "TextureCompression.h"
 #include "../../Services/ServiceLocator.h"
 #include "../../Services/Graphics/Graphics.h"
+#include "../../Platforms/PlatformLayer.h"
+
+
+//The compressed texture formats aren't defined by every platform's OpenGL headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+#ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#endif
+
+#ifndef TEXTURE_DEFAULT_FILTER
+#define TEXTURE_DEFAULT_FILTER TextureFilterNearest
+#endif
+
+#ifndef TEXTURE_DEFAULT_ANISOTROPY
+#define TEXTURE_DEFAULT_ANISOTROPY 1.0f
+#endif
+
+#ifndef TEXTURE_GENERATE_MIPMAPS
+#define TEXTURE_GENERATE_MIPMAPS 0
+#endif
 
 
 namespace GameDev2D
 {
     Texture::Texture(const string& aFilename) : BaseObject("Texture"),
         m_Size(uvec2(0, 0)),
-        m_MipmapLevel(0),
+        m_MipmapCount(1),
+        m_Filter(TEXTURE_DEFAULT_FILTER),
+        m_Anisotropy(TEXTURE_DEFAULT_ANISOTROPY),
         m_Format(0),
+        m_CompressedFormat(0),
         m_Id(0),
-        m_Filename(string(aFilename))
+        m_Filename(string(aFilename)),
+        m_IsPremultiplied(false),
+        m_ResidentMemory(0),
+        m_UncompressedMemory(0)
     {
         
     }
     
     Texture::Texture(unsigned int aWidth, unsigned int aHeight, unsigned int aFormat, void* aData) : BaseObject("Texture"),
         m_Size(uvec2(aWidth, aHeight)),
-        m_MipmapLevel(0),
+        m_MipmapCount(1),
+        m_Filter(TEXTURE_DEFAULT_FILTER),
+        m_Anisotropy(TEXTURE_DEFAULT_ANISOTROPY),
         m_Format(aFormat),
+        m_CompressedFormat(0),
         m_Id(0),
-        m_Filename("")
+        m_Filename(""),
+        m_IsPremultiplied(false),
+        m_ResidentMemory(0),
+        m_UncompressedMemory(0)
     {
         GenerateTexture(aData);
     }
     
     Texture::Texture(unsigned int aWidth, unsigned int aHeight) : BaseObject("Texture"),
         m_Size(uvec2(aWidth, aHeight)),
-        m_MipmapLevel(0),
+        m_MipmapCount(1),
+        m_Filter(TEXTURE_DEFAULT_FILTER),
+        m_Anisotropy(TEXTURE_DEFAULT_ANISOTROPY),
         m_Format(GL_RGBA),
+        m_CompressedFormat(0),
         m_Id(0),
-        m_Filename("")
+        m_Filename(""),
+        m_IsPremultiplied(false),
+        m_ResidentMemory(0),
+        m_UncompressedMemory(0)
     {
         GenerateTexture(0);
     }
@@ -48,15 +103,8 @@ namespace GameDev2D
         //Safety check the texture id
         if(m_Id != 0)
         {
-            //If the texture we are about to delete is bound, we need to unbind it
-            if(m_Id == ServiceLocator::GetGraphics()->GetBoundTextureId())
-            {
-                ServiceLocator::GetGraphics()->BindTexture(nullptr);
-            }
-        
-            //Delete the texture
-            glDeleteTextures(1, &m_Id);
-            m_Id = 0;
+            //Delete the texture, the Graphics service unbinds it if it is bound to any texture unit
+            ServiceLocator::GetGraphics()->DeleteTexture(m_Id);
         }
     }
     
@@ -80,8 +128,191 @@ namespace GameDev2D
         return m_Filename;
     }
     
+    bool Texture::IsPremultiplied()
+    {
+        return m_IsPremultiplied;
+    }
+    
+    bool Texture::IsCompressed()
+    {
+        return m_CompressedFormat != 0;
+    }
+    
+    void Texture::SetFilter(TextureFilter aFilter)
+    {
+        m_Filter = aFilter;
+        
+        //If the texture has been generated, update its texture parameters
+        if(m_Id != 0)
+        {
+            ServiceLocator::GetGraphics()->BindTexture(this);
+            ApplySamplingPolicy();
+        }
+    }
+    
+    TextureFilter Texture::GetFilter()
+    {
+        return m_Filter;
+    }
+    
+    void Texture::SetAnisotropy(float aAnisotropy)
+    {
+        m_Anisotropy = aAnisotropy;
+        
+        //If the texture has been generated, update its texture parameters
+        if(m_Id != 0)
+        {
+            ServiceLocator::GetGraphics()->BindTexture(this);
+            ApplySamplingPolicy();
+        }
+    }
+    
+    float Texture::GetAnisotropy()
+    {
+        return m_Anisotropy;
+    }
+    
+    bool Texture::GenerateMipmaps()
+    {
+        //The texture must have been generated, and it can't be block compressed
+        if(m_Id == 0 || m_CompressedFormat != 0)
+        {
+            return false;
+        }
+        
+        //On Windows the function pointer also has to be loaded
+        #if _WIN32 && !HEADLESS_OPENGL
+        if(glGenerateMipmap == nullptr)
+        {
+            return false;
+        }
+        #endif
+        
+        //Generate the mipmaps from the first level
+        ServiceLocator::GetGraphics()->BindTexture(this);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        
+        //Count the mipmap levels, the chain goes down to 1x1
+        unsigned int width = m_Size.x;
+        unsigned int height = m_Size.y;
+        m_MipmapCount = 1;
+        while(width > 1 || height > 1)
+        {
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+            m_MipmapCount++;
+        }
+        
+        //Sample the mipmaps and include them in the texture's memory
+        ApplySamplingPolicy();
+        CalculateMemory();
+        return true;
+    }
+    
+    unsigned int Texture::GetMipmapCount()
+    {
+        return m_MipmapCount;
+    }
+    
+    unsigned int Texture::GetResidentMemory()
+    {
+        return m_ResidentMemory;
+    }
+    
+    unsigned int Texture::GetUncompressedMemory()
+    {
+        return m_UncompressedMemory;
+    }
+    
     bool Texture::LoadFromPath(const string& aPath)
     {
+        //Texture containers are memory mapped and uploaded straight from the mapped file
+        if(IsContainerPath(aPath) == true)
+        {
+            //Map the texture container
+            unsigned int containerSize = 0;
+            const unsigned char* containerData = (const unsigned char*)ServiceLocator::GetPlatformLayer()->MapFile(aPath, containerSize);
+            if(containerData == nullptr)
+            {
+                return false;
+            }
+            
+            //Generate the OpenGL texture with the container's image data, decompressing it if the format isn't supported
+            TextureImageData imageData;
+            bool success = ReadContainerData(containerData, containerSize, imageData);
+            if(success == true)
+            {
+                bool didDecompress = DecompressImageData(imageData);
+                LoadFromImageData(imageData);
+                
+                //Free the decompressed data, it has been uploaded
+                if(didDecompress == true)
+                {
+                    SafeFree(imageData.data);
+                }
+            }
+            
+            //Unmap the texture container, the pixels have been uploaded
+            ServiceLocator::GetPlatformLayer()->UnmapFile(containerData, containerSize);
+            return success;
+        }
+        
+        //Decode the png image
+        TextureImageData imageData;
+        if(DecodeFromPath(aPath, imageData) == false)
+        {
+            return false;
+        }
+        
+        //Generate the OpenGL texture with the image data
+        LoadFromImageData(imageData);
+        
+        //Free the image data it has served its purpose
+        SafeFree(imageData.data);
+        return true;
+    }
+    
+    bool Texture::DecodeFromPath(const string& aPath, TextureImageData& aImageData)
+    {
+        //Initialize the image data
+        aImageData.data = nullptr;
+        aImageData.size = uvec2(0, 0);
+        aImageData.format = 0;
+        aImageData.compressedFormat = 0;
+        aImageData.dataSize = 0;
+        aImageData.mipmapCount = 1;
+        aImageData.isPremultiplied = false;
+        
+        //Is the path for a texture container?
+        if(IsContainerPath(aPath) == true)
+        {
+            //Map the texture container
+            unsigned int containerSize = 0;
+            const unsigned char* containerData = (const unsigned char*)ServiceLocator::GetPlatformLayer()->MapFile(aPath, containerSize);
+            if(containerData == nullptr)
+            {
+                return false;
+            }
+            
+            //The image data must outlive the mapping, so the pixels are copied, there is no decoding or flipping. If the
+            //compressed format isn't supported the pixels are decompressed instead, on the worker thread
+            TextureImageData containerImageData;
+            bool success = ReadContainerData(containerData, containerSize, containerImageData);
+            if(success == true)
+            {
+                aImageData = containerImageData;
+                if(DecompressImageData(aImageData) == false)
+                {
+                    aImageData.data = (unsigned char*)malloc(containerImageData.dataSize);
+                    memcpy(aImageData.data, containerImageData.data, containerImageData.dataSize);
+                }
+            }
+            
+            //Unmap the texture container
+            ServiceLocator::GetPlatformLayer()->UnmapFile(containerData, containerSize);
+            return success;
+        }
+        
         png_structp png_ptr;
         png_infop info_ptr;
         unsigned int sig_read = 0;
@@ -141,8 +372,8 @@ namespace GameDev2D
         //pixels) into the info structure with this call:
         png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING | PNG_TRANSFORM_EXPAND, NULL);
         
-        //Set the texture data
-        SetPngData(png_ptr, info_ptr);
+        //Set the image data
+        SetPngData(png_ptr, info_ptr, aImageData);
         
         //Clean up after the read, and free any memory allocated - REQUIRED
         png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
@@ -154,32 +385,209 @@ namespace GameDev2D
         return true;
     }
     
-    void Texture::SetPngData(png_structp aPngPointer, png_infop aInfoPointer)
+    void Texture::LoadFromImageData(const TextureImageData& aImageData)
+    {
+        //Set the size, the texture color format, the compressed format, the number of mipmaps and wether the color is premultiplied
+        m_Size = aImageData.size;
+        m_Format = aImageData.format;
+        m_CompressedFormat = aImageData.compressedFormat;
+        m_MipmapCount = aImageData.mipmapCount;
+        m_IsPremultiplied = aImageData.isPremultiplied;
+        
+        //Generate the OpenGL texture with the image data
+        GenerateTexture(aImageData.data);
+        
+        //Upload the remaining mipmap levels, the texture is still bound from GenerateTexture()
+        if(m_MipmapCount > 1)
+        {
+            unsigned int containerFormat = GetContainerFormat(m_Format, m_CompressedFormat);
+            unsigned char* levelData = aImageData.data + GetTextureContainerLevelSize(containerFormat, m_Size.x, m_Size.y);
+            for(unsigned int level = 1; level < m_MipmapCount; level++)
+            {
+                unsigned int width = (m_Size.x >> level) > 0 ? (m_Size.x >> level) : 1;
+                unsigned int height = (m_Size.y >> level) > 0 ? (m_Size.y >> level) : 1;
+                unsigned int levelSize = GetTextureContainerLevelSize(containerFormat, width, height);
+                if(m_CompressedFormat != 0)
+                {
+                    glCompressedTexImage2D(GL_TEXTURE_2D, level, m_CompressedFormat, width, height, 0, levelSize, levelData);
+                }
+                else
+                {
+                    glTexImage2D(GL_TEXTURE_2D, level, m_Format, width, height, 0, m_Format, GL_UNSIGNED_BYTE, levelData);
+                }
+                levelData += levelSize;
+            }
+        }
+        
+        //Generate the mipmaps, if the image data doesn't have any
+        #if TEXTURE_GENERATE_MIPMAPS
+        if(m_MipmapCount == 1)
+        {
+            GenerateMipmaps();
+        }
+        #endif
+    }
+    
+    bool Texture::ReadContainerData(const unsigned char* aContainerData, unsigned int aContainerSize, TextureImageData& aImageData)
+    {
+        //Safety check the size of the container
+        if(aContainerSize < sizeof(TextureContainerHeader))
+        {
+            return false;
+        }
+        
+        //Copy the header, the mapped data might not be aligned
+        TextureContainerHeader header;
+        memcpy(&header, aContainerData, sizeof(TextureContainerHeader));
+        
+        //Validate the header
+        if(header.magic != TEXTURE_CONTAINER_MAGIC || header.version != TEXTURE_CONTAINER_VERSION || GetTextureContainerLevelSize(header.format, 1, 1) == 0 || header.width == 0 || header.height == 0)
+        {
+            return false;
+        }
+        
+        //Calculate the size of the mipmap levels, there is either one level or a full chain down to 1x1
+        unsigned int dataSize = 0;
+        unsigned int levelCount = 0;
+        unsigned int width = header.width;
+        unsigned int height = header.height;
+        while(true)
+        {
+            dataSize += GetTextureContainerLevelSize(header.format, width, height);
+            levelCount++;
+            
+            //Stop at the last level or at the 1x1 level
+            if(levelCount == header.mipmapCount || (width == 1 && height == 1))
+            {
+                break;
+            }
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        
+        //Validate the mipmap levels and the data size, the last level of a chain has to be 1x1
+        bool isFullChain = width == 1 && height == 1;
+        if(levelCount != header.mipmapCount || (levelCount > 1 && isFullChain == false) || dataSize != header.dataSize || aContainerSize - sizeof(TextureContainerHeader) < dataSize)
+        {
+            return false;
+        }
+        
+        //Set the image data, it points into the container's data
+        aImageData.data = (unsigned char*)(aContainerData + sizeof(TextureContainerHeader));
+        aImageData.size = uvec2(header.width, header.height);
+        aImageData.format = DoesTextureContainerFormatHaveAlpha(header.format) == true ? GL_RGBA : GL_RGB;
+        aImageData.compressedFormat = 0;
+        aImageData.dataSize = dataSize;
+        aImageData.mipmapCount = header.mipmapCount;
+        aImageData.isPremultiplied = (header.flags & TextureContainerFlagPremultiplied) != 0;
+        
+        //Set the OpenGL compressed format
+        if(header.format == TextureContainerFormatBC1)
+        {
+            aImageData.compressedFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        }
+        else if(header.format == TextureContainerFormatBC3)
+        {
+            aImageData.compressedFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        }
+        else if(header.format == TextureContainerFormatETC2RGB8)
+        {
+            aImageData.compressedFormat = GL_COMPRESSED_RGB8_ETC2;
+        }
+        else if(header.format == TextureContainerFormatETC2RGBA8)
+        {
+            aImageData.compressedFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        }
+        return true;
+    }
+    
+    bool Texture::IsContainerPath(const string& aPath)
+    {
+        string extension = "." + TEXTURE_CONTAINER_EXTENSION;
+        return aPath.length() > extension.length() && aPath.compare(aPath.length() - extension.length(), extension.length(), extension) == 0;
+    }
+    
+    bool Texture::DecompressImageData(TextureImageData& aImageData)
+    {
+        //Is the image data compressed in a format that OpenGL doesn't support?
+        if(aImageData.compressedFormat == 0 || ServiceLocator::GetGraphics()->IsCompressedTextureFormatSupported(aImageData.compressedFormat) == true)
+        {
+            return false;
+        }
+        
+        //Calculate the size of the decompressed levels
+        unsigned int containerFormat = GetContainerFormat(aImageData.format, aImageData.compressedFormat);
+        unsigned int uncompressedFormat = aImageData.format == GL_RGBA ? TextureContainerFormatRGBA8 : TextureContainerFormatRGB8;
+        unsigned int dataSize = 0;
+        for(unsigned int level = 0; level < aImageData.mipmapCount; level++)
+        {
+            unsigned int width = (aImageData.size.x >> level) > 0 ? (aImageData.size.x >> level) : 1;
+            unsigned int height = (aImageData.size.y >> level) > 0 ? (aImageData.size.y >> level) : 1;
+            dataSize += GetTextureContainerLevelSize(uncompressedFormat, width, height);
+        }
+        
+        //Decompress each level
+        unsigned char* data = (unsigned char*)malloc(dataSize);
+        const unsigned char* blocks = aImageData.data;
+        unsigned char* pixels = data;
+        for(unsigned int level = 0; level < aImageData.mipmapCount; level++)
+        {
+            unsigned int width = (aImageData.size.x >> level) > 0 ? (aImageData.size.x >> level) : 1;
+            unsigned int height = (aImageData.size.y >> level) > 0 ? (aImageData.size.y >> level) : 1;
+            DecompressTextureBlocks(containerFormat, blocks, width, height, pixels);
+            blocks += GetTextureContainerLevelSize(containerFormat, width, height);
+            pixels += GetTextureContainerLevelSize(uncompressedFormat, width, height);
+        }
+        
+        //Set the decompressed data
+        aImageData.data = data;
+        aImageData.compressedFormat = 0;
+        aImageData.dataSize = dataSize;
+        return true;
+    }
+    
+    unsigned int Texture::GetContainerFormat(unsigned int aFormat, unsigned int aCompressedFormat)
+    {
+        if(aCompressedFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+        {
+            return TextureContainerFormatBC1;
+        }
+        else if(aCompressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+        {
+            return TextureContainerFormatBC3;
+        }
+        else if(aCompressedFormat == GL_COMPRESSED_RGB8_ETC2)
+        {
+            return TextureContainerFormatETC2RGB8;
+        }
+        else if(aCompressedFormat == GL_COMPRESSED_RGBA8_ETC2_EAC)
+        {
+            return TextureContainerFormatETC2RGBA8;
+        }
+        return aFormat == GL_RGBA ? TextureContainerFormatRGBA8 : TextureContainerFormatRGB8;
+    }
+    
+    void Texture::SetPngData(png_structp aPngPointer, png_infop aInfoPointer, TextureImageData& aImageData)
     {
         //Get the data, width and height of the image.
         png_size_t rowBytes = png_get_rowbytes(aPngPointer, aInfoPointer);
         png_bytepp rowPointers = png_get_rows(aPngPointer, aInfoPointer);
-        m_Size.x = png_get_image_width(aPngPointer, aInfoPointer);
-        m_Size.y = png_get_image_height(aPngPointer, aInfoPointer);
+        aImageData.size.x = png_get_image_width(aPngPointer, aInfoPointer);
+        aImageData.size.y = png_get_image_height(aPngPointer, aInfoPointer);
         unsigned char colorType = png_get_color_type(aPngPointer, aInfoPointer);
         
         //Set the texture color format
-        m_Format = colorType == PNG_COLOR_TYPE_RGB ? GL_RGB : GL_RGBA;
+        aImageData.format = colorType == PNG_COLOR_TYPE_RGB ? GL_RGB : GL_RGBA;
         
         //Allocate the image data
-        unsigned char* imageData = (unsigned char*)malloc(rowBytes * m_Size.y);
+        aImageData.dataSize = (unsigned int)(rowBytes * aImageData.size.y);
+        aImageData.data = (unsigned char*)malloc(aImageData.dataSize);
         
         //The png image is ordered top to bottom, but OpenGL expect it bottom to top so the order or swapped
-        for (unsigned int i = 0; i < m_Size.y; i++)
+        for (unsigned int i = 0; i < aImageData.size.y; i++)
         {
-            memcpy(imageData + (rowBytes * (m_Size.y - 1 - i)), rowPointers[i], rowBytes);
+            memcpy(aImageData.data + (rowBytes * (aImageData.size.y - 1 - i)), rowPointers[i], rowBytes);
         }
-        
-        //Generate the OpenGL texture with the image data
-        GenerateTexture(imageData);
-        
-        //Free the image data it has served its purpose
-        SafeFree(imageData);
     }
     
     void Texture::GenerateTexture(void* data)
@@ -190,22 +598,72 @@ namespace GameDev2D
         //Bind the texture name.
         ServiceLocator::GetGraphics()->BindTexture(this);
         
-        //Set the texture parameters to use a minifying filter and a linear filer (weighted average)
-        if(m_MipmapLevel > 0)
+        //Set the texture parameters for the sampling policy and to clamp the texture coordinates
+        ApplySamplingPolicy();
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        
+        //Specify a 2D texture image, provideing the a pointer to the image data in memory
+        unsigned int levelSize = GetTextureContainerLevelSize(GetContainerFormat(m_Format, m_CompressedFormat), m_Size.x, m_Size.y);
+        if(m_CompressedFormat != 0)
         {
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glCompressedTexImage2D(GL_TEXTURE_2D, 0, m_CompressedFormat, m_Size.x, m_Size.y, 0, levelSize, data);
         }
         else
         {
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage2D(GL_TEXTURE_2D, 0, m_Format, m_Size.x, m_Size.y, 0, m_Format, GL_UNSIGNED_BYTE, data);
         }
         
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        //Keep track of the memory used by the texture
+        CalculateMemory();
+    }
+    
+    void Texture::ApplySamplingPolicy()
+    {
+        //Determine the filters, if the texture has mipmaps they are sampled when the texture is minified
+        GLint magnificationFilter = m_Filter == TextureFilterNearest ? GL_NEAREST : GL_LINEAR;
+        GLint minificationFilter = magnificationFilter;
+        if(m_MipmapCount > 1)
+        {
+            if(m_Filter == TextureFilterNearest)
+            {
+                minificationFilter = GL_NEAREST_MIPMAP_NEAREST;
+            }
+            else if(m_Filter == TextureFilterBilinear)
+            {
+                minificationFilter = GL_LINEAR_MIPMAP_NEAREST;
+            }
+            else
+            {
+                minificationFilter = GL_LINEAR_MIPMAP_LINEAR;
+            }
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minificationFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magnificationFilter);
         
-        //Specify a 2D texture image, provideing the a pointer to the image data in memory
-        glTexImage2D(GL_TEXTURE_2D, m_MipmapLevel, m_Format, m_Size.x, m_Size.y, 0, m_Format, GL_UNSIGNED_BYTE, data);
+        //Set the anisotropy, clamped to the maximum anisotropy, if anisotropic filtering is supported
+        float maxAnisotropy = ServiceLocator::GetGraphics()->GetMaxTextureAnisotropy();
+        if(maxAnisotropy > 1.0f)
+        {
+            float anisotropy = m_Anisotropy > 1.0f ? (m_Anisotropy < maxAnisotropy ? m_Anisotropy : maxAnisotropy) : 1.0f;
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+        }
+    }
+    
+    void Texture::CalculateMemory()
+    {
+        //Add up the size of each mipmap level, and the size it would be if it wasn't compressed
+        unsigned int containerFormat = GetContainerFormat(m_Format, m_CompressedFormat);
+        unsigned int uncompressedFormat = m_Format == GL_RGBA ? TextureContainerFormatRGBA8 : TextureContainerFormatRGB8;
+        m_ResidentMemory = 0;
+        m_UncompressedMemory = 0;
+        for(unsigned int level = 0; level < m_MipmapCount; level++)
+        {
+            unsigned int width = (m_Size.x >> level) > 0 ? (m_Size.x >> level) : 1;
+            unsigned int height = (m_Size.y >> level) > 0 ? (m_Size.y >> level) : 1;
+            m_ResidentMemory += GetTextureContainerLevelSize(containerFormat, width, height);
+            m_UncompressedMemory += GetTextureContainerLevelSize(uncompressedFormat, width, height);
+        }
     }
 }
@@ -20,11 +20,39 @@ using namespace std;
 namespace GameDev2D
 {
     //TODO: Add more opengl texture properties and handle different formats
-    //TODO: Better mipmap implementation
 
+    
+    //The sampling policies a Texture can use, if the texture has mipmaps they are always sampled
+    //when the texture is minified, the policy determines how the texels and mipmap levels are blended
+    enum TextureFilter
+    {
+        TextureFilterNearest = 0,   //The nearest texel of the nearest mipmap level
+        TextureFilterBilinear,      //A blend of the four nearest texels, of the nearest mipmap level
+        TextureFilterTrilinear      //A blend of the four nearest texels, of the two nearest mipmap levels
+    };
+    
+    //Decoded image data, ordered bottom to top the way OpenGL expects it. The data is
+    //allocated with malloc() and must be freed by whoever owns the TextureImageData.
+    //The data holds every mipmap level, largest first, png images only have one level.
+    //Block compressed data has a compressed format, it is zero for uncompressed data
+    struct TextureImageData
+    {
+        unsigned char* data;
+        uvec2 size;
+        unsigned int format;
+        unsigned int compressedFormat;
+        unsigned int dataSize;
+        unsigned int mipmapCount;
+        bool isPremultiplied;
+    };
 
     //The Texture class is responsible for loading PNG texture data in OpenGL. It can
-    //also be used to load image data manually or generate an empty texture.
+    //also be used to load image data manually or generate an empty texture. Texture
+    //container files (.gdtex), cooked by the TextureCooker tool, are memory mapped and
+    //uploaded directly, without decoding or flipping the pixels. Block compressed texture
+    //containers (BC1, BC3, ETC2) stay compressed on the GPU, if the OpenGL implementation
+    //doesn't support the format they are decompressed in software instead. Mipmaps are
+    //either cooked into the texture container or generated when the texture is loaded.
     class Texture : public BaseObject
     {
     public:
@@ -47,6 +75,35 @@ namespace GameDev2D
         //Returns the id of the texture
         unsigned int GetId();
         
+        //Returns wether the texture's color is premultiplied by its alpha, the texture
+        //must be drawn with GL_ONE, GL_ONE_MINUS_SRC_ALPHA blending if it is
+        bool IsPremultiplied();
+        
+        //Returns wether the texture is block compressed on the GPU
+        bool IsCompressed();
+        
+        //Sets the sampling policy of the texture, the default is TEXTURE_DEFAULT_FILTER
+        void SetFilter(TextureFilter filter);
+        TextureFilter GetFilter();
+        
+        //Sets the maximum anisotropy used to sample the texture, the default is TEXTURE_DEFAULT_ANISOTROPY. It is
+        //clamped to the maximum anisotropy the OpenGL implementation supports, one disables anisotropic filtering
+        void SetAnisotropy(float anisotropy);
+        float GetAnisotropy();
+        
+        //Generates a full chain of mipmaps from the texture's first level, block compressed textures must have
+        //their mipmaps cooked into the texture container instead. Returns false if the mipmaps can't be generated
+        bool GenerateMipmaps();
+        
+        //Returns the number of mipmap levels the texture has, one if the texture doesn't have mipmaps
+        unsigned int GetMipmapCount();
+        
+        //Returns the memory the texture takes up on the GPU, in bytes, including every mipmap level
+        unsigned int GetResidentMemory();
+        
+        //Returns the memory the texture would take up on the GPU if it wasn't block compressed, in bytes
+        unsigned int GetUncompressedMemory();
+        
         //Returns the filename of the image used to generate the texture, can return
         //nothing if the texture wasn't generated from a PNG image
         string GetFilename();
@@ -55,23 +112,58 @@ namespace GameDev2D
         //Loads the texture from a path, returns true if the loading was successful
         bool LoadFromPath(const string& path);
         
-        //Set the png data
-        void SetPngData(png_structp pngPointer, png_infop infoPointer);
+        //Reads and decodes a png image or a texture container from a path, returns true if the decoding was successful.
+        //It doesn't make any OpenGL calls, so it is safe to call from a worker thread
+        static bool DecodeFromPath(const string& path, TextureImageData& imageData);
+        
+        //Validates a memory mapped texture container and sets the image data, the image data points into the
+        //container's data and must NOT be freed. Returns false if the container isn't valid
+        static bool ReadContainerData(const unsigned char* containerData, unsigned int containerSize, TextureImageData& imageData);
+        
+        //Returns wether a path is for a texture container
+        static bool IsContainerPath(const string& path);
+        
+        //Decompresses block compressed image data if the OpenGL implementation doesn't support its compressed format. The
+        //decompressed data is allocated with malloc() and replaces the image data's data, which ISN'T freed. Returns true
+        //if the image data was decompressed
+        static bool DecompressImageData(TextureImageData& imageData);
+        
+        //Returns the texture container format for an OpenGL format and compressed format, used to calculate the level sizes
+        static unsigned int GetContainerFormat(unsigned int format, unsigned int compressedFormat);
+        
+        //Generates the OpenGL texture from decoded image data, must be called on the render thread
+        void LoadFromImageData(const TextureImageData& imageData);
+        
+        //Copies the png data into the image data, flipping the rows
+        static void SetPngData(png_structp pngPointer, png_infop infoPointer, TextureImageData& imageData);
         
         //Generates an open gl texture for the image data
         void GenerateTexture(void* data);
         
+        //Sets the texture parameters for the sampling policy, anisotropy and mipmaps, the texture must be bound
+        void ApplySamplingPolicy();
+        
+        //Calculates the memory used by the texture, and the memory it would use uncompressed, for its mipmap levels
+        void CalculateMemory();
+        
         //Friend classes, that need to access the protected methods
         friend class FontData;
         friend class TextureManager;
+        friend class TextureDecodeQueue;
         
     private:
         //Member variables
         uvec2 m_Size;
-        unsigned int m_MipmapLevel;
+        unsigned int m_MipmapCount;
+        TextureFilter m_Filter;
+        float m_Anisotropy;
         unsigned int m_Format;
+        unsigned int m_CompressedFormat;
         unsigned int m_Id;
         string m_Filename;
+        bool m_IsPremultiplied;
+        unsigned int m_ResidentMemory;
+        unsigned int m_UncompressedMemory;
     };
 }
 
@@ -0,0 +1,385 @@
+//
+//  TextureCompression.cpp
+//  GameDev2D
+//
+
+#include "TextureCompression.h"
+#include "TextureContainer.h"
+#include <cstring>
+
+
+namespace GameDev2D
+{
+    //The ETC1/ETC2 intensity modifiers, indexed by the block's table index
+    const int ETC_MODIFIER_TABLE[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+    
+    //The ETC2 distances used by the T and H modes
+    const int ETC_DISTANCE_TABLE[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+    
+    //The EAC alpha modifiers, indexed by the block's table index
+    const int EAC_MODIFIER_TABLE[16][8] =
+    {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+    
+    //Clamps a value to the 0 to 255 range
+    static inline unsigned char ClampByte(int aValue)
+    {
+        return (unsigned char)(aValue < 0 ? 0 : (aValue > 255 ? 255 : aValue));
+    }
+    
+    //Expands 4, 5, 6 and 7 bit color channels to 8 bits
+    static inline int Expand4(unsigned int aValue)
+    {
+        return (int)((aValue << 4) | aValue);
+    }
+    
+    static inline int Expand5(unsigned int aValue)
+    {
+        return (int)((aValue << 3) | (aValue >> 2));
+    }
+    
+    static inline int Expand6(unsigned int aValue)
+    {
+        return (int)((aValue << 2) | (aValue >> 4));
+    }
+    
+    static inline int Expand7(unsigned int aValue)
+    {
+        return (int)((aValue << 1) | (aValue >> 6));
+    }
+    
+    //Sets a texel's color, the texels of a block are indexed by y * 4 + x
+    static inline void SetTexel(unsigned char aTexel[4], int aRed, int aGreen, int aBlue)
+    {
+        aTexel[0] = ClampByte(aRed);
+        aTexel[1] = ClampByte(aGreen);
+        aTexel[2] = ClampByte(aBlue);
+    }
+    
+    //Decodes the 8 byte color block of a BC1 or BC3 block, BC1 blocks can use the 3 color mode, BC3 color blocks can't
+    static void DecodeBCColorBlock(const unsigned char* aBlock, bool aAllowThreeColors, unsigned char aTexels[16][4])
+    {
+        //Expand the two 565 endpoints
+        unsigned int color0 = aBlock[0] | (aBlock[1] << 8);
+        unsigned int color1 = aBlock[2] | (aBlock[3] << 8);
+        int palette[4][3];
+        palette[0][0] = Expand5((color0 >> 11) & 31);
+        palette[0][1] = Expand6((color0 >> 5) & 63);
+        palette[0][2] = Expand5(color0 & 31);
+        palette[1][0] = Expand5((color1 >> 11) & 31);
+        palette[1][1] = Expand6((color1 >> 5) & 63);
+        palette[1][2] = Expand5(color1 & 31);
+        
+        //Interpolate the other two palette colors, in the 3 color mode the last color is black
+        for(unsigned int i = 0; i < 3; i++)
+        {
+            if(color0 > color1 || aAllowThreeColors == false)
+            {
+                palette[2][i] = (2 * palette[0][i] + palette[1][i] + 1) / 3;
+                palette[3][i] = (palette[0][i] + 2 * palette[1][i] + 1) / 3;
+            }
+            else
+            {
+                palette[2][i] = (palette[0][i] + palette[1][i] + 1) / 2;
+                palette[3][i] = 0;
+            }
+        }
+        
+        //Each texel has a 2 bit palette index
+        unsigned int indices = aBlock[4] | (aBlock[5] << 8) | (aBlock[6] << 16) | ((unsigned int)aBlock[7] << 24);
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            unsigned int index = (indices >> (i * 2)) & 3;
+            SetTexel(aTexels[i], palette[index][0], palette[index][1], palette[index][2]);
+            aTexels[i][3] = 255;
+        }
+    }
+    
+    //Decodes the 8 byte alpha block of a BC3 block
+    static void DecodeBC3AlphaBlock(const unsigned char* aBlock, unsigned char aTexels[16][4])
+    {
+        //Setup the alpha palette, there are either 8 interpolated values or 6 interpolated values plus 0 and 255
+        int palette[8];
+        palette[0] = aBlock[0];
+        palette[1] = aBlock[1];
+        if(palette[0] > palette[1])
+        {
+            for(int i = 1; i < 7; i++)
+            {
+                palette[i + 1] = ((7 - i) * palette[0] + i * palette[1] + 3) / 7;
+            }
+        }
+        else
+        {
+            for(int i = 1; i < 5; i++)
+            {
+                palette[i + 1] = ((5 - i) * palette[0] + i * palette[1] + 2) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        
+        //Each texel has a 3 bit palette index
+        unsigned long long indices = 0;
+        for(unsigned int i = 0; i < 6; i++)
+        {
+            indices |= (unsigned long long)aBlock[2 + i] << (i * 8);
+        }
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            aTexels[i][3] = (unsigned char)palette[(indices >> (i * 3)) & 7];
+        }
+    }
+    
+    //Decodes an 8 byte ETC2 color block, all five modes (individual, differential, T, H and planar) are supported.
+    //The ETC pixel indices are ordered column by column, so the texel at x, y uses the pixel index x * 4 + y
+    static void DecodeETC2ColorBlock(const unsigned char* aBlock, unsigned char aTexels[16][4])
+    {
+        //The block is big endian, high holds bits 63 to 32 and low holds bits 31 to 0
+        unsigned int high = ((unsigned int)aBlock[0] << 24) | (aBlock[1] << 16) | (aBlock[2] << 8) | aBlock[3];
+        unsigned int low = ((unsigned int)aBlock[4] << 24) | (aBlock[5] << 16) | (aBlock[6] << 8) | aBlock[7];
+        bool isDifferential = ((high >> 1) & 1) != 0;
+        bool isFlipped = (high & 1) != 0;
+        
+        //Set the alpha of every texel, only the ETC2 RGBA8 format has an alpha block
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            aTexels[i][3] = 255;
+        }
+        
+        int baseColors[2][3];
+        if(isDifferential == false)
+        {
+            //Individual mode, each sub block has its own 444 base color
+            baseColors[0][0] = Expand4((high >> 28) & 15);
+            baseColors[1][0] = Expand4((high >> 24) & 15);
+            baseColors[0][1] = Expand4((high >> 20) & 15);
+            baseColors[1][1] = Expand4((high >> 16) & 15);
+            baseColors[0][2] = Expand4((high >> 12) & 15);
+            baseColors[1][2] = Expand4((high >> 8) & 15);
+        }
+        else
+        {
+            //Differential mode, the second sub block's color is a signed 3 bit offset from the first sub block's 555 color
+            int red = (high >> 27) & 31;
+            int green = (high >> 19) & 31;
+            int blue = (high >> 11) & 31;
+            int red2 = red + (((int)((high >> 24) & 7) ^ 4) - 4);
+            int green2 = green + (((int)((high >> 16) & 7) ^ 4) - 4);
+            int blue2 = blue + (((int)((high >> 8) & 7) ^ 4) - 4);
+            
+            //ETC2 uses the combinations that overflow the red channel for the T mode
+            if(red2 < 0 || red2 > 31)
+            {
+                int paintColors[4][3];
+                paintColors[0][0] = Expand4((((high >> 27) & 3) << 2) | ((high >> 24) & 3));
+                paintColors[0][1] = Expand4((high >> 20) & 15);
+                paintColors[0][2] = Expand4((high >> 16) & 15);
+                paintColors[2][0] = Expand4((high >> 12) & 15);
+                paintColors[2][1] = Expand4((high >> 8) & 15);
+                paintColors[2][2] = Expand4((high >> 4) & 15);
+                int distance = ETC_DISTANCE_TABLE[(((high >> 2) & 3) << 1) | (high & 1)];
+                for(unsigned int i = 0; i < 3; i++)
+                {
+                    paintColors[1][i] = paintColors[2][i] + distance;
+                    paintColors[3][i] = paintColors[2][i] - distance;
+                }
+                
+                for(unsigned int x = 0; x < 4; x++)
+                {
+                    for(unsigned int y = 0; y < 4; y++)
+                    {
+                        unsigned int pixel = x * 4 + y;
+                        unsigned int index = (((low >> (16 + pixel)) & 1) << 1) | ((low >> pixel) & 1);
+                        SetTexel(aTexels[y * 4 + x], paintColors[index][0], paintColors[index][1], paintColors[index][2]);
+                    }
+                }
+                return;
+            }
+            
+            //The combinations that overflow the green channel are used for the H mode
+            if(green2 < 0 || green2 > 31)
+            {
+                unsigned int color1[3];
+                unsigned int color2[3];
+                color1[0] = (high >> 27) & 15;
+                color1[1] = (((high >> 24) & 7) << 1) | ((high >> 20) & 1);
+                color1[2] = (((high >> 19) & 1) << 3) | ((high >> 15) & 7);
+                color2[0] = (high >> 11) & 15;
+                color2[1] = (high >> 7) & 15;
+                color2[2] = (high >> 3) & 15;
+                
+                //The last bit of the distance index is implied by the order of the two colors
+                unsigned int value1 = (color1[0] << 8) | (color1[1] << 4) | color1[2];
+                unsigned int value2 = (color2[0] << 8) | (color2[1] << 4) | color2[2];
+                int distance = ETC_DISTANCE_TABLE[(((high >> 2) & 1) << 2) | ((high & 1) << 1) | (value1 >= value2 ? 1 : 0)];
+                
+                int paintColors[4][3];
+                for(unsigned int i = 0; i < 3; i++)
+                {
+                    paintColors[0][i] = Expand4(color1[i]) + distance;
+                    paintColors[1][i] = Expand4(color1[i]) - distance;
+                    paintColors[2][i] = Expand4(color2[i]) + distance;
+                    paintColors[3][i] = Expand4(color2[i]) - distance;
+                }
+                
+                for(unsigned int x = 0; x < 4; x++)
+                {
+                    for(unsigned int y = 0; y < 4; y++)
+                    {
+                        unsigned int pixel = x * 4 + y;
+                        unsigned int index = (((low >> (16 + pixel)) & 1) << 1) | ((low >> pixel) & 1);
+                        SetTexel(aTexels[y * 4 + x], paintColors[index][0], paintColors[index][1], paintColors[index][2]);
+                    }
+                }
+                return;
+            }
+            
+            //The combinations that overflow the blue channel are used for the planar mode
+            if(blue2 < 0 || blue2 > 31)
+            {
+                int origin[3];
+                int horizontal[3];
+                int vertical[3];
+                origin[0] = Expand6((high >> 25) & 63);
+                origin[1] = Expand7((((high >> 24) & 1) << 6) | ((high >> 17) & 63));
+                origin[2] = Expand6((((high >> 16) & 1) << 5) | (((high >> 11) & 3) << 3) | ((high >> 7) & 7));
+                horizontal[0] = Expand6((((high >> 2) & 31) << 1) | (high & 1));
+                horizontal[1] = Expand7((low >> 25) & 127);
+                horizontal[2] = Expand6((low >> 19) & 63);
+                vertical[0] = Expand6((low >> 13) & 63);
+                vertical[1] = Expand7((low >> 6) & 127);
+                vertical[2] = Expand6(low & 63);
+                
+                for(int x = 0; x < 4; x++)
+                {
+                    for(int y = 0; y < 4; y++)
+                    {
+                        int color[3];
+                        for(unsigned int i = 0; i < 3; i++)
+                        {
+                            color[i] = (x * (horizontal[i] - origin[i]) + y * (vertical[i] - origin[i]) + 4 * origin[i] + 2) >> 2;
+                        }
+                        SetTexel(aTexels[y * 4 + x], color[0], color[1], color[2]);
+                    }
+                }
+                return;
+            }
+            
+            baseColors[0][0] = Expand5(red);
+            baseColors[0][1] = Expand5(green);
+            baseColors[0][2] = Expand5(blue);
+            baseColors[1][0] = Expand5(red2);
+            baseColors[1][1] = Expand5(green2);
+            baseColors[1][2] = Expand5(blue2);
+        }
+        
+        //Each sub block has a modifier table, the sub blocks are either side by side or, if the block is flipped, on top of each other
+        unsigned int tables[2] = {(high >> 5) & 7, (high >> 2) & 7};
+        for(unsigned int x = 0; x < 4; x++)
+        {
+            for(unsigned int y = 0; y < 4; y++)
+            {
+                unsigned int pixel = x * 4 + y;
+                unsigned int subBlock = isFlipped == true ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+                int modifier = ETC_MODIFIER_TABLE[tables[subBlock]][(low >> pixel) & 1];
+                if(((low >> (16 + pixel)) & 1) != 0)
+                {
+                    modifier = -modifier;
+                }
+                SetTexel(aTexels[y * 4 + x], baseColors[subBlock][0] + modifier, baseColors[subBlock][1] + modifier, baseColors[subBlock][2] + modifier);
+            }
+        }
+    }
+    
+    //Decodes the 8 byte EAC alpha block of an ETC2 RGBA8 block
+    static void DecodeEACAlphaBlock(const unsigned char* aBlock, unsigned char aTexels[16][4])
+    {
+        int base = aBlock[0];
+        int multiplier = aBlock[1] >> 4;
+        const int* modifiers = EAC_MODIFIER_TABLE[aBlock[1] & 15];
+        
+        //The 3 bit indices are big endian and ordered column by column, like the ETC color indices
+        unsigned long long indices = 0;
+        for(unsigned int i = 0; i < 6; i++)
+        {
+            indices = (indices << 8) | aBlock[2 + i];
+        }
+        for(unsigned int x = 0; x < 4; x++)
+        {
+            for(unsigned int y = 0; y < 4; y++)
+            {
+                unsigned int pixel = x * 4 + y;
+                unsigned int index = (indices >> (45 - pixel * 3)) & 7;
+                aTexels[y * 4 + x][3] = ClampByte(base + modifiers[index] * multiplier);
+            }
+        }
+    }
+    
+    bool DecompressTextureBlocks(unsigned int aFormat, const unsigned char* aBlocks, unsigned int aWidth, unsigned int aHeight, unsigned char* aPixels)
+    {
+        //Safety check the format
+        unsigned int bytesPerBlock = GetTextureContainerBytesPerBlock(aFormat);
+        if(bytesPerBlock == 0)
+        {
+            return false;
+        }
+        
+        //Decode each block and copy the texels that are inside the level
+        unsigned int bytesPerPixel = DoesTextureContainerFormatHaveAlpha(aFormat) == true ? 4 : 3;
+        unsigned char texels[16][4];
+        const unsigned char* block = aBlocks;
+        for(unsigned int blockY = 0; blockY < aHeight; blockY += 4)
+        {
+            for(unsigned int blockX = 0; blockX < aWidth; blockX += 4)
+            {
+                if(aFormat == TextureContainerFormatBC1)
+                {
+                    DecodeBCColorBlock(block, true, texels);
+                }
+                else if(aFormat == TextureContainerFormatBC3)
+                {
+                    DecodeBCColorBlock(block + 8, false, texels);
+                    DecodeBC3AlphaBlock(block, texels);
+                }
+                else if(aFormat == TextureContainerFormatETC2RGB8)
+                {
+                    DecodeETC2ColorBlock(block, texels);
+                }
+                else
+                {
+                    DecodeETC2ColorBlock(block + 8, texels);
+                    DecodeEACAlphaBlock(block, texels);
+                }
+                block += bytesPerBlock;
+                
+                //The blocks on the right and top edges can be partially outside the level
+                for(unsigned int y = 0; y < 4 && blockY + y < aHeight; y++)
+                {
+                    for(unsigned int x = 0; x < 4 && blockX + x < aWidth; x++)
+                    {
+                        memcpy(aPixels + ((blockY + y) * aWidth + blockX + x) * bytesPerPixel, texels[y * 4 + x], bytesPerPixel);
+                    }
+                }
+            }
+        }
+        
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+//
+//  TextureCompression.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__TextureCompression__
+#define __GameDev2D__TextureCompression__
+
+
+namespace GameDev2D
+{
+    //Decompresses one mipmap level of a block compressed texture container format (BC1, BC3, ETC2 RGB8 or ETC2 RGBA8)
+    //into tightly packed pixels, used when the OpenGL implementation can't sample the compressed format. The formats with
+    //an alpha channel are decompressed to 4 bytes per pixel, the others to 3 bytes per pixel. The pixels must be big enough
+    //to hold the whole level, the rows keep the same order as the blocks. Returns false if the format isn't compressed.
+    //Like TextureContainer.h, it doesn't depend on any other GameDev2D headers, so the TextureCooker can use it as well
+    bool DecompressTextureBlocks(unsigned int format, const unsigned char* blocks, unsigned int width, unsigned int height, unsigned char* pixels);
+}
+
+#endif /* defined(__GameDev2D__TextureCompression__) */
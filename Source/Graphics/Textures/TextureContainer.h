@@ -0,0 +1,104 @@
+//
+//  TextureContainer.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__TextureContainer__
+#define __GameDev2D__TextureContainer__
+
+#include <string>
+
+
+namespace GameDev2D
+{
+    //TextureContainer constants, the container header starts with the magic number 'GDTX'
+    const std::string TEXTURE_CONTAINER_EXTENSION = "gdtex";
+    const unsigned int TEXTURE_CONTAINER_MAGIC = 0x58544447;
+    const unsigned int TEXTURE_CONTAINER_VERSION = 1;
+    
+    //The pixel formats a texture container can hold, the compressed formats are stored in 4x4 pixel blocks
+    enum TextureContainerFormat
+    {
+        TextureContainerFormatRGB8 = 0,
+        TextureContainerFormatRGBA8,
+        TextureContainerFormatBC1,
+        TextureContainerFormatBC3,
+        TextureContainerFormatETC2RGB8,
+        TextureContainerFormatETC2RGBA8
+    };
+    
+    //Texture container flags
+    enum TextureContainerFlags
+    {
+        TextureContainerFlagPremultiplied = 1 << 0
+    };
+    
+    //The header of a texture container (.gdtex) file, it is followed by the pixels of each mipmap level, largest first.
+    //The pixels are tightly packed and ordered bottom to top, the way OpenGL expects them, so the texture can be uploaded
+    //straight from the memory mapped file. Compressed levels are made of rows of 4x4 pixel blocks, also bottom to top,
+    //the blocks on the right and top edges are padded when the level's size isn't a multiple of 4. The container is written by the TextureCooker tool and doesn't depend on any
+    //other GameDev2D headers, all the values are 32-bit little endian
+    struct TextureContainerHeader
+    {
+        unsigned int magic;
+        unsigned int version;
+        unsigned int width;
+        unsigned int height;
+        unsigned int format;
+        unsigned int mipmapCount;
+        unsigned int flags;
+        unsigned int dataSize;
+    };
+    
+    //Returns the number of bytes per pixel for a texture container format, zero if the format is unknown
+    inline unsigned int GetTextureContainerBytesPerPixel(unsigned int format)
+    {
+        if(format == TextureContainerFormatRGB8)
+        {
+            return 3;
+        }
+        else if(format == TextureContainerFormatRGBA8)
+        {
+            return 4;
+        }
+        return 0;
+    }
+    
+    //Returns wether a texture container format is block compressed
+    inline bool IsTextureContainerFormatCompressed(unsigned int format)
+    {
+        return format == TextureContainerFormatBC1 || format == TextureContainerFormatBC3 || format == TextureContainerFormatETC2RGB8 || format == TextureContainerFormatETC2RGBA8;
+    }
+    
+    //Returns wether a texture container format has an alpha channel
+    inline bool DoesTextureContainerFormatHaveAlpha(unsigned int format)
+    {
+        return format == TextureContainerFormatRGBA8 || format == TextureContainerFormatBC3 || format == TextureContainerFormatETC2RGBA8;
+    }
+    
+    //Returns the number of bytes in each 4x4 pixel block for a compressed texture container format, zero if the format isn't compressed
+    inline unsigned int GetTextureContainerBytesPerBlock(unsigned int format)
+    {
+        if(format == TextureContainerFormatBC1 || format == TextureContainerFormatETC2RGB8)
+        {
+            return 8;
+        }
+        else if(format == TextureContainerFormatBC3 || format == TextureContainerFormatETC2RGBA8)
+        {
+            return 16;
+        }
+        return 0;
+    }
+    
+    //Returns the number of bytes a mipmap level of a given size takes up, zero if the format is unknown
+    inline unsigned int GetTextureContainerLevelSize(unsigned int format, unsigned int width, unsigned int height)
+    {
+        if(IsTextureContainerFormatCompressed(format) == true)
+        {
+            return ((width + 3) / 4) * ((height + 3) / 4) * GetTextureContainerBytesPerBlock(format);
+        }
+        return width * height * GetTextureContainerBytesPerPixel(format);
+    }
+}
+
+#endif /* defined(__GameDev2D__TextureContainer__) */
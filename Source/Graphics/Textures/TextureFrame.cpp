@@ -15,19 +15,27 @@
 
 namespace GameDev2D
 {
-    TextureFrame::TextureFrame(const string& aFilename, const string& aAtlasKey, const string& aDirectory) : BaseObject("TextureFrame"),
+    TextureFrame::TextureFrame(const string& aFilename, const string& aAtlasKey, const string& aDirectory, bool aLoadAsync) : BaseObject("TextureFrame"),
         m_Texture(nullptr),
         m_Shader(nullptr),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_SourceFrame(SourceFrame(0.0f, 0.0f, 0.0f, 0.0f)),
         m_OwnsTexture(true),
+        m_IsAtlasFrame(aAtlasKey != ""),
+        m_IsWaitingForTexture(false),
         m_VertexArrayObject(0),
         m_VertexBufferObject(0),
-        m_UvCoordinatesBufferObject(0),
-        m_ColorsBufferObject(0)
+        m_VertexBufferUsage(0)
     {
         //Load the texture via the texture manager, this will ensure only one texture with this filename will be loaded
-        ServiceLocator::GetTextureManager()->AddTexture(aFilename, aDirectory, this);
+        if(aLoadAsync == true)
+        {
+            ServiceLocator::GetTextureManager()->AddTextureAsync(aFilename, aDirectory, this);
+        }
+        else
+        {
+            ServiceLocator::GetTextureManager()->AddTexture(aFilename, aDirectory, this);
+        }
         
         //Safety check the atlas key
         if(aAtlasKey != "")
@@ -47,13 +55,14 @@ namespace GameDev2D
     TextureFrame::TextureFrame(unsigned int aWidth, unsigned int aHeight) : BaseObject("TextureFrame"),
         m_Texture(nullptr),
         m_Shader(nullptr),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_SourceFrame(SourceFrame(0.0f, 0.0f, (float)aWidth, (float)aHeight)),
         m_OwnsTexture(true),
+        m_IsAtlasFrame(false),
+        m_IsWaitingForTexture(false),
         m_VertexArrayObject(0),
         m_VertexBufferObject(0),
-        m_UvCoordinatesBufferObject(0),
-        m_ColorsBufferObject(0)
+        m_VertexBufferUsage(0)
     {
         //Create a new texture object for the width and height
         m_Texture = new Texture(aWidth, aHeight);
@@ -62,13 +71,14 @@ namespace GameDev2D
     TextureFrame::TextureFrame(Texture* aTexture, bool aOwnsTexture) : BaseObject("TextureFrame"),
         m_Texture(aTexture),
         m_Shader(nullptr),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_SourceFrame(SourceFrame(0.0f, 0.0f, (float)m_Texture->GetSize().x, (float)m_Texture->GetSize().y)),
         m_OwnsTexture(aOwnsTexture),
+        m_IsAtlasFrame(false),
+        m_IsWaitingForTexture(false),
         m_VertexArrayObject(0),
         m_VertexBufferObject(0),
-        m_UvCoordinatesBufferObject(0),
-        m_ColorsBufferObject(0)
+        m_VertexBufferUsage(0)
     {
 
     }
@@ -86,80 +96,49 @@ namespace GameDev2D
             m_Texture = nullptr;
         }
         
-        //Set the Shader to null
-        m_Shader = nullptr;
-        
-        //Delete the VBO
-        if(m_VertexBufferObject != 0)
+        //If the TextureFrame is waiting for an asynchronously loaded texture, stop waiting for it
+        if(m_IsWaitingForTexture == true)
         {
-            glDeleteBuffers(1, &m_VertexBufferObject);
-            m_VertexBufferObject = 0;
+            ServiceLocator::GetTextureManager()->RemoveTexture(this);
         }
         
-        //Delete the UV Coordinate buffer object
-        if(m_UvCoordinatesBufferObject != 0)
-        {
-            glDeleteBuffers(1, &m_UvCoordinatesBufferObject);
-            m_UvCoordinatesBufferObject = 0;
-        }
+        //Set the Shader to null
+        m_Shader = nullptr;
         
-        //Delete the color buffer object
-        if(m_ColorsBufferObject != 0)
-        {
-            glDeleteBuffers(1, &m_ColorsBufferObject);
-            m_ColorsBufferObject = 0;
-        }
+        //Delete the VBO
+        DeleteVertexBuffer();
 
         //Delete the VAO
         if(m_VertexArrayObject != 0)
         {
-            glDeleteVertexArrays(1, &m_VertexArrayObject);
-            m_VertexArrayObject = 0;
+            ServiceLocator::GetGraphics()->DeleteVertexArray(m_VertexArrayObject);
         }
     }
     
     void TextureFrame::Draw(mat4 aModelMatrix)
     {
-        //Set the shader to be used
-        m_Shader->Use();
-
-        //Multiply the model matrix by the projection and view matrices
+        //Cache the graphics service
         Graphics* graphics = ServiceLocator::GetGraphics();
         
-        //Bind the vertex array object
-        graphics->BindVertexArray(m_VertexArrayObject);
-
-        //Set the model view projection matrix
-        mat4 mvp = graphics->GetProjectionMatrix() * graphics->GetViewMatrix() * aModelMatrix;
-        glUniformMatrix4fv(m_Shader->GetModelViewProjectionUniform(), 1, 0, &mvp[0][0]);
-        glUniform1i(m_Shader->GetTextureUniform(), 0);
+        //Setup the render command, the TextureFrame's vertex array holds a unit quad
+        RenderCommand command = MakeRenderCommand(m_Shader, GetTexture(), m_VertexArrayObject, GL_TRIANGLE_STRIP, 0, 4);
         
-        //Validate the shader, return if it fails
-        if(m_Shader->Validate() == false)
-        {
-            return;
-        }
+        //Set the model view projection matrix, the vertices are for a unit quad, scale it by the source frame's size
+        command.modelViewProjection = graphics->GetProjectionMatrix() * graphics->GetViewMatrix() * scale(aModelMatrix, vec3(m_SourceFrame.size.x, m_SourceFrame.size.y, 1.0f));
         
-        //Bind the texture
-        graphics->BindTexture(GetTexture());
+        //Set the color, the color attribute array is disabled so the constant attribute value is used. A premultiplied texture needs a premultiplied color
+        bool isPremultiplied = m_Texture != nullptr && m_Texture->IsPremultiplied() == true;
+        command.colorAttribute = m_Shader->GetAttribute("a_textureColor");
+        command.color = isPremultiplied == true ? PremultiplyColorRGBA(m_Color) : m_Color;
         
-        //Enable blending if the texture has an alpha channel
-        if(GetFormat() == GL_RGBA || m_Color.Alpha() != 1.0f)
+        //Enable blending if the texture has an alpha channel, a premultiplied texture's color is already multiplied by its alpha
+        if(GetFormat() == GL_RGBA || m_Color.a != 1.0f)
         {
-            graphics->EnableBlending();
+            command.blending = isPremultiplied == true ? RenderCommandBlendingPremultiplied : RenderCommandBlendingAlpha;
         }
         
-        //Draw the texture
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        
-        //Unbind the vertex array
-        graphics->BindVertexArray(0);
-        
-        //Disable blending, if we did in fact have it enabled
-        if(GetFormat() == GL_RGBA || m_Color.Alpha() != 1.0f)
-        {
-            graphics->DisableBlending();
-        }
+        //Add the render command, it is submitted by the Graphics service's RenderQueue
+        graphics->GetRenderQueue()->AddCommand(command);
     }
     
     unsigned int TextureFrame::GetFormat()
@@ -186,8 +165,8 @@ namespace GameDev2D
         m_SourceFrame.position = aSourceFrame.position;
         m_SourceFrame.size = aSourceFrame.size;
         
-        //Update the VBO and Uv coordinates
-        UpdateVertexBuffer(BufferObjectVertex | BufferObjectUvCoordinates);
+        //Update the Uv coordinates
+        UpdateVertexBuffer(true);
     }
     
     SourceFrame TextureFrame::GetSourceFrame()
@@ -203,8 +182,8 @@ namespace GameDev2D
             //Get the new Shader from the ShaderManager
             m_Shader = aShader;
             
-            //Update the vertex buffer
-            UpdateVertexBuffer(BufferObjectAll);
+            //Update the vertex array, the attribute locations could be different for the new shader
+            UpdateVertexBuffer(false);
         }
     }
     
@@ -215,19 +194,21 @@ namespace GameDev2D
     
     void TextureFrame::SetColor(Color aColor)
     {
-        if(aColor != m_Color)
+        if(aColor.GetRGBA() != m_Color)
         {
-            //Set the color
-            m_Color = aColor;
-            
-            //And update the vertex buffer
-            UpdateVertexBuffer(BufferObjectColors);
+            //Set the color, it is set when the TextureFrame is drawn, the vertex buffer doesn't need to be updated
+            m_Color = aColor.GetRGBA();
         }
     }
     
     Color TextureFrame::GetColor()
     {
-        return m_Color;
+        return Color(m_Color);
+    }
+    
+    bool TextureFrame::IsWaitingForTexture()
+    {
+        return m_IsWaitingForTexture;
     }
     
     Texture* TextureFrame::GetTexture() const
@@ -251,25 +232,37 @@ namespace GameDev2D
                 m_Texture = nullptr;
             }
         
+            //If the TextureFrame is waiting for an asynchronously loaded texture, stop waiting for it
+            if(m_IsWaitingForTexture == true)
+            {
+                ServiceLocator::GetTextureManager()->RemoveTexture(this);
+            }
+            
             //Set the new texture and the ownership
             m_Texture = aTexture;
             m_OwnsTexture = aOwnsTexture;
             
-            //Set the source frame's size
-            m_SourceFrame.size = m_Texture->GetSize();
+            //Set the source frame's size, atlas frames keep their source frame
+            if(m_IsAtlasFrame == false)
+            {
+                m_SourceFrame.size = m_Texture->GetSize();
+            }
             
-            //Update the vertex buffer
-            UpdateVertexBuffer(BufferObjectVertex | BufferObjectUvCoordinates);
+            //Update the Uv coordinates
+            UpdateVertexBuffer(true);
         }
     }
     
-    void TextureFrame::UpdateVertexBuffer(unsigned int aBufferObjectType)
+    void TextureFrame::UpdateVertexBuffer(bool aSourceFrameChanged)
     {
-        //If the shader hasn't been set we can't update the vertex buffer, return
-        if(m_Shader == nullptr)
+        //If the shader or the texture hasn't been set we can't update the vertex buffer, return
+        if(m_Shader == nullptr || m_Texture == nullptr)
         {
             return;
         }
+        
+        //Get the Graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
     
         //If the VAO hasn't been generated yet, generate one
         if(m_VertexArrayObject == 0)
@@ -278,133 +271,111 @@ namespace GameDev2D
         }
         
         //Bind the VAO
-        ServiceLocator::GetGraphics()->BindVertexArray(m_VertexArrayObject);
+        graphics->BindVertexArray(m_VertexArrayObject);
 
         //Use the shader
         m_Shader->Use();
 
-        //Do we need to update the vertex buffer?
-        if((aBufferObjectType & BufferObjectVertex) == BufferObjectVertex)
+        //If the source frame covers the whole Texture, use the shared unit quad buffer
+        if(IsFullTextureFrame() == true)
+        {
+            //The TextureFrame no longer needs its own vertex buffer
+            DeleteVertexBuffer();
+            
+            //Bind the shared unit quad buffer
+            graphics->BindArrayBuffer(graphics->GetUnitQuadBuffer());
+        }
+        else
         {
             //Has the VBO been generated, if not generate one
             if(m_VertexBufferObject == 0)
             {
                 glGenBuffers(1, &m_VertexBufferObject);
+                aSourceFrameChanged = true;
             }
             
             //Bind the VBO
-            glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
-
-            //Create an array for the vertices
-            const int vertexSize = 2;
-            const int vertexCount = 4;
-            float* vertices = new float[vertexSize * vertexCount];
-            
-            //Initialize the vertices array
-            vertices[0] = 0.0f;                     vertices[1] = 0.0f;
-            vertices[2] = m_SourceFrame.size.x;     vertices[3] = 0.0f;
-            vertices[4] = 0.0f;                     vertices[5] = m_SourceFrame.size.y;
-            vertices[6] = m_SourceFrame.size.x;     vertices[7] = m_SourceFrame.size.y;
-            
-            //Set the vertex buffer data
-            glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertexCount * vertexSize, vertices, GL_DYNAMIC_DRAW);
+            graphics->BindArrayBuffer(m_VertexBufferObject);
             
-            //Enabled the vertices attribute for the shader
-            int verticesIndex = m_Shader->GetAttribute("a_vertices");
-            glEnableVertexAttribArray(verticesIndex);
-
-            //Set the shader's attribute for the vertices
-            glVertexAttribPointer(verticesIndex, vertexSize, GL_FLOAT, GL_FALSE, 0, 0);
-            
-            //Delete the vertices array
-            SafeDeleteArray(vertices);
-        }
-        
-        //Do we need to update the uv coordinates?
-        if((aBufferObjectType & BufferObjectUvCoordinates) == BufferObjectUvCoordinates)
-        {
-            //Has the uv coordinates buffer been generated, if not generate one
-            if(m_UvCoordinatesBufferObject == 0)
+            //Do we need to update the uv coordinates?
+            if(aSourceFrameChanged == true)
             {
-                glGenBuffers(1, &m_UvCoordinatesBufferObject);
+                //Build the UV Coordinates
+                float x1 = (float)m_SourceFrame.position.x / (float)m_Texture->GetSize().x;
+                float y1 = 1.0f - (((float)m_SourceFrame.position.y + m_SourceFrame.size.y) / (float)m_Texture->GetSize().y);
+                float x2 = (float)(m_SourceFrame.position.x + m_SourceFrame.size.x) / (float)m_Texture->GetSize().x;
+                float y2 = 1.0f - (m_SourceFrame.position.y / (float)m_Texture->GetSize().y);
+                
+                //Initialize the vertices, in triangle strip order
+                const TextureFrameVertex vertices[TEXTURE_FRAME_VERTEX_COUNT] =
+                {
+                    { 0.0f, 0.0f, x1, y1 },
+                    { 1.0f, 0.0f, x2, y1 },
+                    { 0.0f, 1.0f, x1, y2 },
+                    { 1.0f, 1.0f, x2, y2 }
+                };
+                
+                //Set the vertex buffer data, the first upload is static, if the source frame changes after
+                //that the buffer is re-created once as dynamic, any updates after that re-use the storage
+                if(m_VertexBufferUsage == 0)
+                {
+                    m_VertexBufferUsage = GL_STATIC_DRAW;
+                    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, m_VertexBufferUsage);
+                }
+                else if(m_VertexBufferUsage == GL_STATIC_DRAW)
+                {
+                    m_VertexBufferUsage = GL_DYNAMIC_DRAW;
+                    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, m_VertexBufferUsage);
+                }
+                else
+                {
+                    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+                }
             }
-            
-            //Bind the uv coordinates buffer
-            glBindBuffer(GL_ARRAY_BUFFER, m_UvCoordinatesBufferObject);
-            
-            //Build the UV Coordinates
-            float x1 = (float)m_SourceFrame.position.x / (float)m_Texture->GetSize().x;
-            float y1 = 1.0f - (((float)m_SourceFrame.position.y + m_SourceFrame.size.y) / (float)m_Texture->GetSize().y);
-            float x2 = (float)(m_SourceFrame.position.x + m_SourceFrame.size.x) / (float)m_Texture->GetSize().x;
-            float y2 = 1.0f - (m_SourceFrame.position.y / (float)m_Texture->GetSize().y);
-            
-            //Create the uv coordinates array
-            const int uvSize = 2;
-            const int uvCount = 4;
-            float* uvCoordinates = new float[uvSize * uvCount];
-            
-            //Initialize the uv coordinates array
-            uvCoordinates[0] = x1;  uvCoordinates[1] = y1;
-            uvCoordinates[2] = x2;  uvCoordinates[3] = y1;
-            uvCoordinates[4] = x1;  uvCoordinates[5] = y2;
-            uvCoordinates[6] = x2;  uvCoordinates[7] = y2;
+        }
 
-            //Set the uv coordinate data
-            glBufferData(GL_ARRAY_BUFFER, sizeof(float) * uvCount * uvSize, uvCoordinates, GL_DYNAMIC_DRAW);
+        //Enable and set the shader's vertices attribute
+        int verticesIndex = m_Shader->GetAttribute("a_vertices");
+        glEnableVertexAttribArray(verticesIndex);
+        long verticesOffset = 0;
+        glVertexAttribPointer(verticesIndex, 2, GL_FLOAT, GL_FALSE, sizeof(TextureFrameVertex), (const GLvoid*)verticesOffset);
         
-            //Enable the texture coordinates attributes for the shader
-            int uvIndex = m_Shader->GetAttribute("a_textureCoordinates");
-            glEnableVertexAttribArray(uvIndex);
-            
-            //Set the shader's attribute for the uv coordinates
-            glVertexAttribPointer(uvIndex, uvSize, GL_FLOAT, GL_FALSE, 0, 0);
-            
-            //Delete the uv coordinates array
-            SafeDeleteArray(uvCoordinates);
-        }
+        //Enable and set the shader's texture coordinates attribute
+        int uvIndex = m_Shader->GetAttribute("a_textureCoordinates");
+        glEnableVertexAttribArray(uvIndex);
+        long uvOffset = 2 * sizeof(float);
+        glVertexAttribPointer(uvIndex, 2, GL_FLOAT, GL_FALSE, sizeof(TextureFrameVertex), (const GLvoid*)uvOffset);
+        
+        //Disable the shader's color attribute array, the color is set when the TextureFrame is drawn
+        glDisableVertexAttribArray(m_Shader->GetAttribute("a_textureColor"));
         
-        //Do we need to update the colors?
-        if((aBufferObjectType & BufferObjectColors) == BufferObjectColors)
+        //Unbind the VAO
+        graphics->BindVertexArray(0);
+    }
+    
+    void TextureFrame::DeleteVertexBuffer()
+    {
+        if(m_VertexBufferObject != 0)
         {
-            //Has the colors buffer been generated, if not generate one
-            if(m_ColorsBufferObject == 0)
+            //If the buffer we are about to delete is bound, we need to unbind it
+            if(ServiceLocator::GetGraphics()->GetBoundArrayBuffer() == m_VertexBufferObject)
             {
-                glGenBuffers(1, &m_ColorsBufferObject);
+                ServiceLocator::GetGraphics()->BindArrayBuffer(0);
             }
             
-            //Bind the colors buffer
-            glBindBuffer(GL_ARRAY_BUFFER, m_ColorsBufferObject);
-            
-            //Create the colors array
-            const int colorSize = 4;
-            const int colorCount = 4;
-            float* colors = new float[colorSize * colorCount];
-            
-            //Initialize the colors array
-            for(int i = 0; i < colorCount; i++)
-            {
-                int offset = i * colorSize;
-                colors[offset] = m_Color.Red();
-                colors[offset+1] = m_Color.Green();
-                colors[offset+2] = m_Color.Blue();
-                colors[offset+3] = m_Color.Alpha();
-            }
-            
-            //Set the colors data
-            glBufferData(GL_ARRAY_BUFFER, sizeof(float) * colorCount * colorSize, colors, GL_DYNAMIC_DRAW);
-        
-            //Enable the colors attributes for the shader
-            int colorIndex = m_Shader->GetAttribute("a_textureColor");
-            glEnableVertexAttribArray(colorIndex);
-            
-            //Set the shader's attribute for the colors
-            glVertexAttribPointer(colorIndex, colorSize, GL_FLOAT, GL_FALSE, 0, 0);
-            
-            //Delete the colors array
-            SafeDeleteArray(colors);
+            //Delete the VBO
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+            m_VertexBufferUsage = 0;
         }
-        
-        //Unbind the VAO
-        ServiceLocator::GetGraphics()->BindVertexArray(0);
+    }
+    
+    bool TextureFrame::IsFullTextureFrame()
+    {
+        if(m_Texture != nullptr)
+        {
+            return m_SourceFrame.position.x == 0.0f && m_SourceFrame.position.y == 0.0f && m_SourceFrame.size.x == (float)m_Texture->GetSize().x && m_SourceFrame.size.y == (float)m_Texture->GetSize().y;
+        }
+        return false;
     }
 }
\ No newline at end of file
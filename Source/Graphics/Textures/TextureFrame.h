@@ -47,14 +47,24 @@ namespace GameDev2D
         vec2 position;
         vec2 size;
     };
+    
+    //Interleaved vertex format used by the TextureFrame, the position is for a unit quad and
+    //is scaled by the source frame's size when drawing. The color isn't part of the vertex,
+    //it is set as a constant vertex attribute for each draw call
+    struct TextureFrameVertex
+    {
+        float x, y;
+        float u, v;
+    };
 
 
     //The TextureFrame class contains a Texture object as well a specific source frame of the Texture to render
     class TextureFrame : public BaseObject
     {
     public:
-        //Loads a TextureFrame from a texture atlas, in a specific directory
-        TextureFrame(const string& filename, const string& atlasKey, const string& directory);
+        //Loads a TextureFrame from a texture atlas, in a specific directory. If the texture is loaded asynchronously
+        //the checkerboard texture is displayed until the texture is uploaded, the source frame's size changes then
+        TextureFrame(const string& filename, const string& atlasKey, const string& directory, bool loadAsync = false);
         
         //Loads a TextureFrame for a specific width and height, usually used with the RenderTarget
         TextureFrame(unsigned int width, unsigned int height);
@@ -90,6 +100,9 @@ namespace GameDev2D
         //Returns the color that the TextureFrame will be rendered with
         Color GetColor();
         
+        //Returns wether the TextureFrame is displaying the checkerboard texture, while it waits for an asynchronously loaded texture
+        bool IsWaitingForTexture();
+    
     protected:
         //Called from the TextureManager
         Texture* GetTexture() const;
@@ -99,32 +112,37 @@ namespace GameDev2D
         friend class TextureManager;
         friend class RenderTarget;
         friend class Graphics;
+        friend class SpriteBatch;
+        friend class TrueTypeFont;
+        friend class BitmapFont;
+        friend class AnimationClip;
     
     private:
-        //Enum of the vertex buffer elements
-        enum
-        {
-            BufferObjectVertex = 1,
-            BufferObjectUvCoordinates = 2,
-            BufferObjectColors = 4,
-            BufferObjectAll = BufferObjectVertex | BufferObjectUvCoordinates | BufferObjectColors
-        };
+        //Conveniance method to update the vertex array, TextureFrames that render the whole Texture use the
+        //Graphics service's shared unit quad buffer, otherwise the TextureFrame owns a vertex buffer for
+        //its uv coordinates. The uv coordinates are only uploaded if the source frame changed
+        virtual void UpdateVertexBuffer(bool sourceFrameChanged);
     
-        //Conveniance method to update part of the vertex buffer
-        virtual void UpdateVertexBuffer(unsigned int bufferObjectType);
+        //Conveniance method to delete the vertex buffer owned by the TextureFrame
+        void DeleteVertexBuffer();
+        
+        //Returns wether the source frame covers the whole Texture
+        bool IsFullTextureFrame();
 
         //Member variables
         Texture* m_Texture;
         Shader* m_Shader;
-        Color m_Color;
+        ColorRGBA m_Color;
         SourceFrame m_SourceFrame;
         bool m_OwnsTexture;
+        bool m_IsAtlasFrame;
+        bool m_IsWaitingForTexture;
         
-        //VAO and VBO member variables
+        //VAO and VBO member variables, the VBO is zero when the shared unit quad buffer is used. The VBO
+        //usage starts as GL_STATIC_DRAW and is only changed to GL_DYNAMIC_DRAW if the source frame changes
         unsigned int m_VertexArrayObject;
         unsigned int m_VertexBufferObject;
-        unsigned int m_UvCoordinatesBufferObject;
-        unsigned int m_ColorsBufferObject;
+        GLenum m_VertexBufferUsage;
     };
 }
 
@@ -8,105 +8,163 @@
 
 #include "b2DebugDraw.h"
 #include "b2Helper.h"
+#include "../../Services/ServiceLocator.h"
+#include "../../Services/Graphics/Graphics.h"
+#include "../../Services/ShaderManager/ShaderManager.h"
 #include "../../Graphics/Primitives/Primitives.h"
 #include "../../Graphics/OpenGL.h"
 
+
+#ifndef BOX2D_DEBUG_DRAW_CULLING
+#define BOX2D_DEBUG_DRAW_CULLING 1
+#endif
+
+
 using namespace glm;
 
 namespace GameDev2D
 {
     b2DebugDraw::b2DebugDraw() : b2Draw(),
-        m_Polygon(nullptr),
-        m_Circle(nullptr),
-        m_Line(nullptr)
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_VertexBufferCapacity(0),
+        m_CullingEnabled(BOX2D_DEBUG_DRAW_CULLING),
+        m_DrawnShapes(0),
+        m_CulledShapes(0),
+        m_DrawnShapeCount(0),
+        m_CulledShapeCount(0)
     {
-        m_Polygon = new Polygon();
-        m_Circle = new Circle();
-        m_Line = new Line();
+        //Get the shared unit circle table, the circles are scaled and translated from it
+        m_UnitCircle = Circle::GetUnitCircle(DEFAULT_LINE_SEGMENTS);
     }
     
     b2DebugDraw::~b2DebugDraw()
     {
-        SafeDelete(m_Polygon);
-        SafeDelete(m_Circle);
-        SafeDelete(m_Line);
+        //Delete the VBO
+        if(m_VertexBufferObject != 0)
+        {
+            //If the VBO we are about to delete is bound, we need to unbind it
+            if(m_VertexBufferObject == ServiceLocator::GetGraphics()->GetBoundArrayBuffer())
+            {
+                ServiceLocator::GetGraphics()->BindArrayBuffer(0);
+            }
+            
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+        }
+        
+        //Delete the VAO
+        if(m_VertexArrayObject != 0)
+        {
+            ServiceLocator::GetGraphics()->DeleteVertexArray(m_VertexArrayObject);
+        }
     }
     
     void b2DebugDraw::DrawPolygon(const b2Vec2* aVertices, int aVertexCount, const b2Color& aColor)
     {
-        //Clear the existing vertices
-        m_Polygon->ClearVertices();
+        //Convert the vertices to pixels, unless the polygon is culled
+        if(PrepareVertices(aVertices, aVertexCount) == false)
+        {
+            return;
+        }
         
-        float ratio = b2Helper::Ratio();
-        vec2 vertex = vec2(0.0f, 0.0f);
+        //Add the outline as line segments
         for(int i = 0; i < aVertexCount; i++)
         {
-            vertex.x = aVertices[i].x * ratio;
-            vertex.y = aVertices[i].y * ratio;
-            m_Polygon->AddVertex(vertex);
+            AddLineVertex(m_Vertices.at(i), aColor, 1.0f);
+            AddLineVertex(m_Vertices.at((i + 1) % aVertexCount), aColor, 1.0f);
         }
-        
-        m_Polygon->SetColor(Color(aColor.r, aColor.g, aColor.b));
-        m_Polygon->SetRenderMode(GL_LINE_LOOP);
-        m_Polygon->Draw();
     }
     
     void b2DebugDraw::DrawSolidPolygon(const b2Vec2* aVertices, int aVertexCount, const b2Color& aColor)
     {
-        //Clear the existing vertices
-        m_Polygon->ClearVertices();
+        //Convert the vertices to pixels, unless the polygon is culled
+        if(PrepareVertices(aVertices, aVertexCount) == false)
+        {
+            return;
+        }
         
-        float ratio = b2Helper::Ratio();
-        vec2 vertex = vec2(0.0f, 0.0f);
-        for(int i = 0; i < aVertexCount; i++)
+        //Add the fill as a triangle fan around the first vertex, at half the color
+        b2Color fillColor(aColor.r * 0.5f, aColor.g * 0.5f, aColor.b * 0.5f);
+        for(int i = 1; i < aVertexCount - 1; i++)
         {
-            vertex.x = aVertices[i].x * ratio;
-            vertex.y = aVertices[i].y * ratio;
-            m_Polygon->AddVertex(vertex);
+            AddTriangleVertex(m_Vertices.at(0), fillColor, 1.0f);
+            AddTriangleVertex(m_Vertices.at(i), fillColor, 1.0f);
+            AddTriangleVertex(m_Vertices.at(i + 1), fillColor, 1.0f);
         }
         
-        m_Polygon->SetColor(Color(aColor.r * 0.5f, aColor.g * 0.5f, aColor.b * 0.5f));
-        m_Polygon->SetRenderMode(GL_TRIANGLE_FAN);
-        m_Polygon->Draw();
-    
-        m_Polygon->SetColor(Color(aColor.r, aColor.g, aColor.b));
-        m_Polygon->SetRenderMode(GL_LINE_LOOP);
-        m_Polygon->Draw();
+        //Add the outline as line segments
+        for(int i = 0; i < aVertexCount; i++)
+        {
+            AddLineVertex(m_Vertices.at(i), aColor, 1.0f);
+            AddLineVertex(m_Vertices.at((i + 1) % aVertexCount), aColor, 1.0f);
+        }
     }
     
     void b2DebugDraw::DrawCircle(const b2Vec2& aCenter, float aRadius, const b2Color& aColor)
     {
+        //Cull the circle by its bounds
         float ratio = b2Helper::Ratio();
-        m_Circle->SetLocalPosition(aCenter.x * ratio, aCenter.y * ratio);
-        m_Circle->SetRadius(aRadius * ratio);
-        m_Circle->SetColor(Color(aColor.r * 0.5f, aColor.g * 0.5f, aColor.b * 0.5f));
-        m_Circle->SetIsFilled(false);
-        m_Circle->Draw();
+        vec2 center = vec2(aCenter.x * ratio, aCenter.y * ratio);
+        float radius = aRadius * ratio;
+        if(IsCulled(MakeBoundingBox(center - vec2(radius, radius), center + vec2(radius, radius))) == true)
+        {
+            return;
+        }
+        
+        //Add the outline as line segments, at half the color
+        b2Color lineColor(aColor.r * 0.5f, aColor.g * 0.5f, aColor.b * 0.5f);
+        for(unsigned int i = 0; i < m_UnitCircle.size(); i++)
+        {
+            AddLineVertex(center + m_UnitCircle.at(i) * radius, lineColor, 1.0f);
+            AddLineVertex(center + m_UnitCircle.at((i + 1) % m_UnitCircle.size()) * radius, lineColor, 1.0f);
+        }
     }
     
     void b2DebugDraw::DrawSolidCircle(const b2Vec2& aCenter, float aRadius, const b2Vec2& aAxis, const b2Color& aColor)
     {
+        //Cull the circle by its bounds
         float ratio = b2Helper::Ratio();
-        m_Circle->SetLocalPosition(aCenter.x * ratio, aCenter.y * ratio);
-        m_Circle->SetRadius(aRadius * ratio);
-        m_Circle->SetColor(Color(aColor.r * 0.5f, aColor.g * 0.5f, aColor.b * 0.5f, 0.5f));
-        m_Circle->SetIsFilled(true);
-        m_Circle->Draw();
+        vec2 center = vec2(aCenter.x * ratio, aCenter.y * ratio);
+        float radius = aRadius * ratio;
+        if(IsCulled(MakeBoundingBox(center - vec2(radius, radius), center + vec2(radius, radius))) == true)
+        {
+            return;
+        }
         
-        m_Circle->SetColor(Color(aColor.r, aColor.g, aColor.b));
-        m_Circle->SetIsFilled(false);
-        m_Circle->Draw();
+        //Add the fill as triangles around the center, at half the color and alpha
+        b2Color fillColor(aColor.r * 0.5f, aColor.g * 0.5f, aColor.b * 0.5f);
+        for(unsigned int i = 0; i < m_UnitCircle.size(); i++)
+        {
+            AddTriangleVertex(center, fillColor, 0.5f);
+            AddTriangleVertex(center + m_UnitCircle.at(i) * radius, fillColor, 0.5f);
+            AddTriangleVertex(center + m_UnitCircle.at((i + 1) % m_UnitCircle.size()) * radius, fillColor, 0.5f);
+        }
         
-        DrawSegment(aCenter,aCenter + aRadius * aAxis, aColor);
+        //Add the outline as line segments
+        for(unsigned int i = 0; i < m_UnitCircle.size(); i++)
+        {
+            AddLineVertex(center + m_UnitCircle.at(i) * radius, aColor, 1.0f);
+            AddLineVertex(center + m_UnitCircle.at((i + 1) % m_UnitCircle.size()) * radius, aColor, 1.0f);
+        }
+        
+        //Add the axis
+        AddLineVertex(center, aColor, 1.0f);
+        AddLineVertex(center + vec2(aAxis.x, aAxis.y) * radius, aColor, 1.0f);
     }
     
     void b2DebugDraw::DrawSegment(const b2Vec2& aP1, const b2Vec2& aP2, const b2Color& aColor)
     {
-        float ratio = b2Helper::Ratio();
-        m_Line->SetLocalPosition(aP1.x * ratio, aP1.y * ratio);
-        m_Line->SetPositionB(aP2.x * ratio, aP2.y * ratio);
-        m_Line->SetColor(Color(aColor.r, aColor.g, aColor.b));
-        m_Line->Draw();
+        //Convert the vertices to pixels, unless the segment is culled
+        b2Vec2 vertices[] = { aP1, aP2 };
+        if(PrepareVertices(vertices, 2) == false)
+        {
+            return;
+        }
+        
+        //Add the line segment
+        AddLineVertex(m_Vertices.at(0), aColor, 1.0f);
+        AddLineVertex(m_Vertices.at(1), aColor, 1.0f);
     }
     
     void b2DebugDraw::DrawTransform(const b2Transform& xf)
@@ -120,4 +178,179 @@ namespace GameDev2D
         p2 = p1 + k_axisScale * xf.q.GetYAxis();
         DrawSegment(p1,p2,b2Color(0,1,0));
     }
-}
+    
+    void b2DebugDraw::Flush()
+    {
+        //Set the shape counts for this pass and reset them for the next
+        m_DrawnShapeCount = m_DrawnShapes;
+        m_CulledShapeCount = m_CulledShapes;
+        m_DrawnShapes = 0;
+        m_CulledShapes = 0;
+        
+        //Is there anything to draw?
+        if(m_TriangleVertices.size() == 0 && m_LineVertices.size() == 0)
+        {
+            return;
+        }
+        
+        //Safety check the shader
+        Shader* shader = ServiceLocator::GetShaderManager()->GetPassthroughShader();
+        if(shader == nullptr)
+        {
+            m_TriangleVertices.clear();
+            m_LineVertices.clear();
+            return;
+        }
+        
+        //Create the vertex array and vertex buffer, if they haven't been created yet
+        if(m_VertexArrayObject == 0)
+        {
+            CreateBuffers();
+        }
+        
+        //Any pending render commands for the VAO still need the old vertices, submit them before the vertex buffer is orphaned
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        if(graphics->GetRenderQueue()->HasPendingCommands(m_VertexArrayObject) == true)
+        {
+            graphics->GetRenderQueue()->Submit();
+        }
+        
+        //Bind the VAO and the streaming vertex buffer
+        graphics->BindVertexArray(m_VertexArrayObject);
+        graphics->BindArrayBuffer(m_VertexBufferObject);
+        
+        //Orphan the vertex buffer and upload the triangles followed by the lines, the buffer only grows
+        unsigned int trianglesSize = (unsigned int)(sizeof(b2DebugDrawVertex) * m_TriangleVertices.size());
+        unsigned int linesSize = (unsigned int)(sizeof(b2DebugDrawVertex) * m_LineVertices.size());
+        m_VertexBufferCapacity = trianglesSize + linesSize > m_VertexBufferCapacity ? trianglesSize + linesSize : m_VertexBufferCapacity;
+        glBufferData(GL_ARRAY_BUFFER, m_VertexBufferCapacity, nullptr, GL_STREAM_DRAW);
+        if(trianglesSize > 0)
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, trianglesSize, &m_TriangleVertices[0]);
+        }
+        if(linesSize > 0)
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, trianglesSize, linesSize, &m_LineVertices[0]);
+        }
+        
+        //Unbind the vertex array
+        graphics->BindVertexArray(0);
+        
+        //Setup the render command, the vertices are already in world space and the solid circles are filled with transparency
+        RenderCommand command = MakeRenderCommand(shader, nullptr, m_VertexArrayObject, GL_TRIANGLES, 0, (unsigned int)m_TriangleVertices.size());
+        command.modelViewProjection = graphics->GetProjectionMatrix() * graphics->GetViewMatrix();
+        command.blending = RenderCommandBlendingAlpha;
+        
+        //Add the render commands for the triangles, then the lines on top of them
+        if(m_TriangleVertices.size() > 0)
+        {
+            graphics->GetRenderQueue()->AddCommand(command);
+        }
+        if(m_LineVertices.size() > 0)
+        {
+            command.primitiveMode = GL_LINES;
+            command.first = (unsigned int)m_TriangleVertices.size();
+            command.count = (unsigned int)m_LineVertices.size();
+            graphics->GetRenderQueue()->AddCommand(command);
+        }
+        
+        //Clear the vertices, the vectors keep their capacity for the next pass
+        m_TriangleVertices.clear();
+        m_LineVertices.clear();
+    }
+    
+    void b2DebugDraw::SetCullingEnabled(bool aCullingEnabled)
+    {
+        m_CullingEnabled = aCullingEnabled;
+    }
+    
+    bool b2DebugDraw::IsCullingEnabled()
+    {
+        return m_CullingEnabled;
+    }
+    
+    unsigned int b2DebugDraw::GetDrawnShapeCount()
+    {
+        return m_DrawnShapeCount;
+    }
+    
+    unsigned int b2DebugDraw::GetCulledShapeCount()
+    {
+        return m_CulledShapeCount;
+    }
+    
+    void b2DebugDraw::AddTriangleVertex(const vec2& aVertex, const b2Color& aColor, float aAlpha)
+    {
+        b2DebugDrawVertex vertex = { aVertex.x, aVertex.y, aColor.r, aColor.g, aColor.b, aAlpha };
+        m_TriangleVertices.push_back(vertex);
+    }
+    
+    void b2DebugDraw::AddLineVertex(const vec2& aVertex, const b2Color& aColor, float aAlpha)
+    {
+        b2DebugDrawVertex vertex = { aVertex.x, aVertex.y, aColor.r, aColor.g, aColor.b, aAlpha };
+        m_LineVertices.push_back(vertex);
+    }
+    
+    bool b2DebugDraw::PrepareVertices(const b2Vec2* aVertices, int aVertexCount)
+    {
+        //Convert the vertices to pixels and calculate their bounds
+        float ratio = b2Helper::Ratio();
+        BoundingBox bounds = MakeEmptyBoundingBox();
+        m_Vertices.clear();
+        for(int i = 0; i < aVertexCount; i++)
+        {
+            m_Vertices.push_back(vec2(aVertices[i].x * ratio, aVertices[i].y * ratio));
+            ExpandBoundingBox(bounds, m_Vertices.back());
+        }
+        
+        //Safety check the vertices, then cull them by their bounds
+        return aVertexCount >= 2 && IsCulled(bounds) == false;
+    }
+    
+    bool b2DebugDraw::IsCulled(const BoundingBox& aBounds)
+    {
+        //Is culling enabled and is there an active camera
+        Camera* camera = ServiceLocator::GetGraphics()->GetActiveCamera();
+        if(m_CullingEnabled == true && camera != nullptr)
+        {
+            //If the shape's bounds don't overlap the camera's view bounds the shape is culled
+            BoundingBox viewBounds = camera->GetViewBounds();
+            if(IsBoundingBoxEmpty(viewBounds) == false && DoBoundingBoxesIntersect(viewBounds, aBounds) == false)
+            {
+                m_CulledShapes++;
+                return true;
+            }
+        }
+        
+        //The shape will be drawn
+        m_DrawnShapes++;
+        return false;
+    }
+    
+    void b2DebugDraw::CreateBuffers()
+    {
+        //Generate the VAO and the VBO
+        Shader* shader = ServiceLocator::GetShaderManager()->GetPassthroughShader();
+        glGenVertexArrays(1, &m_VertexArrayObject);
+        glGenBuffers(1, &m_VertexBufferObject);
+        
+        //Bind the VAO and the VBO
+        ServiceLocator::GetGraphics()->BindVertexArray(m_VertexArrayObject);
+        ServiceLocator::GetGraphics()->BindArrayBuffer(m_VertexBufferObject);
+        
+        //Enable and set the shader's vertices attribute
+        int verticesIndex = shader->GetAttribute("a_vertices");
+        glEnableVertexAttribArray(verticesIndex);
+        long verticesOffset = 0;
+        glVertexAttribPointer(verticesIndex, 2, GL_FLOAT, GL_FALSE, sizeof(b2DebugDrawVertex), (const GLvoid*)verticesOffset);
+        
+        //Enable and set the shader's color attribute
+        int colorIndex = shader->GetAttribute("a_sourceColor");
+        glEnableVertexAttribArray(colorIndex);
+        long colorOffset = 2 * sizeof(float);
+        glVertexAttribPointer(colorIndex, 4, GL_FLOAT, GL_FALSE, sizeof(b2DebugDrawVertex), (const GLvoid*)colorOffset);
+        
+        //Unbind the VAO
+        ServiceLocator::GetGraphics()->BindVertexArray(0);
+    }
+}
\ No newline at end of file
@@ -10,15 +10,18 @@
 #define GameDevFramework_b2DebugDraw_h
 
 #include "Box2D.h"
+#include "../../Core/BoundingBox.h"
+#include <vector>
 
 struct b2AABB;
 
+using namespace std;
+
 namespace GameDev2D
 {
-    class Polygon;
-    class Circle;
-    class Line;
-
+    //The b2DebugDraw accumulates the Box2D debug shapes into a triangle list and a line list, instead of drawing each
+    //shape on its own. Flush() must be called after b2World::DrawDebugData(), it uploads both lists into one vertex
+    //buffer and draws them with two draw calls. Shapes that are outside the active camera's view bounds are culled.
     class b2DebugDraw : public b2Draw
     {
     public:
@@ -32,10 +35,51 @@ namespace GameDev2D
         void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color);
         void DrawTransform(const b2Transform& xf);
         
+        //Draws the accumulated triangles and lines, then clears them
+        void Flush();
+        
+        //Sets wether the shapes outside the active camera's view bounds are culled
+        void SetCullingEnabled(bool cullingEnabled);
+        bool IsCullingEnabled();
+        
+        //Returns the number of shapes that were drawn and culled by the last Flush()
+        unsigned int GetDrawnShapeCount();
+        unsigned int GetCulledShapeCount();
+    
     private:
-        Polygon* m_Polygon;
-        Circle* m_Circle;
-        Line* m_Line;
+        //Interleaved vertex format, matches the passthrough shader's attributes
+        struct b2DebugDrawVertex
+        {
+            float x, y;
+            float r, g, b, a;
+        };
+        
+        //Adds a vertex to the triangle or line list
+        void AddTriangleVertex(const vec2& vertex, const b2Color& color, float alpha);
+        void AddLineVertex(const vec2& vertex, const b2Color& color, float alpha);
+        
+        //Converts the Box2D vertices to pixels and returns false if the shape is culled
+        bool PrepareVertices(const b2Vec2* vertices, int vertexCount);
+        
+        //Returns wether the bounds are outside the active camera's view bounds
+        bool IsCulled(const BoundingBox& bounds);
+        
+        //Creates the vertex array and vertex buffer
+        void CreateBuffers();
+        
+        //Member variables
+        vector<b2DebugDrawVertex> m_TriangleVertices;
+        vector<b2DebugDrawVertex> m_LineVertices;
+        vector<vec2> m_Vertices;
+        vector<vec2> m_UnitCircle;
+        unsigned int m_VertexArrayObject;
+        unsigned int m_VertexBufferObject;
+        unsigned int m_VertexBufferCapacity;
+        bool m_CullingEnabled;
+        unsigned int m_DrawnShapes;
+        unsigned int m_CulledShapes;
+        unsigned int m_DrawnShapeCount;
+        unsigned int m_CulledShapeCount;
     };
 }
 
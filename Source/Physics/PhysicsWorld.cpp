@@ -57,6 +57,12 @@ namespace GameDev2D
         if(m_World != NULL)
         {
             m_World->DrawDebugData();
+            
+            //Draw the accumulated debug shapes
+            if(m_DebugDraw != nullptr)
+            {
+                m_DebugDraw->Flush();
+            }
         }
         #endif
     }
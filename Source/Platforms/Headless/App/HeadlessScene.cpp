@@ -0,0 +1,71 @@
+//
+//  HeadlessScene.cpp
+//  GameDev2D
+//
+
+#include "HeadlessScene.h"
+#include "../../../UI/Sprite/Sprite.h"
+#include "../../../UI/Label/Label.h"
+#include "../../../Graphics/Primitives/Rect.h"
+
+
+//The Sprites are laid out in a grid, of this many columns
+#define HEADLESS_SCENE_COLUMNS 16
+#define HEADLESS_SCENE_SPACING 48.0f
+
+
+namespace GameDev2D
+{
+    HeadlessScene::HeadlessScene() : Scene("HeadlessScene"),
+        m_Label(nullptr),
+        m_SpriteCount(0)
+    {
+    
+    }
+    
+    HeadlessScene::~HeadlessScene()
+    {
+        //The Scene takes care of deleting any GameObjects
+    }
+    
+    float HeadlessScene::LoadContent()
+    {
+        //Batch the Sprites, they all share the same Texture
+        SetSpriteBatchingEnabled(true, SpriteBatchSortTexture);
+        
+        //Add the grid of Sprites
+        AddSprites(HEADLESS_SCENE_COLUMNS * 4);
+        
+        //Add a Rect, it is drawn on top of the Sprites
+        Rect* rect = (Rect*)AddGameObject(new Rect(400.0f, 400.0f, 200.0f, 100.0f), 1);
+        rect->SetColor(Color::RedColor());
+        
+        //Add a Label
+        m_Label = (Label*)AddGameObject(new Label("TestFont"), 2);
+        m_Label->SetLocalPosition(400.0f, 600.0f);
+        m_Label->SetText("Score: 00000");
+        
+        //Return 1.0f when loading has completed
+        return 1.0f;
+    }
+    
+    void HeadlessScene::AddSprites(unsigned int aCount)
+    {
+        for(unsigned int i = 0; i < aCount; i++)
+        {
+            Sprite* sprite = (Sprite*)AddGameObject(new Sprite("CharHead"));
+            sprite->SetLocalPosition(32.0f + (m_SpriteCount % HEADLESS_SCENE_COLUMNS) * HEADLESS_SCENE_SPACING, 32.0f + (m_SpriteCount / HEADLESS_SCENE_COLUMNS) * HEADLESS_SCENE_SPACING);
+            m_SpriteCount++;
+        }
+    }
+    
+    unsigned int HeadlessScene::GetSpriteCount()
+    {
+        return m_SpriteCount;
+    }
+    
+    Label* HeadlessScene::GetLabel()
+    {
+        return m_Label;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+//
+//  HeadlessScene.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__HeadlessScene__
+#define __GameDev2D__HeadlessScene__
+
+#include "../../../Core/Scene.h"
+
+
+namespace GameDev2D
+{
+    class Label;
+    
+    //The HeadlessScene is the Scene the headless driver runs, it has a grid of Sprites that share the same
+    //Texture, a Label and a Rect. Its content doesn't change from frame to frame, unless Sprites are added
+    class HeadlessScene : public Scene
+    {
+    public:
+        HeadlessScene();
+        ~HeadlessScene();
+        
+        //Loads the Sprites, the Label and the Rect
+        float LoadContent();
+        
+        //Adds Sprites to the grid, they all use the same Texture
+        void AddSprites(unsigned int count);
+        
+        //Returns the number of Sprites in the grid
+        unsigned int GetSpriteCount();
+        
+        //Returns the Label
+        Label* GetLabel();
+    
+    private:
+        //Member variables
+        Label* m_Label;
+        unsigned int m_SpriteCount;
+    };
+}
+
+#endif /* defined(__GameDev2D__HeadlessScene__) */
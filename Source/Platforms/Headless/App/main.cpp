@@ -0,0 +1,526 @@
+//
+//  main.cpp
+//  GameDev2D
+//
+
+#include "HeadlessScene.h"
+#include "../../../UI/Label/Label.h"
+#include "../../../UI/Sprite/Sprite.h"
+#include "../../../UI/TileMap/TileMap.h"
+#include "../../../Graphics/Textures/TextureContainer.h"
+#include "../Platform_Headless.h"
+#include "../../../Graphics/Headless/GLCommandLog.h"
+#include "../../../Services/ServiceLocator.h"
+#include "../../../Services/DebugUI/DebugUI.h"
+
+
+//The headless view's size and frame rate, and the number of frames that are run before and while the GL calls are checked
+#define HEADLESS_WIDTH 1024
+#define HEADLESS_HEIGHT 768
+#define HEADLESS_TARGET_FPS 30
+#define HEADLESS_WARM_UP_FRAMES 10
+#define HEADLESS_MEASURED_FRAMES 5
+
+
+using namespace GameDev2D;
+
+//The GL calls that were recorded for a single frame
+struct HeadlessFrame
+{
+    unsigned int commands;
+    unsigned int drawCalls;
+    unsigned int stateChanges;
+    unsigned int validations;
+    unsigned int shaderCompiles;
+    unsigned int textureUploads;
+};
+
+//Exposes the Texture's protected container methods, so that texture containers can be checked without the file system
+class HeadlessTexture : public Texture
+{
+public:
+    HeadlessTexture() : Texture("HeadlessTexture")
+    {
+    }
+    
+    using Texture::ReadContainerData;
+    using Texture::DecompressImageData;
+    using Texture::LoadFromImageData;
+    using Texture::LoadFromPath;
+};
+
+//The number of expectations that failed
+static unsigned int s_Failures = 0;
+
+//Runs a single frame through the PlatformLayer and returns the GL calls that were recorded
+static HeadlessFrame RunFrame(Platform_Headless* aPlatform)
+{
+    //Clear the log and run the frame
+    GLCommandLog::Clear();
+    aPlatform->GameLoop();
+    
+    //Count the recorded GL calls
+    HeadlessFrame frame;
+    frame.commands = GLCommandLog::GetCommandCount();
+    frame.drawCalls = GLCommandLog::GetDrawCallCount();
+    frame.stateChanges = GLCommandLog::GetStateChangeCount();
+    frame.validations = GLCommandLog::GetCallCount("glValidateProgram");
+    frame.shaderCompiles = GLCommandLog::GetCallCount("glCompileShader");
+    frame.textureUploads = GLCommandLog::GetCallCount("glTexImage2D") + GLCommandLog::GetCallCount("glCompressedTexImage2D");
+    return frame;
+}
+
+//Builds a texture container in memory, with a full chain of mipmap levels if it has more than one level
+static vector<unsigned char> MakeTextureContainer(unsigned int aFormat, unsigned int aWidth, unsigned int aHeight, unsigned int aMipmapCount)
+{
+    //Calculate the size of the mipmap levels
+    unsigned int dataSize = 0;
+    for(unsigned int level = 0; level < aMipmapCount; level++)
+    {
+        unsigned int width = (aWidth >> level) > 0 ? (aWidth >> level) : 1;
+        unsigned int height = (aHeight >> level) > 0 ? (aHeight >> level) : 1;
+        dataSize += GetTextureContainerLevelSize(aFormat, width, height);
+    }
+    
+    //Set the header
+    TextureContainerHeader header;
+    header.magic = TEXTURE_CONTAINER_MAGIC;
+    header.version = TEXTURE_CONTAINER_VERSION;
+    header.width = aWidth;
+    header.height = aHeight;
+    header.format = aFormat;
+    header.mipmapCount = aMipmapCount;
+    header.flags = 0;
+    header.dataSize = dataSize;
+    
+    //Copy the header and fill the levels with a pattern, any data is valid for the compressed formats
+    vector<unsigned char> container(sizeof(TextureContainerHeader) + dataSize);
+    memcpy(&container[0], &header, sizeof(TextureContainerHeader));
+    for(unsigned int i = 0; i < dataSize; i++)
+    {
+        container[sizeof(TextureContainerHeader) + i] = (unsigned char)(i * 37);
+    }
+    return container;
+}
+
+//Reads a file's bytes, the vector is empty if the file doesn't exist
+static vector<unsigned char> ReadBinaryFile(const string& aPath)
+{
+    vector<unsigned char> data;
+    FILE* file = fopen(aPath.c_str(), "rb");
+    if(file != nullptr)
+    {
+        fseek(file, 0, SEEK_END);
+        data.resize(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        if(data.size() > 0 && fread(&data[0], 1, data.size(), file) != data.size())
+        {
+            data.clear();
+        }
+        fclose(file);
+    }
+    return data;
+}
+
+//Writes the bytes to a file, replacing the file if it exists
+static void WriteBinaryFile(const string& aPath, const vector<unsigned char>& aData)
+{
+    FILE* file = fopen(aPath.c_str(), "wb");
+    if(file != nullptr)
+    {
+        if(aData.size() > 0)
+        {
+            fwrite(&aData[0], 1, aData.size(), file);
+        }
+        fclose(file);
+    }
+}
+
+//Returns wether a new ShaderCache, that reads the file at the path, links the shader from a cached program binary
+static bool LoadFromShaderCache(const string& aPath, Shader* aShader, unsigned long long aHash)
+{
+    ShaderCache* shaderCache = new ShaderCache(aPath);
+    bool didLoad = shaderCache->Load(aShader, aHash);
+    SafeDelete(shaderCache);
+    return didLoad;
+}
+
+//Prints the result of an expectation, and keeps track of the failures
+static void Expect(bool aCondition, const char* aDescription)
+{
+    printf("%s: %s\n", aCondition == true ? "PASS" : "FAIL", aDescription);
+    if(aCondition == false)
+    {
+        s_Failures++;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    //The directory the Assets directory is in is the first argument, by default the driver is run from Platforms/Headless
+    //and the Makefile copies the Assets directory and the fixtures to the build directory
+    string resourceDirectory = argc > 1 ? string(argv[1]) : string("build");
+    
+    //Create the headless PlatformLayer, initialize it and set the root Scene
+    Platform_Headless* platform = new Platform_Headless(resourceDirectory, HEADLESS_WIDTH, HEADLESS_HEIGHT, HEADLESS_TARGET_FPS);
+    platform->Init();
+    HeadlessScene* scene = new HeadlessScene();
+    platform->SetRootScene(scene);
+    
+    //Stop watching the frames per second, its Label changes with the machine's timing and every frame has to record the same GL calls
+    ServiceLocator::GetDebugUI()->StopWatchingValueUnsignedInt(platform, CastDebugCallbackUnsignedInt(PlatformLayer::GetFramesPerSecond));
+    
+    //Run the warm up frames, the content is loaded and the shaders and textures are uploaded
+    for(unsigned int i = 0; i < HEADLESS_WARM_UP_FRAMES; i++)
+    {
+        RunFrame(platform);
+    }
+    
+    //Run the measured frames, nothing in the Scene changes so every frame should record the same draw calls and state changes
+    HeadlessFrame first = RunFrame(platform);
+    bool isSameDrawCalls = true;
+    bool isSameStateChanges = true;
+    for(unsigned int i = 1; i < HEADLESS_MEASURED_FRAMES; i++)
+    {
+        HeadlessFrame frame = RunFrame(platform);
+        isSameDrawCalls = isSameDrawCalls && frame.drawCalls == first.drawCalls;
+        isSameStateChanges = isSameStateChanges && frame.stateChanges == first.stateChanges;
+    }
+    printf("Frame: %u commands, %u draw calls, %u state changes, %u validations, %u sprites\n", first.commands, first.drawCalls, first.stateChanges, first.validations, scene->GetSpriteCount());
+    
+    //Check the steady state frames
+    Expect(first.drawCalls > 0, "A frame issues draw calls");
+    Expect(isSameDrawCalls, "Every static frame issues the same number of draw calls");
+    Expect(isSameStateChanges, "Every static frame issues the same number of state changes");
+    Expect(first.drawCalls < scene->GetSpriteCount(), "The Sprites are batched into fewer draw calls than Sprites");
+    Expect(first.validations == 0, "The shader validation results are cached");
+    Expect(first.shaderCompiles == 0, "No shaders are compiled after the first frames");
+    Expect(first.textureUploads == 0, "No textures are uploaded after the first frames");
+    
+    //Double the Sprites, Sprites that share a Texture are batched, so the draw calls shouldn't change
+    scene->AddSprites(scene->GetSpriteCount());
+    RunFrame(platform);
+    HeadlessFrame doubled = RunFrame(platform);
+    printf("Frame: %u commands, %u draw calls, %u state changes, %u validations, %u sprites\n", doubled.commands, doubled.drawCalls, doubled.stateChanges, doubled.validations, scene->GetSpriteCount());
+    Expect(doubled.drawCalls == first.drawCalls, "Doubling the batched Sprites doesn't add draw calls");
+    Expect(doubled.stateChanges == first.stateChanges, "Doubling the batched Sprites doesn't add state changes");
+    
+    //Enable culling, every GameObject in the Scene is in the Camera's view so none of them should be culled
+    Graphics* graphics = ServiceLocator::GetGraphics();
+    graphics->SetCullingEnabled(true);
+    RunFrame(platform);
+    RunFrame(platform);
+    printf("Culling: %u drawn, %u culled\n", graphics->GetDrawnObjectsPerFrame(), graphics->GetCulledObjectsPerFrame());
+    Expect(graphics->GetCulledObjectsPerFrame() == 0, "GameObjects in the Camera's view aren't culled");
+    
+    //Move the Camera away from the Scene, the Sprites, Rect and Label should all be culled
+    scene->GetCamera()->SetPosition(-10000.0f, -10000.0f);
+    RunFrame(platform);
+    RunFrame(platform);
+    printf("Culling: %u drawn, %u culled\n", graphics->GetDrawnObjectsPerFrame(), graphics->GetCulledObjectsPerFrame());
+    Expect(graphics->GetCulledObjectsPerFrame() == scene->GetSpriteCount() + 2, "GameObjects outside the Camera's view are culled");
+    
+    //Move the Camera back, the cached world bounds are still valid so nothing should be culled
+    scene->GetCamera()->SetPosition(0.0f, 0.0f);
+    RunFrame(platform);
+    RunFrame(platform);
+    Expect(graphics->GetCulledObjectsPerFrame() == 0, "GameObjects back in the Camera's view aren't culled");
+    
+    //Move the Label out of the Camera's view, its cached world bounds are dirty so it should be the only GameObject culled
+    scene->GetLabel()->SetLocalPosition(-10000.0f, -10000.0f);
+    RunFrame(platform);
+    RunFrame(platform);
+    Expect(graphics->GetCulledObjectsPerFrame() == 1, "A GameObject that moves out of the Camera's view is culled");
+    
+    //Move the Label back and change the score without changing the text's length, only the two glyphs that changed are updated
+    Label* label = scene->GetLabel();
+    label->SetLocalPosition(400.0f, 600.0f);
+    label->SetText("Score: 00009");
+    RunFrame(platform);
+    label->SetText("Score: 00010");
+    RunFrame(platform);
+    RunFrame(platform);
+    Expect(graphics->GetLabelUpdatesPerFrame() == 1 && graphics->GetLabelRebuildsPerFrame() == 0 && graphics->GetLabelGlyphUploadsPerFrame() == 2, "A same length text change only updates the changed glyphs");
+    map<unsigned int, vector<unsigned char>> updatedBuffers = GLCommandLog::GetBufferData();
+    
+    //Setting the same text again is skipped
+    label->SetText("Score: 00010");
+    RunFrame(platform);
+    Expect(graphics->GetLabelSkippedTextChangesPerFrame() == 1 && graphics->GetLabelUpdatesPerFrame() == 0 && graphics->GetLabelRebuildsPerFrame() == 0, "Setting the same text is skipped");
+    
+    //Rebuild the whole glyph buffer with the same text, by changing the text's length and back. The vertices the partial update
+    //uploaded have to be the same as the full rebuild's, and nothing else in the Scene changed so every array buffer has to match
+    label->SetText("Score: 000010");
+    RunFrame(platform);
+    label->SetText("Score: 00010");
+    RunFrame(platform);
+    RunFrame(platform);
+    Expect(graphics->GetLabelRebuildsPerFrame() == 1 && graphics->GetLabelUpdatesPerFrame() == 0, "A text length change rebuilds the glyph buffer");
+    Expect(GLCommandLog::GetBufferData() == updatedBuffers, "The partially updated glyph vertices are the same as a full rebuild's");
+    
+    //The Sprites are batched, the Rect and the Label's single run of glyphs are recorded as render commands and sorted once per frame
+    RenderQueue* renderQueue = graphics->GetRenderQueue();
+    printf("RenderQueue: %u commands, %u sorted, %f ms\n", renderQueue->GetCommandsPerFrame(), renderQueue->GetSortedCommandsPerFrame(), renderQueue->GetSortTimePerFrame());
+    Expect(renderQueue->GetSortedCommandsPerFrame() == 2 && renderQueue->GetCommandsPerFrame() >= 2, "The Scene's non-batched draw calls are recorded as render commands");
+    Expect(renderQueue->IsRecording() == false && renderQueue->HasPendingCommands() == false, "Every render command is submitted by the end of the frame");
+    
+    //Store the passThrough shader's program binary in a cache file, the headless program binary is retrieved from the linked program
+    string shaderCachePath = platform->GetWorkingDirectory() + "/ShaderCacheCheck.bin";
+    Shader* shader = ServiceLocator::GetShaderManager()->GetShader("passThrough");
+    unsigned long long shaderHash = 1;
+    remove(shaderCachePath.c_str());
+    ShaderCache* shaderCache = new ShaderCache(shaderCachePath);
+    GLCommandLog::Clear();
+    shaderCache->Store(shader, shaderHash);
+    shaderCache->Save();
+    Expect(shaderCache->IsSupported() == true && GLCommandLog::GetCallCount("glGetProgramBinary") == 1, "The linked program binary is retrieved for the shader cache");
+    SafeDelete(shaderCache);
+    
+    //A new ShaderCache reads the file back and links the shader from its program binary, unless the hash changed
+    vector<unsigned char> shaderCacheFile = ReadBinaryFile(shaderCachePath);
+    GLCommandLog::Clear();
+    bool didLoadShader = LoadFromShaderCache(shaderCachePath, shader, shaderHash);
+    Expect(didLoadShader == true && GLCommandLog::GetCallCount("glProgramBinary") == 1 && GLCommandLog::GetCallCount("glCompileShader") == 0, "A shader is linked from the program binary that was written to the cache file");
+    Expect(LoadFromShaderCache(shaderCachePath, shader, shaderHash + 1) == false, "A program binary with a different hash isn't linked");
+    
+    //A truncated file, a file with the wrong magic number and a file that is shorter than the header are ignored
+    vector<unsigned char> truncatedFile(shaderCacheFile.begin(), shaderCacheFile.end() - 1);
+    vector<unsigned char> badMagicFile = shaderCacheFile;
+    badMagicFile[0] ^= 0xff;
+    vector<unsigned char> tooShortFile(shaderCacheFile.begin(), shaderCacheFile.begin() + 8);
+    WriteBinaryFile(shaderCachePath, truncatedFile);
+    GLCommandLog::Clear();
+    Expect(LoadFromShaderCache(shaderCachePath, shader, shaderHash) == false && GLCommandLog::GetCallCount("glProgramBinary") == 0, "A truncated shader cache file entry is ignored");
+    WriteBinaryFile(shaderCachePath, badMagicFile);
+    Expect(LoadFromShaderCache(shaderCachePath, shader, shaderHash) == false && GLCommandLog::GetCallCount("glProgramBinary") == 0, "A shader cache file with the wrong magic number is ignored");
+    WriteBinaryFile(shaderCachePath, tooShortFile);
+    Expect(LoadFromShaderCache(shaderCachePath, shader, shaderHash) == false && GLCommandLog::GetCallCount("glProgramBinary") == 0, "A shader cache file that is shorter than its header is ignored");
+    
+    //Change the last byte of the program binary, the file is valid but the headless driver rejects the program binary
+    vector<unsigned char> rejectedFile = shaderCacheFile;
+    rejectedFile.back() ^= 0xff;
+    WriteBinaryFile(shaderCachePath, rejectedFile);
+    shaderCache = new ShaderCache(shaderCachePath);
+    GLCommandLog::Clear();
+    Expect(shaderCache->Load(shader, shaderHash) == false && GLCommandLog::GetCallCount("glProgramBinary") == 1 && shaderCache->GetMissCount() == 1, "A program binary that the driver rejects isn't linked");
+    
+    //The rejected program binary is dropped, the rewritten file doesn't have an entry for the shader
+    shaderCache->Save();
+    SafeDelete(shaderCache);
+    GLCommandLog::Clear();
+    Expect(LoadFromShaderCache(shaderCachePath, shader, shaderHash) == false && GLCommandLog::GetCallCount("glProgramBinary") == 0, "A rejected program binary is dropped from the shader cache file");
+    
+    //Link the shader from the valid program binary again, the rejected program binary left it unlinked
+    WriteBinaryFile(shaderCachePath, shaderCacheFile);
+    Expect(LoadFromShaderCache(shaderCachePath, shader, shaderHash) == true, "A shader is linked again from a valid program binary");
+    remove(shaderCachePath.c_str());
+    
+    //RGB texture data is tightly packed, an odd sized RGB texture's rows aren't padded to 4 bytes so GL has to read exactly its pixels
+    unsigned char rgbPixels[3 * 3 * 3] = {};
+    GLCommandLog::Clear();
+    Texture* rgbTexture = new Texture(3, 3, GL_RGB, rgbPixels);
+    Expect(GLCommandLog::GetUploadBytes() == sizeof(rgbPixels), "Odd sized RGB textures are uploaded with tightly packed rows");
+    SafeDelete(rgbTexture);
+    
+    //The headless GL doesn't support any compressed format, so block compressed containers are decompressed in software. An odd sized
+    //BC1 container with a full mipmap chain (5x3, 2x1, 1x1) is decompressed into tightly packed RGB levels and each level is uploaded
+    vector<unsigned char> bc1Container = MakeTextureContainer(TextureContainerFormatBC1, 5, 3, 3);
+    HeadlessTexture* bc1Texture = new HeadlessTexture();
+    TextureImageData bc1ImageData;
+    bool isBC1Valid = HeadlessTexture::ReadContainerData(&bc1Container[0], (unsigned int)bc1Container.size(), bc1ImageData);
+    bool didDecompressBC1 = isBC1Valid == true && HeadlessTexture::DecompressImageData(bc1ImageData) == true;
+    GLCommandLog::Clear();
+    if(didDecompressBC1 == true)
+    {
+        bc1Texture->LoadFromImageData(bc1ImageData);
+        SafeFree(bc1ImageData.data);
+    }
+    unsigned int bc1LevelBytes = (5 * 3 + 2 * 1 + 1 * 1) * 3;
+    Expect(didDecompressBC1 == true && bc1ImageData.format == GL_RGB && bc1ImageData.dataSize == bc1LevelBytes, "An odd sized BC1 container with mipmaps is decompressed in software");
+    Expect(GLCommandLog::GetCallCount("glTexImage2D") == 3 && GLCommandLog::GetCallCount("glCompressedTexImage2D") == 0 && bc1Texture->GetMipmapCount() == 3, "Every decompressed BC1 mipmap level is uploaded");
+    Expect(GLCommandLog::GetUploadBytes() == bc1LevelBytes, "The decompressed BC1 levels are uploaded with tightly packed rows");
+    SafeDelete(bc1Texture);
+    
+    //The fixture's texture container was cooked with mipmaps from the 8x4 png next to it, the texture container is loaded instead
+    //of the png so its four mipmap levels are uploaded (8x4 + 4x2 + 2x1 + 1x1 RGBA pixels), the png would only upload 8x4 pixels
+    GLCommandLog::Clear();
+    TextureFrame* fixtureFrame = new TextureFrame("HeadlessFixture", "", "Fixtures");
+    Expect(GLCommandLog::GetCallCount("glTexImage2D") == 4 && GLCommandLog::GetUploadBytes() == (8 * 4 + 4 * 2 + 2 * 1 + 1 * 1) * 4, "The cooked texture container is loaded instead of the png image");
+    SafeDelete(fixtureFrame);
+    
+    //Read the fixture's header, it is the TextureCooker's 8x4 RGBA texture container with a full mipmap chain
+    vector<unsigned char> fixture = ReadBinaryFile(resourceDirectory + "/Assets/Fixtures/HeadlessFixture.gdtex");
+    TextureImageData fixtureImageData;
+    bool isFixtureValid = fixture.size() > sizeof(TextureContainerHeader) && HeadlessTexture::ReadContainerData(&fixture[0], (unsigned int)fixture.size(), fixtureImageData);
+    Expect(isFixtureValid == true && fixtureImageData.size == uvec2(8, 4) && fixtureImageData.format == GL_RGBA && fixtureImageData.mipmapCount == 4 && fixtureImageData.dataSize == fixture.size() - sizeof(TextureContainerHeader), "The cooked texture container's header is valid");
+    
+    //Change each header field, a texture container with an invalid header is rejected
+    bool isInvalidHeaderRejected = isFixtureValid;
+    for(unsigned int field = 0; field < sizeof(TextureContainerHeader) / sizeof(unsigned int) && isFixtureValid == true; field++)
+    {
+        //The flags don't have to be validated, any other field is changed to a value that doesn't match the data
+        if(field * sizeof(unsigned int) == offsetof(TextureContainerHeader, flags))
+        {
+            continue;
+        }
+        vector<unsigned char> invalidHeader = fixture;
+        unsigned int value = 0;
+        memcpy(&value, &invalidHeader[field * sizeof(unsigned int)], sizeof(unsigned int));
+        value = field * sizeof(unsigned int) == offsetof(TextureContainerHeader, width) ? 0 : value + 1;
+        memcpy(&invalidHeader[field * sizeof(unsigned int)], &value, sizeof(unsigned int));
+        TextureImageData invalidImageData;
+        isInvalidHeaderRejected = isInvalidHeaderRejected && HeadlessTexture::ReadContainerData(&invalidHeader[0], (unsigned int)invalidHeader.size(), invalidImageData) == false;
+    }
+    Expect(isInvalidHeaderRejected, "A texture container with an invalid header is rejected");
+    
+    //A texture container that is shorter than its header, or that is missing the last byte of its data, is rejected
+    TextureImageData truncatedImageData;
+    Expect(isFixtureValid == true && HeadlessTexture::ReadContainerData(&fixture[0], sizeof(TextureContainerHeader) - 1, truncatedImageData) == false, "A texture container that is shorter than its header is rejected");
+    Expect(isFixtureValid == true && HeadlessTexture::ReadContainerData(&fixture[0], (unsigned int)fixture.size() - 1, truncatedImageData) == false, "A truncated texture container is rejected");
+    
+    //A truncated texture container file fails to load, nothing is uploaded
+    string truncatedPath = platform->GetWorkingDirectory() + "/TruncatedCheck.gdtex";
+    vector<unsigned char> truncatedFixture = fixture;
+    truncatedFixture.resize(fixture.size() > 0 ? fixture.size() - 1 : 0);
+    WriteBinaryFile(truncatedPath, truncatedFixture);
+    HeadlessTexture* truncatedTexture = new HeadlessTexture();
+    GLCommandLog::Clear();
+    Expect(isFixtureValid == true && truncatedTexture->LoadFromPath(truncatedPath) == false && GLCommandLog::GetCallCount("glTexImage2D") == 0, "A truncated texture container file fails to load");
+    SafeDelete(truncatedTexture);
+    remove(truncatedPath.c_str());
+    
+    //Load a texture asynchronously, then load it synchronously before it is uploaded. The synchronous load has to finish the
+    //asynchronous load, so that neither TextureFrame is left displaying the checkerboard texture
+    TextureManager* textureManager = ServiceLocator::GetTextureManager();
+    TextureFrame* asyncFrame = new TextureFrame("DemonTorso", "", "Images/", true);
+    TextureLoadHandle handle = textureManager->AddTextureAsync("DemonTorso", "Images/");
+    Expect(asyncFrame->IsWaitingForTexture() == true, "An asynchronously loaded TextureFrame waits for its texture");
+    TextureFrame* syncFrame = new TextureFrame("DemonTorso", "", "Images/");
+    Expect(asyncFrame->IsWaitingForTexture() == false && syncFrame->IsWaitingForTexture() == false, "A synchronous load finishes a pending asynchronous load");
+    Expect(syncFrame->GetSourceFrame().size == asyncFrame->GetSourceFrame().size, "The synchronously loaded TextureFrame has the texture's size");
+    
+    //The load state handle is released once it reports the load has completed
+    Expect(textureManager->GetTextureLoadState(handle) == TextureLoadComplete, "The asynchronous load is complete");
+    Expect(textureManager->GetTextureLoadState(handle) == TextureLoadFailed, "The load state handle is released once it is complete");
+    textureManager->RemoveTexture("DemonTorso");
+    SafeDelete(syncFrame);
+    SafeDelete(asyncFrame);
+    
+    //Load a Sprite asynchronously, run frames until its texture is uploaded, its size then has to be the texture's size
+    Sprite* asyncSprite = new Sprite("DemonArmLeft", "", SpriteLoadAsync);
+    vec2 placeholderSize = asyncSprite->GetSize();
+    for(unsigned int i = 0; i < HEADLESS_WARM_UP_FRAMES && textureManager->GetPendingTextureLoadCount() > 0; i++)
+    {
+        RunFrame(platform);
+    }
+    asyncSprite->Update(0.0);
+    Sprite* syncSprite = new Sprite("DemonArmLeft");
+    Expect(textureManager->GetPendingTextureLoadCount() == 0, "The asynchronously loaded Sprite's texture is uploaded");
+    Expect(asyncSprite->GetSize() == syncSprite->GetSize() && asyncSprite->GetSize() != placeholderSize, "The asynchronously loaded Sprite has the texture's size");
+    SafeDelete(syncSprite);
+    SafeDelete(asyncSprite);
+    
+    //Evict the textures that are already cached, so that only the textures loaded below are cached
+    unsigned int textureBudget = textureManager->GetTextureBudget();
+    textureManager->SetTextureBudget(textureManager->GetTextureMemory() - textureManager->GetCachedTextureMemory());
+    textureManager->SetTextureBudget(textureBudget);
+    textureManager->ResetTextureCacheStats();
+    
+    //Textures that are released stay cached within the texture budget, adding them again is a cache hit
+    textureManager->AddTexture("DemonHead", "Images/");
+    textureManager->AddTexture("DemonLegLeft", "Images/");
+    textureManager->AddTexture("DemonLegRight", "Images/");
+    textureManager->RemoveTexture("DemonHead");
+    textureManager->RemoveTexture("DemonLegLeft");
+    Expect(textureManager->GetCachedTextureCount() == 2 && textureManager->GetTextureCacheMisses() == 3 && textureManager->GetTextureCacheEvictions() == 0, "Released textures stay cached within the texture budget");
+    textureManager->AddTexture("DemonHead", "Images/");
+    Expect(textureManager->GetTextureCacheHits() == 1 && textureManager->GetTextureCacheMisses() == 3 && textureManager->GetCachedTextureCount() == 1, "Adding a cached texture again is a cache hit");
+    
+    //Release the DemonHead texture again, the DemonLegLeft texture is now the least recently used texture and is evicted first
+    textureManager->RemoveTexture("DemonHead");
+    textureManager->SetTextureBudget(textureManager->GetTextureMemory() - 1);
+    Expect(textureManager->GetTextureCacheEvictions() == 1 && textureManager->GetCachedTextureCount() == 1, "Exceeding the texture budget evicts a single cached texture");
+    textureManager->AddTexture("DemonHead", "Images/");
+    Expect(textureManager->GetTextureCacheHits() == 2 && textureManager->GetTextureCacheReloads() == 0, "The least recently used texture is evicted first");
+    
+    //Adding the evicted texture reloads it, every loaded texture is referenced so none of them can be evicted to fit within the budget
+    textureManager->AddTexture("DemonLegLeft", "Images/");
+    Expect(textureManager->GetTextureCacheReloads() == 1 && textureManager->GetTextureCacheEvictions() == 1, "An evicted texture is reloaded when it is added again");
+    Expect(textureManager->GetTextureMemory() > textureManager->GetTextureBudget() && textureManager->GetCachedTextureCount() == 0, "Referenced textures are never evicted, even over the texture budget");
+    
+    //Release the textures and restore the texture budget
+    textureManager->RemoveTexture("DemonHead");
+    textureManager->RemoveTexture("DemonLegLeft");
+    textureManager->RemoveTexture("DemonLegRight");
+    textureManager->SetTextureBudget(textureBudget);
+    
+    //Draw two TextureFrames, alternating between them in one layer, after a TextureFrame in the layer below. By default only the layers
+    //are sorted, sorting by state groups each layer's render commands by Texture, the layer below is drawn first in both modes. Sorted
+    //by state each Texture is bound once per layer, twice if the first Texture in the upper layer isn't the one the layer below used
+    TextureFrame* frameA = new TextureFrame("DemonHead", "", "Images");
+    TextureFrame* frameB = new TextureFrame("DemonLegLeft", "", "Images");
+    frameA->SetShader(ServiceLocator::GetShaderManager()->GetPassthroughTextureShader());
+    frameB->SetShader(ServiceLocator::GetShaderManager()->GetPassthroughTextureShader());
+    RenderQueueSortMode sortModes[2] = { RenderQueueSortNone, RenderQueueSortState };
+    unsigned int textureBinds[2] = { 0, 0 };
+    unsigned int drawCalls[2] = { 0, 0 };
+    for(unsigned int i = 0; i < 2; i++)
+    {
+        graphics->BindTexture(nullptr);
+        GLCommandLog::Clear();
+        renderQueue->Begin(sortModes[i]);
+        renderQueue->SetLayer(1);
+        for(unsigned int j = 0; j < 4; j++)
+        {
+            (j % 2 == 0 ? frameA : frameB)->Draw(translate(mat4(1.0f), vec3(j * 64.0f, 0.0f, 0.0f)));
+        }
+        renderQueue->SetLayer(0);
+        frameB->Draw(mat4(1.0f));
+        Expect(GLCommandLog::GetDrawCallCount() == 0 && renderQueue->HasPendingCommands() == true, "Render commands aren't submitted while the RenderQueue is recording");
+        renderQueue->End();
+        textureBinds[i] = GLCommandLog::GetCallCount("glBindTexture");
+        drawCalls[i] = GLCommandLog::GetDrawCallCount();
+    }
+    Expect(textureBinds[0] == 5 && drawCalls[0] == 5, "The render commands are drawn layer by layer, in the order they were added");
+    Expect(textureBinds[1] <= 3 && drawCalls[1] == 5, "Sorting the render commands by state groups each layer's Textures");
+    SafeDelete(frameA);
+    SafeDelete(frameB);
+    
+    //The map images are split into tiles by the AtlasPacker, each tile has to fit within the streaming budget
+    TileMap* tileMap = new TileMap("Map0", "Images", TextureFilterTrilinear, true);
+    Texture* tile = textureManager->GetStreamedTexture("Map0-tile-0-0", "Images", true, TextureFilterTrilinear, true);
+    Expect(tileMap->GetTileSize().x < tileMap->GetSize().x && tileMap->GetTileSize().y < tileMap->GetSize().y, "The map image is split into tiles");
+    Expect(tile != nullptr && tile->GetResidentMemory() <= textureManager->GetStreamingBudget(), "A map tile fits within the streaming budget");
+    SafeDelete(tileMap);
+    
+    //Add a TileMap to the Scene, its visible tiles are requested asynchronously in Draw() so the first frame doesn't draw any tiles
+    TileMap* asyncTileMap = (TileMap*)scene->AddGameObject(new TileMap("Map1", "Images"));
+    HeadlessFrame tileMapFrame = RunFrame(platform);
+    Expect(asyncTileMap->GetVisibleTileCount() > 0 && asyncTileMap->GetResidentTileCount() == 0 && tileMapFrame.textureUploads == 0, "A TileMap requests its visible tiles asynchronously and doesn't draw them until they are resident");
+    Expect(textureManager->GetPendingTextureLoadCount() > 0 && textureManager->IsStreamedTextureLoading("Map1-tile-0-0", "Images") == true, "The TileMap's tiles are decoded by the decode queue");
+    
+    //Run frames until the tiles are decoded and uploaded, the worker threads are given time to decode them
+    for(unsigned int i = 0; i < HEADLESS_TARGET_FPS * 10 && textureManager->GetPendingTextureLoadCount() > 0; i++)
+    {
+        usleep(1000);
+        RunFrame(platform);
+    }
+    RunFrame(platform);
+    Expect(textureManager->GetPendingTextureLoadCount() == 0 && asyncTileMap->GetResidentTileCount() == asyncTileMap->GetVisibleTileCount(), "A TileMap draws its tiles once they are resident");
+    scene->RemoveGameObject(asyncTileMap);
+    RunFrame(platform);
+    
+    //Streamed textures that weren't used this frame are evicted when the streaming budget is reduced
+    unsigned int streamingBudget = textureManager->GetStreamingBudget();
+    RunFrame(platform);
+    textureManager->SetStreamingBudget(0);
+    Expect(textureManager->GetStreamedTextureCount() == 0, "Streamed textures are evicted when the streaming budget is reduced");
+    textureManager->SetStreamingBudget(streamingBudget);
+    
+    //Cleanup the headless platform layer, it removes the Game services
+    delete platform;
+    
+    //Return the number of failures, zero if every expectation passed
+    printf("%u failures\n", s_Failures);
+    return s_Failures > 0 ? 1 : 0;
+}
\ No newline at end of file
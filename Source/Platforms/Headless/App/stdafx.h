@@ -0,0 +1,29 @@
+#ifndef GameDev2D_Headless_stdafx_h
+#define GameDev2D_Headless_stdafx_h
+
+//Headless prefix header, it is force included by the headless Makefile
+
+#include "glm.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#endif
@@ -0,0 +1,336 @@
+//
+//  Platform_Headless.cpp
+//  GameDev2D
+//
+
+#include "Platform_Headless.h"
+#include "../../Services/ServiceLocator.h"
+#include "../../Events/Platform/ResizeEvent.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+
+namespace GameDev2D
+{
+    Platform_Headless::Platform_Headless(const string& aResourceDirectory, unsigned int aWidth, unsigned int aHeight, int aFrameRate) : PlatformLayer("Platform_Headless", aFrameRate),
+        m_ResourceDirectory(aResourceDirectory),
+        m_InitialWidth(aWidth),
+        m_InitialHeight(aHeight),
+        m_Ticks(0)
+    {
+        m_VideoModeChangeInfo.width = 0;
+        m_VideoModeChangeInfo.height = 0;
+        m_VideoModeChangeInfo.needsChange = false;
+    }
+    
+    Platform_Headless::~Platform_Headless()
+    {
+    
+    }
+    
+    PlatformType Platform_Headless::GetPlatformType()
+    {
+        return PlatformType_Headless;
+    }
+    
+    void Platform_Headless::Init()
+    {
+        //Initialize the base class, it loads the Game services
+        PlatformLayer::Init();
+        
+        //Set the view's initial size
+        VideoModeInfo videoModeInfo;
+        videoModeInfo.width = m_InitialWidth;
+        videoModeInfo.height = m_InitialHeight;
+        videoModeInfo.needsChange = false;
+        ApplyVideoModeChanges(&videoModeInfo);
+    }
+    
+    bool Platform_Headless::Update()
+    {
+        //If the game isn't running anymore, return false
+        if(m_IsRunning == false)
+        {
+            return false;
+        }
+        
+        //Advance the simulated clock by one frame
+        DoSleep();
+        
+        //Handle video mode changes
+        if(m_VideoModeChangeInfo.needsChange == true)
+        {
+            ApplyVideoModeChanges(&m_VideoModeChangeInfo);
+            m_VideoModeChangeInfo.needsChange = false;
+        }
+        
+        //Calculate the tick (milleseconds since last update) and update the game
+        Tick();
+        
+        //Return wether the game is still running or not
+        return m_IsRunning;
+    }
+    
+    void Platform_Headless::Draw()
+    {
+        //If the application isn't suspended, clear the view
+        if(m_IsSuspended == false)
+        {
+            ServiceLocator::GetGraphics()->Clear();
+        }
+        
+        //Draw the services, there is no draw buffer to swap
+        ServiceLocator::DrawServices();
+    }
+    
+    void Platform_Headless::ResizeTo(unsigned int aWidth, unsigned int aHeight)
+    {
+        VideoModeInfo videoModeInfo;
+        videoModeInfo.width = aWidth;
+        videoModeInfo.height = aHeight;
+        SetVideoModeInfo(&videoModeInfo);
+    }
+    
+    void Platform_Headless::SetVideoModeInfo(VideoModeInfo* aVideoModeInfo)
+    {
+        m_VideoModeChangeInfo.needsChange = true;
+        m_VideoModeChangeInfo.width = aVideoModeInfo->width;
+        m_VideoModeChangeInfo.height = aVideoModeInfo->height;
+    }
+    
+    void Platform_Headless::ApplyVideoModeChanges(VideoModeInfo* aVideoModeInfo)
+    {
+        HandleViewportResize(aVideoModeInfo->width * GetScale(), aVideoModeInfo->height * GetScale());
+    }
+    
+    void Platform_Headless::HandleViewportResize(unsigned int aWidth, unsigned int aHeight)
+    {
+        //Safety check that the width and height have changed
+        if(aWidth != m_Width || aHeight != m_Height)
+        {
+            //Set the width and height
+            m_Width = aWidth;
+            m_Height = aHeight;
+            
+            //Resize the Graphics service
+            ServiceLocator::GetGraphics()->Resize(m_Width, m_Height);
+            
+            //Dispatch a Resize event
+            DispatchEvent(new ResizeEvent(vec2(m_Width, m_Height)));
+        }
+    }
+    
+    void Platform_Headless::DoSleep()
+    {
+        m_Ticks += m_RefreshInterval;
+    }
+    
+    bool Platform_Headless::HasMouseInput()
+    {
+        return false;
+    }
+    
+    bool Platform_Headless::HasKeyboardInput()
+    {
+        return false;
+    }
+    
+    bool Platform_Headless::HasTouchInput()
+    {
+        return false;
+    }
+    
+    bool Platform_Headless::HasControllerInput()
+    {
+        return false;
+    }
+    
+    bool Platform_Headless::HasAccelerometerInput()
+    {
+        return false;
+    }
+    
+    bool Platform_Headless::HasGyroscopeInput()
+    {
+        return false;
+    }
+    
+    bool Platform_Headless::IsMultipleTouchEnabled()
+    {
+        return false;
+    }
+    
+    void Platform_Headless::SetMultipleTouchEnabled(bool aEnabled)
+    {
+        //Unused on the headless platform
+    }
+    
+    bool Platform_Headless::IsAccelerometerEnabled()
+    {
+        return false;
+    }
+    
+    void Platform_Headless::SetAccelerometerEnabled(bool aEnabled)
+    {
+        //Unused on the headless platform
+    }
+    
+    void Platform_Headless::SetAccelerometerUpdateInterval(double aInterval)
+    {
+        //Unused on the headless platform
+    }
+    
+    bool Platform_Headless::IsGyroscopeEnabled()
+    {
+        return false;
+    }
+    
+    void Platform_Headless::SetGyroscopeEnabled(bool aEnabled)
+    {
+        //Unused on the headless platform
+    }
+    
+    void Platform_Headless::SetGyroscopeUpdateInterval(double aInterval)
+    {
+        //Unused on the headless platform
+    }
+    
+    string Platform_Headless::GetWorkingDirectory()
+    {
+        char currentDir[PATH_MAX];
+        if(getcwd(currentDir, PATH_MAX) == nullptr)
+        {
+            return string(".");
+        }
+        return string(currentDir);
+    }
+    
+    string Platform_Headless::GetApplicationDirectory()
+    {
+        return m_ResourceDirectory;
+    }
+    
+    string Platform_Headless::GetPathForResourceInDirectory(const char* aFileName, const char* aFileType, const char* aDirectory)
+    {
+        string path = string(GetApplicationDirectory());
+        path += "/Assets/";
+        path += string(aDirectory);
+        path += "/";
+        path += string(aFileName);
+        path += ".";
+        path += string(aFileType);
+        return path;
+    }
+    
+    bool Platform_Headless::DoesFileExistAtPath(const string& aPath)
+    {
+        struct stat fileStat;
+        return stat(aPath.c_str(), &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+    }
+    
+    const void* Platform_Headless::MapFile(const string& aPath, unsigned int& aSize)
+    {
+        //Open the file
+        aSize = 0;
+        int file = open(aPath.c_str(), O_RDONLY);
+        if(file == -1)
+        {
+            return nullptr;
+        }
+        
+        //Get the size of the file, an empty file can't be mapped
+        struct stat fileStat;
+        if(fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(file);
+            return nullptr;
+        }
+        
+        //Map the whole file, the mapping keeps the file open so it can be closed
+        void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(data == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        
+        //Set the size
+        aSize = (unsigned int)fileStat.st_size;
+        return data;
+    }
+    
+    void Platform_Headless::UnmapFile(const void* aData, unsigned int aSize)
+    {
+        if(aData != nullptr)
+        {
+            munmap((void*)aData, aSize);
+        }
+    }
+    
+    int Platform_Headless::PresentNativeDialogBox(const char* aTitle, const char* aMessage, NativeDialogType aType)
+    {
+        Log(VerbosityLevel_Debug, "%s: %s", aTitle, aMessage);
+        return 0;
+    }
+    
+    void Platform_Headless::PlatformName(string& aName)
+    {
+        struct utsname name;
+        aName = uname(&name) == 0 ? string(name.sysname) : "Headless";
+    }
+    
+    void Platform_Headless::PlatformModel(string& aModel)
+    {
+        aModel = "Headless";
+    }
+    
+    void Platform_Headless::PlatformVersion(string& aVersion)
+    {
+        struct utsname name;
+        aVersion = uname(&name) == 0 ? string(name.release) : "";
+    }
+    
+    unsigned long long Platform_Headless::MemoryInstalled()
+    {
+        return (unsigned long long)sysconf(_SC_PHYS_PAGES) * (unsigned long long)sysconf(_SC_PAGE_SIZE);
+    }
+    
+    unsigned long long Platform_Headless::DiskSpaceUsed()
+    {
+        return DiskSpaceTotal() - DiskSpaceFree();
+    }
+    
+    unsigned long long Platform_Headless::DiskSpaceFree()
+    {
+        struct statvfs fileSystem;
+        if(statvfs(GetWorkingDirectory().c_str(), &fileSystem) != 0)
+        {
+            return 0;
+        }
+        return (unsigned long long)fileSystem.f_bavail * fileSystem.f_frsize;
+    }
+    
+    unsigned long long Platform_Headless::DiskSpaceTotal()
+    {
+        struct statvfs fileSystem;
+        if(statvfs(GetWorkingDirectory().c_str(), &fileSystem) != 0)
+        {
+            return 0;
+        }
+        return (unsigned long long)fileSystem.f_blocks * fileSystem.f_frsize;
+    }
+    
+    unsigned int Platform_Headless::CpuCount()
+    {
+        return (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    
+    unsigned int Platform_Headless::GetTicks()
+    {
+        return m_Ticks;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+//
+//  Platform_Headless.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__Platform_Headless__
+#define __GameDev2D__Platform_Headless__
+
+#include "../PlatformLayer.h"
+
+
+namespace GameDev2D
+{
+    //The Platform_Headless class inherits from the PlatformLayer class. It runs the game loop without a window,
+    //input or audio, it is built with HEADLESS_OPENGL=1 so every GL call is recorded in the GLCommandLog. The
+    //ticks are simulated, each Update() advances the clock by exactly one frame at the target frame rate, that
+    //way every run of the same frames is deterministic. The resources are loaded from the resource directory.
+    class Platform_Headless : public PlatformLayer
+    {
+    public:
+        //The constructor takes in the directory the Assets directory is in, the view's size and the target frame rate
+        Platform_Headless(const string& resourceDirectory, unsigned int width, unsigned int height, int frameRate);
+        ~Platform_Headless();
+        
+        //Returns the Headless platform type
+        PlatformType GetPlatformType();
+        
+        //Initializes the PlatformLayer and the view's size
+        void Init();
+        
+        //Methods used to Update and Draw the application, inherited from PlatformLayer
+        bool Update();
+        void Draw();
+        
+        //Call this method to resize the headless view, inherited from PlatformLayer
+        void ResizeTo(unsigned int width, unsigned int height);
+        
+        //Sets the current video mode, the size is applied at the start of the next Update(), inherited from PlatformLayer
+        void SetVideoModeInfo(VideoModeInfo* videoModeInfo);
+        
+        //There is no input on the headless platform, inherited from PlatformLayer
+        bool HasMouseInput();
+        bool HasKeyboardInput();
+        bool HasTouchInput();
+        bool HasControllerInput();
+        bool HasAccelerometerInput();
+        bool HasGyroscopeInput();
+        bool IsMultipleTouchEnabled();
+        void SetMultipleTouchEnabled(bool enabled);
+        bool IsAccelerometerEnabled();
+        void SetAccelerometerEnabled(bool enabled);
+        void SetAccelerometerUpdateInterval(double interval);
+        bool IsGyroscopeEnabled();
+        void SetGyroscopeEnabled(bool enabled);
+        void SetGyroscopeUpdateInterval(double interval);
+        
+        //Returns the current directory, files are written to it, inherited from PlatformLayer
+        string GetWorkingDirectory();
+        
+        //Returns the resource directory, inherited from PlatformLayer
+        string GetApplicationDirectory();
+        
+        //Returns a path for a resource in a specific directory, inherited from PlatformLayer
+        string GetPathForResourceInDirectory(const char* fileName, const char* fileType, const char* directory);
+        
+        //Returns wether the file exists at the path, inherited from PlatformLayer
+        bool DoesFileExistAtPath(const string& path);
+        
+        //Maps and unmaps a file into memory as read only, inherited from PlatformLayer
+        const void* MapFile(const string& path, unsigned int& size);
+        void UnmapFile(const void* data, unsigned int size);
+        
+        //There are no dialog boxes, the message is logged and the first option is returned, inherited from PlatformLayer
+        int PresentNativeDialogBox(const char* title, const char* message, NativeDialogType type);
+        
+        //Returns the platform details, inherited from PlatformLayer
+        void PlatformName(string& name);
+        void PlatformModel(string& model);
+        void PlatformVersion(string& version);
+        unsigned long long MemoryInstalled();
+        unsigned long long DiskSpaceUsed();
+        unsigned long long DiskSpaceFree();
+        unsigned long long DiskSpaceTotal();
+        unsigned int CpuCount();
+        
+        //Returns the simulated number of ticks since the start of the application, inherited from PlatformLayer
+        unsigned int GetTicks();
+    
+    protected:
+        //Applies the size set in the SetVideoModeInfo() method, inherited from PlatformLayer
+        void ApplyVideoModeChanges(VideoModeInfo* videoModeInfo);
+        
+        //Resizes the Graphics service and dispatches a resize event, inherited from PlatformLayer
+        void HandleViewportResize(unsigned int width, unsigned int height);
+        
+        //The frames aren't throttled, the simulated clock advances by one frame each Update()
+        void DoSleep();
+    
+    private:
+        //Member variables
+        string m_ResourceDirectory;
+        unsigned int m_InitialWidth;
+        unsigned int m_InitialHeight;
+        unsigned int m_Ticks;
+        VideoModeInfo m_VideoModeChangeInfo;
+    };
+}
+
+#endif /* defined(__GameDev2D__Platform_Headless__) */
@@ -10,7 +10,7 @@
 #include "PlatformLayer.h"
 #include "../Services/ServiceLocator.h"
 #include "../../Game/Game.h"
-#if __APPLE__
+#if __APPLE__ || __linux__
 #include <unistd.h>
 #endif
 
@@ -30,6 +30,7 @@ namespace GameDev2D
         PlatformType_iOS,
         PlatformType_OSX,
         PlatformType_Win32,
+        PlatformType_Headless,
     };
     
     //Supported orientations (only iOS)
@@ -167,6 +168,13 @@ namespace GameDev2D
         //Returns wether the file exists at the path, abstract, must be implemented by an inheriting class
         virtual bool DoesFileExistAtPath(const string& path) = 0;
         
+        //Maps a file into memory as read only and sets the size of the file, returns null if the file couldn't be
+        //mapped. It is safe to call from a worker thread. Abstract, must be implemented by an inheriting class
+        virtual const void* MapFile(const string& path, unsigned int& size) = 0;
+        
+        //Unmaps a file that was mapped with MapFile(), abstract, must be implemented by an inheriting class
+        virtual void UnmapFile(const void* data, unsigned int size) = 0;
+        
         //Presents a platform specific native dialog box, abstract, must be implemented by an inheriting class
         virtual int PresentNativeDialogBox(const char* title, const char* message, NativeDialogType type) = 0;
  
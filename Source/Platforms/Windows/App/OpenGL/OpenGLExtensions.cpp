@@ -53,10 +53,13 @@ PFNGLGETSHADERIVPROC                glGetShaderiv = 0;
 PFNGLGETUNIFORMLOCATIONPROC         glGetUniformLocation = 0;
 
 PFNGLACTIVETEXTUREPROC              glActiveTexture = 0;
+PFNGLCOMPRESSEDTEXIMAGE2DPROC       glCompressedTexImage2D = 0;
+PFNGLGENERATEMIPMAPPROC             glGenerateMipmap = 0;
 
 PFNGLGENBUFFERSPROC                 glGenBuffers = 0;
 PFNGLBINDBUFFERPROC                 glBindBuffer = 0;
 PFNGLBUFFERDATAPROC                 glBufferData = 0;
+PFNGLBUFFERSUBDATAPROC              glBufferSubData = 0;
 PFNGLDELETEBUFFERSPROC              glDeleteBuffers = 0;
 
 PFNGLBLENDFUNCSEPARATEPROC          glBlendFuncSeparate = 0;
@@ -69,9 +72,14 @@ PFNGLFRAMEBUFFERTEXTURE2DPROC       glFramebufferTexture2D = 0;
 PFNGLCHECKFRAMEBUFFERSTATUSPROC     glCheckFramebufferStatus = 0;
 
 PFNGLVALIDATEPROGRAMPROC            glValidateProgram = 0;
+PFNGLGETPROGRAMBINARYPROC           glGetProgramBinary = 0;
+PFNGLPROGRAMBINARYPROC              glProgramBinary = 0;
+PFNGLPROGRAMPARAMETERIPROC          glProgramParameteri = 0;
 PFNGLBINDVERTEXARRAYPROC            glBindVertexArray = 0;
 PFNGLGENVERTEXARRAYSPROC            glGenVertexArrays = 0;
 PFNGLDELETEVERTEXARRAYSPROC         glDeleteVertexArrays = 0;
+PFNGLDRAWARRAYSINSTANCEDPROC        glDrawArraysInstanced = 0;
+PFNGLVERTEXATTRIBDIVISORPROC        glVertexAttribDivisor = 0;
 
 PFNGLFRAMEBUFFERRENDERBUFFERPROC    glFramebufferRenderbuffer = 0;
 PFNGLBINDRENDERBUFFERPROC           glBindRenderbuffer = 0;
@@ -137,10 +145,15 @@ void InitOpenGLExtensions()
     glGetUniformLocation            = (PFNGLGETUNIFORMLOCATIONPROC)         wglGetProcAddress( "glGetUniformLocation" );
 
     glActiveTexture                 = (PFNGLACTIVETEXTUREPROC)              wglGetProcAddress( "glActiveTexture" );
+    glCompressedTexImage2D          = (PFNGLCOMPRESSEDTEXIMAGE2DPROC)       wglGetProcAddress( "glCompressedTexImage2D" );
+    glGenerateMipmap                = (PFNGLGENERATEMIPMAPPROC)             wglGetProcAddress( "glGenerateMipmap" );
+    if( glGenerateMipmap == 0 )
+        glGenerateMipmap            = (PFNGLGENERATEMIPMAPPROC)             wglGetProcAddress( "glGenerateMipmapEXT" );
 
     glGenBuffers                    = (PFNGLGENBUFFERSPROC)                 wglGetProcAddress( "glGenBuffers" );
     glBindBuffer                    = (PFNGLBINDBUFFERPROC)                 wglGetProcAddress( "glBindBuffer" );
     glBufferData                    = (PFNGLBUFFERDATAPROC)                 wglGetProcAddress( "glBufferData" );
+    glBufferSubData                 = (PFNGLBUFFERSUBDATAPROC)              wglGetProcAddress( "glBufferSubData" );
     glDeleteBuffers                 = (PFNGLDELETEBUFFERSPROC)              wglGetProcAddress( "glDeleteBuffers" );
 
     glBlendFuncSeparate             = (PFNGLBLENDFUNCSEPARATEPROC)          wglGetProcAddress( "glBlendFuncSeparate" );
@@ -167,9 +180,14 @@ void InitOpenGLExtensions()
         glCheckFramebufferStatus    = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)     wglGetProcAddress( "glCheckFramebufferStatusEXT" );
 
     glValidateProgram               = (PFNGLVALIDATEPROGRAMPROC)            wglGetProcAddress( "glValidateProgram" );
+    glGetProgramBinary              = (PFNGLGETPROGRAMBINARYPROC)           wglGetProcAddress( "glGetProgramBinary" );
+    glProgramBinary                 = (PFNGLPROGRAMBINARYPROC)              wglGetProcAddress( "glProgramBinary" );
+    glProgramParameteri             = (PFNGLPROGRAMPARAMETERIPROC)          wglGetProcAddress( "glProgramParameteri" );
     glBindVertexArray               = (PFNGLBINDVERTEXARRAYPROC)            wglGetProcAddress( "glBindVertexArray" );
     glGenVertexArrays               = (PFNGLGENVERTEXARRAYSPROC)            wglGetProcAddress( "glGenVertexArrays" );
     glDeleteVertexArrays            = (PFNGLDELETEVERTEXARRAYSPROC)         wglGetProcAddress( "glDeleteVertexArrays" );
+    glDrawArraysInstanced           = (PFNGLDRAWARRAYSINSTANCEDPROC)        wglGetProcAddress( "glDrawArraysInstanced" );
+    glVertexAttribDivisor           = (PFNGLVERTEXATTRIBDIVISORPROC)        wglGetProcAddress( "glVertexAttribDivisor" );
 
     glFramebufferRenderbuffer       = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)    wglGetProcAddress( "glFramebufferRenderbuffer" );
     if( glFramebufferRenderbuffer == 0 )
@@ -59,10 +59,13 @@ extern PFNGLGETSHADERIVPROC                 glGetShaderiv;
 extern PFNGLGETUNIFORMLOCATIONPROC          glGetUniformLocation;
 
 extern PFNGLACTIVETEXTUREPROC               glActiveTexture;
+extern PFNGLCOMPRESSEDTEXIMAGE2DPROC        glCompressedTexImage2D;
+extern PFNGLGENERATEMIPMAPPROC              glGenerateMipmap;
 
 extern PFNGLGENBUFFERSPROC                  glGenBuffers;
 extern PFNGLBINDBUFFERPROC                  glBindBuffer;
 extern PFNGLBUFFERDATAPROC                  glBufferData;
+extern PFNGLBUFFERSUBDATAPROC               glBufferSubData;
 extern PFNGLDELETEBUFFERSPROC               glDeleteBuffers;
 
 extern PFNGLBLENDFUNCSEPARATEPROC           glBlendFuncSeparate;
@@ -75,11 +78,17 @@ extern PFNGLFRAMEBUFFERTEXTURE2DPROC        glFramebufferTexture2D;
 extern PFNGLCHECKFRAMEBUFFERSTATUSPROC      glCheckFramebufferStatus;
 
 extern PFNGLVALIDATEPROGRAMPROC             glValidateProgram;
+extern PFNGLGETPROGRAMBINARYPROC            glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC               glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC           glProgramParameteri;
 
 extern PFNGLBINDVERTEXARRAYPROC             glBindVertexArray;
 extern PFNGLGENVERTEXARRAYSPROC             glGenVertexArrays;
 extern PFNGLDELETEVERTEXARRAYSPROC          glDeleteVertexArrays;
 
+extern PFNGLDRAWARRAYSINSTANCEDPROC         glDrawArraysInstanced;
+extern PFNGLVERTEXATTRIBDIVISORPROC         glVertexAttribDivisor;
+
 extern PFNGLFRAMEBUFFERRENDERBUFFERPROC     glFramebufferRenderbuffer;
 extern PFNGLBINDRENDERBUFFERPROC            glBindRenderbuffer;
 extern PFNGLGENRENDERBUFFERSPROC            glGenRenderbuffers;
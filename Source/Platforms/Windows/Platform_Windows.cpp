@@ -379,6 +379,49 @@ namespace GameDev2D
         return (fileAttributes != INVALID_FILE_ATTRIBUTES && !(fileAttributes & FILE_ATTRIBUTE_DIRECTORY));
     }
 
+    const void* Platform_Windows::MapFile(const string& aPath, unsigned int& aSize)
+    {
+        //Open the file
+        aSize = 0;
+        HANDLE file = CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+        
+        //Get the size of the file, an empty file can't be mapped
+        DWORD fileSize = GetFileSize(file, NULL);
+        if(fileSize == INVALID_FILE_SIZE || fileSize == 0)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+        
+        //Create the file mapping and map a view of the whole file, the view keeps the file open so the handles can be closed
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        const void* data = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+        if(mapping != NULL)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        
+        //Set the size, if the file was mapped
+        if(data != NULL)
+        {
+            aSize = (unsigned int)fileSize;
+        }
+        return data;
+    }
+    
+    void Platform_Windows::UnmapFile(const void* aData, unsigned int aSize)
+    {
+        if(aData != nullptr)
+        {
+            UnmapViewOfFile(aData);
+        }
+    }
+    
     int Platform_Windows::PresentNativeDialogBox(const char* aTitle, const char* aMessage, NativeDialogType aType)
     {   
         //Determine the type of windows dialog box to display
@@ -109,6 +109,10 @@ namespace GameDev2D
         //Returns wether the file exists at the path, inherited from PlatformLayer
         bool DoesFileExistAtPath(const string& path);
         
+        //Maps and unmaps a file into memory as read only, inherited from PlatformLayer
+        const void* MapFile(const string& path, unsigned int& size);
+        void UnmapFile(const void* data, unsigned int size);
+        
         //Presents a platform specific native dialog box, inherited from PlatformLayer
         int PresentNativeDialogBox(const char* title, const char* message, NativeDialogType type);
 
@@ -111,6 +111,10 @@ namespace GameDev2D
         //Returns wether the file exists at the path, inherited from PlatformLayer
         bool DoesFileExistAtPath(const string& path);
         
+        //Maps and unmaps a file into memory as read only, inherited from PlatformLayer
+        const void* MapFile(const string& path, unsigned int& size);
+        void UnmapFile(const void* data, unsigned int size);
+        
         //Dispatches a low memory warning, if you receive this event you should unload any un-needed resources
         void LowMemoryWarning();
         
@@ -16,6 +16,10 @@
 #include <mach/mach.h>
 #include <mach/mach_host.h>
 #include <mach/mach_time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #import "GameView.h"
 #import <QuartzCore/QuartzCore.h>
 #import <CoreMotion/CoreMotion.h>
@@ -378,6 +382,44 @@ namespace GameDev2D
         return fileExists;
     }
     
+    const void* Platform_iOS::MapFile(const string& aPath, unsigned int& aSize)
+    {
+        //Open the file
+        aSize = 0;
+        int file = open(aPath.c_str(), O_RDONLY);
+        if(file == -1)
+        {
+            return nullptr;
+        }
+        
+        //Get the size of the file, an empty file can't be mapped
+        struct stat fileStat;
+        if(fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(file);
+            return nullptr;
+        }
+        
+        //Map the file, the mapping keeps the file open so it can be closed
+        void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(data == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        
+        aSize = (unsigned int)fileStat.st_size;
+        return data;
+    }
+    
+    void Platform_iOS::UnmapFile(const void* aData, unsigned int aSize)
+    {
+        if(aData != nullptr)
+        {
+            munmap((void*)aData, aSize);
+        }
+    }
+    
     void Platform_iOS::LowMemoryWarning()
     {
         //Dispatch event - low memory warning
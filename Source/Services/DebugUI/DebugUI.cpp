@@ -21,6 +21,50 @@
 #define DEBUG_UI_FONT_COLOR Color::BlackColor()
 #endif
 
+#ifndef DEBUG_UI_SPRITE_BATCH_STATS
+#define DEBUG_UI_SPRITE_BATCH_STATS 0
+#endif
+
+#ifndef DEBUG_UI_RENDER_QUEUE_STATS
+#define DEBUG_UI_RENDER_QUEUE_STATS 0
+#endif
+
+#ifndef DEBUG_UI_SHADER_VALIDATION_STATS
+#define DEBUG_UI_SHADER_VALIDATION_STATS 0
+#endif
+
+#ifndef DEBUG_UI_GRAPHICS_STATE_STATS
+#define DEBUG_UI_GRAPHICS_STATE_STATS 0
+#endif
+
+#ifndef DEBUG_UI_CULLING_STATS
+#define DEBUG_UI_CULLING_STATS 0
+#endif
+
+#ifndef DEBUG_UI_TEXTURE_STREAMING_STATS
+#define DEBUG_UI_TEXTURE_STREAMING_STATS 0
+#endif
+
+#ifndef DEBUG_UI_TEXTURE_UPLOAD_STATS
+#define DEBUG_UI_TEXTURE_UPLOAD_STATS 0
+#endif
+
+#ifndef DEBUG_UI_TEXTURE_MEMORY_STATS
+#define DEBUG_UI_TEXTURE_MEMORY_STATS 0
+#endif
+
+#ifndef DEBUG_UI_TEXTURE_CACHE_STATS
+#define DEBUG_UI_TEXTURE_CACHE_STATS 0
+#endif
+
+#ifndef DEBUG_UI_RENDER_TARGET_POOL_STATS
+#define DEBUG_UI_RENDER_TARGET_POOL_STATS 0
+#endif
+
+#ifndef DEBUG_UI_LABEL_STATS
+#define DEBUG_UI_LABEL_STATS 0
+#endif
+
 
 namespace GameDev2D
 {
@@ -42,6 +86,90 @@ namespace GameDev2D
             WatchValueUnsignedInt(ServiceLocator::GetInputManager(), CastDebugCallbackUnsignedInt(InputManager::GetNumberOfFingersTouching));
         }
         
+        //Add watch values for the number of SpriteBatch draw calls, quads, instances and render commands per frame
+        #if DEBUG_UI_SPRITE_BATCH_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackUnsignedInt(SpriteBatch::GetDrawCallsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackUnsignedInt(SpriteBatch::GetQuadsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackUnsignedInt(SpriteBatch::GetInstancedDrawCallsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackUnsignedInt(SpriteBatch::GetInstancesPerFrame));
+        WatchValueFloat(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackFloat(SpriteBatch::GetInstancesPerDrawPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackUnsignedInt(SpriteBatch::GetCommandsPerFrame));
+        WatchValueFloat(ServiceLocator::GetGraphics()->GetSpriteBatch(), CastDebugCallbackFloat(SpriteBatch::GetSortTimePerFrame));
+        #endif
+        
+        //Add watch values for the number of RenderQueue commands submitted and sorted per frame, and the sort time
+        #if DEBUG_UI_RENDER_QUEUE_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderQueue(), CastDebugCallbackUnsignedInt(RenderQueue::GetCommandsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderQueue(), CastDebugCallbackUnsignedInt(RenderQueue::GetSortedCommandsPerFrame));
+        WatchValueFloat(ServiceLocator::GetGraphics()->GetRenderQueue(), CastDebugCallbackFloat(RenderQueue::GetSortTimePerFrame));
+        #endif
+        
+        //Add watch values for the number of shader validations issued and cached per frame
+        #if DEBUG_UI_SHADER_VALIDATION_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetShaderManager(), CastDebugCallbackUnsignedInt(ShaderManager::GetValidationsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetShaderManager(), CastDebugCallbackUnsignedInt(ShaderManager::GetCachedValidationsPerFrame));
+        #endif
+        
+        //Add watch values for the number of open gl state changes issued and filtered per frame
+        #if DEBUG_UI_GRAPHICS_STATE_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetStateChangesPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetFilteredStateChangesPerFrame));
+        #endif
+        
+        //Add watch values for the number of GameObjects culled and drawn per frame
+        #if DEBUG_UI_CULLING_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetCulledObjectsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetDrawnObjectsPerFrame));
+        #endif
+        
+        //Add watch values for the streamed texture memory, count, and the number of streamed textures loaded and evicted per frame
+        #if DEBUG_UI_TEXTURE_STREAMING_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetStreamingMemory));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetStreamedTextureCount));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetStreamedLoadsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetStreamedEvictionsPerFrame));
+        #endif
+        
+        //Add watch values for the pending asynchronous texture loads, and the number of textures and bytes uploaded per frame
+        #if DEBUG_UI_TEXTURE_UPLOAD_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetPendingTextureLoadCount));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureUploadsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureUploadBytesPerFrame));
+        #endif
+        
+        //Add watch values for the GPU memory used by the textures, and the memory they would use uncompressed
+        #if DEBUG_UI_TEXTURE_MEMORY_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetResidentTextureMemory));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetUncompressedTextureMemory));
+        #endif
+        
+        //Add watch values for the loaded and cached texture memory, and the texture cache hits, misses, evictions and reloads
+        #if DEBUG_UI_TEXTURE_CACHE_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureMemory));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetCachedTextureMemory));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureCacheHits));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureCacheMisses));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureCacheEvictions));
+        WatchValueUnsignedInt(ServiceLocator::GetTextureManager(), CastDebugCallbackUnsignedInt(TextureManager::GetTextureCacheReloads));
+        #endif
+        
+        //Add watch values for the render target pool's occupancy and allocation churn
+        #if DEBUG_UI_RENDER_TARGET_POOL_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderTargetPool(), CastDebugCallbackUnsignedInt(RenderTargetPool::GetActiveRenderTargetCount));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderTargetPool(), CastDebugCallbackUnsignedInt(RenderTargetPool::GetFreeRenderTargetCount));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderTargetPool(), CastDebugCallbackUnsignedInt(RenderTargetPool::GetCreatedRenderTargetsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderTargetPool(), CastDebugCallbackUnsignedInt(RenderTargetPool::GetReusedRenderTargetsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics()->GetRenderTargetPool(), CastDebugCallbackUnsignedInt(RenderTargetPool::GetDeletedRenderTargetsPerFrame));
+        #endif
+        
+        //Add watch values for the number of Label glyph buffer rebuilds, updates, uploaded glyphs and skipped text changes per frame
+        #if DEBUG_UI_LABEL_STATS
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetLabelRebuildsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetLabelUpdatesPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetLabelGlyphUploadsPerFrame));
+        WatchValueUnsignedInt(ServiceLocator::GetGraphics(), CastDebugCallbackUnsignedInt(Graphics::GetLabelSkippedTextChangesPerFrame));
+        #endif
+        
         //We need to listen for resize events to ensure the labels are position in the proper place
         ServiceLocator::GetPlatformLayer()->AddEventListener(this, RESIZE_EVENT);
         
@@ -10,6 +10,16 @@
 #include "../ServiceLocator.h"
 #include "../ShaderManager/ShaderManager.h"
 #include "../../Platforms/PlatformLayer.h"
+#include "../../Core/GameObject.h"
+
+
+#ifndef CAMERA_CULLING_ENABLED
+#define CAMERA_CULLING_ENABLED 0
+#endif
+
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
+#endif
 
 
 namespace GameDev2D
@@ -27,9 +37,55 @@ namespace GameDev2D
         m_ActiveCamera(nullptr),
         m_ViewportWidth(0),
         m_ViewportHeight(0),
-        m_BoundTextureId(0),
-        m_BoundVertexArray(0)
+        m_ActiveTextureUnit(0),
+        m_BoundVertexArray(0),
+        m_DeletedObjectCount(0),
+        m_ActiveProgram(0),
+        m_BoundArrayBuffer(0),
+        m_BlendingEnabled(false),
+        m_SourceBlending(GL_ONE),
+        m_DestinationBlending(GL_ZERO),
+        m_ScissorTestEnabled(false),
+        m_ScissorRect(-1, -1, -1, -1),
+        m_GLClearColor(0.0f, 0.0f, 0.0f, 0.0f),
+        m_StateChanges(0),
+        m_FilteredStateChanges(0),
+        m_StateChangesPerFrame(0),
+        m_FilteredStateChangesPerFrame(0),
+        m_CullingEnabled(CAMERA_CULLING_ENABLED),
+        m_CulledObjects(0),
+        m_DrawnObjects(0),
+        m_CulledObjectsPerFrame(0),
+        m_DrawnObjectsPerFrame(0),
+        m_LabelRebuilds(0),
+        m_LabelUpdates(0),
+        m_LabelGlyphUploads(0),
+        m_LabelSkippedTextChanges(0),
+        m_LabelRebuildsPerFrame(0),
+        m_LabelUpdatesPerFrame(0),
+        m_LabelGlyphUploadsPerFrame(0),
+        m_LabelSkippedTextChangesPerFrame(0),
+        m_SpriteBatch(nullptr),
+        m_RenderQueue(nullptr),
+        m_RenderTargetPool(nullptr),
+        m_UnitQuadBuffer(0),
+        m_MaxTextureAnisotropy(1.0f)
     {
+        //Initialize the bound texture ids for each texture unit
+        for(unsigned int i = 0; i < GRAPHICS_MAX_TEXTURE_UNITS; i++)
+        {
+            m_BoundTextureIds[i] = 0;
+        }
+        
+        //Create the SpriteBatch, it has to exist before any render target is set
+        m_SpriteBatch = new SpriteBatch();
+        
+        //Create the RenderQueue
+        m_RenderQueue = new RenderQueue();
+        
+        //Create the RenderTargetPool
+        m_RenderTargetPool = new RenderTargetPool();
+        
         #if TARGET_OS_IPHONE
         m_MainRenderTarget = new RenderTarget();
         SetActiveRenderTarget(m_MainRenderTarget);
@@ -40,10 +96,55 @@ namespace GameDev2D
         //Create the default camera and set it as the active camera
         m_DefaultCamera = new Camera();
         m_ActiveCamera = m_DefaultCamera;
+        
+        //Query the compressed texture formats, they don't change so they only have to be queried once
+        GLint compressedFormatCount = 0;
+        glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &compressedFormatCount);
+        if(compressedFormatCount > 0)
+        {
+            vector<GLint> compressedFormats(compressedFormatCount);
+            glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, &compressedFormats[0]);
+            m_CompressedTextureFormats.assign(compressedFormats.begin(), compressedFormats.end());
+        }
+        Log(VerbosityLevel_Graphics, "%i compressed texture formats are supported", compressedFormatCount);
+        
+        //Query the maximum texture anisotropy, if anisotropic filtering isn't supported the query sets an error
+        GLfloat maxAnisotropy = 1.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+        if(glGetError() == GL_NO_ERROR && maxAnisotropy > 1.0f)
+        {
+            m_MaxTextureAnisotropy = maxAnisotropy;
+        }
+        Log(VerbosityLevel_Graphics, "Max texture anisotropy: %f", m_MaxTextureAnisotropy);
+        
+        //Texture data is tightly packed, the rows of RGB images and of the smallest mipmap levels
+        //aren't a multiple of 4 bytes, so OpenGL mustn't expect the rows to be padded to 4 bytes
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     }
     
     Graphics::~Graphics()
     {
+        //Delete the SpriteBatch
+        SafeDelete(m_SpriteBatch);
+        
+        //Delete the RenderQueue
+        SafeDelete(m_RenderQueue);
+        
+        //Delete the RenderTargetPool, and the render targets in it
+        SafeDelete(m_RenderTargetPool);
+        
+        //Delete the shared unit quad buffer
+        if(m_UnitQuadBuffer != 0)
+        {
+            if(m_BoundArrayBuffer == m_UnitQuadBuffer)
+            {
+                BindArrayBuffer(0);
+            }
+            
+            glDeleteBuffers(1, &m_UnitQuadBuffer);
+            m_UnitQuadBuffer = 0;
+        }
+        
         //Delete the 'main' render target, only used on iOS
         #if TARGET_OS_IPHONE
         SafeDelete(m_MainRenderTarget);
@@ -60,6 +161,16 @@ namespace GameDev2D
     
     void Graphics::Clear()
     {
+        //Set the clear color, the active render target has its own clear color
+        if(m_ActiveRenderTarget != nullptr)
+        {
+            SetGLClearColor(m_ActiveRenderTarget->GetClearColor());
+        }
+        else
+        {
+            SetGLClearColor(GetClearColor());
+        }
+    
         glClear(GL_COLOR_BUFFER_BIT);
     }
     
@@ -69,7 +180,6 @@ namespace GameDev2D
         m_MainRenderTarget->SetClearColor(aColor);
         #else
         m_ClearColor = aColor;
-        glClearColor(m_ClearColor.Red(), m_ClearColor.Green(), m_ClearColor.Blue(), m_ClearColor.Alpha());
         #endif
     }
     
@@ -144,7 +254,7 @@ namespace GameDev2D
     void Graphics::ResetViewport()
     {
         glViewport(0, 0, m_ViewportWidth, m_ViewportHeight);
-        glScissor(0, 0,  m_ViewportWidth, m_ViewportHeight);
+        SetScissorRect(0, 0, m_ViewportWidth, m_ViewportHeight);
     }
     
     void Graphics::SetViewportSize(int aWidth, int aHeight)
@@ -182,6 +292,10 @@ namespace GameDev2D
         //Safety check that the render target isn't null and that it isn't already set
         if(aRenderTarget != m_ActiveRenderTarget)
         {
+            //Flush any batched sprites and submit the render commands, they belong to the previous render target
+            m_SpriteBatch->Flush();
+            m_RenderQueue->Submit();
+            
             //Safety check the active render target and unbind it
             if(m_ActiveRenderTarget != nullptr)
             {
@@ -218,8 +332,11 @@ namespace GameDev2D
     
     void Graphics::SetActiveCamera(Camera* aCamera)
     {
-        if(aCamera != nullptr)
+        if(aCamera != nullptr && aCamera != m_ActiveCamera)
         {
+            //Flush any batched sprites, they were batched using the previous camera
+            m_SpriteBatch->Flush();
+            
             m_ActiveCamera = aCamera;
         }
     }
@@ -231,14 +348,18 @@ namespace GameDev2D
     
     void Graphics::PushScissorClip(float aX, float aY, float aWidth, float aHeight)
     {
+        //Flush any batched sprites and submit the render commands before the clipping rect changes
+        m_SpriteBatch->Flush();
+        m_RenderQueue->Submit();
+        
         //If this is the first scissor clip, enable scissor clipping
         if(m_ScissorStack.size() == 0)
         {
-            glEnable(GL_SCISSOR_TEST);
+            SetScissorTestEnabled(true);
         }
         
         //Set the scissor clipping rect
-        glScissor((GLint)aX, (GLint)aY, (GLsizei)aWidth, (GLsizei)aHeight);
+        SetScissorRect((int)aX, (int)aY, (int)aWidth, (int)aHeight);
         Log(VerbosityLevel_Graphics, "Push scissor clip: (%f, %f, %f, %f)", aX, aY, aWidth, aHeight);
         
         //Push the scissor clip onto the scissor stack
@@ -247,6 +368,10 @@ namespace GameDev2D
     
     void Graphics::PopScissorClip()
     {
+        //Flush any batched sprites and submit the render commands before the clipping rect changes
+        m_SpriteBatch->Flush();
+        m_RenderQueue->Submit();
+        
         //Pop back the scissor stack
         m_ScissorStack.pop_back();
         Log(VerbosityLevel_Graphics, "Pop scissor clip");
@@ -254,45 +379,107 @@ namespace GameDev2D
         //Is there still clipping rects on the scissor stack?
         if(m_ScissorStack.size() > 0)
         {
-            //Set the front scissor rect
-            vec2 position = m_ScissorStack.front().first;
-            vec2 size = m_ScissorStack.front().first;
-            glScissor((GLint)position.x, (GLint)position.y, (GLsizei)size.x, (GLsizei)size.y);
+            //Set the back scissor rect
+            vec2 position = m_ScissorStack.back().first;
+            vec2 size = m_ScissorStack.back().second;
+            SetScissorRect((int)position.x, (int)position.y, (int)size.x, (int)size.y);
         }
         else
         {
             //Disable the scissor test
-            glDisable(GL_SCISSOR_TEST);
+            SetScissorTestEnabled(false);
         }
     }
     
-    void Graphics::BindTexture(Texture* aTexture)
+    void Graphics::BindTexture(Texture* aTexture, unsigned int aTextureUnit)
     {
-        //Safety check the Texture object
-        if(aTexture != nullptr)
+        //Safety check the texture unit
+        if(aTextureUnit >= GRAPHICS_MAX_TEXTURE_UNITS)
         {
-            //Get the texture id from the Texture object
-            unsigned int textureId = aTexture->GetId();
-            
-            //Bind the texture id (if its not aleady bound)
-            if(textureId != m_BoundTextureId)
-            {
-                m_BoundTextureId = textureId;
-                glBindTexture(GL_TEXTURE_2D, m_BoundTextureId);
-                Log(VerbosityLevel_Graphics, "Bind texture: %u", m_BoundTextureId);
-            }
+            Error(false, "Failed to bind texture, texture unit %u is out of range", aTextureUnit);
+            return;
+        }
+    
+        //Get the texture id from the Texture object, a null Texture object unbinds the texture
+        unsigned int textureId = aTexture != nullptr ? aTexture->GetId() : 0;
+        
+        //Bind the texture id (if its not aleady bound)
+        if(textureId != m_BoundTextureIds[aTextureUnit])
+        {
+            SetActiveTextureUnit(aTextureUnit);
+            m_BoundTextureIds[aTextureUnit] = textureId;
+            glBindTexture(GL_TEXTURE_2D, textureId);
+            m_StateChanges++;
+            Log(VerbosityLevel_Graphics, "Bind texture: %u", textureId);
         }
         else
         {
-            //Unbind the texture
-            m_BoundTextureId = 0;
-            glBindTexture(GL_TEXTURE_2D, m_BoundTextureId);
+            m_FilteredStateChanges++;
         }
     }
     
-    unsigned int Graphics::GetBoundTextureId()
+    unsigned int Graphics::GetBoundTextureId(unsigned int aTextureUnit)
     {
-        return m_BoundTextureId;
+        if(aTextureUnit < GRAPHICS_MAX_TEXTURE_UNITS)
+        {
+            return m_BoundTextureIds[aTextureUnit];
+        }
+        return 0;
+    }
+    
+    void Graphics::SetActiveTextureUnit(unsigned int aTextureUnit)
+    {
+        if(aTextureUnit != m_ActiveTextureUnit)
+        {
+            m_ActiveTextureUnit = aTextureUnit;
+            glActiveTexture(GL_TEXTURE0 + m_ActiveTextureUnit);
+            m_StateChanges++;
+            Log(VerbosityLevel_Graphics, "Active texture unit: %u", m_ActiveTextureUnit);
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+    }
+    
+    void Graphics::UseProgram(unsigned int aProgram)
+    {
+        if(aProgram != m_ActiveProgram)
+        {
+            m_ActiveProgram = aProgram;
+            glUseProgram(m_ActiveProgram);
+            m_StateChanges++;
+            Log(VerbosityLevel_Graphics, "Use program: %u", m_ActiveProgram);
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+    }
+    
+    unsigned int Graphics::GetActiveProgram()
+    {
+        return m_ActiveProgram;
+    }
+    
+    void Graphics::BindArrayBuffer(unsigned int aArrayBuffer)
+    {
+        if(aArrayBuffer != m_BoundArrayBuffer)
+        {
+            m_BoundArrayBuffer = aArrayBuffer;
+            glBindBuffer(GL_ARRAY_BUFFER, m_BoundArrayBuffer);
+            m_StateChanges++;
+            Log(VerbosityLevel_Graphics, "Bind array buffer: %u", m_BoundArrayBuffer);
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+    }
+    
+    unsigned int Graphics::GetBoundArrayBuffer()
+    {
+        return m_BoundArrayBuffer;
     }
     
     void Graphics::BindVertexArray(unsigned int aVertexArray)
@@ -301,8 +488,13 @@ namespace GameDev2D
         {
             m_BoundVertexArray = aVertexArray;
             glBindVertexArray(m_BoundVertexArray);
+            m_StateChanges++;
             Log(VerbosityLevel_Graphics, "Bind vertex array: %u", aVertexArray);
         }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
     }
     
     unsigned int Graphics::GetBoundVertexArray()
@@ -310,26 +502,342 @@ namespace GameDev2D
         return m_BoundVertexArray;
     }
     
+    void Graphics::DeleteVertexArray(unsigned int& aVertexArray)
+    {
+        //Safety check the vertex array
+        if(aVertexArray == 0)
+        {
+            return;
+        }
+        
+        //Submit the render commands first, if any of them still draw with the vertex array
+        if(m_RenderQueue != nullptr && m_RenderQueue->HasPendingCommands(aVertexArray) == true)
+        {
+            m_RenderQueue->Submit();
+        }
+        
+        //If the vertex array we are about to delete is bound, we need to unbind it
+        if(aVertexArray == m_BoundVertexArray)
+        {
+            BindVertexArray(0);
+        }
+        
+        //Delete the vertex array
+        glDeleteVertexArrays(1, &aVertexArray);
+        aVertexArray = 0;
+        m_DeletedObjectCount++;
+    }
+    
+    void Graphics::DeleteTexture(unsigned int& aTextureId)
+    {
+        //Safety check the texture id
+        if(aTextureId == 0)
+        {
+            return;
+        }
+        
+        //Submit the render commands first, they could still draw with the texture
+        if(m_RenderQueue != nullptr)
+        {
+            m_RenderQueue->Submit();
+        }
+        
+        //If the texture we are about to delete is bound to any texture unit, we need to unbind it
+        for(unsigned int i = 0; i < GRAPHICS_MAX_TEXTURE_UNITS; i++)
+        {
+            if(aTextureId == m_BoundTextureIds[i])
+            {
+                BindTexture(nullptr, i);
+            }
+        }
+        
+        //Delete the texture
+        glDeleteTextures(1, &aTextureId);
+        aTextureId = 0;
+        m_DeletedObjectCount++;
+    }
+    
+    unsigned int Graphics::GetDeletedObjectCount()
+    {
+        return m_DeletedObjectCount;
+    }
+    
     void Graphics::EnableBlending(GLenum aSourceBlending, GLenum aDestinationBlending)
     {
-        glBlendFunc(aSourceBlending, aDestinationBlending);
-        glEnable(GL_BLEND);
-        Log(VerbosityLevel_Graphics, "Blending enabled");
+        //Set the blend function, if it has changed
+        if(aSourceBlending != m_SourceBlending || aDestinationBlending != m_DestinationBlending)
+        {
+            m_SourceBlending = aSourceBlending;
+            m_DestinationBlending = aDestinationBlending;
+            glBlendFunc(m_SourceBlending, m_DestinationBlending);
+            m_StateChanges++;
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+        
+        //Enable blending, if it isn't already enabled
+        if(m_BlendingEnabled == false)
+        {
+            m_BlendingEnabled = true;
+            glEnable(GL_BLEND);
+            m_StateChanges++;
+            Log(VerbosityLevel_Graphics, "Blending enabled");
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
     }
     
     void Graphics::DisableBlending()
     {
-        glDisable(GL_BLEND);
-        Log(VerbosityLevel_Graphics, "Blending disabled");
+        //Disable blending, if it isn't already disabled
+        if(m_BlendingEnabled == true)
+        {
+            m_BlendingEnabled = false;
+            glDisable(GL_BLEND);
+            m_StateChanges++;
+            Log(VerbosityLevel_Graphics, "Blending disabled");
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
     }
     
-    bool Graphics::CanUpdate()
+    unsigned int Graphics::GetStateChangesPerFrame()
     {
+        return m_StateChangesPerFrame;
+    }
+    
+    unsigned int Graphics::GetFilteredStateChangesPerFrame()
+    {
+        return m_FilteredStateChangesPerFrame;
+    }
+    
+    bool Graphics::IsCulled(GameObject* aGameObject)
+    {
+        //Is culling enabled and is there an active camera
+        if(m_CullingEnabled == true && m_ActiveCamera != nullptr)
+        {
+            //Get the camera's view bounds and the GameObject's world bounds, if either is unknown don't cull the GameObject
+            BoundingBox viewBounds = m_ActiveCamera->GetViewBounds();
+            BoundingBox worldBounds;
+            if(IsBoundingBoxEmpty(viewBounds) == false && aGameObject->GetWorldBounds(worldBounds) == true)
+            {
+                //If the bounds don't overlap the GameObject is culled
+                if(DoBoundingBoxesIntersect(viewBounds, worldBounds) == false)
+                {
+                    m_CulledObjects++;
+                    return true;
+                }
+            }
+        }
+        
+        //The GameObject will be drawn
+        m_DrawnObjects++;
         return false;
     }
     
+    void Graphics::SetCullingEnabled(bool aCullingEnabled)
+    {
+        m_CullingEnabled = aCullingEnabled;
+    }
+    
+    bool Graphics::IsCullingEnabled()
+    {
+        return m_CullingEnabled;
+    }
+    
+    unsigned int Graphics::GetCulledObjectsPerFrame()
+    {
+        return m_CulledObjectsPerFrame;
+    }
+    
+    unsigned int Graphics::GetDrawnObjectsPerFrame()
+    {
+        return m_DrawnObjectsPerFrame;
+    }
+    
+    void Graphics::LabelGlyphBufferRebuilt(unsigned int aGlyphCount)
+    {
+        m_LabelRebuilds++;
+        m_LabelGlyphUploads += aGlyphCount;
+    }
+    
+    void Graphics::LabelGlyphBufferUpdated(unsigned int aGlyphCount)
+    {
+        m_LabelUpdates++;
+        m_LabelGlyphUploads += aGlyphCount;
+    }
+    
+    void Graphics::LabelTextChangeSkipped()
+    {
+        m_LabelSkippedTextChanges++;
+    }
+    
+    unsigned int Graphics::GetLabelRebuildsPerFrame()
+    {
+        return m_LabelRebuildsPerFrame;
+    }
+    
+    unsigned int Graphics::GetLabelUpdatesPerFrame()
+    {
+        return m_LabelUpdatesPerFrame;
+    }
+    
+    unsigned int Graphics::GetLabelGlyphUploadsPerFrame()
+    {
+        return m_LabelGlyphUploadsPerFrame;
+    }
+    
+    unsigned int Graphics::GetLabelSkippedTextChangesPerFrame()
+    {
+        return m_LabelSkippedTextChangesPerFrame;
+    }
+    
+    SpriteBatch* Graphics::GetSpriteBatch()
+    {
+        return m_SpriteBatch;
+    }
+    
+    RenderQueue* Graphics::GetRenderQueue()
+    {
+        return m_RenderQueue;
+    }
+    
+    RenderTargetPool* Graphics::GetRenderTargetPool()
+    {
+        return m_RenderTargetPool;
+    }
+    
+    bool Graphics::IsCompressedTextureFormatSupported(unsigned int aCompressedFormat)
+    {
+        return find(m_CompressedTextureFormats.begin(), m_CompressedTextureFormats.end(), aCompressedFormat) != m_CompressedTextureFormats.end();
+    }
+    
+    float Graphics::GetMaxTextureAnisotropy()
+    {
+        return m_MaxTextureAnisotropy;
+    }
+    
+    unsigned int Graphics::GetUnitQuadBuffer()
+    {
+        //If the unit quad buffer hasn't been created yet, create it
+        if(m_UnitQuadBuffer == 0)
+        {
+            //The unit quad's vertices, in the same order as the TextureFrame's triangle strip
+            const TextureFrameVertex vertices[TEXTURE_FRAME_VERTEX_COUNT] =
+            {
+                { 0.0f, 0.0f, 0.0f, 0.0f },
+                { 1.0f, 0.0f, 1.0f, 0.0f },
+                { 0.0f, 1.0f, 0.0f, 1.0f },
+                { 1.0f, 1.0f, 1.0f, 1.0f }
+            };
+            
+            //Generate the buffer and upload the vertices, they will never change
+            glGenBuffers(1, &m_UnitQuadBuffer);
+            BindArrayBuffer(m_UnitQuadBuffer);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        }
+        
+        return m_UnitQuadBuffer;
+    }
+    
+    void Graphics::Update(double aDelta)
+    {
+        //Reset the SpriteBatch's per frame stats
+        m_SpriteBatch->ResetFrameStats();
+        
+        //Reset the RenderQueue's per frame stats
+        m_RenderQueue->ResetFrameStats();
+        
+        //Reset the RenderTargetPool's per frame stats
+        m_RenderTargetPool->ResetFrameStats();
+        
+        //Store the last frame's state change stats and reset the counters
+        m_StateChangesPerFrame = m_StateChanges;
+        m_FilteredStateChangesPerFrame = m_FilteredStateChanges;
+        m_StateChanges = 0;
+        m_FilteredStateChanges = 0;
+        
+        //Store the last frame's culling stats and reset the counters
+        m_CulledObjectsPerFrame = m_CulledObjects;
+        m_DrawnObjectsPerFrame = m_DrawnObjects;
+        m_CulledObjects = 0;
+        m_DrawnObjects = 0;
+        
+        //Store the last frame's Label stats and reset the counters
+        m_LabelRebuildsPerFrame = m_LabelRebuilds;
+        m_LabelUpdatesPerFrame = m_LabelUpdates;
+        m_LabelGlyphUploadsPerFrame = m_LabelGlyphUploads;
+        m_LabelSkippedTextChangesPerFrame = m_LabelSkippedTextChanges;
+        m_LabelRebuilds = 0;
+        m_LabelUpdates = 0;
+        m_LabelGlyphUploads = 0;
+        m_LabelSkippedTextChanges = 0;
+    }
+    
+    bool Graphics::CanUpdate()
+    {
+        return true;
+    }
+    
     bool Graphics::CanDraw()
     {
         return false;
     }
+    
+    void Graphics::SetScissorTestEnabled(bool aEnabled)
+    {
+        if(aEnabled != m_ScissorTestEnabled)
+        {
+            m_ScissorTestEnabled = aEnabled;
+            if(m_ScissorTestEnabled == true)
+            {
+                glEnable(GL_SCISSOR_TEST);
+            }
+            else
+            {
+                glDisable(GL_SCISSOR_TEST);
+            }
+            m_StateChanges++;
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+    }
+    
+    void Graphics::SetScissorRect(int aX, int aY, int aWidth, int aHeight)
+    {
+        ivec4 scissorRect(aX, aY, aWidth, aHeight);
+        if(scissorRect != m_ScissorRect)
+        {
+            m_ScissorRect = scissorRect;
+            glScissor((GLint)aX, (GLint)aY, (GLsizei)aWidth, (GLsizei)aHeight);
+            m_StateChanges++;
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+    }
+    
+    void Graphics::SetGLClearColor(Color aColor)
+    {
+        vec4 clearColor(aColor.Red(), aColor.Green(), aColor.Blue(), aColor.Alpha());
+        if(clearColor != m_GLClearColor)
+        {
+            m_GLClearColor = clearColor;
+            glClearColor(m_GLClearColor.r, m_GLClearColor.g, m_GLClearColor.b, m_GLClearColor.a);
+            m_StateChanges++;
+        }
+        else
+        {
+            m_FilteredStateChanges++;
+        }
+    }
 }
@@ -18,6 +18,9 @@
 #include "../../Graphics/Textures/Texture.h"
 #include "../../Graphics/Textures/TextureFrame.h"
 #include "../../Graphics/Primitives/Primitives.h"
+#include "SpriteBatch.h"
+#include "RenderQueue.h"
+#include "RenderTargetPool.h"
 #include "matrix_transform.hpp"
 
 
@@ -25,9 +28,18 @@ using namespace glm;
 
 namespace GameDev2D
 {
+    //Forward declarations
+    class GameObject;
+    
+    //The number of texture units the Graphics service keeps track of
+    const unsigned int GRAPHICS_MAX_TEXTURE_UNITS = 8;
+
     //The Graphics game service is responsible for clearing the back buffer, managing
     //the active RenderTarget and Camera, resizing the viewport and backbuffer. Managing
     //a clipping rect stack and the currently bound texture and vertex array object.
+    //The Graphics service also shadows the open gl state it manages (shader program,
+    //blending, array buffer, textures, scissor and clear color), redundant state changes
+    //are filtered out and never reach open gl.
     class Graphics : public GameService
     {
     public:
@@ -84,11 +96,26 @@ namespace GameDev2D
         //Pops the last clipping rect off the clipping stack
         void PopScissorClip();
     
-        //Bind the open gl texture id associated with the Texture object
-        void BindTexture(Texture* texture);
+        //Bind the open gl texture id associated with the Texture object, to a texture unit
+        void BindTexture(Texture* texture, unsigned int textureUnit = 0);
+        
+        //Returns the currently bound texture id for a texture unit
+        unsigned int GetBoundTextureId(unsigned int textureUnit = 0);
+        
+        //Sets the active open gl texture unit
+        void SetActiveTextureUnit(unsigned int textureUnit);
+        
+        //Uses an open gl shader program
+        void UseProgram(unsigned int program);
         
-        //Returns the currently bound texture id
-        unsigned int GetBoundTextureId();
+        //Returns the shader program currently in use
+        unsigned int GetActiveProgram();
+        
+        //Binds an open gl array buffer
+        void BindArrayBuffer(unsigned int arrayBuffer);
+        
+        //Returns the currently bound array buffer
+        unsigned int GetBoundArrayBuffer();
         
         //Binds an open gl vertex array
         void BindVertexArray(unsigned int vertexArray);
@@ -96,15 +123,80 @@ namespace GameDev2D
         //Returns the currently bound vertex array
         unsigned int GetBoundVertexArray();
         
+        //Deletes an open gl vertex array or texture, and unbinds it if it is bound. Open gl reuses deleted names, the
+        //Shaders compare the deleted object count to know when their cached validation results are no longer valid
+        void DeleteVertexArray(unsigned int& vertexArray);
+        void DeleteTexture(unsigned int& textureId);
+        
+        //Returns the number of vertex arrays and textures that were deleted
+        unsigned int GetDeletedObjectCount();
+        
         //Enables and disables open gl alpha blending
         void EnableBlending(GLenum sourceBlending = GL_SRC_ALPHA, GLenum destinationBlending = GL_ONE_MINUS_SRC_ALPHA);
         void DisableBlending();
+        
+        //Returns the number of open gl state changes that were issued and filtered out last frame
+        unsigned int GetStateChangesPerFrame();
+        unsigned int GetFilteredStateChangesPerFrame();
+        
+        //Returns wether a GameObject, and all its children, is outside the active Camera's view and shouldn't be drawn.
+        //GameObjects with unknown bounds are never culled. Keeps track of the culled and drawn GameObjects
+        bool IsCulled(GameObject* gameObject);
+        
+        //Sets wether GameObjects outside the active Camera's view are culled
+        void SetCullingEnabled(bool cullingEnabled);
+        bool IsCullingEnabled();
+        
+        //Returns the number of GameObjects that were culled and drawn last frame
+        unsigned int GetCulledObjectsPerFrame();
+        unsigned int GetDrawnObjectsPerFrame();
+        
+        //Keeps track of the Labels' text changes, a rebuild re-lays out the whole glyph buffer, an update only uploads
+        //the glyphs that changed and a text change is skipped if the text is the same
+        void LabelGlyphBufferRebuilt(unsigned int glyphCount);
+        void LabelGlyphBufferUpdated(unsigned int glyphCount);
+        void LabelTextChangeSkipped();
+        
+        //Returns the number of Label glyph buffer rebuilds, updates, uploaded glyphs and skipped text changes last frame
+        unsigned int GetLabelRebuildsPerFrame();
+        unsigned int GetLabelUpdatesPerFrame();
+        unsigned int GetLabelGlyphUploadsPerFrame();
+        unsigned int GetLabelSkippedTextChangesPerFrame();
+        
+        //Returns the SpriteBatch used to batch Sprite draw calls
+        SpriteBatch* GetSpriteBatch();
+        
+        //Returns the RenderQueue used to sort and submit the non-batched draw calls
+        RenderQueue* GetRenderQueue();
+        
+        //Returns the RenderTargetPool used to reuse the RenderTargets of offscreen passes
+        RenderTargetPool* GetRenderTargetPool();
+        
+        //Returns wether the OpenGL implementation supports a compressed texture format. The supported formats
+        //are queried once, when the Graphics service is created, so it is safe to call from any thread
+        bool IsCompressedTextureFormatSupported(unsigned int compressedFormat);
+        
+        //Returns the maximum texture anisotropy, 1.0 if anisotropic filtering isn't supported
+        float GetMaxTextureAnisotropy();
+        
+        //Returns the shared unit quad vertex buffer, it holds four TextureFrameVertex and is shared
+        //by all the TextureFrames that render a whole Texture. The buffer is created on first use
+        unsigned int GetUnitQuadBuffer();
+        
+        //Updates the Graphics service, resets the per frame stats
+        void Update(double delta);
 
         //Used to determine if the Graphics should be updated and drawn
         bool CanUpdate();
         bool CanDraw();
 
     private:
+        //Conveniance methods to set the scissor state and clear color, redundant changes are filtered
+        void SetScissorTestEnabled(bool enabled);
+        void SetScissorRect(int x, int y, int width, int height);
+        void SetGLClearColor(Color color);
+        
+
         //RenderTarget members
         RenderTarget* m_ActiveRenderTarget;
         
@@ -124,12 +216,65 @@ namespace GameDev2D
         int m_ViewportWidth;
         int m_ViewportHeight;
         
-        //Members for the bound texture and vertex array objects
-        unsigned int m_BoundTextureId;
+        //Members for the bound textures and vertex array objects
+        unsigned int m_BoundTextureIds[GRAPHICS_MAX_TEXTURE_UNITS];
+        unsigned int m_ActiveTextureUnit;
         unsigned int m_BoundVertexArray;
+        unsigned int m_DeletedObjectCount;
+        
+        //Members for the shadowed open gl state
+        unsigned int m_ActiveProgram;
+        unsigned int m_BoundArrayBuffer;
+        bool m_BlendingEnabled;
+        GLenum m_SourceBlending;
+        GLenum m_DestinationBlending;
+        bool m_ScissorTestEnabled;
+        ivec4 m_ScissorRect;
+        vec4 m_GLClearColor;
+        
+        //Stats member variables
+        unsigned int m_StateChanges;
+        unsigned int m_FilteredStateChanges;
+        unsigned int m_StateChangesPerFrame;
+        unsigned int m_FilteredStateChangesPerFrame;
+        
+        //Culling member variables
+        bool m_CullingEnabled;
+        unsigned int m_CulledObjects;
+        unsigned int m_DrawnObjects;
+        unsigned int m_CulledObjectsPerFrame;
+        unsigned int m_DrawnObjectsPerFrame;
+        
+        //Label member variables
+        unsigned int m_LabelRebuilds;
+        unsigned int m_LabelUpdates;
+        unsigned int m_LabelGlyphUploads;
+        unsigned int m_LabelSkippedTextChanges;
+        unsigned int m_LabelRebuildsPerFrame;
+        unsigned int m_LabelUpdatesPerFrame;
+        unsigned int m_LabelGlyphUploadsPerFrame;
+        unsigned int m_LabelSkippedTextChangesPerFrame;
         
         //Scissor stack to keep track of multiple clipping rects
         vector<pair<vec2, vec2>> m_ScissorStack;
+        
+        //The SpriteBatch used to batch Sprite draw calls
+        SpriteBatch* m_SpriteBatch;
+        
+        //The RenderQueue used to sort and submit the non-batched draw calls
+        RenderQueue* m_RenderQueue;
+        
+        //The RenderTargetPool used to reuse the RenderTargets of offscreen passes
+        RenderTargetPool* m_RenderTargetPool;
+        
+        //The shared unit quad vertex buffer
+        unsigned int m_UnitQuadBuffer;
+        
+        //The compressed texture formats supported by the OpenGL implementation
+        vector<unsigned int> m_CompressedTextureFormats;
+        
+        //The maximum texture anisotropy supported by the OpenGL implementation
+        float m_MaxTextureAnisotropy;
     };
 }
 
@@ -0,0 +1,298 @@
+//
+//  RenderQueue.cpp
+//  GameDev2D
+//
+
+#include "RenderQueue.h"
+#include "Graphics.h"
+#include "../ServiceLocator.h"
+#include "../../Graphics/Core/Shader.h"
+#include "../../Graphics/Textures/Texture.h"
+#include <chrono>
+
+
+namespace GameDev2D
+{
+    RenderQueue::RenderQueue() : BaseObject("RenderQueue"),
+        m_SortMode(RenderQueueSortNone),
+        m_Layer(0),
+        m_IsRecording(false),
+        m_CommandCount(0),
+        m_SortedCommandCount(0),
+        m_CommandsPerFrame(0),
+        m_SortedCommandsPerFrame(0),
+        m_SortTime(0.0),
+        m_SortTimePerFrame(0.0)
+    {
+        //Reserve enough memory for a typical frame, the buffers only grow
+        m_Commands.reserve(RENDER_QUEUE_RESERVED_COMMANDS);
+        m_Entries.reserve(RENDER_QUEUE_RESERVED_COMMANDS);
+        m_SortBuffer.reserve(RENDER_QUEUE_RESERVED_COMMANDS);
+    }
+    
+    RenderQueue::~RenderQueue()
+    {
+        //Clear the commands, they are never submitted once the Graphics service is shutting down
+        m_Commands.clear();
+        m_Entries.clear();
+        m_SortBuffer.clear();
+    }
+    
+    void RenderQueue::Begin(RenderQueueSortMode aSortMode)
+    {
+        //Submit any commands left over from a previous Begin() call
+        Submit();
+        
+        //Set the sort mode, reset the layer and start recording
+        m_SortMode = aSortMode;
+        m_Layer = 0;
+        m_IsRecording = true;
+    }
+    
+    void RenderQueue::End()
+    {
+        //Submit the collected commands and stop recording
+        Submit();
+        m_IsRecording = false;
+    }
+    
+    bool RenderQueue::IsRecording()
+    {
+        return m_IsRecording;
+    }
+    
+    void RenderQueue::AddCommand(const RenderCommand& aCommand)
+    {
+        //Safety check the command's shader
+        if(aCommand.shader == nullptr)
+        {
+            return;
+        }
+        
+        //Flush any batched sprites, to maintain the draw order
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        graphics->GetSpriteBatch()->Flush();
+        
+        //If the RenderQueue isn't recording, submit the command right away
+        if(m_IsRecording == false)
+        {
+            SubmitCommand(aCommand);
+            graphics->BindVertexArray(0);
+            m_CommandCount++;
+            return;
+        }
+        
+        //Add the sort key entry for the command and add the command to the frame's commands
+        RenderQueueEntry entry;
+        entry.sortKey = MakeSortKey(aCommand);
+        entry.commandIndex = (unsigned int)m_Commands.size();
+        m_Entries.push_back(entry);
+        m_Commands.push_back(aCommand);
+    }
+    
+    void RenderQueue::Submit()
+    {
+        //If there aren't any commands, there is nothing to submit
+        if(m_Commands.size() == 0)
+        {
+            return;
+        }
+        
+        //Sort the entries by their sort key
+        SortEntries();
+        
+        //Submit the commands, in the sorted order
+        for(unsigned int i = 0; i < m_Entries.size(); i++)
+        {
+            SubmitCommand(m_Commands.at(m_Entries.at(i).commandIndex));
+        }
+        m_CommandCount += (unsigned int)m_Commands.size();
+        
+        //Unbind the vertex array
+        ServiceLocator::GetGraphics()->BindVertexArray(0);
+        
+        //Clear the commands, the vectors keep their capacity for the next frame
+        m_Commands.clear();
+        m_Entries.clear();
+    }
+    
+    bool RenderQueue::HasPendingCommands()
+    {
+        return m_Commands.size() > 0;
+    }
+    
+    bool RenderQueue::HasPendingCommands(unsigned int aVertexArray)
+    {
+        for(unsigned int i = 0; i < m_Commands.size(); i++)
+        {
+            if(m_Commands.at(i).vertexArray == aVertexArray)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void RenderQueue::SetLayer(unsigned char aLayer)
+    {
+        m_Layer = aLayer;
+    }
+    
+    unsigned char RenderQueue::GetLayer()
+    {
+        return m_Layer;
+    }
+    
+    unsigned int RenderQueue::GetCommandsPerFrame()
+    {
+        return m_CommandsPerFrame;
+    }
+    
+    unsigned int RenderQueue::GetSortedCommandsPerFrame()
+    {
+        return m_SortedCommandsPerFrame;
+    }
+    
+    float RenderQueue::GetSortTimePerFrame()
+    {
+        return (float)(m_SortTimePerFrame * 1000.0);
+    }
+    
+    void RenderQueue::ResetFrameStats()
+    {
+        //Store the last frame's stats and reset the counters
+        m_CommandsPerFrame = m_CommandCount;
+        m_SortedCommandsPerFrame = m_SortedCommandCount;
+        m_SortTimePerFrame = m_SortTime;
+        m_CommandCount = 0;
+        m_SortedCommandCount = 0;
+        m_SortTime = 0.0;
+    }
+    
+    unsigned long long RenderQueue::MakeSortKey(const RenderCommand& aCommand)
+    {
+        //The layer is the most significant byte of the key
+        unsigned long long sortKey = (unsigned long long)m_Layer << 56;
+        
+        //When sorting by state, the shader program (8 bits), the texture id (24 bits), the blending (2 bits) and the vertex array
+        //(22 bits) follow the layer. Ids that don't fit only cost a redundant state change, the Graphics service filters those
+        if(m_SortMode == RenderQueueSortState)
+        {
+            unsigned int textureId = aCommand.texture != nullptr ? aCommand.texture->GetId() : 0;
+            sortKey |= ((unsigned long long)aCommand.shader->GetProgram() & 0xFF) << 48;
+            sortKey |= ((unsigned long long)textureId & 0xFFFFFF) << 24;
+            sortKey |= ((unsigned long long)aCommand.blending & 0x3) << 22;
+            sortKey |= (unsigned long long)aCommand.vertexArray & 0x3FFFFF;
+        }
+        
+        return sortKey;
+    }
+    
+    void RenderQueue::SortEntries()
+    {
+        //Keep track of the number of commands sorted and the time it takes to sort them
+        unsigned int entryCount = (unsigned int)m_Entries.size();
+        m_SortedCommandCount += entryCount;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        
+        //Cycle through the bytes of the sort key, from least significant to most significant
+        m_SortBuffer.resize(entryCount);
+        for(unsigned int shift = 0; shift < 64; shift += 8)
+        {
+            //Count the number of entries for each byte value
+            unsigned int counts[256] = {};
+            for(unsigned int i = 0; i < entryCount; i++)
+            {
+                counts[(m_Entries[i].sortKey >> shift) & 0xFF]++;
+            }
+            
+            //If every entry has the same byte value, this pass wouldn't change the order
+            if(counts[(m_Entries[0].sortKey >> shift) & 0xFF] == entryCount)
+            {
+                continue;
+            }
+            
+            //Turn the counts into the offsets for each byte value
+            unsigned int offset = 0;
+            for(unsigned int i = 0; i < 256; i++)
+            {
+                unsigned int count = counts[i];
+                counts[i] = offset;
+                offset += count;
+            }
+            
+            //Scatter the entries into the sort buffer, in order, and swap the buffers
+            for(unsigned int i = 0; i < entryCount; i++)
+            {
+                m_SortBuffer[counts[(m_Entries[i].sortKey >> shift) & 0xFF]++] = m_Entries[i];
+            }
+            m_Entries.swap(m_SortBuffer);
+        }
+        
+        //Accumulate the sort time, in seconds
+        m_SortTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    
+    void RenderQueue::SubmitCommand(const RenderCommand& aCommand)
+    {
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        Shader* shader = aCommand.shader;
+        
+        //Set the shader to be used and bind the vertex array object
+        shader->Use();
+        graphics->BindVertexArray(aCommand.vertexArray);
+        
+        //Set the model view projection matrix
+        glUniformMatrix4fv(shader->GetModelViewProjectionUniform(), 1, 0, &aCommand.modelViewProjection[0][0]);
+        
+        //If the shader samples a texture, set the texture unit and bind the texture
+        if((int)shader->GetTextureUniform() != -1)
+        {
+            glUniform1i(shader->GetTextureUniform(), 0);
+            graphics->BindTexture(aCommand.texture);
+        }
+        
+        //Set the constant attributes, they aren't part of the vertex array's state
+        if(aCommand.colorAttribute != -1)
+        {
+            glVertexAttrib4f(aCommand.colorAttribute, aCommand.color.r, aCommand.color.g, aCommand.color.b, aCommand.color.a);
+        }
+        if(aCommand.pointSizeAttribute != -1)
+        {
+            glVertexAttrib1f(aCommand.pointSizeAttribute, aCommand.pointSize);
+        }
+        
+        //Validate the shader, skip the command if it fails
+        if(shader->Validate() == false)
+        {
+            return;
+        }
+        
+        //Set the blending
+        if(aCommand.blending == RenderCommandBlendingPremultiplied)
+        {
+            graphics->EnableBlending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        else if(aCommand.blending == RenderCommandBlendingAlpha)
+        {
+            graphics->EnableBlending();
+        }
+        else
+        {
+            graphics->DisableBlending();
+        }
+        
+        //Draw the vertex range, or the index range if the vertex array has an index buffer
+        if(aCommand.indexType == 0)
+        {
+            glDrawArrays(aCommand.primitiveMode, aCommand.first, aCommand.count);
+        }
+        else
+        {
+            unsigned long indexSize = aCommand.indexType == GL_UNSIGNED_INT ? sizeof(unsigned int) : sizeof(unsigned short);
+            unsigned long indexOffset = aCommand.first * indexSize;
+            glDrawElements(aCommand.primitiveMode, aCommand.count, aCommand.indexType, (const GLvoid*)indexOffset);
+        }
+    }
+}
\ No newline at end of file
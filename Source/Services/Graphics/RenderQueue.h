@@ -0,0 +1,164 @@
+//
+//  RenderQueue.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__RenderQueue__
+#define __GameDev2D__RenderQueue__
+
+#include "../../Core/BaseObject.h"
+#include "../../Graphics/OpenGL.h"
+#include "../../Graphics/Core/Color.h"
+#include <glm.hpp>
+
+
+using namespace glm;
+using namespace std;
+
+namespace GameDev2D
+{
+    //RenderQueue constants
+    const unsigned int RENDER_QUEUE_RESERVED_COMMANDS = 1024;
+    
+    //Forward declarations
+    class Shader;
+    class Texture;
+    
+    //Sort modes for the RenderQueue, by default the draw order is preserved and the commands are only
+    //sorted by layer. RenderQueueSortState will also regroup the commands by Shader, Texture, blending and
+    //vertex array within each layer, this results in the least amount of state changes but should only be
+    //used when overlapping objects in the same layer don't depend on the order they were drawn in.
+    enum RenderQueueSortMode
+    {
+        RenderQueueSortNone = 0,
+        RenderQueueSortState
+    };
+    
+    //The blending a render command is drawn with
+    enum RenderCommandBlending
+    {
+        RenderCommandBlendingNone = 0,
+        RenderCommandBlendingAlpha,
+        RenderCommandBlendingPremultiplied
+    };
+    
+    //Everything needed to issue a draw call, the model view projection matrix is calculated when the command is added.
+    //If the index type is zero the vertex range is drawn with glDrawArrays(), otherwise with glDrawElements() and the
+    //first index is the offset in the vertex array's index buffer. An attribute location of -1 isn't set
+    struct RenderCommand
+    {
+        Shader* shader;
+        Texture* texture;
+        RenderCommandBlending blending;
+        unsigned int vertexArray;
+        GLenum primitiveMode;
+        GLenum indexType;
+        unsigned int first;
+        unsigned int count;
+        mat4 modelViewProjection;
+        int colorAttribute;
+        ColorRGBA color;
+        int pointSizeAttribute;
+        float pointSize;
+    };
+    
+    //Creates a RenderCommand that draws a vertex range without blending, the index type, model view
+    //projection matrix, color and point size can be set on the returned RenderCommand
+    inline RenderCommand MakeRenderCommand(Shader* shader, Texture* texture, unsigned int vertexArray, GLenum primitiveMode, unsigned int first, unsigned int count)
+    {
+        RenderCommand command = { shader, texture, RenderCommandBlendingNone, vertexArray, primitiveMode, 0, first, count, mat4(1.0f), -1, MakeColorRGBA(1.0f, 1.0f, 1.0f), -1, 1.0f };
+        return command;
+    }
+    
+    //The RenderQueue collects the render commands of the non-batched draw calls between a Begin() and End() call and
+    //submits them all at once, the commands are radix sorted by a 64-bit sort key (layer, shader, texture, blending
+    //and vertex array) before they are submitted, the sort is stable so commands with the same key are drawn in the
+    //order they were added. It is owned by the Graphics service, every Scene's Draw() records into the RenderQueue.
+    //Outside of a Begin() and End() call, commands are submitted as soon as they are added. Any change to the render
+    //target or scissor clip (and deleting a vertex array or texture) submits the commands collected so far, to ensure
+    //the draw order is maintained. The SpriteBatch and the RenderQueue never hold pending work at the same time,
+    //adding a command flushes the SpriteBatch and adding a quad to the SpriteBatch submits the RenderQueue.
+    class RenderQueue : public BaseObject
+    {
+    public:
+        RenderQueue();
+        ~RenderQueue();
+        
+        //Starts collecting render commands, any commands that were already collected will be submitted
+        void Begin(RenderQueueSortMode sortMode = RenderQueueSortNone);
+        
+        //Submits the collected render commands and stops collecting render commands
+        void End();
+        
+        //Returns wether the RenderQueue is between a Begin() and End() call
+        bool IsRecording();
+        
+        //Adds a render command, the command is submitted right away if the RenderQueue isn't recording
+        void AddCommand(const RenderCommand& command);
+        
+        //Sorts and submits all the collected render commands, called automatically whenever the draw order requires it
+        void Submit();
+        
+        //Returns wether there are render commands waiting to be submitted
+        bool HasPendingCommands();
+        
+        //Returns wether any of the render commands waiting to be submitted draw with a vertex array, the vertex array's
+        //buffers and attributes mustn't change (and it mustn't be deleted) until those render commands are submitted
+        bool HasPendingCommands(unsigned int vertexArray);
+        
+        //Sets the layer for the commands added after this call, lower layers are drawn first. The Scene
+        //sets the layer to the depth of the GameObject it is drawing, the layer is reset by Begin()
+        void SetLayer(unsigned char layer);
+        unsigned char GetLayer();
+        
+        //Returns the number of render commands that were submitted last frame, the number of those that
+        //were sorted and the time it took to sort them, in milliseconds
+        unsigned int GetCommandsPerFrame();
+        unsigned int GetSortedCommandsPerFrame();
+        float GetSortTimePerFrame();
+    
+    protected:
+        //Called from the Graphics service at the start of every frame
+        void ResetFrameStats();
+        
+        //The Graphics service needs to access the protected methods
+        friend class Graphics;
+    
+    private:
+        //A sort key and the index of the render command it sorts
+        struct RenderQueueEntry
+        {
+            unsigned long long sortKey;
+            unsigned int commandIndex;
+        };
+        
+        //Conveniance method to build the sort key for a render command, the layer is always the most significant byte.
+        //The Shader, Texture, blending and vertex array are only part of the key when sorting by state
+        unsigned long long MakeSortKey(const RenderCommand& command);
+        
+        //Conveniance method to sort the entries, using a stable least significant digit radix
+        //sort, one byte per pass. Passes where every entry has the same byte are skipped
+        void SortEntries();
+        
+        //Conveniance method to set the open gl state for a render command and issue its draw call
+        void SubmitCommand(const RenderCommand& command);
+        
+        //Member variables
+        vector<RenderCommand> m_Commands;
+        vector<RenderQueueEntry> m_Entries;
+        vector<RenderQueueEntry> m_SortBuffer;
+        RenderQueueSortMode m_SortMode;
+        unsigned char m_Layer;
+        bool m_IsRecording;
+        
+        //Stats member variables
+        unsigned int m_CommandCount;
+        unsigned int m_SortedCommandCount;
+        unsigned int m_CommandsPerFrame;
+        unsigned int m_SortedCommandsPerFrame;
+        double m_SortTime;
+        double m_SortTimePerFrame;
+    };
+}
+
+#endif /* defined(__GameDev2D__RenderQueue__) */
@@ -0,0 +1,191 @@
+//
+//  RenderTargetPool.cpp
+//  GameDev2D
+//
+
+#include "RenderTargetPool.h"
+#include "../../Graphics/Core/RenderTarget.h"
+#include "../../Graphics/Textures/TextureFrame.h"
+
+
+#ifndef RENDER_TARGET_POOL_MIN_SIZE
+#define RENDER_TARGET_POOL_MIN_SIZE 16
+#endif
+
+#ifndef RENDER_TARGET_POOL_MAX_FREE
+#define RENDER_TARGET_POOL_MAX_FREE 8
+#endif
+
+
+namespace GameDev2D
+{
+    RenderTargetPool::RenderTargetPool() : BaseObject("RenderTargetPool"),
+        m_MaxFreeRenderTargets(RENDER_TARGET_POOL_MAX_FREE),
+        m_CreatedRenderTargets(0),
+        m_ReusedRenderTargets(0),
+        m_DeletedRenderTargets(0),
+        m_CreatedRenderTargetsPerFrame(0),
+        m_ReusedRenderTargetsPerFrame(0),
+        m_DeletedRenderTargetsPerFrame(0)
+    {
+    
+    }
+    
+    RenderTargetPool::~RenderTargetPool()
+    {
+        //Delete the released render targets
+        Purge();
+        
+        //Any render targets that weren't released are deleted as well
+        if(m_ActiveRenderTargets.size() > 0)
+        {
+            Log(VerbosityLevel_Graphics, "%u render targets were never released to the pool", (unsigned int)m_ActiveRenderTargets.size());
+        }
+        for(set<RenderTarget*>::iterator it = m_ActiveRenderTargets.begin(); it != m_ActiveRenderTargets.end(); ++it)
+        {
+            RenderTarget* renderTarget = *it;
+            SafeDelete(renderTarget);
+        }
+        m_ActiveRenderTargets.clear();
+    }
+    
+    RenderTarget* RenderTargetPool::AcquireRenderTarget(int aWidth, int aHeight)
+    {
+        //Safety check the size
+        if(aWidth <= 0 || aHeight <= 0)
+        {
+            Error(false, "Failed to acquire a render target, the size (%i, %i) is invalid", aWidth, aHeight);
+            return nullptr;
+        }
+        
+        //Round the size up to its bucket
+        int width = GetBucketSize(aWidth);
+        int height = GetBucketSize(aHeight);
+        
+        //Is there a released render target in the same bucket? The most recently released is at the front
+        RenderTarget* renderTarget = nullptr;
+        for(list<RenderTarget*>::iterator it = m_FreeRenderTargets.begin(); it != m_FreeRenderTargets.end(); ++it)
+        {
+            if((*it)->GetWidth() == width && (*it)->GetHeight() == height)
+            {
+                renderTarget = *it;
+                m_FreeRenderTargets.erase(it);
+                break;
+            }
+        }
+        
+        //Reuse the render target, or create a new one. A reused render target's clear color and source frame are reset
+        if(renderTarget != nullptr)
+        {
+            renderTarget->SetClearColor(Color::ClearColor());
+            renderTarget->GetTextureFrame()->SetSourceFrame(SourceFrame(0.0f, 0.0f, (float)width, (float)height));
+            m_ReusedRenderTargets++;
+        }
+        else
+        {
+            renderTarget = new RenderTarget(width, height);
+            renderTarget->CreateFrameBuffer();
+            m_CreatedRenderTargets++;
+            Log(VerbosityLevel_Graphics, "Created a pooled render target (%i, %i) for (%i, %i)", width, height, aWidth, aHeight);
+        }
+        
+        //The render target is handed out
+        m_ActiveRenderTargets.insert(renderTarget);
+        return renderTarget;
+    }
+    
+    void RenderTargetPool::ReleaseRenderTarget(RenderTarget* aRenderTarget)
+    {
+        //Safety check the render target
+        if(aRenderTarget == nullptr)
+        {
+            return;
+        }
+        
+        //Was the render target handed out by the pool?
+        set<RenderTarget*>::iterator it = m_ActiveRenderTargets.find(aRenderTarget);
+        if(it == m_ActiveRenderTargets.end())
+        {
+            Error(false, "Failed to release the render target, it wasn't acquired from the pool");
+            return;
+        }
+        
+        //Move the render target to the front of the free list, then delete the least recently released if there are too many
+        m_ActiveRenderTargets.erase(it);
+        m_FreeRenderTargets.push_front(aRenderTarget);
+        TrimFreeRenderTargets(m_MaxFreeRenderTargets);
+    }
+    
+    void RenderTargetPool::Purge()
+    {
+        TrimFreeRenderTargets(0);
+    }
+    
+    void RenderTargetPool::SetMaxFreeRenderTargets(unsigned int aMaxFreeRenderTargets)
+    {
+        m_MaxFreeRenderTargets = aMaxFreeRenderTargets;
+        TrimFreeRenderTargets(m_MaxFreeRenderTargets);
+    }
+    
+    unsigned int RenderTargetPool::GetMaxFreeRenderTargets()
+    {
+        return m_MaxFreeRenderTargets;
+    }
+    
+    unsigned int RenderTargetPool::GetActiveRenderTargetCount()
+    {
+        return (unsigned int)m_ActiveRenderTargets.size();
+    }
+    
+    unsigned int RenderTargetPool::GetFreeRenderTargetCount()
+    {
+        return (unsigned int)m_FreeRenderTargets.size();
+    }
+    
+    unsigned int RenderTargetPool::GetCreatedRenderTargetsPerFrame()
+    {
+        return m_CreatedRenderTargetsPerFrame;
+    }
+    
+    unsigned int RenderTargetPool::GetReusedRenderTargetsPerFrame()
+    {
+        return m_ReusedRenderTargetsPerFrame;
+    }
+    
+    unsigned int RenderTargetPool::GetDeletedRenderTargetsPerFrame()
+    {
+        return m_DeletedRenderTargetsPerFrame;
+    }
+    
+    void RenderTargetPool::ResetFrameStats()
+    {
+        //Store the last frame's stats and reset the counters
+        m_CreatedRenderTargetsPerFrame = m_CreatedRenderTargets;
+        m_ReusedRenderTargetsPerFrame = m_ReusedRenderTargets;
+        m_DeletedRenderTargetsPerFrame = m_DeletedRenderTargets;
+        m_CreatedRenderTargets = 0;
+        m_ReusedRenderTargets = 0;
+        m_DeletedRenderTargets = 0;
+    }
+    
+    int RenderTargetPool::GetBucketSize(int aSize)
+    {
+        int bucketSize = RENDER_TARGET_POOL_MIN_SIZE;
+        while(bucketSize < aSize)
+        {
+            bucketSize *= 2;
+        }
+        return bucketSize;
+    }
+    
+    void RenderTargetPool::TrimFreeRenderTargets(unsigned int aMaxFreeRenderTargets)
+    {
+        while(m_FreeRenderTargets.size() > aMaxFreeRenderTargets)
+        {
+            RenderTarget* renderTarget = m_FreeRenderTargets.back();
+            m_FreeRenderTargets.pop_back();
+            SafeDelete(renderTarget);
+            m_DeletedRenderTargets++;
+        }
+    }
+}
\ No newline at end of file
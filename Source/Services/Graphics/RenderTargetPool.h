@@ -0,0 +1,80 @@
+//
+//  RenderTargetPool.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__RenderTargetPool__
+#define __GameDev2D__RenderTargetPool__
+
+#include "../../Core/BaseObject.h"
+#include <list>
+#include <set>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class RenderTarget;
+    
+    //The RenderTargetPool hands out RenderTargets for offscreen passes, instead of each pass creating and deleting its
+    //own texture and frame buffer. The requested size is rounded up to a power of two bucket, so a RenderTarget that was
+    //released can be reused for any request in the same bucket. The released RenderTargets are kept in the pool, up to
+    //a maximum count, the least recently released are deleted first. It is owned by the Graphics service.
+    class RenderTargetPool : public BaseObject
+    {
+    public:
+        RenderTargetPool();
+        ~RenderTargetPool();
+        
+        //Returns a RenderTarget that is at least the width and height, the RenderTarget's size is the power of two bucket
+        //(use GetWidth() and GetHeight()) and its frame buffer is already created. The contents of a reused RenderTarget
+        //aren't cleared. The RenderTarget must be returned with ReleaseRenderTarget(), it must NOT be deleted
+        RenderTarget* AcquireRenderTarget(int width, int height);
+        
+        //Returns a RenderTarget to the pool, so it can be handed out again
+        void ReleaseRenderTarget(RenderTarget* renderTarget);
+        
+        //Deletes all the released RenderTargets in the pool
+        void Purge();
+        
+        //Sets the maximum number of released RenderTargets the pool keeps
+        void SetMaxFreeRenderTargets(unsigned int maxFreeRenderTargets);
+        unsigned int GetMaxFreeRenderTargets();
+        
+        //Returns the pool's occupancy, the number of RenderTargets that are handed out and released (free)
+        unsigned int GetActiveRenderTargetCount();
+        unsigned int GetFreeRenderTargetCount();
+        
+        //Returns the allocation churn, the number of RenderTargets that were created, reused and deleted last frame
+        unsigned int GetCreatedRenderTargetsPerFrame();
+        unsigned int GetReusedRenderTargetsPerFrame();
+        unsigned int GetDeletedRenderTargetsPerFrame();
+        
+        //Resets the per frame stats, called once a frame by the Graphics service
+        void ResetFrameStats();
+    
+    private:
+        //Returns the power of two bucket for a width or height
+        static int GetBucketSize(int size);
+        
+        //Deletes the least recently released RenderTargets, until the pool is within the maximum count
+        void TrimFreeRenderTargets(unsigned int maxFreeRenderTargets);
+        
+        //Member variables
+        list<RenderTarget*> m_FreeRenderTargets;
+        set<RenderTarget*> m_ActiveRenderTargets;
+        unsigned int m_MaxFreeRenderTargets;
+        
+        //Stats member variables
+        unsigned int m_CreatedRenderTargets;
+        unsigned int m_ReusedRenderTargets;
+        unsigned int m_DeletedRenderTargets;
+        unsigned int m_CreatedRenderTargetsPerFrame;
+        unsigned int m_ReusedRenderTargetsPerFrame;
+        unsigned int m_DeletedRenderTargetsPerFrame;
+    };
+}
+
+#endif /* defined(__GameDev2D__RenderTargetPool__) */
@@ -0,0 +1,718 @@
+//
+//  SpriteBatch.cpp
+//  GameDev2D
+//
+
+#include "SpriteBatch.h"
+#include "Graphics.h"
+#include "../ServiceLocator.h"
+#include "../../Graphics/Core/Shader.h"
+#include "../../Graphics/Textures/Texture.h"
+#include "../../Graphics/Textures/TextureFrame.h"
+#include "../ShaderManager/ShaderManager.h"
+#include "../../Platforms/PlatformLayer.h"
+#include <chrono>
+
+
+#ifndef SPRITE_BATCH_INSTANCING_ENABLED
+#define SPRITE_BATCH_INSTANCING_ENABLED 0
+#endif
+
+
+namespace GameDev2D
+{
+    SpriteBatch::SpriteBatch() : BaseObject("SpriteBatch"),
+        m_SortMode(SpriteBatchSortNone),
+        m_Layer(0),
+        m_IsBatching(false),
+        m_AttributeShader(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_IndexBufferObject(0),
+        m_VertexBufferCapacity(0),
+        m_InstancingEnabled(SPRITE_BATCH_INSTANCING_ENABLED),
+        m_InstancingSupported(-1),
+        m_InstanceAttributeShader(nullptr),
+        m_InstanceVertexArrayObject(0),
+        m_InstanceBufferObject(0),
+        m_InstanceBufferCapacity(0),
+        m_DrawCalls(0),
+        m_QuadCount(0),
+        m_InstancedDrawCalls(0),
+        m_InstanceCount(0),
+        m_DrawCallsPerFrame(0),
+        m_QuadsPerFrame(0),
+        m_InstancedDrawCallsPerFrame(0),
+        m_InstancesPerFrame(0),
+        m_CommandCount(0),
+        m_CommandsPerFrame(0),
+        m_SortTime(0.0),
+        m_SortTimePerFrame(0.0)
+    {
+        //Reserve enough memory for a full batch
+        m_Quads.reserve(SPRITE_BATCH_MAX_QUADS);
+        m_Commands.reserve(SPRITE_BATCH_MAX_QUADS);
+        m_SortBuffer.reserve(SPRITE_BATCH_MAX_QUADS);
+        m_SortedQuads.reserve(SPRITE_BATCH_MAX_QUADS);
+        m_Vertices.reserve(SPRITE_BATCH_MAX_QUADS * SPRITE_BATCH_VERTICES_PER_QUAD);
+        m_Instances.reserve(SPRITE_BATCH_MAX_QUADS);
+    }
+    
+    SpriteBatch::~SpriteBatch()
+    {
+        //Delete the index buffer
+        if(m_IndexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_IndexBufferObject);
+            m_IndexBufferObject = 0;
+        }
+        
+        //Delete the vertex buffer
+        if(m_VertexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+        }
+        
+        //Delete the VAO
+        if(m_VertexArrayObject != 0)
+        {
+            glDeleteVertexArrays(1, &m_VertexArrayObject);
+            m_VertexArrayObject = 0;
+        }
+        
+        //Delete the instance buffer
+        if(m_InstanceBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_InstanceBufferObject);
+            m_InstanceBufferObject = 0;
+        }
+        
+        //Delete the instancing VAO
+        if(m_InstanceVertexArrayObject != 0)
+        {
+            glDeleteVertexArrays(1, &m_InstanceVertexArrayObject);
+            m_InstanceVertexArrayObject = 0;
+        }
+        
+        //Clear the quads and commands
+        m_Quads.clear();
+        m_Commands.clear();
+        m_SortBuffer.clear();
+        m_SortedQuads.clear();
+        m_Vertices.clear();
+        m_Instances.clear();
+    }
+    
+    void SpriteBatch::Begin(SpriteBatchSortMode aSortMode)
+    {
+        //Flush any quads left over from a previous batch
+        Flush();
+        
+        //Set the sort mode, reset the layer and start batching
+        m_SortMode = aSortMode;
+        m_Layer = 0;
+        m_IsBatching = true;
+    }
+    
+    void SpriteBatch::End()
+    {
+        //Flush the collected quads and stop batching
+        Flush();
+        m_IsBatching = false;
+    }
+    
+    bool SpriteBatch::IsBatching()
+    {
+        return m_IsBatching;
+    }
+    
+    void SpriteBatch::AddQuad(TextureFrame* aTextureFrame, const mat4& aModelMatrix)
+    {
+        //Safety check the texture frame
+        if(aTextureFrame == nullptr)
+        {
+            return;
+        }
+        
+        //Add the quad for the texture frame's shader, texture, source frame and color
+        AddQuad(aTextureFrame->GetShader(), aTextureFrame->GetTexture(), aTextureFrame->GetSourceFrame(), aTextureFrame->m_Color, aModelMatrix);
+    }
+    
+    void SpriteBatch::AddQuad(Shader* aShader, Texture* aTexture, const SourceFrame& aSourceFrame, const ColorRGBA& aColor, const mat4& aModelMatrix)
+    {
+        //Safety check the shader and texture
+        if(aShader == nullptr || aTexture == nullptr)
+        {
+            return;
+        }
+        
+        //Submit any render commands, to maintain the draw order
+        ServiceLocator::GetGraphics()->GetRenderQueue()->Submit();
+        
+        //If the batch is full, flush it
+        if(m_Quads.size() >= SPRITE_BATCH_MAX_QUADS)
+        {
+            Flush();
+        }
+        
+        //Get the texture, source frame and color, a premultiplied texture needs a premultiplied color
+        Texture* texture = aTexture;
+        const SourceFrame& sourceFrame = aSourceFrame;
+        ColorRGBA8 packedColor = PackColorRGBA8(texture->IsPremultiplied() == true ? PremultiplyColorRGBA(aColor) : aColor);
+        
+        //Setup the quad's render state
+        SpriteBatchQuad quad;
+        quad.shader = aShader;
+        quad.texture = texture;
+        quad.blending = texture->GetFormat() == GL_RGBA || aColor.a != 1.0f;
+        
+        //Build the UV Coordinates, the same way the TextureFrame does
+        float x1 = sourceFrame.position.x / (float)texture->GetSize().x;
+        float y1 = 1.0f - ((sourceFrame.position.y + sourceFrame.size.y) / (float)texture->GetSize().y);
+        float x2 = (sourceFrame.position.x + sourceFrame.size.x) / (float)texture->GetSize().x;
+        float y2 = 1.0f - (sourceFrame.position.y / (float)texture->GetSize().y);
+        
+        //The corners of the quad, in the same order as the TextureFrame's triangle strip
+        const vec2 corners[SPRITE_BATCH_VERTICES_PER_QUAD] = { vec2(0.0f, 0.0f), vec2(sourceFrame.size.x, 0.0f), vec2(0.0f, sourceFrame.size.y), vec2(sourceFrame.size.x, sourceFrame.size.y) };
+        const vec2 uvCoordinates[SPRITE_BATCH_VERTICES_PER_QUAD] = { vec2(x1, y1), vec2(x2, y1), vec2(x1, y2), vec2(x2, y2) };
+        
+        //Transform the corners by the model matrix and set the vertex data
+        for(unsigned int i = 0; i < SPRITE_BATCH_VERTICES_PER_QUAD; i++)
+        {
+            vec4 position = aModelMatrix * vec4(corners[i].x, corners[i].y, 0.0f, 1.0f);
+            quad.vertices[i].x = position.x;
+            quad.vertices[i].y = position.y;
+            quad.vertices[i].u = uvCoordinates[i].x;
+            quad.vertices[i].v = uvCoordinates[i].y;
+            quad.vertices[i].color = packedColor;
+        }
+        
+        //Set the instance record, the size of the quad is folded into the transform
+        quad.instance.transform[0] = aModelMatrix[0][0] * sourceFrame.size.x;
+        quad.instance.transform[1] = aModelMatrix[0][1] * sourceFrame.size.x;
+        quad.instance.transform[2] = aModelMatrix[1][0] * sourceFrame.size.y;
+        quad.instance.transform[3] = aModelMatrix[1][1] * sourceFrame.size.y;
+        quad.instance.translation[0] = aModelMatrix[3][0];
+        quad.instance.translation[1] = aModelMatrix[3][1];
+        quad.instance.uvRect[0] = x1;
+        quad.instance.uvRect[1] = y1;
+        quad.instance.uvRect[2] = x2;
+        quad.instance.uvRect[3] = y2;
+        quad.instance.color = packedColor;
+        
+        //Add the render command for the quad and add the quad to the batch
+        SpriteBatchCommand command;
+        command.sortKey = MakeSortKey(quad.shader, quad.texture, quad.blending);
+        command.quadIndex = (unsigned int)m_Quads.size();
+        m_Commands.push_back(command);
+        m_Quads.push_back(quad);
+    }
+    
+    void SpriteBatch::Flush()
+    {
+        //If there aren't any quads, there is nothing to flush
+        if(m_Quads.size() == 0)
+        {
+            return;
+        }
+        
+        //Create the buffers, if they haven't been created yet
+        if(m_VertexArrayObject == 0)
+        {
+            CreateBuffers();
+        }
+        
+        //Sort the render commands by their sort key
+        SortCommands();
+        
+        //Build the list of quads to render, in the sorted command order
+        m_SortedQuads.clear();
+        for(unsigned int i = 0; i < m_Commands.size(); i++)
+        {
+            m_SortedQuads.push_back(&m_Quads.at(m_Commands.at(i).quadIndex));
+        }
+        
+        //Get the instancing shader, it is null if instancing is disabled or not supported. Quads that use the
+        //pass through texture shader are instanced, quads that use any other shader use the vertex path
+        Shader* instancingShader = GetInstancingShader();
+        Shader* passthroughShader = ServiceLocator::GetShaderManager()->GetPassthroughTextureShader();
+        
+        //Build the interleaved vertex data and the instance data
+        m_Vertices.clear();
+        m_Instances.clear();
+        for(unsigned int i = 0; i < m_SortedQuads.size(); i++)
+        {
+            if(instancingShader != nullptr && m_SortedQuads.at(i)->shader == passthroughShader)
+            {
+                m_Instances.push_back(m_SortedQuads.at(i)->instance);
+            }
+            else
+            {
+                for(unsigned int j = 0; j < SPRITE_BATCH_VERTICES_PER_QUAD; j++)
+                {
+                    m_Vertices.push_back(m_SortedQuads.at(i)->vertices[j]);
+                }
+            }
+        }
+        
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //Upload the vertex data, if there is any
+        if(m_Vertices.size() > 0)
+        {
+            //Bind the VAO and the streaming vertex buffer
+            graphics->BindVertexArray(m_VertexArrayObject);
+            graphics->BindArrayBuffer(m_VertexBufferObject);
+            
+            //Orphan the vertex buffer and upload the vertex data, the buffer only grows
+            unsigned int size = (unsigned int)(sizeof(SpriteBatchVertex) * m_Vertices.size());
+            m_VertexBufferCapacity = size > m_VertexBufferCapacity ? size : m_VertexBufferCapacity;
+            glBufferData(GL_ARRAY_BUFFER, m_VertexBufferCapacity, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, size, &m_Vertices[0]);
+        }
+        
+        //Upload the instance data, if there is any
+        if(m_Instances.size() > 0)
+        {
+            //Create the instancing buffers, if they haven't been created yet
+            if(m_InstanceVertexArrayObject == 0)
+            {
+                CreateInstanceBuffers();
+            }
+            
+            //Orphan the instance buffer and upload the instance data, the buffer only grows
+            graphics->BindArrayBuffer(m_InstanceBufferObject);
+            unsigned int size = (unsigned int)(sizeof(SpriteBatchInstance) * m_Instances.size());
+            m_InstanceBufferCapacity = size > m_InstanceBufferCapacity ? size : m_InstanceBufferCapacity;
+            glBufferData(GL_ARRAY_BUFFER, m_InstanceBufferCapacity, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, size, &m_Instances[0]);
+        }
+        
+        //The projection and view matrices, the quads are already in world space
+        mat4 viewProjection = graphics->GetProjectionMatrix() * graphics->GetViewMatrix();
+        
+        //Cycle through the quads and render each group of quads with the same state in one draw call
+        Shader* activeShader = nullptr;
+        unsigned int vertexQuadOffset = 0;
+        unsigned int instanceOffset = 0;
+        unsigned int start = 0;
+        while(start < m_SortedQuads.size())
+        {
+            //Find the end of the group
+            SpriteBatchQuad* first = m_SortedQuads.at(start);
+            unsigned int end = start + 1;
+            while(end < m_SortedQuads.size() && m_SortedQuads.at(end)->shader == first->shader && m_SortedQuads.at(end)->texture == first->texture && m_SortedQuads.at(end)->blending == first->blending)
+            {
+                end++;
+            }
+            
+            //Is the group instanced? If it is, the instancing shader is used instead of the quad's shader
+            unsigned int count = end - start;
+            bool isInstanced = instancingShader != nullptr && first->shader == passthroughShader;
+            Shader* shader = isInstanced == true ? instancingShader : first->shader;
+            
+            //Set the shader, if it has changed
+            if(shader != activeShader)
+            {
+                activeShader = shader;
+                activeShader->Use();
+                glUniformMatrix4fv(activeShader->GetModelViewProjectionUniform(), 1, 0, &viewProjection[0][0]);
+                glUniform1i(activeShader->GetTextureUniform(), 0);
+            }
+            
+            //Bind the vertex array and set the attributes for the group
+            if(isInstanced == true)
+            {
+                graphics->BindVertexArray(m_InstanceVertexArrayObject);
+                SetInstanceAttributes(activeShader, instanceOffset);
+            }
+            else
+            {
+                graphics->BindVertexArray(m_VertexArrayObject);
+                graphics->BindArrayBuffer(m_VertexBufferObject);
+                SetVertexAttributes(activeShader);
+            }
+            
+            //Bind the texture
+            graphics->BindTexture(first->texture);
+            
+            //Validate the shader, skip the group of quads if it fails
+            if(activeShader->Validate() == true)
+            {
+                //Enable blending if the group of quads needs it, otherwise disable it
+                if(first->blending == true)
+                {
+                    //A premultiplied texture's color is already multiplied by its alpha, the group has a single texture
+                    if(first->texture->IsPremultiplied() == true)
+                    {
+                        graphics->EnableBlending(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                    }
+                    else
+                    {
+                        graphics->EnableBlending();
+                    }
+                }
+                else
+                {
+                    graphics->DisableBlending();
+                }
+                
+                //Draw the group of quads
+                if(isInstanced == true)
+                {
+                    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, SPRITE_BATCH_VERTICES_PER_QUAD, count);
+                    m_InstancedDrawCalls++;
+                    m_InstanceCount += count;
+                }
+                else
+                {
+                    unsigned long indexOffset = vertexQuadOffset * SPRITE_BATCH_INDICES_PER_QUAD * sizeof(unsigned short);
+                    glDrawElements(GL_TRIANGLES, count * SPRITE_BATCH_INDICES_PER_QUAD, GL_UNSIGNED_SHORT, (const GLvoid*)indexOffset);
+                }
+                m_DrawCalls++;
+            }
+            
+            //Move onto the next group
+            if(isInstanced == true)
+            {
+                instanceOffset += count;
+            }
+            else
+            {
+                vertexQuadOffset += count;
+            }
+            start = end;
+        }
+        
+        //Unbind the vertex array
+        graphics->BindVertexArray(0);
+        
+        //Keep track of the number of quads flushed and clear the batch
+        m_QuadCount += (unsigned int)m_Quads.size();
+        m_Quads.clear();
+        m_Commands.clear();
+    }
+    
+    void SpriteBatch::SetLayer(unsigned char aLayer)
+    {
+        m_Layer = aLayer;
+    }
+    
+    unsigned char SpriteBatch::GetLayer()
+    {
+        return m_Layer;
+    }
+    
+    void SpriteBatch::SetInstancingEnabled(bool aInstancingEnabled)
+    {
+        if(aInstancingEnabled != m_InstancingEnabled)
+        {
+            //Flush the collected quads, they were collected for the current mode
+            Flush();
+            m_InstancingEnabled = aInstancingEnabled;
+        }
+    }
+    
+    bool SpriteBatch::IsInstancingEnabled()
+    {
+        return m_InstancingEnabled;
+    }
+    
+    bool SpriteBatch::IsInstancingSupported()
+    {
+        //The instancing support only has to be determined once
+        if(m_InstancingSupported == -1)
+        {
+            //Instancing requires glDrawArraysInstanced and glVertexAttribDivisor, OpenGL 3.3 or OpenGL ES 3.0
+            int majorVersion = 0;
+            int minorVersion = 0;
+            int minimumMinorVersion = 3;
+            if(ServiceLocator::GetPlatformLayer()->GetPlatformType() == PlatformType_iOS)
+            {
+                sscanf((char *)glGetString(GL_VERSION), "OpenGL ES %d.%d", &majorVersion, &minorVersion);
+                minimumMinorVersion = 0;
+            }
+            else
+            {
+                sscanf((char *)glGetString(GL_VERSION), "%d.%d", &majorVersion, &minorVersion);
+            }
+            
+            //Set the support flag
+            bool isSupported = majorVersion > 3 || (majorVersion == 3 && minorVersion >= minimumMinorVersion);
+            
+            //On Windows the function pointers also have to be loaded
+            #if _WIN32 && !HEADLESS_OPENGL
+            isSupported = isSupported && glDrawArraysInstanced != nullptr && glVertexAttribDivisor != nullptr;
+            #endif
+            
+            m_InstancingSupported = isSupported == true ? 1 : 0;
+            Log(VerbosityLevel_Graphics, "Instancing is %s", isSupported == true ? "supported" : "not supported, using the vertex path");
+        }
+        
+        return m_InstancingSupported == 1;
+    }
+    
+    unsigned int SpriteBatch::GetDrawCallsPerFrame()
+    {
+        return m_DrawCallsPerFrame;
+    }
+    
+    unsigned int SpriteBatch::GetQuadsPerFrame()
+    {
+        return m_QuadsPerFrame;
+    }
+    
+    unsigned int SpriteBatch::GetInstancedDrawCallsPerFrame()
+    {
+        return m_InstancedDrawCallsPerFrame;
+    }
+    
+    unsigned int SpriteBatch::GetInstancesPerFrame()
+    {
+        return m_InstancesPerFrame;
+    }
+    
+    float SpriteBatch::GetInstancesPerDrawPerFrame()
+    {
+        if(m_InstancedDrawCallsPerFrame > 0)
+        {
+            return (float)m_InstancesPerFrame / (float)m_InstancedDrawCallsPerFrame;
+        }
+        return 0.0f;
+    }
+    
+    unsigned int SpriteBatch::GetCommandsPerFrame()
+    {
+        return m_CommandsPerFrame;
+    }
+    
+    float SpriteBatch::GetSortTimePerFrame()
+    {
+        return (float)(m_SortTimePerFrame * 1000.0);
+    }
+    
+    void SpriteBatch::ResetFrameStats()
+    {
+        //Store the last frame's stats and reset the counters
+        m_DrawCallsPerFrame = m_DrawCalls;
+        m_QuadsPerFrame = m_QuadCount;
+        m_InstancedDrawCallsPerFrame = m_InstancedDrawCalls;
+        m_InstancesPerFrame = m_InstanceCount;
+        m_CommandsPerFrame = m_CommandCount;
+        m_SortTimePerFrame = m_SortTime;
+        m_DrawCalls = 0;
+        m_QuadCount = 0;
+        m_InstancedDrawCalls = 0;
+        m_InstanceCount = 0;
+        m_CommandCount = 0;
+        m_SortTime = 0.0;
+    }
+    
+    void SpriteBatch::CreateBuffers()
+    {
+        //Generate the VAO and bind it, the index buffer binding is part of the VAO's state
+        glGenVertexArrays(1, &m_VertexArrayObject);
+        ServiceLocator::GetGraphics()->BindVertexArray(m_VertexArrayObject);
+        
+        //Generate the streaming vertex buffer
+        glGenBuffers(1, &m_VertexBufferObject);
+        
+        //Create the indices for a full batch, each quad is made up of two triangles
+        const unsigned int indexCount = SPRITE_BATCH_MAX_QUADS * SPRITE_BATCH_INDICES_PER_QUAD;
+        unsigned short* indices = new unsigned short[indexCount];
+        for(unsigned int i = 0; i < SPRITE_BATCH_MAX_QUADS; i++)
+        {
+            unsigned short vertex = (unsigned short)(i * SPRITE_BATCH_VERTICES_PER_QUAD);
+            unsigned int offset = i * SPRITE_BATCH_INDICES_PER_QUAD;
+            indices[offset] = vertex;
+            indices[offset+1] = vertex + 1;
+            indices[offset+2] = vertex + 2;
+            indices[offset+3] = vertex + 2;
+            indices[offset+4] = vertex + 1;
+            indices[offset+5] = vertex + 3;
+        }
+        
+        //Generate the index buffer and set the index data, it never changes
+        glGenBuffers(1, &m_IndexBufferObject);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * indexCount, indices, GL_STATIC_DRAW);
+        
+        //Delete the indices array
+        SafeDeleteArray(indices);
+        
+        //Unbind the VAO
+        ServiceLocator::GetGraphics()->BindVertexArray(0);
+    }
+    
+    void SpriteBatch::SetVertexAttributes(Shader* aShader)
+    {
+        //The attribute locations only need to be set when the shader changes
+        if(aShader == m_AttributeShader)
+        {
+            return;
+        }
+        m_AttributeShader = aShader;
+        
+        //Enable and set the shader's vertices attribute
+        int verticesIndex = aShader->GetAttribute("a_vertices");
+        glEnableVertexAttribArray(verticesIndex);
+        long verticesOffset = 0;
+        glVertexAttribPointer(verticesIndex, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteBatchVertex), (const GLvoid*)verticesOffset);
+        
+        //Enable and set the shader's texture coordinates attribute
+        int uvIndex = aShader->GetAttribute("a_textureCoordinates");
+        glEnableVertexAttribArray(uvIndex);
+        long uvOffset = 2 * sizeof(float);
+        glVertexAttribPointer(uvIndex, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteBatchVertex), (const GLvoid*)uvOffset);
+        
+        //Enable and set the shader's color attribute
+        int colorIndex = aShader->GetAttribute("a_textureColor");
+        glEnableVertexAttribArray(colorIndex);
+        long colorOffset = 4 * sizeof(float);
+        glVertexAttribPointer(colorIndex, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteBatchVertex), (const GLvoid*)colorOffset);
+    }
+    
+    void SpriteBatch::CreateInstanceBuffers()
+    {
+        //Generate the instancing VAO and the streaming instance buffer
+        glGenVertexArrays(1, &m_InstanceVertexArrayObject);
+        glGenBuffers(1, &m_InstanceBufferObject);
+    }
+    
+    void SpriteBatch::SetInstanceAttributes(Shader* aShader, unsigned int aFirstInstance)
+    {
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //Get the instance attribute locations
+        int transformIndex = aShader->GetAttribute("a_instanceTransform");
+        int translationIndex = aShader->GetAttribute("a_instanceTranslation");
+        int uvRectIndex = aShader->GetAttribute("a_instanceUvRect");
+        int colorIndex = aShader->GetAttribute("a_instanceColor");
+        
+        //The per vertex attribute and the attribute divisors only need to be set when the shader changes
+        if(aShader != m_InstanceAttributeShader)
+        {
+            m_InstanceAttributeShader = aShader;
+            
+            //Enable and set the shader's vertices attribute, from the shared unit quad
+            int verticesIndex = aShader->GetAttribute("a_vertices");
+            graphics->BindArrayBuffer(graphics->GetUnitQuadBuffer());
+            glEnableVertexAttribArray(verticesIndex);
+            long verticesOffset = 0;
+            glVertexAttribPointer(verticesIndex, 2, GL_FLOAT, GL_FALSE, sizeof(TextureFrameVertex), (const GLvoid*)verticesOffset);
+            
+            //Enable the instance attributes, they advance once per instance
+            glEnableVertexAttribArray(transformIndex);
+            glVertexAttribDivisor(transformIndex, 1);
+            glEnableVertexAttribArray(translationIndex);
+            glVertexAttribDivisor(translationIndex, 1);
+            glEnableVertexAttribArray(uvRectIndex);
+            glVertexAttribDivisor(uvRectIndex, 1);
+            glEnableVertexAttribArray(colorIndex);
+            glVertexAttribDivisor(colorIndex, 1);
+        }
+        
+        //Set the instance attributes, offset to the first instance of the group
+        graphics->BindArrayBuffer(m_InstanceBufferObject);
+        long instanceOffset = aFirstInstance * sizeof(SpriteBatchInstance);
+        glVertexAttribPointer(transformIndex, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteBatchInstance), (const GLvoid*)instanceOffset);
+        glVertexAttribPointer(translationIndex, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteBatchInstance), (const GLvoid*)(instanceOffset + 4 * sizeof(float)));
+        glVertexAttribPointer(uvRectIndex, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteBatchInstance), (const GLvoid*)(instanceOffset + 6 * sizeof(float)));
+        glVertexAttribPointer(colorIndex, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteBatchInstance), (const GLvoid*)(instanceOffset + 10 * sizeof(float)));
+    }
+    
+    Shader* SpriteBatch::GetInstancingShader()
+    {
+        //Is instancing enabled and supported?
+        if(m_InstancingEnabled == false || IsInstancingSupported() == false)
+        {
+            return nullptr;
+        }
+        
+        //Get the instancing shader, the ShaderManager only loads it once
+        Shader* shader = ServiceLocator::GetShaderManager()->GetShader("passThrough-tex-instanced", "passThrough-tex");
+        if(shader == nullptr)
+        {
+            vector<string> attributes;
+            attributes.push_back("a_vertices");
+            attributes.push_back("a_instanceTransform");
+            attributes.push_back("a_instanceTranslation");
+            attributes.push_back("a_instanceUvRect");
+            attributes.push_back("a_instanceColor");
+            shader = ServiceLocator::GetShaderManager()->LoadShader("passThrough-tex-instanced", "passThrough-tex", attributes);
+            
+            //If the instancing shader failed to load, fallback to the vertex path
+            if(shader == nullptr)
+            {
+                m_InstancingSupported = 0;
+            }
+        }
+        
+        return shader;
+    }
+    
+    unsigned long long SpriteBatch::MakeSortKey(Shader* aShader, Texture* aTexture, bool aBlending)
+    {
+        //The layer is the most significant byte of the key
+        unsigned long long sortKey = (unsigned long long)m_Layer << 56;
+        
+        //When sorting by texture, the shader program (16 bits), the texture id (24 bits) and the blending (1 bit)
+        //follow the layer. Ids that don't fit only cost a merged draw call, quads are still grouped by pointer
+        if(m_SortMode == SpriteBatchSortTexture)
+        {
+            sortKey |= ((unsigned long long)aShader->GetProgram() & 0xFFFF) << 40;
+            sortKey |= ((unsigned long long)aTexture->GetId() & 0xFFFFFF) << 16;
+            sortKey |= (unsigned long long)(aBlending == true ? 1 : 0) << 15;
+        }
+        
+        return sortKey;
+    }
+    
+    void SpriteBatch::SortCommands()
+    {
+        //Keep track of the number of commands sorted and the time it takes to sort them
+        unsigned int commandCount = (unsigned int)m_Commands.size();
+        m_CommandCount += commandCount;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        
+        //Cycle through the bytes of the sort key, from least significant to most significant
+        m_SortBuffer.resize(commandCount);
+        for(unsigned int shift = 0; shift < 64; shift += 8)
+        {
+            //Count the number of commands for each byte value
+            unsigned int counts[256] = {};
+            for(unsigned int i = 0; i < commandCount; i++)
+            {
+                counts[(m_Commands[i].sortKey >> shift) & 0xFF]++;
+            }
+            
+            //If every command has the same byte value, this pass wouldn't change the order
+            if(counts[(m_Commands[0].sortKey >> shift) & 0xFF] == commandCount)
+            {
+                continue;
+            }
+            
+            //Turn the counts into the offsets for each byte value
+            unsigned int offset = 0;
+            for(unsigned int i = 0; i < 256; i++)
+            {
+                unsigned int count = counts[i];
+                counts[i] = offset;
+                offset += count;
+            }
+            
+            //Scatter the commands into the sort buffer, in order, and swap the buffers
+            for(unsigned int i = 0; i < commandCount; i++)
+            {
+                m_SortBuffer[counts[(m_Commands[i].sortKey >> shift) & 0xFF]++] = m_Commands[i];
+            }
+            m_Commands.swap(m_SortBuffer);
+        }
+        
+        //Accumulate the sort time, in seconds
+        m_SortTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+//
+//  SpriteBatch.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__SpriteBatch__
+#define __GameDev2D__SpriteBatch__
+
+#include "../../Core/BaseObject.h"
+#include "../../Graphics/OpenGL.h"
+#include "../../Graphics/Core/Color.h"
+#include <glm.hpp>
+
+
+using namespace glm;
+using namespace std;
+
+namespace GameDev2D
+{
+    //SpriteBatch constants
+    const unsigned int SPRITE_BATCH_MAX_QUADS = 2048;
+    const unsigned int SPRITE_BATCH_VERTICES_PER_QUAD = 4;
+    const unsigned int SPRITE_BATCH_INDICES_PER_QUAD = 6;
+    
+    //Forward declarations
+    class Shader;
+    class Texture;
+    class TextureFrame;
+    struct SourceFrame;
+    
+    //Sort modes for the SpriteBatch, by default the draw order is preserved and only consecutive
+    //quads that share the same Shader, Texture and blending are merged into a single draw call.
+    //SpriteBatchSortTexture will also regroup quads by Shader and Texture within each layer, this
+    //results in the least amount of draw calls but should only be used when overlapping sprites
+    //in the same layer don't depend on the order they were drawn in.
+    enum SpriteBatchSortMode
+    {
+        SpriteBatchSortNone = 0,
+        SpriteBatchSortTexture
+    };
+    
+    //The SpriteBatch collects pre-transformed TextureFrame quads between a Begin() and End() call and renders
+    //all the quads that share a Shader, Texture and blend state with a single draw call, from one streaming
+    //vertex buffer. It is owned by the Graphics service, a Scene can opt-in to batching its Sprites. Any draw
+    //call that doesn't go through the SpriteBatch (or any change to the render target, camera or scissor clip)
+    //will flush the quads collected so far, to ensure the draw order is maintained. Adding a quad submits the
+    //Graphics service's RenderQueue, for the same reason.
+    //When instancing is enabled and supported (OpenGL 3.3 or OpenGL ES 3.0), quads that use the pass through texture
+    //shader are submitted as one instance record each (transform, uv rect and color) and are rendered with a single
+    //glDrawArraysInstanced() call per group, using the passThrough-tex-instanced vertex shader. Otherwise, or for
+    //quads that use any other shader, the pre-transformed vertex path is used.
+    //Each quad is recorded as a render command, a 64-bit sort key (layer, shader, texture and blending) and
+    //the quad's index in the frame's quad buffer. The commands are radix sorted before they are submitted,
+    //the sort is stable so quads with the same key are drawn in the order they were added.
+    class SpriteBatch : public BaseObject
+    {
+    public:
+        SpriteBatch();
+        ~SpriteBatch();
+        
+        //Starts collecting quads, any quads that were already collected will be flushed
+        void Begin(SpriteBatchSortMode sortMode = SpriteBatchSortNone);
+        
+        //Flushes the collected quads and stops collecting quads
+        void End();
+        
+        //Returns wether the SpriteBatch is between a Begin() and End() call
+        bool IsBatching();
+        
+        //Adds a quad for the TextureFrame, transformed by the model matrix
+        void AddQuad(TextureFrame* textureFrame, const mat4& modelMatrix);
+        
+        //Adds a quad for a source frame of a Texture, transformed by the model matrix. Used by
+        //objects that render a Texture without a TextureFrame, such as an AnimationClip
+        void AddQuad(Shader* shader, Texture* texture, const SourceFrame& sourceFrame, const ColorRGBA& color, const mat4& modelMatrix);
+        
+        //Renders all the collected quads, called automatically whenever the draw order requires it
+        void Flush();
+        
+        //Sets the layer for the quads added after this call, lower layers are drawn first. The Scene
+        //sets the layer to the depth of the GameObject it is drawing, the layer is reset by Begin()
+        void SetLayer(unsigned char layer);
+        unsigned char GetLayer();
+        
+        //Sets wether quads are rendered with instancing, if instancing isn't supported by the
+        //open gl context the SpriteBatch falls back to the pre-transformed vertex path
+        void SetInstancingEnabled(bool instancingEnabled);
+        bool IsInstancingEnabled();
+        
+        //Returns wether instancing is supported by the open gl context
+        bool IsInstancingSupported();
+        
+        //Returns the number of draw calls and quads that were flushed last frame
+        unsigned int GetDrawCallsPerFrame();
+        unsigned int GetQuadsPerFrame();
+        
+        //Returns the number of instanced draw calls and instances that were flushed last frame,
+        //as well as the average number of instances per instanced draw call
+        unsigned int GetInstancedDrawCallsPerFrame();
+        unsigned int GetInstancesPerFrame();
+        float GetInstancesPerDrawPerFrame();
+        
+        //Returns the number of render commands that were sorted last frame and the time
+        //it took to sort them, in milliseconds (the sort time is only measured in debug)
+        unsigned int GetCommandsPerFrame();
+        float GetSortTimePerFrame();
+    
+    protected:
+        //Called from the Graphics service at the start of every frame
+        void ResetFrameStats();
+        
+        //The Graphics service needs to access the protected methods
+        friend class Graphics;
+    
+    private:
+        //Interleaved vertex format used by the SpriteBatch, the color is packed into 4 bytes
+        struct SpriteBatchVertex
+        {
+            float x, y;
+            float u, v;
+            ColorRGBA8 color;
+        };
+        
+        //Per instance record used by the instancing path, the transform holds the 2x2 rotation and
+        //scale part of the model matrix (including the quad's size), the uv rect is: x1, y1, x2, y2
+        struct SpriteBatchInstance
+        {
+            float transform[4];
+            float translation[2];
+            float uvRect[4];
+            ColorRGBA8 color;
+        };
+        
+        //Keeps track of a quad and its render state until it is flushed
+        struct SpriteBatchQuad
+        {
+            Shader* shader;
+            Texture* texture;
+            bool blending;
+            SpriteBatchVertex vertices[SPRITE_BATCH_VERTICES_PER_QUAD];
+            SpriteBatchInstance instance;
+        };
+        
+        //A render command, the sort key and the index of the quad it renders
+        struct SpriteBatchCommand
+        {
+            unsigned long long sortKey;
+            unsigned int quadIndex;
+        };
+        
+        //Conveniance method to build the sort key for a quad, the layer is always the most significant
+        //byte. The Shader, Texture and blending are only part of the key when sorting by texture
+        unsigned long long MakeSortKey(Shader* shader, Texture* texture, bool blending);
+        
+        //Conveniance method to sort the render commands, using a stable least significant digit radix
+        //sort, one byte per pass. Passes where every command has the same byte are skipped
+        void SortCommands();
+        
+        //Conveniance method to create the vertex array, vertex buffer and index buffer
+        void CreateBuffers();
+        
+        //Conveniance method to set the shader's vertex attributes for the interleaved vertex format
+        void SetVertexAttributes(Shader* shader);
+        
+        //Conveniance method to create the instancing vertex array and instance buffer
+        void CreateInstanceBuffers();
+        
+        //Conveniance method to set the instancing shader's attributes, the instance attributes
+        //point to the first instance of the group that is about to be drawn
+        void SetInstanceAttributes(Shader* shader, unsigned int firstInstance);
+        
+        //Returns the instancing shader, if instancing is enabled and supported, otherwise null
+        Shader* GetInstancingShader();
+        
+        //Member variables
+        vector<SpriteBatchQuad> m_Quads;
+        vector<SpriteBatchCommand> m_Commands;
+        vector<SpriteBatchCommand> m_SortBuffer;
+        vector<SpriteBatchQuad*> m_SortedQuads;
+        vector<SpriteBatchVertex> m_Vertices;
+        vector<SpriteBatchInstance> m_Instances;
+        SpriteBatchSortMode m_SortMode;
+        unsigned char m_Layer;
+        bool m_IsBatching;
+        Shader* m_AttributeShader;
+        unsigned int m_VertexArrayObject;
+        unsigned int m_VertexBufferObject;
+        unsigned int m_IndexBufferObject;
+        unsigned int m_VertexBufferCapacity;
+        
+        //Instancing member variables, the instancing support is determined on first use (-1 unknown, 0 no, 1 yes)
+        bool m_InstancingEnabled;
+        int m_InstancingSupported;
+        Shader* m_InstanceAttributeShader;
+        unsigned int m_InstanceVertexArrayObject;
+        unsigned int m_InstanceBufferObject;
+        unsigned int m_InstanceBufferCapacity;
+        
+        //Stats member variables
+        unsigned int m_DrawCalls;
+        unsigned int m_QuadCount;
+        unsigned int m_InstancedDrawCalls;
+        unsigned int m_InstanceCount;
+        unsigned int m_DrawCallsPerFrame;
+        unsigned int m_QuadsPerFrame;
+        unsigned int m_InstancedDrawCallsPerFrame;
+        unsigned int m_InstancesPerFrame;
+        unsigned int m_CommandCount;
+        unsigned int m_CommandsPerFrame;
+        double m_SortTime;
+        double m_SortTimePerFrame;
+    };
+}
+
+#endif /* defined(__GameDev2D__SpriteBatch__) */
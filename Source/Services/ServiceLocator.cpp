@@ -45,7 +45,9 @@ namespace GameDev2D
         AddService(new TextureManager());
         AddService(new Graphics());
         AddService(new InputManager());
-        AddService(new AudioManager());
+        #if !HEADLESS_OPENGL
+        AddService(new AudioManager()); //The headless build doesn't link against FMOD
+        #endif
         AddService(new FontManager());
         AddService(new SceneManager());
         AddService(new LoadingUI());
@@ -196,6 +198,12 @@ namespace GameDev2D
         RemoveService(s_FontManager);
         RemoveService(s_AudioManager);
         RemoveService(s_InputManager);
+        
+        //The textures are deleted through the Graphics service, cached textures outlive the Scenes so they are unloaded first
+        if(s_TextureManager != nullptr)
+        {
+            s_TextureManager->UnloadTextures();
+        }
         RemoveService(s_Graphics);
         RemoveService(s_TextureManager);
         RemoveService(s_ShaderManager);
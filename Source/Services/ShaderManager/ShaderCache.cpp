@@ -0,0 +1,270 @@
+//
+//  ShaderCache.cpp
+//  GameDev2D
+//
+
+#include "ShaderCache.h"
+#include "../ServiceLocator.h"
+#include "../../Platforms/PlatformLayer.h"
+
+
+//The shader cache file starts with the magic number and version, if either doesn't match the file is ignored
+#define SHADER_CACHE_MAGIC 0x48534447
+#define SHADER_CACHE_VERSION 1
+
+
+namespace GameDev2D
+{
+    ShaderCache::ShaderCache(const string& aPath) : BaseObject("ShaderCache"),
+        m_Path(aPath),
+        m_Driver(""),
+        m_IsSupported(false),
+        m_IsDirty(false),
+        m_HitCount(0),
+        m_MissCount(0)
+    {
+        //Does the OpenGL implementation support any program binary formats?
+        GLint numberOfFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numberOfFormats);
+        m_IsSupported = numberOfFormats > 0;
+        
+        //On Windows the function pointers also have to be loaded
+        #if _WIN32 && !HEADLESS_OPENGL
+        if(glGetProgramBinary == nullptr || glProgramBinary == nullptr || glProgramParameteri == nullptr)
+        {
+            m_IsSupported = false;
+        }
+        #endif
+        
+        //Program binaries are only valid for the driver that created them
+        const char* strings[] = { (const char*)glGetString(GL_VENDOR), (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION) };
+        for(unsigned int i = 0; i < 3; i++)
+        {
+            if(strings[i] != nullptr)
+            {
+                m_Driver += string(strings[i]);
+            }
+            m_Driver += "\n";
+        }
+        
+        //Read the cached program binaries
+        if(m_IsSupported == true)
+        {
+            Read();
+        }
+        else
+        {
+            Log(VerbosityLevel_Shaders, "Program binaries aren't supported, the shaders will be compiled");
+        }
+    }
+    
+    ShaderCache::~ShaderCache()
+    {
+    
+    }
+    
+    bool ShaderCache::IsSupported()
+    {
+        return m_IsSupported;
+    }
+    
+    unsigned long long ShaderCache::Hash(const string& aVertexSource, const string& aFragmentSource, const vector<string>& aAttributes)
+    {
+        //Combine everything that affects the linked program
+        string data = aVertexSource + '\0' + aFragmentSource + '\0';
+        for(unsigned int i = 0; i < aAttributes.size(); i++)
+        {
+            data += aAttributes.at(i) + '\0';
+        }
+        data += m_Driver;
+        
+        //Hash the data with 64 bit FNV-1a
+        unsigned long long hash = 14695981039346656037ULL;
+        for(unsigned int i = 0; i < data.length(); i++)
+        {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+    
+    bool ShaderCache::Load(Shader* aShader, unsigned long long aHash)
+    {
+        //Safety check the shader
+        if(m_IsSupported == false || aShader == nullptr)
+        {
+            return false;
+        }
+        
+        //Is there a cached program binary for the shader, with the same hash?
+        map<string, ShaderCacheEntry>::iterator it = m_Entries.find(aShader->GetKey());
+        if(it == m_Entries.end() || it->second.hash != aHash || it->second.binary.size() == 0)
+        {
+            m_MissCount++;
+            return false;
+        }
+        
+        //Link the shader from the program binary, if the driver rejects it the entry is stale
+        if(aShader->LinkProgramBinary(it->second.format, &it->second.binary[0], (GLsizei)it->second.binary.size()) == false)
+        {
+            m_Entries.erase(it);
+            m_IsDirty = true;
+            m_MissCount++;
+            return false;
+        }
+        
+        //The shader was linked from the cache
+        Log(VerbosityLevel_Shaders, "Loaded shader %s from the program binary cache", aShader->GetKey().c_str());
+        m_HitCount++;
+        return true;
+    }
+    
+    void ShaderCache::Store(Shader* aShader, unsigned long long aHash)
+    {
+        //Safety check the shader
+        if(m_IsSupported == false || aShader == nullptr)
+        {
+            return;
+        }
+        
+        //Get the program binary, it replaces any previous entry for the shader's key
+        ShaderCacheEntry entry;
+        GLenum format = 0;
+        if(aShader->GetProgramBinary(format, entry.binary) == true)
+        {
+            entry.hash = aHash;
+            entry.format = format;
+            m_Entries[aShader->GetKey()] = entry;
+            m_IsDirty = true;
+        }
+    }
+    
+    void ShaderCache::Save()
+    {
+        //Only write the file if a program binary was stored
+        if(m_IsDirty == false)
+        {
+            return;
+        }
+        
+        //Open the file
+        FILE* file = fopen(m_Path.c_str(), "wb");
+        if(file == nullptr)
+        {
+            Log(VerbosityLevel_Shaders, "Failed to write the shader cache file: %s", m_Path.c_str());
+            return;
+        }
+        
+        //Write the header
+        unsigned int header[] = { SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, (unsigned int)m_Entries.size() };
+        fwrite(header, sizeof(header), 1, file);
+        
+        //Write each entry: the key length, key, hash, format, binary length and binary
+        for(map<string, ShaderCacheEntry>::iterator it = m_Entries.begin(); it != m_Entries.end(); ++it)
+        {
+            unsigned int keyLength = (unsigned int)it->first.length();
+            unsigned int length = (unsigned int)it->second.binary.size();
+            fwrite(&keyLength, sizeof(keyLength), 1, file);
+            fwrite(it->first.c_str(), 1, keyLength, file);
+            fwrite(&it->second.hash, sizeof(it->second.hash), 1, file);
+            fwrite(&it->second.format, sizeof(it->second.format), 1, file);
+            fwrite(&length, sizeof(length), 1, file);
+            if(length > 0)
+            {
+                fwrite(&it->second.binary[0], 1, length, file);
+            }
+        }
+        
+        //Close the file
+        fclose(file);
+        m_IsDirty = false;
+    }
+    
+    unsigned int ShaderCache::GetHitCount()
+    {
+        return m_HitCount;
+    }
+    
+    unsigned int ShaderCache::GetMissCount()
+    {
+        return m_MissCount;
+    }
+    
+    void ShaderCache::Read()
+    {
+        //Is there a shader cache file?
+        PlatformLayer* platformLayer = ServiceLocator::GetPlatformLayer();
+        if(platformLayer->DoesFileExistAtPath(m_Path) == false)
+        {
+            return;
+        }
+        
+        //Map the file
+        unsigned int size = 0;
+        const unsigned char* data = (const unsigned char*)platformLayer->MapFile(m_Path, size);
+        if(data == nullptr)
+        {
+            return;
+        }
+        
+        //Check the header
+        unsigned int header[3];
+        unsigned int offset = sizeof(header);
+        if(size >= offset)
+        {
+            memcpy(header, data, sizeof(header));
+        }
+        if(size < offset || header[0] != SHADER_CACHE_MAGIC || header[1] != SHADER_CACHE_VERSION)
+        {
+            Log(VerbosityLevel_Shaders, "Ignoring the invalid shader cache file: %s", m_Path.c_str());
+            platformLayer->UnmapFile(data, size);
+            return;
+        }
+        
+        //Read each entry, stop at the first entry that goes past the end of the file
+        for(unsigned int i = 0; i < header[2]; i++)
+        {
+            //Read the key
+            unsigned int keyLength = 0;
+            if(size - offset < sizeof(keyLength))
+            {
+                break;
+            }
+            memcpy(&keyLength, data + offset, sizeof(keyLength));
+            offset += sizeof(keyLength);
+            if(size - offset < keyLength)
+            {
+                break;
+            }
+            string key((const char*)(data + offset), keyLength);
+            offset += keyLength;
+            
+            //Read the hash, format and binary length
+            ShaderCacheEntry entry;
+            unsigned int length = 0;
+            if(size - offset < sizeof(entry.hash) + sizeof(entry.format) + sizeof(length))
+            {
+                break;
+            }
+            memcpy(&entry.hash, data + offset, sizeof(entry.hash));
+            offset += sizeof(entry.hash);
+            memcpy(&entry.format, data + offset, sizeof(entry.format));
+            offset += sizeof(entry.format);
+            memcpy(&length, data + offset, sizeof(length));
+            offset += sizeof(length);
+            
+            //Read the binary
+            if(size - offset < length)
+            {
+                break;
+            }
+            entry.binary.assign(data + offset, data + offset + length);
+            offset += length;
+            m_Entries[key] = entry;
+        }
+        
+        //Unmap the file
+        platformLayer->UnmapFile(data, size);
+        Log(VerbosityLevel_Shaders, "Read %u program binaries from the shader cache file", (unsigned int)m_Entries.size());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+//
+//  ShaderCache.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__ShaderCache__
+#define __GameDev2D__ShaderCache__
+
+#include "../../Core/BaseObject.h"
+#include "../../Graphics/Core/Shader.h"
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //A linked program binary, keyed by the hash of the shader it was linked from
+    struct ShaderCacheEntry
+    {
+        unsigned long long hash;
+        unsigned int format;
+        vector<unsigned char> binary;
+    };
+    
+    //The ShaderCache stores the linked program binaries of the ShaderManager's shaders in a file in the working directory,
+    //so the shaders don't have to be compiled and linked every time the game is launched. Each program binary is stored
+    //with a hash of the shader's sources, attributes and the OpenGL vendor, renderer and version strings, if any of them
+    //change the hash doesn't match and the shader is compiled and linked again. The cache is disabled if the OpenGL
+    //implementation doesn't support any program binary formats (it requires OpenGL 4.1 or OpenGL ES 3).
+    class ShaderCache : public BaseObject
+    {
+    public:
+        ShaderCache(const string& path);
+        ~ShaderCache();
+        
+        //Returns wether the OpenGL implementation supports program binaries
+        bool IsSupported();
+        
+        //Returns the hash of a shader's sources, attributes and the OpenGL implementation
+        unsigned long long Hash(const string& vertexSource, const string& fragmentSource, const vector<string>& attributes);
+        
+        //Links the shader from its cached program binary, returns false if there isn't a cached program
+        //binary for the shader's key with the same hash, or if the driver rejected the program binary
+        bool Load(Shader* shader, unsigned long long hash);
+        
+        //Stores the program binary of a linked shader, it is written to the file by Save()
+        void Store(Shader* shader, unsigned long long hash);
+        
+        //Writes the program binaries to the file, if any were stored since the file was last written
+        void Save();
+        
+        //Returns the number of shaders that were linked from a cached program binary and the number that were compiled
+        unsigned int GetHitCount();
+        unsigned int GetMissCount();
+    
+    private:
+        //Reads the program binaries from the file
+        void Read();
+        
+        //Member variables
+        map<string, ShaderCacheEntry> m_Entries;
+        string m_Path;
+        string m_Driver;
+        bool m_IsSupported;
+        bool m_IsDirty;
+        unsigned int m_HitCount;
+        unsigned int m_MissCount;
+    };
+}
+
+#endif /* defined(__GameDev2D__ShaderCache__) */
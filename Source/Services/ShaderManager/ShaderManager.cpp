@@ -10,12 +10,40 @@
 #include "../ServiceLocator.h"
 #include "../../Platforms/PlatformLayer.h"
 #include "../../IO/File.h"
+#include <chrono>
+
+
+#ifndef SHADER_VALIDATE_EVERY_DRAW
+#define SHADER_VALIDATE_EVERY_DRAW 0
+#endif
+
+#ifndef SHADER_BINARY_CACHE_ENABLED
+#define SHADER_BINARY_CACHE_ENABLED 1
+#endif
+
+#ifndef SHADER_BINARY_CACHE_FILE
+#define SHADER_BINARY_CACHE_FILE "/ShaderCache.bin"
+#endif
 
 
 namespace GameDev2D
 {
-    ShaderManager::ShaderManager() : GameService("ShaderManager")
+    ShaderManager::ShaderManager() : GameService("ShaderManager"),
+        m_ShaderCache(nullptr),
+        m_StartupTime(0.0),
+        m_CompiledShaderCount(0),
+        m_ValidateEveryDraw(SHADER_VALIDATE_EVERY_DRAW),
+        m_ValidationsPerFrame(0),
+        m_CachedValidationsPerFrame(0)
     {
+        //Profile how long it takes to load the default shaders
+        BeginProfile("ShaderManager startup");
+        
+        //Create the program binary cache, the shaders linked from it don't have to be compiled
+        #if SHADER_BINARY_CACHE_ENABLED
+        m_ShaderCache = new ShaderCache(ServiceLocator::GetPlatformLayer()->GetWorkingDirectory() + SHADER_BINARY_CACHE_FILE);
+        #endif
+        
         //Load the pass through shader
         vector<string> attributes;
         attributes.push_back("a_vertices");
@@ -29,10 +57,27 @@ namespace GameDev2D
         attributes.push_back("a_textureCoordinates");
         attributes.push_back("a_textureColor");
         LoadShader("passThrough-tex", attributes);
+        
+        //Write any newly linked program binaries to the cache file
+        if(m_ShaderCache != nullptr)
+        {
+            m_ShaderCache->Save();
+        }
+        
+        //Log the startup time
+        m_StartupTime = EndProfile();
+        Log(VerbosityLevel_Shaders, "Loaded %u shaders in %f seconds, %u from the program binary cache and %u compiled", (unsigned int)m_ShaderMap.size(), m_StartupTime, GetCachedShaderCount(), GetCompiledShaderCount());
     }
 
     ShaderManager::~ShaderManager()
     {
+        //Write any program binaries that were linked since startup, then delete the cache
+        if(m_ShaderCache != nullptr)
+        {
+            m_ShaderCache->Save();
+        }
+        SafeDelete(m_ShaderCache);
+        
         //Unload all the shaders
         while(m_ShaderMap.size() > 0)
         {
@@ -203,15 +248,27 @@ namespace GameDev2D
             //Create a new shader with the vertex and fragment shaders
             Shader* shader = new Shader(vertexSource, fragmentSource);
             shader->SetKey(key);
+            shader->SetValidateEveryDraw(m_ValidateEveryDraw);
             
-            //Cycle through the attributes and add them to the shader
+            //Cycle through the attributes and add them to the shader, they are bound before the
+            //program is linked, either from the cached program binary or by compiling the shaders
             for(unsigned int i = 0; i < aAttributes.size(); i++)
             {
                 shader->AddAttribute(aAttributes.at(i).c_str());
             }
             
-            //Link the shader
-            shader->Link();
+            //Link the shader from the program binary cache, if there is a matching program binary
+            unsigned long long hash = m_ShaderCache != nullptr ? m_ShaderCache->Hash(vertexSource, fragmentSource, aAttributes) : 0;
+            if(m_ShaderCache == nullptr || m_ShaderCache->Load(shader, hash) == false)
+            {
+                //Otherwise compile and link the shader, and store its program binary in the cache
+                shader->Link(m_ShaderCache != nullptr && m_ShaderCache->IsSupported() == true);
+                m_CompiledShaderCount++;
+                if(m_ShaderCache != nullptr)
+                {
+                    m_ShaderCache->Store(shader, hash);
+                }
+            }
             
             //Set the shader map pair for the filename key
             m_ShaderMap[key] = shader;
@@ -253,9 +310,108 @@ namespace GameDev2D
         return GetShader("passThrough-tex");
     }
 
+    void ShaderManager::SetValidateEveryDraw(bool aValidateEveryDraw)
+    {
+        //Set the validate every draw flag
+        m_ValidateEveryDraw = aValidateEveryDraw;
+        
+        //Cycle through and set the flag on all the loaded shaders
+        for(map<string, Shader*>::iterator it = m_ShaderMap.begin(); it != m_ShaderMap.end(); ++it)
+        {
+            if(it->second != nullptr)
+            {
+                it->second->SetValidateEveryDraw(m_ValidateEveryDraw);
+            }
+        }
+    }
+    
+    bool ShaderManager::IsValidatingEveryDraw()
+    {
+        return m_ValidateEveryDraw;
+    }
+    
+    unsigned int ShaderManager::GetValidationsPerFrame()
+    {
+        return m_ValidationsPerFrame;
+    }
+    
+    unsigned int ShaderManager::GetCachedValidationsPerFrame()
+    {
+        return m_CachedValidationsPerFrame;
+    }
+    
+    void ShaderManager::BenchmarkValidation(Shader* aShader, unsigned int aIterations)
+    {
+        //Safety check the shader and the iterations
+        if(aShader == nullptr || aIterations == 0)
+        {
+            return;
+        }
+        
+        //The shader has to be in use to be validated
+        aShader->Use();
+        bool validateEveryDraw = aShader->m_ValidateEveryDraw;
+        unsigned int validationCount = aShader->GetValidationCount();
+        unsigned int cachedValidationCount = aShader->GetCachedValidationCount();
+        
+        //Time the validations, the first pass validates every time, the second pass uses the cached validation state
+        double duration[2];
+        for(unsigned int pass = 0; pass < 2; pass++)
+        {
+            aShader->SetValidateEveryDraw(pass == 0);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for(unsigned int i = 0; i < aIterations; i++)
+            {
+                aShader->Validate();
+            }
+            duration[pass] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+        
+        //Restore the shader's validation setting and stats, the benchmark shouldn't show up in the per frame stats
+        aShader->SetValidateEveryDraw(validateEveryDraw);
+        aShader->m_ValidationCount = validationCount;
+        aShader->m_CachedValidationCount = cachedValidationCount;
+        
+        //Log the results
+        Log(VerbosityLevel_Shaders, "Validated shader %s %u times: %f ms without the validation cache, %f ms with it", aShader->GetKey().c_str(), aIterations, duration[0], duration[1]);
+    }
+    
+    double ShaderManager::GetStartupTime()
+    {
+        return m_StartupTime;
+    }
+    
+    unsigned int ShaderManager::GetCachedShaderCount()
+    {
+        return m_ShaderCache != nullptr ? m_ShaderCache->GetHitCount() : 0;
+    }
+    
+    unsigned int ShaderManager::GetCompiledShaderCount()
+    {
+        return m_CompiledShaderCount;
+    }
+    
+    void ShaderManager::Update(double aDelta)
+    {
+        //Reset the per frame stats
+        m_ValidationsPerFrame = 0;
+        m_CachedValidationsPerFrame = 0;
+        
+        //Cycle through the loaded shaders and add up last frame's validation stats
+        for(map<string, Shader*>::iterator it = m_ShaderMap.begin(); it != m_ShaderMap.end(); ++it)
+        {
+            if(it->second != nullptr)
+            {
+                m_ValidationsPerFrame += it->second->GetValidationCount();
+                m_CachedValidationsPerFrame += it->second->GetCachedValidationCount();
+                it->second->ResetValidationStats();
+            }
+        }
+    }
+
     bool ShaderManager::CanUpdate()
     {
-        return false;
+        return true;
     }
     
     bool ShaderManager::CanDraw()
@@ -11,6 +11,7 @@
 
 #include "../GameService.h"
 #include "../../Graphics/Core/Shader.h"
+#include "ShaderCache.h"
 
 
 using namespace std;
@@ -39,6 +40,29 @@ namespace GameDev2D
         Shader* GetPassthroughShader();
         Shader* GetPassthroughTextureShader();
         
+        //Sets wether all the shaders are validated on every draw call, by default the validation state is
+        //cached and only re-validated when the bound state changes. Useful for debugging shader problems
+        void SetValidateEveryDraw(bool validateEveryDraw);
+        bool IsValidatingEveryDraw();
+        
+        //Returns the number of shader validations that were issued and skipped (cached) last frame
+        unsigned int GetValidationsPerFrame();
+        unsigned int GetCachedValidationsPerFrame();
+        
+        //Measures the cost of validating a shader against the bound state, without and then with the cached validation
+        //state. The shader is validated the number of iterations each way, the times are logged, in milliseconds
+        void BenchmarkValidation(Shader* shader, unsigned int iterations);
+        
+        //Returns the time it took to construct the ShaderManager and load the default shaders, in seconds (debug only)
+        double GetStartupTime();
+        
+        //Returns the number of shaders that were linked from the program binary cache and the number that were compiled
+        unsigned int GetCachedShaderCount();
+        unsigned int GetCompiledShaderCount();
+        
+        //Updates the ShaderManager, resets the per frame stats
+        void Update(double delta);
+        
         //Tells the ServiceLocator wether to Update and Draw this Game Service
         bool CanUpdate();
         bool CanDraw();
@@ -46,6 +70,12 @@ namespace GameDev2D
     private:
         //Member variables
         map<string, Shader*> m_ShaderMap;
+        ShaderCache* m_ShaderCache;
+        double m_StartupTime;
+        unsigned int m_CompiledShaderCount;
+        bool m_ValidateEveryDraw;
+        unsigned int m_ValidationsPerFrame;
+        unsigned int m_CachedValidationsPerFrame;
     };
 }
 
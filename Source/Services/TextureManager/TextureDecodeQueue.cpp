@@ -0,0 +1,174 @@
+//
+//  TextureDecodeQueue.cpp
+//  GameDev2D
+//
+
+#include "TextureDecodeQueue.h"
+
+
+namespace GameDev2D
+{
+    TextureDecodeQueue::TextureDecodeQueue(unsigned int aThreadCount) : BaseObject("TextureDecodeQueue"),
+        m_DecodingCount(0),
+        m_IsStopping(false)
+    {
+        //There must be at least one worker thread
+        unsigned int threadCount = aThreadCount > 0 ? aThreadCount : 1;
+        
+        //Start the worker threads
+        for(unsigned int i = 0; i < threadCount; i++)
+        {
+            m_Threads.push_back(thread(&TextureDecodeQueue::DecodeThread, this));
+        }
+    }
+    
+    TextureDecodeQueue::~TextureDecodeQueue()
+    {
+        //Signal the worker threads to stop
+        {
+            lock_guard<mutex> lock(m_Mutex);
+            m_IsStopping = true;
+        }
+        m_Condition.notify_all();
+        
+        //Wait for the worker threads to finish the requests they are decoding
+        for(unsigned int i = 0; i < m_Threads.size(); i++)
+        {
+            m_Threads.at(i).join();
+        }
+        m_Threads.clear();
+        
+        //Delete the requests that were never decoded
+        while(m_PendingRequests.size() > 0)
+        {
+            SafeDelete(m_PendingRequests.front());
+            m_PendingRequests.pop_front();
+        }
+        
+        //Delete the decoded requests that were never popped, and their image data
+        while(m_DecodedRequests.size() > 0)
+        {
+            SafeFree(m_DecodedRequests.front()->imageData.data);
+            SafeDelete(m_DecodedRequests.front());
+            m_DecodedRequests.pop_front();
+        }
+    }
+    
+    void TextureDecodeQueue::Push(TextureDecodeRequest* aRequest)
+    {
+        //Safety check the request
+        if(aRequest == nullptr)
+        {
+            return;
+        }
+        
+        //Add the request and wake up a worker thread
+        {
+            lock_guard<mutex> lock(m_Mutex);
+            m_PendingRequests.push_back(aRequest);
+        }
+        m_Condition.notify_one();
+    }
+    
+    TextureDecodeRequest* TextureDecodeQueue::PopDecoded()
+    {
+        lock_guard<mutex> lock(m_Mutex);
+        
+        //Are there any decoded requests
+        if(m_DecodedRequests.size() == 0)
+        {
+            return nullptr;
+        }
+        
+        //Pop the oldest decoded request
+        TextureDecodeRequest* request = m_DecodedRequests.front();
+        m_DecodedRequests.pop_front();
+        return request;
+    }
+    
+    TextureDecodeRequest* TextureDecodeQueue::FinishRequest(const string& aFilename)
+    {
+        unique_lock<mutex> lock(m_Mutex);
+        while(true)
+        {
+            //Has a worker thread started decoding the request? If it hasn't, decode it on the calling thread
+            for(deque<TextureDecodeRequest*>::iterator it = m_PendingRequests.begin(); it != m_PendingRequests.end(); ++it)
+            {
+                if((*it)->filename == aFilename)
+                {
+                    TextureDecodeRequest* request = *it;
+                    m_PendingRequests.erase(it);
+                    lock.unlock();
+                    
+                    //Read, decode and flip the image, without holding the lock
+                    request->didDecode = Texture::DecodeFromPath(request->path, request->imageData);
+                    return request;
+                }
+            }
+            
+            //Has the request already been decoded?
+            for(deque<TextureDecodeRequest*>::iterator it = m_DecodedRequests.begin(); it != m_DecodedRequests.end(); ++it)
+            {
+                if((*it)->filename == aFilename)
+                {
+                    TextureDecodeRequest* request = *it;
+                    m_DecodedRequests.erase(it);
+                    return request;
+                }
+            }
+            
+            //If no request is being decoded, there isn't a request for the filename
+            if(m_DecodingCount == 0)
+            {
+                return nullptr;
+            }
+            
+            //Wait for a worker thread to finish decoding a request
+            m_DecodedCondition.wait(lock);
+        }
+    }
+    
+    unsigned int TextureDecodeQueue::GetPendingCount()
+    {
+        lock_guard<mutex> lock(m_Mutex);
+        return (unsigned int)m_PendingRequests.size() + m_DecodingCount;
+    }
+    
+    void TextureDecodeQueue::DecodeThread()
+    {
+        while(true)
+        {
+            //Wait for a request, or for the queue to be destroyed
+            TextureDecodeRequest* request = nullptr;
+            {
+                unique_lock<mutex> lock(m_Mutex);
+                while(m_IsStopping == false && m_PendingRequests.size() == 0)
+                {
+                    m_Condition.wait(lock);
+                }
+                
+                //If the queue is being destroyed, stop the thread
+                if(m_IsStopping == true)
+                {
+                    return;
+                }
+                
+                //Take the oldest request
+                request = m_PendingRequests.front();
+                m_PendingRequests.pop_front();
+                m_DecodingCount++;
+            }
+            
+            //Read, decode and flip the image, without holding the lock
+            request->didDecode = Texture::DecodeFromPath(request->path, request->imageData);
+            
+            //Add the request to the decoded requests
+            {
+                lock_guard<mutex> lock(m_Mutex);
+                m_DecodedRequests.push_back(request);
+                m_DecodingCount--;
+            }
+            m_DecodedCondition.notify_all();
+        }
+    }
+}
\ No newline at end of file
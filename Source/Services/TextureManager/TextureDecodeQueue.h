@@ -0,0 +1,74 @@
+//
+//  TextureDecodeQueue.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__TextureDecodeQueue__
+#define __GameDev2D__TextureDecodeQueue__
+
+#include "../../Core/BaseObject.h"
+#include "../../Graphics/Textures/Texture.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //A request to decode a png image on a worker thread, the path must be resolved on the main
+    //thread because the PlatformLayer isn't thread safe. If the decode was successful, the image
+    //data is owned by the request until the texture is uploaded. The filename of a streamed texture's
+    //request is the streamed texture's key, its directory and filename
+    struct TextureDecodeRequest
+    {
+        string filename;
+        string path;
+        TextureImageData imageData;
+        bool didDecode;
+        bool isStreamed;
+    };
+    
+    //The TextureDecodeQueue owns a pool of worker threads that read, decode and flip png images. Requests
+    //are pushed from the main thread and the decoded requests are popped on the main thread, where the
+    //TextureManager uploads them to OpenGL. The worker threads never make any OpenGL or logging calls.
+    class TextureDecodeQueue : public BaseObject
+    {
+    public:
+        TextureDecodeQueue(unsigned int threadCount);
+        ~TextureDecodeQueue();
+        
+        //Pushes a request to be decoded by a worker thread, the queue takes ownership of the request
+        void Push(TextureDecodeRequest* request);
+        
+        //Pops a decoded request, the caller takes ownership of the request and its image data.
+        //Returns null if there aren't any decoded requests, it never blocks on the worker threads
+        TextureDecodeRequest* PopDecoded();
+        
+        //Removes the request for a filename and returns it decoded, the caller takes ownership of the request and its image data.
+        //If a worker thread hasn't started decoding the request it is decoded on the calling thread, if a worker thread is
+        //decoding it the calling thread blocks until it is decoded. Returns null if there isn't a request for the filename
+        TextureDecodeRequest* FinishRequest(const string& filename);
+        
+        //Returns the number of requests that are waiting to be decoded or are being decoded
+        unsigned int GetPendingCount();
+    
+    private:
+        //The worker thread's loop, decodes requests until the queue is destroyed
+        void DecodeThread();
+        
+        //Member variables
+        vector<thread> m_Threads;
+        deque<TextureDecodeRequest*> m_PendingRequests;
+        deque<TextureDecodeRequest*> m_DecodedRequests;
+        mutex m_Mutex;
+        condition_variable m_Condition;
+        condition_variable m_DecodedCondition;
+        unsigned int m_DecodingCount;
+        bool m_IsStopping;
+    };
+}
+
+#endif /* defined(__GameDev2D__TextureDecodeQueue__) */
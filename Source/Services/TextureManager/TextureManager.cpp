@@ -7,17 +7,59 @@
 //
 
 #include "TextureManager.h"
+#include "TextureDecodeQueue.h"
 #include "../ServiceLocator.h"
 #include "../../Graphics/Textures/Texture.h"
+#include "../../Graphics/Textures/TextureContainer.h"
 #include "../../Graphics/Textures/TextureFrame.h"
+#include "../../Graphics/Textures/AnimationClip.h"
 #include "../../Platforms/PlatformLayer.h"
 #include "../../Graphics/OpenGL.h"
 
 
+#ifndef TEXTURE_STREAMING_BUDGET
+#define TEXTURE_STREAMING_BUDGET (64 * 1024 * 1024)
+#endif
+
+#ifndef TEXTURE_BUDGET
+#define TEXTURE_BUDGET (128 * 1024 * 1024)
+#endif
+
+#ifndef TEXTURE_DECODE_THREAD_COUNT
+#define TEXTURE_DECODE_THREAD_COUNT 2
+#endif
+
+#ifndef TEXTURE_UPLOAD_BUDGET_PER_FRAME
+#define TEXTURE_UPLOAD_BUDGET_PER_FRAME (4 * 1024 * 1024)
+#endif
+
+#ifndef TEXTURE_ATLAS_MANIFEST
+#define TEXTURE_ATLAS_MANIFEST "TextureAtlases"
+#endif
+
+
 namespace GameDev2D
 {
     TextureManager::TextureManager() : GameService("TextureManager"),
-        m_PlaceHolder(nullptr)
+        m_PlaceHolder(nullptr),
+        m_DidLoadPackedImages(false),
+        m_DecodeQueue(nullptr),
+        m_NextTextureLoadHandle(0),
+        m_TextureUploadsPerFrame(0),
+        m_TextureUploadBytesPerFrame(0),
+        m_StreamingBudget(TEXTURE_STREAMING_BUDGET),
+        m_StreamingMemory(0),
+        m_StreamingFrame(0),
+        m_StreamedLoads(0),
+        m_StreamedEvictions(0),
+        m_StreamedLoadsPerFrame(0),
+        m_StreamedEvictionsPerFrame(0),
+        m_TextureBudget(TEXTURE_BUDGET),
+        m_TextureReleaseCount(0),
+        m_TextureCacheHits(0),
+        m_TextureCacheMisses(0),
+        m_TextureCacheEvictions(0),
+        m_TextureCacheReloads(0)
     {
         //Register for the low memory event
         ServiceLocator::GetPlatformLayer()->AddEventListener(this, LOW_MEMORY_WARNING_EVENT);
@@ -27,16 +69,22 @@ namespace GameDev2D
     {
         //Remove the listener for the low memory event
         ServiceLocator::GetPlatformLayer()->RemoveEventListener(this, LOW_MEMORY_WARNING_EVENT);
-    
-        //Delete the placeholder texture
-        SafeDelete(m_PlaceHolder);
         
-        //Unload all the textures
-        while(m_TextureMap.size() > 0)
+        //Delete the decode queue, this waits for the worker threads to finish
+        SafeDelete(m_DecodeQueue);
+        
+        //Delete the decoded textures that were never uploaded
+        while(m_PendingUploads.size() > 0)
         {
-            SafeDelete(m_TextureMap.begin()->second.first);
-            m_TextureMap.erase(m_TextureMap.begin());
+            SafeFree(m_PendingUploads.front()->imageData.data);
+            SafeDelete(m_PendingUploads.front());
+            m_PendingUploads.pop_front();
         }
+        m_AsyncTextures.clear();
+        m_AsyncStreamedTextures.clear();
+        
+        //Unload any textures that weren't unloaded before the Graphics service was removed
+        UnloadTextures();
 
         //Unload the atlas data
         while (m_AtlasKeys.size() > 0)
@@ -63,74 +111,33 @@ namespace GameDev2D
             return;
         }
         
-        //Append the filename to the directory
-        string filename = string(aFilename);
+        //Get the pair from the texture map, if the texture is already loaded its path doesn't have to be resolved
+        map<string, pair<Texture*, unsigned int>>::iterator textureIt = m_TextureMap.find(aFilename);
+        pair<Texture*, unsigned int> texturePair = textureIt != m_TextureMap.end() ? textureIt->second : pair<Texture*, unsigned int>(nullptr, 0);
         
-        //Was .png appended to the filename? If it was, remove it
-        size_t found = filename.find(".png");
-        if(found != std::string::npos)
+        //Is the texture pointer null?
+        if(texturePair.first == nullptr)
         {
-            filename.erase(found, 4);
-        }
-        
-        //Flag to track if we should load a scaled image asset
-        bool loadScaledImage = ServiceLocator::GetPlatformLayer()->GetPlatformType() == PlatformType_iOS;
-        string originalFilename = string(filename);
-
-#ifdef SIMULATE_IOS_DEVICE_SCALE
-#if SIMULATE_IOS_DEVICE_SCALE // > 0
-        loadScaledImage = true;
-#endif
-#endif
+            //Get the path for the texture, it is empty if the texture doesn't exist
+            string path = GetPathForTexture(aFilename, aDirectory);
+            bool doesExist = path.length() > 0;
 
-        //If the platform is iOS load the appropriate file
-        if (loadScaledImage == true)
-        {
-            //If the scale is greater than 1, then append the proper scale value to the filename
-            float scale = ServiceLocator::GetPlatformLayer()->GetScale();
-            if(scale > 1.0f)
+            //If the path is empty, set the place holder texture
+            if(doesExist == false)
             {
-                stringstream ss;
-                ss << "@" << (int)scale << "x";
-                filename.append(ss.str());
-            }
-        }
-        
-        //Get the path for the texture
-        string path = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(filename.c_str(), "png", aDirectory.c_str());
-        
-        //Does the image exist at the path
-        bool doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(path);
-        
-        //If the file doesn't exist but we scaled the image, then try loading the original file instead
-        if(doesExist == false && loadScaledImage == true)
-        {
-            //Get the path for the texture
-            path = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(originalFilename.c_str(), "png", aDirectory.c_str());
-
-            //Does the image exist at the path
-            doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(path);
-        }
-
-        //If the path isn't empty, set the place holder texture
-        if(doesExist == false)
-        {
-            Error(false, "Failed to load texture with filename: %s, it doesn't exist", aFilename.c_str());
+                Error(false, "Failed to load texture with filename: %s, it doesn't exist", aFilename.c_str());
             
-            //Safety check the texture frame and set the placeholder texture
-            if(aTextureFrame != nullptr)
-            {
-                aTextureFrame->SetTexture(GetPlaceHolder(), false);
+                //Safety check the texture frame and set the placeholder texture
+                if(aTextureFrame != nullptr)
+                {
+                    aTextureFrame->SetTexture(GetPlaceHolder(), false);
+                }
+                return;
             }
-            return;
-        }
     
-        //Get the pair from the texture map
-        pair<Texture*, unsigned int> texturePair = m_TextureMap[aFilename];
+            //The texture has to be loaded
+            TrackTextureCacheAccess(aFilename, false);
         
-        //Is the texture pointer null?
-        if(texturePair.first == nullptr)
-        {
             //Create a new texture object, set the retain count to 1
             texturePair.first = new Texture(aFilename);
             texturePair.second = 1;
@@ -145,16 +152,39 @@ namespace GameDev2D
                 Error("Failed to load texture: %s", aFilename.c_str());
                 return;
             }
+            
+            //Make room for the texture in the texture budget
+            m_TextureMap[aFilename] = texturePair;
+            EvictUnusedTextures();
         }
         else
         {
             //Increment the reference count
+            TrackTextureCacheAccess(aFilename, true);
             texturePair.second++;
         }
         
         //Set the texture map pair for the filename key
         m_TextureMap[aFilename] = texturePair;
         
+        //If the texture is still being loaded asynchronously, finish loading it now. The texture frame can't wait for it,
+        //it is loaded synchronously so its source frame (and any uv coordinates calculated from it) must be the texture's
+        if(m_AsyncTextures.find(aFilename) != m_AsyncTextures.end())
+        {
+            FinishAsyncTexture(aFilename);
+            
+            //If the texture failed to load it was removed from the texture map, set the placeholder texture
+            textureIt = m_TextureMap.find(aFilename);
+            if(textureIt == m_TextureMap.end())
+            {
+                if(aTextureFrame != nullptr)
+                {
+                    aTextureFrame->SetTexture(GetPlaceHolder(), false);
+                }
+                return;
+            }
+        }
+        
         //Set the texture frame's texture
         if(aTextureFrame != nullptr)
         {
@@ -162,8 +192,137 @@ namespace GameDev2D
         }
     }
     
+    TextureLoadHandle TextureManager::AddTextureAsync(const string& aFilename, const string& aDirectory, TextureFrame* aTextureFrame)
+    {
+        //Safety check the filename
+        if(aFilename.length() == 0)
+        {
+            Error(false, "Failed to load texture, the filename has a length of zero");
+            return MakeTextureLoadHandle(TextureLoadFailed);
+        }
+        
+        //Get the pair from the texture map, if the texture is already loaded its path doesn't have to be resolved
+        map<string, pair<Texture*, unsigned int>>::iterator textureIt = m_TextureMap.find(aFilename);
+        pair<Texture*, unsigned int> texturePair = textureIt != m_TextureMap.end() ? textureIt->second : pair<Texture*, unsigned int>(nullptr, 0);
+        
+        //Is the texture pointer null?
+        if(texturePair.first == nullptr)
+        {
+            //Get the path for the texture, the path is resolved on the main thread
+            string path = GetPathForTexture(aFilename, aDirectory);
+            if(path.length() == 0)
+            {
+                Error(false, "Failed to load texture with filename: %s, it doesn't exist", aFilename.c_str());
+            
+                //Safety check the texture frame and set the placeholder texture
+                if(aTextureFrame != nullptr)
+                {
+                    aTextureFrame->SetTexture(GetPlaceHolder(), false);
+                }
+                return MakeTextureLoadHandle(TextureLoadFailed);
+            }
+        
+            //The texture has to be loaded
+            TrackTextureCacheAccess(aFilename, false);
+        
+            //Create a new texture object, it is empty until the decoded image is uploaded, set the retain count to 1
+            texturePair.first = new Texture(aFilename);
+            texturePair.second = 1;
+            
+            //Create the decode queue the first time a texture is loaded asynchronously
+            if(m_DecodeQueue == nullptr)
+            {
+                m_DecodeQueue = new TextureDecodeQueue(TEXTURE_DECODE_THREAD_COUNT);
+            }
+            
+            //Push the decode request
+            TextureDecodeRequest* request = new TextureDecodeRequest();
+            request->filename = aFilename;
+            request->path = path;
+            request->didDecode = false;
+            request->isStreamed = false;
+            m_DecodeQueue->Push(request);
+            
+            //Keep track of the asynchronous texture
+            AsyncTexture asyncTexture;
+            asyncTexture.handle = MakeTextureLoadHandle(TextureLoadPending);
+            m_AsyncTextures[aFilename] = asyncTexture;
+        }
+        else
+        {
+            //Increment the reference count
+            TrackTextureCacheAccess(aFilename, true);
+            texturePair.second++;
+        }
+        
+        //Set the texture map pair for the filename key
+        m_TextureMap[aFilename] = texturePair;
+        
+        //If the texture is still being loaded asynchronously, the texture frame has to wait for it
+        map<string, AsyncTexture>::iterator it = m_AsyncTextures.find(aFilename);
+        if(it != m_AsyncTextures.end())
+        {
+            WaitForAsyncTexture(it->second, aTextureFrame);
+            return it->second.handle;
+        }
+        
+        //The texture is already loaded, set the texture frame's texture
+        if(aTextureFrame != nullptr)
+        {
+            aTextureFrame->SetTexture(texturePair.first, true);
+        }
+        return MakeTextureLoadHandle(TextureLoadComplete);
+    }
+    
+    TextureLoadState TextureManager::GetTextureLoadState(TextureLoadHandle aHandle)
+    {
+        map<TextureLoadHandle, TextureLoadState>::iterator it = m_TextureLoadStates.find(aHandle);
+        if(it != m_TextureLoadStates.end())
+        {
+            //Once the load has completed or failed, the handle is released
+            TextureLoadState state = it->second;
+            if(state != TextureLoadPending)
+            {
+                m_TextureLoadStates.erase(it);
+            }
+            return state;
+        }
+        return TextureLoadFailed;
+    }
+    
+    unsigned int TextureManager::GetPendingTextureLoadCount()
+    {
+        return (unsigned int)(m_AsyncTextures.size() + m_AsyncStreamedTextures.size());
+    }
+    
+    unsigned int TextureManager::GetTextureUploadsPerFrame()
+    {
+        return m_TextureUploadsPerFrame;
+    }
+    
+    unsigned int TextureManager::GetTextureUploadBytesPerFrame()
+    {
+        return m_TextureUploadBytesPerFrame;
+    }
+    
     bool TextureManager::RemoveTexture(TextureFrame* aTextureFrame)
     {
+        //If the texture frame is waiting for an asynchronously loaded texture, it stops waiting for it
+        if(aTextureFrame->m_IsWaitingForTexture == true)
+        {
+            aTextureFrame->m_IsWaitingForTexture = false;
+            for(map<string, AsyncTexture>::iterator it = m_AsyncTextures.begin(); it != m_AsyncTextures.end(); ++it)
+            {
+                vector<TextureFrame*>::iterator frameIt = find(it->second.textureFrames.begin(), it->second.textureFrames.end(), aTextureFrame);
+                if(frameIt != it->second.textureFrames.end())
+                {
+                    it->second.textureFrames.erase(frameIt);
+                    return RemoveTexture(it->first);
+                }
+            }
+            return false;
+        }
+        
         return RemoveTexture(aTextureFrame->GetFilename());
     }
     
@@ -177,26 +336,33 @@ namespace GameDev2D
         //Is the texture pointer null?
         if(texturePair.first != nullptr)
         {
-            //Subract from the retain counter
-            texturePair.second--;
-            
-            //Has the counter reacher zero?
-            if(texturePair.second <= 0)
+            //Subract from the retain counter, it can't go below zero
+            if(texturePair.second > 0)
             {
-                texturePair.second = 0;
+                texturePair.second--;
+                
+                //Has the counter reached zero? The texture stays cached, keep track of when it was released
+                if(texturePair.second == 0)
+                {
+                    m_TextureReleaseCount++;
+                    m_UnusedTextures[aFilename] = m_TextureReleaseCount;
+                }
             }
 
             //Set the texture map pair for the filename key
             m_TextureMap[aFilename] = texturePair;
             
             //If the purge unused texture congif is enabled, purge the texture
-            //immediately if the retain count reaches zero
-            #if PURGE_UNUSED_TEXTURES_IMMEDIATELY
+            //immediately if the retain count reaches zero, otherwise the unused
+            //textures are only evicted if the texture budget is exceeded
             if(texturePair.second == 0)
             {
+                #if PURGE_UNUSED_TEXTURES_IMMEDIATELY
                 PurgeUnusedTextures();
+                #else
+                EvictUnusedTextures();
+                #endif
             }
-            #endif
             
             //Set the success flag to true
             success = true;
@@ -224,11 +390,11 @@ namespace GameDev2D
                 filename.erase(found, 5);
             }
 
-            //Get the json path
-            string jsonPath = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(filename.c_str(), "json", aDirectory.c_str());
+            //Get the json path, the json must match the scale of the atlas image (@2x, @3x)
+            string jsonPath = GetPathForImage(filename, "json", aDirectory);
 
             //Does the json file exist, if it doesn't the assert below will be hit
-            bool doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(jsonPath);
+            bool doesExist = jsonPath != "";
             assert(doesExist == true);
 
             //If the json files exists, load the atlas frae
@@ -266,8 +432,8 @@ namespace GameDev2D
                             }
                         }
                     }
-
-                    //Set the atlas 
+                    
+                    //Set the atlas
                     m_AtlasKeys[aFilename] = atlasFrames;
                 }
                 else
@@ -289,61 +455,926 @@ namespace GameDev2D
         //Return the source frame
         return sourceFrame;
     }
-
-    SourceFrame* TextureManager::LoadFrame(const Json::Value& aFrame)
-    {
-        //Get the values from the frame
-        unsigned int x = aFrame["x"].asInt();
-        unsigned int y = aFrame["y"].asInt();
-        unsigned int width = aFrame["w"].asInt();
-        unsigned int height = aFrame["h"].asInt();
-
-        //Return the source frame
-        SourceFrame* sourceFrame = new SourceFrame((float)x, (float)y, (float)width, (float)height);
-        return sourceFrame;
-    }
     
-    bool TextureManager::CanUpdate()
+    bool TextureManager::GetPackedImage(const string& aFilename, string& aAtlasFile, string& aAtlasKey)
     {
-        return false;
+        //Load the packed images from the texture atlas manifest, the first time it's needed
+        if(m_DidLoadPackedImages == false)
+        {
+            LoadPackedImages();
+        }
+        
+        //Was .png appended to the filename? If it was, remove it
+        string filename = string(aFilename);
+        size_t found = filename.find(".png");
+        if(found != std::string::npos)
+        {
+            filename.erase(found, 4);
+        }
+        
+        //Was the image packed into a texture atlas?
+        map<string, string>::iterator it = m_PackedImages.find(filename);
+        if(it == m_PackedImages.end())
+        {
+            return false;
+        }
+        
+        //Set the atlas file and key, the atlas key is the image's filename
+        aAtlasFile = it->second;
+        aAtlasKey = filename;
+        return true;
     }
     
-    bool TextureManager::CanDraw()
+    void TextureManager::LoadPackedImages()
     {
-        return false;
+        //Set the flag, the manifest is only loaded once
+        m_DidLoadPackedImages = true;
+        
+        //Does the manifest exist? If it doesn't, there aren't any packed images
+        string manifestPath = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(TEXTURE_ATLAS_MANIFEST, "json", "Images");
+        if(ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(manifestPath) == false)
+        {
+            return;
+        }
+        
+        //Parse the manifest
+        ifstream manifestStream;
+        manifestStream.open(manifestPath.c_str(), std::ifstream::in);
+        Json::Value manifest;
+        Json::Reader reader;
+        if(reader.parse(manifestStream, manifest, false) == false)
+        {
+            Error(false, "Failed to parse the texture atlas manifest: %s", manifestPath.c_str());
+            manifestStream.close();
+            return;
+        }
+        manifestStream.close();
+        
+        //Cycle through the atlases in the manifest
+        const Json::Value atlases = manifest["atlases"];
+        for(unsigned int i = 0; i < atlases.size(); i++)
+        {
+            //Get the atlas json path
+            string atlasFile = atlases[i].asString();
+            string jsonPath = GetPathForImage(atlasFile, "json", "Images");
+            if(jsonPath == "")
+            {
+                Error(false, "Failed to load texture atlas: %s from the manifest, the json file does not exist", atlasFile.c_str());
+                continue;
+            }
+            
+            //Parse the atlas json
+            ifstream inputStream;
+            inputStream.open(jsonPath.c_str(), std::ifstream::in);
+            Json::Value root;
+            if(reader.parse(inputStream, root, false) == true)
+            {
+                //Every frame in the atlas is a packed image
+                const Json::Value frames = root["frames"];
+                for(unsigned int index = 0; index < frames.size(); ++index)
+                {
+                    if(frames[index]["filename"].isString() == true)
+                    {
+                        m_PackedImages[frames[index]["filename"].asString()] = atlasFile;
+                    }
+                }
+            }
+            else
+            {
+                Error(false, "Failed to parse texture atlas JSON: %s from the manifest", atlasFile.c_str());
+            }
+            
+            //Close the input stream
+            inputStream.close();
+        }
     }
-    
-    void TextureManager::HandleEvent(Event* aEvent)
+
+    AnimationClip* TextureManager::AddAnimationClip(const string& aImageFile, const string& aJsonFile)
     {
-        if(aEvent->GetEventCode() == LOW_MEMORY_WARNING_EVENT)
+        //The key is the combination of the image and json file
+        string key = aImageFile + ":" + aJsonFile;
+        
+        //Get the pair from the animation clip map
+        pair<AnimationClip*, unsigned int> animationClipPair = m_AnimationClipMap[key];
+        
+        //Is the animation clip pointer null?
+        if(animationClipPair.first == nullptr)
         {
-            PurgeUnusedTextures();
+            //Create a new animation clip object, set the retain count to 1
+            animationClipPair.first = new AnimationClip(aImageFile, aJsonFile);
+            animationClipPair.second = 1;
+        }
+        else
+        {
+            //Increment the reference count
+            animationClipPair.second++;
         }
+        
+        //Set the animation clip map pair for the key
+        m_AnimationClipMap[key] = animationClipPair;
+        return animationClipPair.first;
     }
     
-    void TextureManager::PurgeUnusedTextures()
+    void TextureManager::RemoveAnimationClip(AnimationClip* aAnimationClip)
     {
-        //Cycle through the texture map and purge any textures with a reference count of zero
-        for(map<string, pair<Texture*, unsigned int>>::iterator it = m_TextureMap.begin(); it != m_TextureMap.end();)
+        //Cycle through the animation clip map and find the animation clip
+        for(map<string, pair<AnimationClip*, unsigned int>>::iterator it = m_AnimationClipMap.begin(); it != m_AnimationClipMap.end(); ++it)
         {
-            //Is the reference count zero
-            if(it->second.second == 0)
+            if(it->second.first == aAnimationClip)
             {
-                //Delete the texture object
-                SafeDelete(it->second.first);
+                //Subract from the retain counter
+                it->second.second--;
                 
-                //Erase the pointer from the texture map
-                map<string, pair<Texture*, unsigned int>>::iterator eraseIt = it;
-                ++it;
-                m_TextureMap.erase(eraseIt);
-            }
-            else
-            {
-                it++;
+                //Has the counter reached zero? Delete the animation clip, it owns GPU buffers
+                if(it->second.second == 0)
+                {
+                    SafeDelete(it->second.first);
+                    m_AnimationClipMap.erase(it);
+                }
+                return;
             }
         }
     }
     
+    Texture* TextureManager::GetStreamedTexture(const string& aFilename, const string& aDirectory, bool aCanLoad, TextureFilter aFilter, bool aGenerateMipmaps)
+    {
+        //Is the texture already resident? If it is, mark it as used this frame
+        string key = aDirectory + "/" + aFilename;
+        map<string, StreamedTexture>::iterator it = m_StreamedTextures.find(key);
+        if(it != m_StreamedTextures.end())
+        {
+            it->second.lastUsedFrame = m_StreamingFrame;
+            return it->second.texture;
+        }
+        
+        //Can the texture be loaded this frame?
+        if(aCanLoad == false)
+        {
+            return nullptr;
+        }
+        
+        //Get the path for the texture
+        string path = GetPathForTexture(aFilename, aDirectory);
+        if(path.length() == 0)
+        {
+            Error(false, "Failed to stream texture with filename: %s, it doesn't exist", aFilename.c_str());
+            return nullptr;
+        }
+        
+        //Load the texture from the path
+        Texture* texture = new Texture(aFilename);
+        if(texture->LoadFromPath(path) == false)
+        {
+            SafeDelete(texture);
+            Error(false, "Failed to stream texture: %s", aFilename.c_str());
+            return nullptr;
+        }
+        
+        //Generate the mipmaps before the texture's memory is added to the streaming budget, then apply the filter
+        if(aGenerateMipmaps == true)
+        {
+            texture->GenerateMipmaps();
+        }
+        texture->SetFilter(aFilter);
+        
+        //Make room for the texture's memory in the streaming budget, compressed textures take up less of it
+        unsigned int memorySize = texture->GetResidentMemory();
+        EvictStreamedTextures(memorySize);
+        
+        //A texture larger than the streaming budget never fits within it, it is still streamed but the image should be split
+        //into smaller tiles, with the AtlasPacker's -tiles option
+        if(memorySize > m_StreamingBudget)
+        {
+            Error(false, "Streamed texture: %s uses %u bytes, more than the streaming budget of %u bytes, it should be split into smaller tiles", aFilename.c_str(), memorySize, m_StreamingBudget);
+        }
+        
+        //Add the streamed texture
+        StreamedTexture streamedTexture;
+        streamedTexture.texture = texture;
+        streamedTexture.memorySize = memorySize;
+        streamedTexture.lastUsedFrame = m_StreamingFrame;
+        m_StreamedTextures[key] = streamedTexture;
+        m_StreamingMemory += memorySize;
+        m_StreamedLoads++;
+        
+        return texture;
+    }
+    
+    Texture* TextureManager::GetStreamedTextureAsync(const string& aFilename, const string& aDirectory, bool aCanLoad, TextureFilter aFilter, bool aGenerateMipmaps)
+    {
+        //Is the texture already resident? If it is, mark it as used this frame
+        Texture* texture = GetStreamedTexture(aFilename, aDirectory, false);
+        if(texture != nullptr)
+        {
+            return texture;
+        }
+        
+        //Can the texture be loaded this frame? If it is already being loaded, it doesn't have to be loaded again
+        string key = aDirectory + "/" + aFilename;
+        if(aCanLoad == false || m_AsyncStreamedTextures.find(key) != m_AsyncStreamedTextures.end())
+        {
+            return nullptr;
+        }
+        
+        //Get the path for the texture, the path is resolved on the main thread
+        string path = GetPathForTexture(aFilename, aDirectory);
+        if(path.length() == 0)
+        {
+            Error(false, "Failed to stream texture with filename: %s, it doesn't exist", aFilename.c_str());
+            return nullptr;
+        }
+        
+        //Create the decode queue the first time a texture is loaded asynchronously
+        if(m_DecodeQueue == nullptr)
+        {
+            m_DecodeQueue = new TextureDecodeQueue(TEXTURE_DECODE_THREAD_COUNT);
+        }
+        
+        //Push the decode request, the streamed texture's key is used as the request's filename
+        TextureDecodeRequest* request = new TextureDecodeRequest();
+        request->filename = key;
+        request->path = path;
+        request->didDecode = false;
+        request->isStreamed = true;
+        m_DecodeQueue->Push(request);
+        
+        //Keep track of the asynchronous streamed texture
+        AsyncStreamedTexture asyncStreamedTexture;
+        asyncStreamedTexture.filename = aFilename;
+        asyncStreamedTexture.filter = aFilter;
+        asyncStreamedTexture.generateMipmaps = aGenerateMipmaps;
+        m_AsyncStreamedTextures[key] = asyncStreamedTexture;
+        return nullptr;
+    }
+    
+    bool TextureManager::IsStreamedTextureResident(const string& aFilename, const string& aDirectory)
+    {
+        return m_StreamedTextures.find(aDirectory + "/" + aFilename) != m_StreamedTextures.end();
+    }
+    
+    bool TextureManager::IsStreamedTextureLoading(const string& aFilename, const string& aDirectory)
+    {
+        return m_AsyncStreamedTextures.find(aDirectory + "/" + aFilename) != m_AsyncStreamedTextures.end();
+    }
+    
+    void TextureManager::SetStreamingBudget(unsigned int aBudget)
+    {
+        m_StreamingBudget = aBudget;
+        EvictStreamedTextures(0);
+    }
+    
+    unsigned int TextureManager::GetStreamingBudget()
+    {
+        return m_StreamingBudget;
+    }
+    
+    unsigned int TextureManager::GetStreamingMemory()
+    {
+        return m_StreamingMemory;
+    }
+    
+    unsigned int TextureManager::GetStreamedTextureCount()
+    {
+        return (unsigned int)m_StreamedTextures.size();
+    }
+    
+    unsigned int TextureManager::GetStreamedLoadsPerFrame()
+    {
+        return m_StreamedLoadsPerFrame;
+    }
+    
+    unsigned int TextureManager::GetStreamedEvictionsPerFrame()
+    {
+        return m_StreamedEvictionsPerFrame;
+    }
+    
+    void TextureManager::SetTextureBudget(unsigned int aBudget)
+    {
+        m_TextureBudget = aBudget;
+        EvictUnusedTextures();
+    }
+    
+    unsigned int TextureManager::GetTextureBudget()
+    {
+        return m_TextureBudget;
+    }
+    
+    unsigned int TextureManager::GetTextureMemory()
+    {
+        unsigned int textureMemory = 0;
+        for(map<string, pair<Texture*, unsigned int>>::iterator it = m_TextureMap.begin(); it != m_TextureMap.end(); ++it)
+        {
+            if(it->second.first != nullptr)
+            {
+                textureMemory += it->second.first->GetResidentMemory();
+            }
+        }
+        return textureMemory;
+    }
+    
+    unsigned int TextureManager::GetCachedTextureMemory()
+    {
+        unsigned int cachedMemory = 0;
+        for(map<string, unsigned long long>::iterator it = m_UnusedTextures.begin(); it != m_UnusedTextures.end(); ++it)
+        {
+            map<string, pair<Texture*, unsigned int>>::iterator textureIt = m_TextureMap.find(it->first);
+            if(textureIt != m_TextureMap.end() && textureIt->second.first != nullptr)
+            {
+                cachedMemory += textureIt->second.first->GetResidentMemory();
+            }
+        }
+        return cachedMemory;
+    }
+    
+    unsigned int TextureManager::GetCachedTextureCount()
+    {
+        return (unsigned int)m_UnusedTextures.size();
+    }
+    
+    unsigned int TextureManager::GetTextureCacheHits()
+    {
+        return m_TextureCacheHits;
+    }
+    
+    unsigned int TextureManager::GetTextureCacheMisses()
+    {
+        return m_TextureCacheMisses;
+    }
+    
+    unsigned int TextureManager::GetTextureCacheEvictions()
+    {
+        return m_TextureCacheEvictions;
+    }
+    
+    unsigned int TextureManager::GetTextureCacheReloads()
+    {
+        return m_TextureCacheReloads;
+    }
+    
+    void TextureManager::ResetTextureCacheStats()
+    {
+        m_TextureCacheHits = 0;
+        m_TextureCacheMisses = 0;
+        m_TextureCacheEvictions = 0;
+        m_TextureCacheReloads = 0;
+    }
+    
+    void TextureManager::LogTextureCacheStats()
+    {
+        unsigned int accesses = m_TextureCacheHits + m_TextureCacheMisses;
+        Log("Texture cache: %u of %u bytes used, %u cached textures (%u bytes), %u hits, %u misses (%.1f%% hit rate), %u evictions, %u reloads", GetTextureMemory(), m_TextureBudget, GetCachedTextureCount(), GetCachedTextureMemory(), m_TextureCacheHits, m_TextureCacheMisses, accesses > 0 ? 100.0 * m_TextureCacheHits / accesses : 0.0, m_TextureCacheEvictions, m_TextureCacheReloads);
+    }
+    
+    unsigned int TextureManager::GetResidentTextureMemory()
+    {
+        return m_StreamingMemory + GetTextureMemory();
+    }
+    
+    unsigned int TextureManager::GetUncompressedTextureMemory()
+    {
+        unsigned int uncompressedMemory = 0;
+        for(map<string, pair<Texture*, unsigned int>>::iterator it = m_TextureMap.begin(); it != m_TextureMap.end(); ++it)
+        {
+            if(it->second.first != nullptr)
+            {
+                uncompressedMemory += it->second.first->GetUncompressedMemory();
+            }
+        }
+        for(map<string, StreamedTexture>::iterator it = m_StreamedTextures.begin(); it != m_StreamedTextures.end(); ++it)
+        {
+            uncompressedMemory += it->second.texture->GetUncompressedMemory();
+        }
+        return uncompressedMemory;
+    }
+    
+    void TextureManager::LogResidentTextureMemory()
+    {
+        //Gather the loaded and the streamed textures
+        vector<Texture*> textures;
+        for(map<string, pair<Texture*, unsigned int>>::iterator it = m_TextureMap.begin(); it != m_TextureMap.end(); ++it)
+        {
+            if(it->second.first != nullptr)
+            {
+                textures.push_back(it->second.first);
+            }
+        }
+        for(map<string, StreamedTexture>::iterator it = m_StreamedTextures.begin(); it != m_StreamedTextures.end(); ++it)
+        {
+            textures.push_back(it->second.texture);
+        }
+        
+        //Log each texture's memory
+        for(unsigned int i = 0; i < textures.size(); i++)
+        {
+            Texture* texture = textures.at(i);
+            Log("%s: %ux%u, %s, %u bytes resident, %u bytes uncompressed", texture->GetFilename().c_str(), texture->GetSize().x, texture->GetSize().y, texture->IsCompressed() == true ? "compressed" : "uncompressed", texture->GetResidentMemory(), texture->GetUncompressedMemory());
+        }
+        
+        //Log the totals
+        unsigned int residentMemory = GetResidentTextureMemory();
+        unsigned int uncompressedMemory = GetUncompressedTextureMemory();
+        Log("%u textures, %u bytes resident, %u bytes uncompressed (%.1fx smaller)", (unsigned int)textures.size(), residentMemory, uncompressedMemory, residentMemory > 0 ? (double)uncompressedMemory / (double)residentMemory : 1.0);
+    }
+    
+    void TextureManager::ClearResolvedPaths()
+    {
+        m_ImagePaths.clear();
+        m_TexturePaths.clear();
+    }
+    
+    string TextureManager::GetPathForImage(const string& aFilename, const string& aExtension, const string& aDirectory)
+    {
+        //Has the path already been resolved? If it has, the file system doesn't have to be checked again
+        string key = aDirectory + "/" + aFilename + "." + aExtension;
+        map<string, string>::iterator it = m_ImagePaths.find(key);
+        if(it != m_ImagePaths.end())
+        {
+            return it->second;
+        }
+        
+        //Copy the filename
+        string filename = string(aFilename);
+        
+        //Was the extension appended to the filename? If it was, remove it
+        size_t found = filename.find("." + aExtension);
+        if(found != std::string::npos)
+        {
+            filename.erase(found, aExtension.length() + 1);
+        }
+        
+        //Flag to track if we should load a scaled image asset
+        bool loadScaledImage = ServiceLocator::GetPlatformLayer()->GetPlatformType() == PlatformType_iOS;
+        string originalFilename = string(filename);
+
+#ifdef SIMULATE_IOS_DEVICE_SCALE
+#if SIMULATE_IOS_DEVICE_SCALE // > 0
+        loadScaledImage = true;
+#endif
+#endif
+        
+        //If the platform is iOS load the appropriate file
+        if (loadScaledImage == true)
+        {
+            //If the scale is greater than 1, then append the proper scale value to the filename
+            float scale = ServiceLocator::GetPlatformLayer()->GetScale();
+            if(scale > 1.0f)
+            {
+                stringstream ss;
+                ss << "@" << (int)scale << "x";
+                filename.append(ss.str());
+            }
+        }
+        
+        //Get the path for the image
+        string path = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(filename.c_str(), aExtension.c_str(), aDirectory.c_str());
+        
+        //Does the image exist at the path
+        bool doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(path);
+        
+        //If the file doesn't exist but we scaled the image, then try loading the original file instead
+        if(doesExist == false && loadScaledImage == true)
+        {
+            //Get the path for the image
+            path = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(originalFilename.c_str(), aExtension.c_str(), aDirectory.c_str());
+            
+            //Does the image exist at the path
+            doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(path);
+        }
+        
+        //Cache and return the path, if the image exists, otherwise an empty path is cached
+        m_ImagePaths[key] = doesExist == true ? path : "";
+        return m_ImagePaths[key];
+    }
+    
+    string TextureManager::GetPathForTexture(const string& aFilename, const string& aDirectory)
+    {
+        //Has the path already been resolved? If it has, the file system doesn't have to be checked again
+        string key = aDirectory + "/" + aFilename;
+        map<string, string>::iterator it = m_TexturePaths.find(key);
+        if(it != m_TexturePaths.end())
+        {
+            return it->second;
+        }
+        
+        //Was .png appended to the filename? If it was, remove it
+        string filename = string(aFilename);
+        size_t found = filename.find(".png");
+        if(found != std::string::npos)
+        {
+            filename.erase(found, 4);
+        }
+        
+        //Get the path for the png image
+        string path = GetPathForImage(filename, "png", aDirectory);
+        if(path.length() == 0)
+        {
+            //The png image doesn't exist, only the texture container might have been shipped
+            path = GetPathForImage(filename, TEXTURE_CONTAINER_EXTENSION, aDirectory);
+        }
+        else
+        {
+            //Is there a texture container for the png image? It has the same path, but a different extension
+            string containerPath = path.substr(0, path.length() - 3) + TEXTURE_CONTAINER_EXTENSION;
+            if(ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(containerPath) == true)
+            {
+                path = containerPath;
+            }
+        }
+        
+        //Cache and return the path, it is empty if neither the png image or the texture container exist
+        m_TexturePaths[key] = path;
+        return path;
+    }
+    
+    void TextureManager::Update(double aDelta)
+    {
+        //Collect the textures that the worker threads have decoded
+        if(m_DecodeQueue != nullptr)
+        {
+            TextureDecodeRequest* request = nullptr;
+            while((request = m_DecodeQueue->PopDecoded()) != nullptr)
+            {
+                m_PendingUploads.push_back(request);
+            }
+        }
+        
+        //Advance the streaming frame, any streamed texture that isn't used this frame can be evicted, the
+        //streamed textures that are uploaded below are used this frame so they aren't evicted before they are drawn
+        m_StreamingFrame++;
+        
+        //Upload the decoded textures until the upload budget is used, at least one texture is
+        //uploaded each frame so that a texture larger than the budget still gets uploaded
+        m_TextureUploadsPerFrame = 0;
+        m_TextureUploadBytesPerFrame = 0;
+        while(m_PendingUploads.size() > 0)
+        {
+            TextureDecodeRequest* request = m_PendingUploads.front();
+            if(m_TextureUploadsPerFrame > 0 && m_TextureUploadBytesPerFrame + request->imageData.dataSize > TEXTURE_UPLOAD_BUDGET_PER_FRAME)
+            {
+                break;
+            }
+            m_PendingUploads.pop_front();
+            
+            //Update the upload stats
+            m_TextureUploadsPerFrame++;
+            m_TextureUploadBytesPerFrame += request->imageData.dataSize;
+            
+            //Upload the texture, this deletes the request
+            if(request->isStreamed == true)
+            {
+                FinishStreamedTexture(request);
+            }
+            else
+            {
+                FinishAsyncTexture(request);
+            }
+        }
+        
+        //Store the last frame's streaming stats and reset the counters
+        m_StreamedLoadsPerFrame = m_StreamedLoads;
+        m_StreamedEvictionsPerFrame = m_StreamedEvictions;
+        m_StreamedLoads = 0;
+        m_StreamedEvictions = 0;
+    }
+    
+    SourceFrame* TextureManager::LoadFrame(const Json::Value& aFrame)
+    {
+        //Get the values from the frame
+        unsigned int x = aFrame["x"].asInt();
+        unsigned int y = aFrame["y"].asInt();
+        unsigned int width = aFrame["w"].asInt();
+        unsigned int height = aFrame["h"].asInt();
+
+        //Return the source frame
+        SourceFrame* sourceFrame = new SourceFrame((float)x, (float)y, (float)width, (float)height);
+        return sourceFrame;
+    }
+    
+    bool TextureManager::CanUpdate()
+    {
+        return true;
+    }
+    
+    bool TextureManager::CanDraw()
+    {
+        return false;
+    }
+    
+    void TextureManager::UnloadTextures()
+    {
+        //Delete the animation clips, they hold a reference to their textures
+        while(m_AnimationClipMap.size() > 0)
+        {
+            SafeDelete(m_AnimationClipMap.begin()->second.first);
+            m_AnimationClipMap.erase(m_AnimationClipMap.begin());
+        }
+        
+        //Delete the placeholder texture
+        SafeDelete(m_PlaceHolder);
+        
+        //Unload all the streamed textures
+        while(m_StreamedTextures.size() > 0)
+        {
+            SafeDelete(m_StreamedTextures.begin()->second.texture);
+            m_StreamedTextures.erase(m_StreamedTextures.begin());
+        }
+        m_StreamingMemory = 0;
+        
+        //Unload all the textures, including the cached unused textures
+        while(m_TextureMap.size() > 0)
+        {
+            SafeDelete(m_TextureMap.begin()->second.first);
+            m_TextureMap.erase(m_TextureMap.begin());
+        }
+        m_UnusedTextures.clear();
+    }
+    
+    void TextureManager::HandleEvent(Event* aEvent)
+    {
+        if(aEvent->GetEventCode() == LOW_MEMORY_WARNING_EVENT)
+        {
+            PurgeUnusedTextures();
+            
+            //Evict every streamed texture that isn't used this frame
+            unsigned int streamingBudget = m_StreamingBudget;
+            m_StreamingBudget = 0;
+            EvictStreamedTextures(0);
+            m_StreamingBudget = streamingBudget;
+        }
+    }
+    
+    void TextureManager::PurgeUnusedTextures()
+    {
+        //Cycle through the texture map and purge any textures with a reference count of zero
+        for(map<string, pair<Texture*, unsigned int>>::iterator it = m_TextureMap.begin(); it != m_TextureMap.end();)
+        {
+            //Is the reference count zero, textures that are being loaded asynchronously can't be purged
+            if(it->second.second == 0 && m_AsyncTextures.find(it->first) == m_AsyncTextures.end())
+            {
+                //Delete the texture object and erase it from the texture map
+                map<string, pair<Texture*, unsigned int>>::iterator eraseIt = it;
+                ++it;
+                EvictTexture(eraseIt);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+    
+    void TextureManager::WaitForAsyncTexture(AsyncTexture& aAsyncTexture, TextureFrame* aTextureFrame)
+    {
+        //Safety check the texture frame
+        if(aTextureFrame == nullptr)
+        {
+            return;
+        }
+        
+        //Set the placeholder texture, then mark the texture frame as waiting
+        aTextureFrame->SetTexture(GetPlaceHolder(), false);
+        aTextureFrame->m_IsWaitingForTexture = true;
+        aAsyncTexture.textureFrames.push_back(aTextureFrame);
+    }
+    
+    void TextureManager::FinishAsyncTexture(TextureDecodeRequest* aRequest)
+    {
+        //Get the asynchronous texture and the texture object
+        map<string, AsyncTexture>::iterator it = m_AsyncTextures.find(aRequest->filename);
+        map<string, pair<Texture*, unsigned int>>::iterator textureIt = m_TextureMap.find(aRequest->filename);
+        if(it != m_AsyncTextures.end() && textureIt != m_TextureMap.end() && textureIt->second.first != nullptr)
+        {
+            //Did the texture decode?
+            if(aRequest->didDecode == true)
+            {
+                //Generate the OpenGL texture with the image data
+                textureIt->second.first->LoadFromImageData(aRequest->imageData);
+                m_TextureLoadStates[it->second.handle] = TextureLoadComplete;
+                
+                //Set the texture for the texture frames that are waiting for it
+                for(unsigned int i = 0; i < it->second.textureFrames.size(); i++)
+                {
+                    it->second.textureFrames.at(i)->m_IsWaitingForTexture = false;
+                    it->second.textureFrames.at(i)->SetTexture(textureIt->second.first, true);
+                }
+            }
+            else
+            {
+                //Log an error, the texture frames keep the placeholder texture
+                Error(false, "Failed to load texture: %s", aRequest->filename.c_str());
+                m_TextureLoadStates[it->second.handle] = TextureLoadFailed;
+                
+                //The texture frames are no longer waiting for the texture
+                for(unsigned int i = 0; i < it->second.textureFrames.size(); i++)
+                {
+                    it->second.textureFrames.at(i)->m_IsWaitingForTexture = false;
+                }
+                
+                //Delete the empty texture object
+                SafeDelete(textureIt->second.first);
+                m_UnusedTextures.erase(textureIt->first);
+                m_TextureMap.erase(textureIt);
+            }
+            
+            //The texture is no longer being loaded, make room for it in the texture budget
+            m_AsyncTextures.erase(it);
+            EvictUnusedTextures();
+        }
+        
+        //Free the image data and delete the request
+        SafeFree(aRequest->imageData.data);
+        SafeDelete(aRequest);
+    }
+    
+    void TextureManager::FinishAsyncTexture(const string& aFilename)
+    {
+        //Has the texture already been decoded? If it has, it is waiting for the upload budget
+        TextureDecodeRequest* request = nullptr;
+        for(deque<TextureDecodeRequest*>::iterator it = m_PendingUploads.begin(); it != m_PendingUploads.end(); ++it)
+        {
+            if((*it)->filename == aFilename && (*it)->isStreamed == false)
+            {
+                request = *it;
+                m_PendingUploads.erase(it);
+                break;
+            }
+        }
+        
+        //Otherwise finish decoding the texture, if a worker thread hasn't started decoding it, it is decoded on this thread
+        if(request == nullptr && m_DecodeQueue != nullptr)
+        {
+            request = m_DecodeQueue->FinishRequest(aFilename);
+        }
+        
+        //Upload the texture, this deletes the request
+        if(request != nullptr)
+        {
+            FinishAsyncTexture(request);
+        }
+    }
+    
+    void TextureManager::EvictUnusedTextures()
+    {
+        //Evict the least recently used unused texture until the loaded textures fit within the texture budget
+        unsigned int textureMemory = GetTextureMemory();
+        while(textureMemory > m_TextureBudget)
+        {
+            //Find the unused texture that was released first, textures that are being loaded asynchronously can't be evicted
+            map<string, unsigned long long>::iterator leastRecentlyUsed = m_UnusedTextures.end();
+            for(map<string, unsigned long long>::iterator it = m_UnusedTextures.begin(); it != m_UnusedTextures.end(); ++it)
+            {
+                if(m_AsyncTextures.find(it->first) == m_AsyncTextures.end() && (leastRecentlyUsed == m_UnusedTextures.end() || it->second < leastRecentlyUsed->second))
+                {
+                    leastRecentlyUsed = it;
+                }
+            }
+            
+            //If there isn't an unused texture that can be evicted, the referenced textures exceed the budget
+            if(leastRecentlyUsed == m_UnusedTextures.end())
+            {
+                return;
+            }
+            
+            //Evict the texture
+            map<string, pair<Texture*, unsigned int>>::iterator textureIt = m_TextureMap.find(leastRecentlyUsed->first);
+            if(textureIt != m_TextureMap.end())
+            {
+                textureMemory -= textureIt->second.first != nullptr ? textureIt->second.first->GetResidentMemory() : 0;
+                EvictTexture(textureIt);
+            }
+            else
+            {
+                m_UnusedTextures.erase(leastRecentlyUsed);
+            }
+        }
+    }
+    
+    void TextureManager::EvictTexture(map<string, pair<Texture*, unsigned int>>::iterator aTextureIt)
+    {
+        //Keep track of the eviction, empty entries weren't loaded so they don't count
+        if(aTextureIt->second.first != nullptr)
+        {
+            m_EvictedTextures.insert(aTextureIt->first);
+            m_TextureCacheEvictions++;
+        }
+        
+        //Delete the texture object and erase it from the unused textures and the texture map
+        SafeDelete(aTextureIt->second.first);
+        m_UnusedTextures.erase(aTextureIt->first);
+        m_TextureMap.erase(aTextureIt);
+    }
+    
+    void TextureManager::TrackTextureCacheAccess(const string& aFilename, bool aIsLoaded)
+    {
+        if(aIsLoaded == true)
+        {
+            //The texture is loaded, if it was cached it is used again
+            m_TextureCacheHits++;
+            m_UnusedTextures.erase(aFilename);
+        }
+        else
+        {
+            //The texture has to be loaded, if it was evicted before it is reloaded
+            m_TextureCacheMisses++;
+            set<string>::iterator it = m_EvictedTextures.find(aFilename);
+            if(it != m_EvictedTextures.end())
+            {
+                m_TextureCacheReloads++;
+                m_EvictedTextures.erase(it);
+            }
+        }
+    }
+    
+    void TextureManager::FinishStreamedTexture(TextureDecodeRequest* aRequest)
+    {
+        //Is the streamed texture still being loaded asynchronously? If it was streamed synchronously in the meantime, it is already resident
+        map<string, AsyncStreamedTexture>::iterator it = m_AsyncStreamedTextures.find(aRequest->filename);
+        if(it != m_AsyncStreamedTextures.end() && m_StreamedTextures.find(aRequest->filename) == m_StreamedTextures.end())
+        {
+            //Did the texture decode?
+            if(aRequest->didDecode == true)
+            {
+                //Generate the OpenGL texture with the image data
+                Texture* texture = new Texture(it->second.filename);
+                texture->LoadFromImageData(aRequest->imageData);
+                
+                //Generate the mipmaps before the texture's memory is added to the streaming budget, then apply the filter
+                if(it->second.generateMipmaps == true)
+                {
+                    texture->GenerateMipmaps();
+                }
+                texture->SetFilter(it->second.filter);
+                
+                //Make room for the texture's memory in the streaming budget
+                unsigned int memorySize = texture->GetResidentMemory();
+                EvictStreamedTextures(memorySize);
+                if(memorySize > m_StreamingBudget)
+                {
+                    Error(false, "Streamed texture: %s uses %u bytes, more than the streaming budget of %u bytes, it should be split into smaller tiles", it->second.filename.c_str(), memorySize, m_StreamingBudget);
+                }
+                
+                //Add the streamed texture, it is used this frame
+                StreamedTexture streamedTexture;
+                streamedTexture.texture = texture;
+                streamedTexture.memorySize = memorySize;
+                streamedTexture.lastUsedFrame = m_StreamingFrame;
+                m_StreamedTextures[aRequest->filename] = streamedTexture;
+                m_StreamingMemory += memorySize;
+                m_StreamedLoads++;
+            }
+            else
+            {
+                Error(false, "Failed to stream texture: %s", it->second.filename.c_str());
+            }
+        }
+        
+        //The streamed texture is no longer being loaded
+        if(it != m_AsyncStreamedTextures.end())
+        {
+            m_AsyncStreamedTextures.erase(it);
+        }
+        
+        //Free the image data and delete the request
+        SafeFree(aRequest->imageData.data);
+        SafeDelete(aRequest);
+    }
+    
+    TextureLoadHandle TextureManager::MakeTextureLoadHandle(TextureLoadState aState)
+    {
+        m_NextTextureLoadHandle++;
+        m_TextureLoadStates[m_NextTextureLoadHandle] = aState;
+        return m_NextTextureLoadHandle;
+    }
+    
+    void TextureManager::EvictStreamedTextures(unsigned int aAdditionalMemory)
+    {
+        //Evict the least recently used streamed texture until there is enough room in the budget
+        while(m_StreamingMemory + aAdditionalMemory > m_StreamingBudget)
+        {
+            //Find the least recently used streamed texture, textures used this frame can't be evicted
+            map<string, StreamedTexture>::iterator leastRecentlyUsed = m_StreamedTextures.end();
+            for(map<string, StreamedTexture>::iterator it = m_StreamedTextures.begin(); it != m_StreamedTextures.end(); ++it)
+            {
+                if(it->second.lastUsedFrame < m_StreamingFrame && (leastRecentlyUsed == m_StreamedTextures.end() || it->second.lastUsedFrame < leastRecentlyUsed->second.lastUsedFrame))
+                {
+                    leastRecentlyUsed = it;
+                }
+            }
+            
+            //If there isn't a streamed texture that can be evicted, the budget will be exceeded this frame
+            if(leastRecentlyUsed == m_StreamedTextures.end())
+            {
+                return;
+            }
+            
+            //Evict the streamed texture
+            m_StreamingMemory -= leastRecentlyUsed->second.memorySize;
+            SafeDelete(leastRecentlyUsed->second.texture);
+            m_StreamedTextures.erase(leastRecentlyUsed);
+            m_StreamedEvictions++;
+        }
+    }
+    
     Texture* TextureManager::GetPlaceHolder()
     {
         if(m_PlaceHolder == nullptr)
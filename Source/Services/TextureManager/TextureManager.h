@@ -12,6 +12,8 @@
 #include "../GameService.h"
 #include "../../Graphics/Textures/TextureFrame.h"
 #include "json.h"
+#include <deque>
+#include <set>
 
 using namespace std;
 
@@ -19,9 +21,52 @@ namespace GameDev2D
 {
     //Forward declarations
     class Texture;
+    class AnimationClip;
+    class TextureDecodeQueue;
+    struct TextureDecodeRequest;
+    
+    //Handle returned by AddTextureAsync(), used to query the state of the load
+    typedef unsigned int TextureLoadHandle;
+    
+    //The states of an asynchronous texture load
+    enum TextureLoadState
+    {
+        TextureLoadPending = 0,
+        TextureLoadComplete,
+        TextureLoadFailed
+    };
+    
+    //Keeps track of a texture that is being loaded asynchronously and the TextureFrames waiting for it
+    struct AsyncTexture
+    {
+        TextureLoadHandle handle;
+        vector<TextureFrame*> textureFrames;
+    };
 
+    //Keeps track of a streamed texture, its size in bytes and the last frame it was used
+    struct StreamedTexture
+    {
+        Texture* texture;
+        unsigned int memorySize;
+        unsigned long long lastUsedFrame;
+    };
+    
+    //Keeps track of a streamed texture that is being decoded asynchronously, the mipmaps are generated and the filter is applied when it is uploaded
+    struct AsyncStreamedTexture
+    {
+        string filename;
+        TextureFilter filter;
+        bool generateMipmaps;
+    };
+    
     //The TextureManager uses reference counting to ensure that the same texture isn't loaded twice.
     //It will also generate a default checkerboard texture if the texture being loaded doesn't exist.
+    //Textures with a reference count of zero stay cached, so they don't have to be loaded again if they
+    //are added again, they are evicted least recently used first when the texture budget is exceeded.
+    //Textures can be loaded asynchronously, the png is read and decoded on a pool of worker threads
+    //and only the OpenGL upload is done in Update(), within an upload budget per frame.
+    //Streamed textures (such as the tiles of a TileMap) aren't reference counted, they are kept resident
+    //within a memory budget and the least recently used textures are evicted to make room for new ones.
     class TextureManager : public GameService
     {
     public:
@@ -32,6 +77,22 @@ namespace GameDev2D
         //If the texture doesn't exist a default checkerboard texture is loaded
         void AddTexture(const string& filename, const string& directory, TextureFrame* textureFrame = nullptr);
         
+        //Loads a texture asynchronously (if its not already loaded) and increments the reference count. The TextureFrame
+        //displays the checkerboard texture until the texture is uploaded, or if it fails to load. The returned handle
+        //can be used to check when the texture has loaded
+        TextureLoadHandle AddTextureAsync(const string& filename, const string& directory, TextureFrame* textureFrame = nullptr);
+        
+        //Returns the state of an asynchronous texture load. Once the state is returned as complete or failed the handle is
+        //released, querying it again returns TextureLoadFailed
+        TextureLoadState GetTextureLoadState(TextureLoadHandle handle);
+        
+        //Returns the number of asynchronous texture loads that haven't been uploaded yet, including the streamed textures
+        unsigned int GetPendingTextureLoadCount();
+        
+        //Returns the number of textures and the number of bytes that were uploaded last frame
+        unsigned int GetTextureUploadsPerFrame();
+        unsigned int GetTextureUploadBytesPerFrame();
+        
         //Decerements the reference count of a texture
         bool RemoveTexture(TextureFrame* textureFrame);
         bool RemoveTexture(const string& filename);
@@ -39,6 +100,101 @@ namespace GameDev2D
         //Conveniance methods to load a TextureFrame from a texture atlas
         SourceFrame* LoadAtlasFrame(const string& filename, const string& atlasKey, const string& directory);
         
+        //Returns wether an image was packed into a texture atlas by the AtlasPacker tool, if it was the atlas file
+        //and atlas key are set. The packed images are listed in the TEXTURE_ATLAS_MANIFEST json file in the Images directory
+        bool GetPackedImage(const string& filename, string& atlasFile, string& atlasKey);
+        
+        //Loads an AnimationClip (if its not already loaded) and increments the reference count if it is loaded.
+        //The same AnimationClip is returned for every Sprite that uses the same image and json file
+        AnimationClip* AddAnimationClip(const string& imageFile, const string& jsonFile);
+        
+        //Decrements the reference count of an AnimationClip, the AnimationClip is deleted when it reaches zero
+        void RemoveAnimationClip(AnimationClip* animationClip);
+        
+        //Returns a streamed texture, loading it if it isn't resident and marking it as used this frame. The texture can be
+        //evicted in any later frame, so the pointer must NOT be kept. If the texture isn't resident and canLoad is false,
+        //or the texture failed to load, null is returned. The filter is applied, and the mipmaps are generated, only when the
+        //texture is loaded, use GetStreamedTexture() with canLoad set to false to change the filter of a resident texture
+        Texture* GetStreamedTexture(const string& filename, const string& directory, bool canLoad = true, TextureFilter filter = TEXTURE_DEFAULT_FILTER, bool generateMipmaps = false);
+        
+        //Returns a streamed texture if it is resident and marks it as used this frame, the same as GetStreamedTexture(). If the
+        //texture isn't resident and canLoad is true, it is decoded on a worker thread and uploaded by Update() within the upload
+        //budget, null is returned until it is resident. The pointer must NOT be kept, the texture can be evicted in any later frame
+        Texture* GetStreamedTextureAsync(const string& filename, const string& directory, bool canLoad = true, TextureFilter filter = TEXTURE_DEFAULT_FILTER, bool generateMipmaps = false);
+        
+        //Returns wether a streamed texture is resident
+        bool IsStreamedTextureResident(const string& filename, const string& directory);
+        
+        //Returns wether a streamed texture is being loaded asynchronously
+        bool IsStreamedTextureLoading(const string& filename, const string& directory);
+        
+        //Sets the memory budget for the streamed textures, in bytes. Textures used in the current frame are never evicted,
+        //so the budget can be exceeded temporarily if a single frame uses more than the budget
+        void SetStreamingBudget(unsigned int budget);
+        unsigned int GetStreamingBudget();
+        
+        //Returns the memory used by the resident streamed textures, in bytes, and the number of resident streamed textures
+        unsigned int GetStreamingMemory();
+        unsigned int GetStreamedTextureCount();
+        
+        //Returns the number of streamed textures that were loaded and evicted last frame
+        unsigned int GetStreamedLoadsPerFrame();
+        unsigned int GetStreamedEvictionsPerFrame();
+        
+        //Sets the memory budget for the loaded textures, in bytes. Textures with a reference count of zero stay cached and
+        //are only evicted, least recently used first, when the loaded textures exceed the budget. Referenced textures are
+        //never evicted, so the budget is exceeded if the referenced textures alone don't fit within it
+        void SetTextureBudget(unsigned int budget);
+        unsigned int GetTextureBudget();
+        
+        //Returns the memory used by the loaded textures, in bytes, including the cached textures. Then the memory used by
+        //the cached textures, that have a reference count of zero, and the number of cached textures
+        unsigned int GetTextureMemory();
+        unsigned int GetCachedTextureMemory();
+        unsigned int GetCachedTextureCount();
+        
+        //Returns the number of textures that were added and were already loaded or cached (hits), that had to be loaded
+        //(misses), that were evicted and that had to be loaded again after being evicted (reloads), since the last reset
+        unsigned int GetTextureCacheHits();
+        unsigned int GetTextureCacheMisses();
+        unsigned int GetTextureCacheEvictions();
+        unsigned int GetTextureCacheReloads();
+        
+        //Resets the texture cache hits, misses, evictions and reloads
+        void ResetTextureCacheStats();
+        
+        //Logs the texture cache stats
+        void LogTextureCacheStats();
+        
+        //Returns the GPU memory used by every loaded and streamed texture, in bytes, and the memory they would use if
+        //none of them were block compressed
+        unsigned int GetResidentTextureMemory();
+        unsigned int GetUncompressedTextureMemory();
+        
+        //Logs the GPU memory used by each loaded and streamed texture, compared to the memory it would use uncompressed
+        void LogResidentTextureMemory();
+        
+        //Returns the path of an image resource, if the platform uses scaled image assets (@2x, @3x) the scaled
+        //image's path is returned if it exists. Returns an empty string if the image doesn't exist. The path is
+        //resolved once and cached, so the file system is only checked the first time an image is requested
+        string GetPathForImage(const string& filename, const string& extension, const string& directory);
+        
+        //Returns the path of a texture, if a texture container (.gdtex) was cooked for the image it is used instead
+        //of the png image, they have the same scale. Returns an empty string if neither exists. The path is cached
+        string GetPathForTexture(const string& filename, const string& directory);
+        
+        //Clears the cached image and texture paths, the resources don't change while the game is running
+        //so this only has to be called if images are added or removed at runtime
+        void ClearResolvedPaths();
+        
+        //Deletes every texture, the cached, streamed and placeholder textures and the animation clips. The OpenGL textures are
+        //deleted through the Graphics service, so the ServiceLocator calls this before the Graphics service is removed
+        void UnloadTextures();
+        
+        //Updates the TextureManager, uploads the asynchronously decoded textures, advances the
+        //streaming frame and resets the per frame stats
+        void Update(double delta);
+        
         //Used to determine if the FontManager should be updated and drawn
         bool CanUpdate();
         bool CanDraw();
@@ -50,9 +206,42 @@ namespace GameDev2D
         //Loads an individual texture's sourcce frame from a JSON texture atlas
         SourceFrame* LoadFrame(const Json::Value& frame);
 
+        //Loads the packed images of every texture atlas in the texture atlas manifest
+        void LoadPackedImages();
+        
         //Will purge any textures with a reference count of zero
         void PurgeUnusedTextures();
         
+        //Evicts the least recently used textures with a reference count of zero, until the loaded textures fit within the texture budget
+        void EvictUnusedTextures();
+        
+        //Deletes a texture with a reference count of zero and keeps track of the eviction
+        void EvictTexture(map<string, pair<Texture*, unsigned int>>::iterator textureIt);
+        
+        //Updates the texture cache hits, misses and reloads for a texture that is added
+        void TrackTextureCacheAccess(const string& filename, bool isLoaded);
+        
+        //Adds a TextureFrame to the TextureFrames waiting for an asynchronously loaded texture, the
+        //TextureFrame displays the checkerboard texture until then
+        void WaitForAsyncTexture(AsyncTexture& asyncTexture, TextureFrame* textureFrame);
+        
+        //Uploads a decoded texture and sets it for the TextureFrames that are waiting for it
+        void FinishAsyncTexture(TextureDecodeRequest* request);
+        
+        //Finishes loading an asynchronously loaded texture on the main thread, the texture is decoded (or waits for the
+        //worker thread that is decoding it) and uploaded without waiting for the upload budget
+        void FinishAsyncTexture(const string& filename);
+        
+        //Uploads an asynchronously decoded streamed texture and makes it resident, within the streaming budget
+        void FinishStreamedTexture(TextureDecodeRequest* request);
+        
+        //Returns a new handle, set to the load state
+        TextureLoadHandle MakeTextureLoadHandle(TextureLoadState state);
+        
+        //Evicts the least recently used streamed textures, that weren't used this frame, until the
+        //streamed textures (plus the additional memory) fit within the streaming budget
+        void EvictStreamedTextures(unsigned int additionalMemory);
+        
         //Conveniance method to load and return the placeholder checkerboard texture
         //in the event a texture being loaded doesn't exist
         Texture* GetPlaceHolder();
@@ -60,7 +249,44 @@ namespace GameDev2D
         //Member variables
         map<string, pair<Texture*, unsigned int>> m_TextureMap;
         map<string, map<string, SourceFrame*>> m_AtlasKeys;
+        map<string, pair<AnimationClip*, unsigned int>> m_AnimationClipMap;
         Texture* m_PlaceHolder;
+        map<string, string> m_PackedImages;
+        bool m_DidLoadPackedImages;
+        
+        //The resolved image and texture paths, keyed by the directory and filename
+        map<string, string> m_ImagePaths;
+        map<string, string> m_TexturePaths;
+        
+        //Asynchronous loading member variables
+        TextureDecodeQueue* m_DecodeQueue;
+        deque<TextureDecodeRequest*> m_PendingUploads;
+        map<string, AsyncTexture> m_AsyncTextures;
+        map<TextureLoadHandle, TextureLoadState> m_TextureLoadStates;
+        TextureLoadHandle m_NextTextureLoadHandle;
+        unsigned int m_TextureUploadsPerFrame;
+        unsigned int m_TextureUploadBytesPerFrame;
+        
+        //Streaming member variables
+        map<string, StreamedTexture> m_StreamedTextures;
+        map<string, AsyncStreamedTexture> m_AsyncStreamedTextures;
+        unsigned int m_StreamingBudget;
+        unsigned int m_StreamingMemory;
+        unsigned long long m_StreamingFrame;
+        unsigned int m_StreamedLoads;
+        unsigned int m_StreamedEvictions;
+        unsigned int m_StreamedLoadsPerFrame;
+        unsigned int m_StreamedEvictionsPerFrame;
+        
+        //Texture cache member variables, the unused textures map holds the order the textures were released in
+        map<string, unsigned long long> m_UnusedTextures;
+        set<string> m_EvictedTextures;
+        unsigned int m_TextureBudget;
+        unsigned long long m_TextureReleaseCount;
+        unsigned int m_TextureCacheHits;
+        unsigned int m_TextureCacheMisses;
+        unsigned int m_TextureCacheEvictions;
+        unsigned int m_TextureCacheReloads;
     };
 }
 
@@ -603,6 +603,12 @@ namespace GameDev2D
         return true;
     }
     
+    bool Button::GetLocalBounds(BoundingBox& aBounds)
+    {
+        aBounds = MakeEmptyBoundingBox();
+        return true;
+    }
+    
     void Button::SetIsEnabled(bool aIsEnabled)
     {
         //Set that the GameObject is enabled
@@ -203,6 +203,9 @@ namespace GameDev2D
         //Returns wether this GameObject should be drawn
         bool CanDraw();
         
+        //The Button doesn't draw anything itself, only its children, its local bounds are empty
+        bool GetLocalBounds(BoundingBox& bounds);
+        
         //Enable and Disable the Button, if a Button is disabled,
         //it can't dispatch BUTTON_ACTION events
         void SetIsEnabled(bool isEnabled);
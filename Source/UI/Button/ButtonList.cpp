@@ -284,6 +284,12 @@ namespace GameDev2D
         return size;
     }
     
+    bool ButtonList::GetLocalBounds(BoundingBox& aBounds)
+    {
+        aBounds = MakeEmptyBoundingBox();
+        return true;
+    }
+    
     Button* ButtonList::GetButtonAtIndex(unsigned int aIndex) const
     {
         //Safety check the index
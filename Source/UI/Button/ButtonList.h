@@ -76,6 +76,9 @@ namespace GameDev2D
         //Returns the size of the button list
         vec2 GetSize();
         
+        //The button list doesn't draw anything itself, only its Buttons, its local bounds are empty
+        bool GetLocalBounds(BoundingBox& bounds);
+        
         //Returns the number of buttons in the button list
         unsigned long GetNumberOfButtons();
         
@@ -7,7 +7,8 @@
 //
 
 #include "Label.h"
-#include "../../Graphics/Textures/TextureFrame.h"
+#include "../../Graphics/Core/Shader.h"
+#include "../../Graphics/Textures/Texture.h"
 #include "../../Services/ServiceLocator.h"
 #include "../../Services/Graphics/Graphics.h"
 #include "../../Animation/Tween.h"
@@ -19,6 +20,9 @@
     #endif
 #endif
 
+//The number of vertices 16-bit indices can address, Labels with more glyph vertices than this use 32-bit indices
+#define LABEL_MAX_SHORT_INDEXED_VERTICES 65536
+
 
 using namespace std;
 
@@ -27,11 +31,10 @@ namespace GameDev2D
     Label::Label(const string& aBitmapFont) : GameObject("Label"),
         m_Font(nullptr),
         m_Shader(nullptr),
-        m_RenderTarget(nullptr),
         m_Justification(JustifyLeft),
         m_Text(""),
         m_Size(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_AnchorPoint(0.0f, 0.0f),
         m_CharacterAngle(0.0f),
         m_CharacterSpacing(0.0f),
@@ -39,7 +42,17 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_TweenCharacterAngle(),
-        m_TweenCharacterSpacing()
+        m_TweenCharacterSpacing(),
+        m_GlyphBufferIsDirty(false),
+        m_GlyphRangeIsDirty(false),
+        m_DirtyRangeStart(0),
+        m_DirtyRangeEnd(0),
+        m_AttributeShader(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_IndexBufferObject(0),
+        m_IndexBufferCapacity(0),
+        m_IndexType(GL_UNSIGNED_SHORT)
     {
         //Load the font
         m_Font = ServiceLocator::GetFontManager()->AddBitmapFont(aBitmapFont);
@@ -57,11 +70,10 @@ namespace GameDev2D
     Label::Label(Shader* aShader, const string& aBitmapFont) : GameObject("Label"),
         m_Font(nullptr),
         m_Shader(nullptr),
-        m_RenderTarget(nullptr),
         m_Justification(JustifyLeft),
         m_Text(""),
         m_Size(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_AnchorPoint(0.0f, 0.0f),
         m_CharacterAngle(0.0f),
         m_CharacterSpacing(0.0f),
@@ -69,7 +81,17 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_TweenCharacterAngle(),
-        m_TweenCharacterSpacing()
+        m_TweenCharacterSpacing(),
+        m_GlyphBufferIsDirty(false),
+        m_GlyphRangeIsDirty(false),
+        m_DirtyRangeStart(0),
+        m_DirtyRangeEnd(0),
+        m_AttributeShader(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_IndexBufferObject(0),
+        m_IndexBufferCapacity(0),
+        m_IndexType(GL_UNSIGNED_SHORT)
     {
         //Load the font
         m_Font = ServiceLocator::GetFontManager()->AddBitmapFont(aBitmapFont);
@@ -87,11 +109,10 @@ namespace GameDev2D
     Label::Label(const string& aTrueTypeFont, const string& aExtension, const unsigned int aFontSize) : GameObject("Label"),
         m_Font(nullptr),
         m_Shader(nullptr),
-        m_RenderTarget(nullptr),
         m_Justification(JustifyLeft),
         m_Text(""),
         m_Size(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_AnchorPoint(0.0f, 0.0f),
         m_CharacterAngle(0.0f),
         m_CharacterSpacing(0.0f),
@@ -99,7 +120,17 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_TweenCharacterAngle(),
-        m_TweenCharacterSpacing()
+        m_TweenCharacterSpacing(),
+        m_GlyphBufferIsDirty(false),
+        m_GlyphRangeIsDirty(false),
+        m_DirtyRangeStart(0),
+        m_DirtyRangeEnd(0),
+        m_AttributeShader(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_IndexBufferObject(0),
+        m_IndexBufferCapacity(0),
+        m_IndexType(GL_UNSIGNED_SHORT)
     {
         //Load the font
         m_Font = ServiceLocator::GetFontManager()->AddTrueTypeFont(aTrueTypeFont, aExtension, aFontSize, CHARACTER_SET_ALPHA_NUMERIC_EXT);
@@ -117,11 +148,10 @@ namespace GameDev2D
     Label::Label(Shader* aShader, const string& aTrueTypeFont, const string& aExtension, const unsigned int aFontSize) : GameObject("Label"),
         m_Font(nullptr),
         m_Shader(nullptr),
-        m_RenderTarget(nullptr),
         m_Justification(JustifyLeft),
         m_Text(""),
         m_Size(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_AnchorPoint(0.0f, 0.0f),
         m_CharacterAngle(0.0f),
         m_CharacterSpacing(0.0f),
@@ -129,7 +159,17 @@ namespace GameDev2D
         m_TweenAnchorY(),
         m_TweenAlpha(),
         m_TweenCharacterAngle(),
-        m_TweenCharacterSpacing()
+        m_TweenCharacterSpacing(),
+        m_GlyphBufferIsDirty(false),
+        m_GlyphRangeIsDirty(false),
+        m_DirtyRangeStart(0),
+        m_DirtyRangeEnd(0),
+        m_AttributeShader(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_IndexBufferObject(0),
+        m_IndexBufferCapacity(0),
+        m_IndexType(GL_UNSIGNED_SHORT)
     {
         //Load the font
         m_Font = ServiceLocator::GetFontManager()->AddTrueTypeFont(aTrueTypeFont, aExtension, aFontSize, CHARACTER_SET_ALPHA_NUMERIC_EXT);
@@ -156,8 +196,39 @@ namespace GameDev2D
             m_Font = nullptr;
         }
 
-        //Delete the render target
-        SafeDelete(m_RenderTarget);
+        //If any of the buffers we are about to delete is bound, we need to unbind it
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        if(graphics != nullptr)
+        {
+            if(m_VertexArrayObject != 0 && graphics->GetBoundVertexArray() == m_VertexArrayObject)
+            {
+                graphics->BindVertexArray(0);
+            }
+            if(m_VertexBufferObject != 0 && graphics->GetBoundArrayBuffer() == m_VertexBufferObject)
+            {
+                graphics->BindArrayBuffer(0);
+            }
+        }
+        
+        //Delete the index buffer
+        if(m_IndexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_IndexBufferObject);
+            m_IndexBufferObject = 0;
+        }
+        
+        //Delete the vertex buffer
+        if(m_VertexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+        }
+        
+        //Delete the VAO
+        if(m_VertexArrayObject != 0)
+        {
+            ServiceLocator::GetGraphics()->DeleteVertexArray(m_VertexArrayObject);
+        }
     }
     
     void Label::Update(double aDelta)
@@ -178,17 +249,8 @@ namespace GameDev2D
         //If this assert is hit, it means there isn't a Shader set
         assert(m_Shader != nullptr);
     
-        //Is the render target null
-        if(m_RenderTarget != nullptr)
-        {
-            //Draw the render target
-            m_RenderTarget->GetTextureFrame()->Draw(m_ModelMatrix);
-        }
-        else
-        {
-            //Draw the text with out the render target
-            DrawText();
-        }
+        //Draw the text
+        DrawText();
         
         //Draw a debug label rect
         #if DRAW_LABEL_RECT
@@ -207,24 +269,52 @@ namespace GameDev2D
     
     void Label::SetText(const string& aText)
     {
-        //We can't modify the render target while it is bound
-        if(m_RenderTarget != nullptr && m_RenderTarget->IsBound() == true)
-        {
-            Error(false, "Failed to set Label text, the render target is already bound");
-            return;
-        }
-        
         //Is the text the exact same, if so return
         if(m_Text == aText)
         {
+            ServiceLocator::GetGraphics()->LabelTextChangeSkipped();
             return;
         }
+        
+        //If the text is the same length, find the range of characters that changed
+        string previousText = m_Text;
+        unsigned int start = 0;
+        unsigned int end = 0;
+        if(previousText.length() == aText.length())
+        {
+            end = (unsigned int)aText.length() - 1;
+            while(previousText.at(start) == aText.at(start))
+            {
+                start++;
+            }
+            while(previousText.at(end) == aText.at(end))
+            {
+                end--;
+            }
+        }
     
         //Set the text
         m_Text = string(aText);
         
-        //Resize the render target
-        ResizeRenderTarget();
+        //Can the characters that changed be updated in place? A common case is a score or a timer
+        if(previousText.length() == m_Text.length() && CanUpdateGlyphRange(previousText, start, end) == true)
+        {
+            //Merge the range with any other text change since the last draw
+            if(m_GlyphRangeIsDirty == true)
+            {
+                start = start < m_DirtyRangeStart ? start : m_DirtyRangeStart;
+                end = end > m_DirtyRangeEnd ? end : m_DirtyRangeEnd;
+            }
+            
+            //Flag the range of characters to be updated the next time the Label is drawn
+            m_DirtyRangeStart = start;
+            m_DirtyRangeEnd = end;
+            m_GlyphRangeIsDirty = true;
+            return;
+        }
+        
+        //Resize the Label and rebuild the glyph buffer
+        ResizeGlyphBuffer();
     }
     
     string Label::GetText()
@@ -236,14 +326,8 @@ namespace GameDev2D
     {
         if(aShader != nullptr)
         {
-            //Set the new shader
+            //Set the new shader, the vertex attributes will be set the next time the Label is drawn
             m_Shader = aShader;
-            
-            //Set the render target's shader
-            if(m_RenderTarget != nullptr)
-            {
-                m_RenderTarget->GetTextureFrame()->SetShader(m_Shader);
-            }
         }
     }
     
@@ -261,6 +345,20 @@ namespace GameDev2D
     {
         return m_Size.y;
     }
+    
+    bool Label::GetLocalBounds(BoundingBox& aBounds)
+    {
+        //Start with the size of the Label
+        aBounds = MakeBoundingBox(vec2(0.0f, 0.0f), GetSize());
+        
+        //Glyph bearings and the character angle can extend past the size, expand the bounds to contain the glyph quads
+        for(unsigned int i = 0; i < m_GlyphVertices.size(); i++)
+        {
+            ExpandBoundingBox(aBounds, vec2(m_GlyphVertices.at(i).x, m_GlyphVertices.at(i).y));
+        }
+        
+        return true;
+    }
 
     void Label::SetAnchorX(float aAnchorX, double aDuration, EasingFunction aEasingFunction, bool aReverse, int aRepeatCount)
     {
@@ -312,45 +410,33 @@ namespace GameDev2D
     
     void Label::SetColor(Color aColor)
     {
-        m_Color = aColor;
-        
-        //Set the render targets color
-        if(m_RenderTarget != nullptr)
-        {
-            m_RenderTarget->GetTextureFrame()->SetColor(m_Color);
-        }
+        m_Color = aColor.GetRGBA();
     }
     
     Color Label::GetColor()
     {
-        return m_Color;
+        return Color(m_Color);
     }
     
     void Label::SetAlpha(float aAlpha, double aDuration, EasingFunction aEasingFunction, bool aReverse, int aRepeatCount)
     {
         if(aDuration == 0.0)
         {
-            //Set the alpha
-            m_Color.SetAlpha(aAlpha);
-            
-            //Set the render target's alpha
-            if(m_RenderTarget != nullptr)
-            {
-                m_RenderTarget->GetTextureFrame()->SetColor(m_Color);
-            }
+            //Set the alpha, the color isn't part of the glyph buffer, it doesn't need to be rebuilt
+            m_Color.a = fminf(fmaxf(aAlpha, 0.0f), 1.0f);
         }
         else
         {
-            if(m_Color.Alpha() != aAlpha)
+            if(m_Color.a != aAlpha)
             {
-                m_TweenAlpha.Set(m_Color.Alpha(), aAlpha, aDuration, aEasingFunction, aReverse, aRepeatCount);
+                m_TweenAlpha.Set(m_Color.a, aAlpha, aDuration, aEasingFunction, aReverse, aRepeatCount);
             }
         }
     }
     
     float Label::GetAlpha()
     {
-        return m_Color.Alpha();
+        return m_Color.a;
     }
     
     void Label::SetCharacterAngle(float aCharacterAngle, double aDuration, EasingFunction aEasingFunction, bool aReverse, int aRepeatCount)
@@ -358,7 +444,7 @@ namespace GameDev2D
         if(aDuration == 0.0)
         {
             m_CharacterAngle = aCharacterAngle;
-            ResetRenderTarget();
+            ResetGlyphBuffer();
         }
         else
         {
@@ -379,7 +465,7 @@ namespace GameDev2D
         if(aDuration == 0.0)
         {
             m_CharacterSpacing = aCharacterSpacing;
-            ResizeRenderTarget();
+            ResizeGlyphBuffer();
         }
         else
         {
@@ -403,10 +489,10 @@ namespace GameDev2D
             //Set the justification
             m_Justification = aJustification;
             
-            //Reset the render target
+            //Reset the glyph buffer
             if(m_Text.length() > 0)
             {
-                ResetRenderTarget();
+                ResetGlyphBuffer();
             }
         }
     }
@@ -450,52 +536,23 @@ namespace GameDev2D
         GameObject::ResetModelMatrix();
     }
     
-    void Label::ResizeRenderTarget()
+    void Label::ResizeGlyphBuffer()
     {
         //Calculate the size of the Label
         m_Size = CalculateSize();
 
-        //Delete the previous render target
-        SafeDelete(m_RenderTarget);
-        
-        //Create a new render target
-        if(m_Text.length() > 1)
-        {
-            m_RenderTarget = new RenderTarget((int)m_Size.x, (int)m_Size.y);
-            m_RenderTarget->CreateFrameBuffer();
-
-            //Reset the render target
-            ResetRenderTarget();
-        }
+        //Flag the glyph buffer to be rebuilt
+        ResetGlyphBuffer();
         
         //Flag the model matrix as dirty
         ModelMatrixIsDirty(true);
     }
     
-    void Label::ResetRenderTarget()
+    void Label::ResetGlyphBuffer()
     {
-        RenderTarget* renderTarget = nullptr;
-    
-        //Safety check the render target
-        if(m_RenderTarget != nullptr)
-        {
-            //Set the render target's shader and color
-            m_RenderTarget->GetTextureFrame()->SetShader(m_Shader);
-            m_RenderTarget->GetTextureFrame()->SetColor(m_Color);
-        
-            //Cache the graphics active render target
-            renderTarget = ServiceLocator::GetGraphics()->GetActiveRenderTarget();
-            
-            //Set the Label's render target as the active render target
-            ServiceLocator::GetGraphics()->SetActiveRenderTarget(m_RenderTarget);
-            ServiceLocator::GetGraphics()->Clear();
-        }
-        
-        //Draw the text to the render target
-        DrawText();
-
-        //Set the original graphic's render target back
-        ServiceLocator::GetGraphics()->SetActiveRenderTarget(renderTarget);
+        //The glyph buffer is rebuilt the next time the Label is drawn, that way it is only rebuilt
+        //once, even if several properties change in the same frame
+        m_GlyphBufferIsDirty = true;
     }
     
     vec2 Label::CalculateSize()
@@ -546,12 +603,67 @@ namespace GameDev2D
         return vec2(maxSize.x, maxSize.y);
     }
     
-    void Label::DrawText()
+    float Label::CalculateLineOrigin(unsigned int aLineIndex)
+    {
+        //What justification are we dealing with
+        if(m_Justification == JustifyCenter)
+        {
+            return (GetSize().x - m_LineWidth.at(aLineIndex)) / 2.0f;
+        }
+        else if(m_Justification == JustifyRight)
+        {
+            return GetSize().x - m_LineWidth.at(aLineIndex);
+        }
+        return 0.0f;
+    }
+    
+    bool Label::CanUpdateGlyphRange(const string& aPreviousText, unsigned int aStart, unsigned int aEnd)
+    {
+        //The glyph buffer has to be built, and not already flagged to be rebuilt
+        if(m_Font == nullptr || m_GlyphBufferIsDirty == true || m_GlyphVertices.size() == 0)
+        {
+            return false;
+        }
+        
+        //Each character has to be on the same texture as the character it replaces, that way the glyph runs don't
+        //change. New lines and characters without a texture would change which quad belongs to which character
+        for(unsigned int i = aStart; i <= aEnd; i++)
+        {
+            if(aPreviousText.at(i) == '\n' || m_Text.at(i) == '\n')
+            {
+                return false;
+            }
+            
+            Texture* texture = m_Font->GetTextureForCharacter(m_Text.at(i));
+            if(texture == nullptr || texture != m_Font->GetTextureForCharacter(aPreviousText.at(i)))
+            {
+                return false;
+            }
+        }
+        
+        //The line widths can't change, otherwise the justification and the characters after the range would move
+        vector<float> previousLineWidth = m_LineWidth;
+        CalculateSize();
+        return m_LineWidth == previousLineWidth;
+    }
+    
+    void Label::BuildGlyphBuffer()
     {
+        //Clear the glyph quads and runs
+        m_GlyphVertices.clear();
+        m_GlyphRuns.clear();
+        
+        //The glyph buffer is no longer dirty, the rebuild includes any dirty range
+        m_GlyphBufferIsDirty = false;
+        m_GlyphRangeIsDirty = false;
+        
+        //The bounds contain the glyph quads
+        WorldBoundsAreDirty();
+        
         //Safety check that the font pointer is null
         if(m_Font == nullptr)
         {
-            Error(false, "Unable to draw the text of the Label, the font pointer is null");
+            Error(false, "Unable to build the glyph buffer of the Label, the font pointer is null");
             return;
         }
         
@@ -563,22 +675,8 @@ namespace GameDev2D
         
         //calculate the baseline and origin for the label
         unsigned int baseline = m_Font->GetLineHeight() - m_Font->GetBaseLine();
-        vec2 origin(0.0f, baseline + (m_Font->GetLineHeight() * (GetNumberOfLines() - 1)));
-        int lineIndex = 0;
-        
-        //What justification are we dealing with
-        if(m_Justification == JustifyLeft)
-        {
-            origin.x = 0.0f;
-        }
-        else if(m_Justification == JustifyCenter)
-        {
-            origin.x = (GetSize().x - m_LineWidth.at(lineIndex)) / 2.0f;
-        }
-        else if(m_Justification == JustifyRight)
-        {
-            origin.x = GetSize().x - m_LineWidth.at(lineIndex);
-        }
+        unsigned int lineIndex = 0;
+        vec2 origin(CalculateLineOrigin(lineIndex), baseline + (m_Font->GetLineHeight() * (GetNumberOfLines() - 1)));
         
         //Cycle through the characters in the text label
         for(unsigned int i = 0; i < m_Text.length(); i++)
@@ -586,77 +684,326 @@ namespace GameDev2D
             //Did we reach a new line?
             if(m_Text.at(i) == '\n')
             {
-                //Increment the line index
+                //Increment the line index and calculate the line's origin based on the justification
                 lineIndex++;
-            
-                //Calculate the line's origin based on the justification
-                if(m_Justification == JustifyLeft)
-                {
-                    origin.x = 0.0f;
-                }
-                else if(m_Justification == JustifyCenter)
-                {
-                    origin.x = (GetSize().x - m_LineWidth.at(lineIndex)) / 2.0f;
-                }
-                else if(m_Justification == JustifyRight)
-                {
-                    origin.x = GetSize().x - m_LineWidth.at(lineIndex);
-                }
+                origin.x = CalculateLineOrigin(lineIndex);
             
                 //Set the y line origin based on the line height of the font
                 origin.y -= m_Font->GetLineHeight();
                 continue;
             }
             
-            //Get the texture frame for the character
-            TextureFrame* textureFrame = m_Font->GetTextureFrameForCharacter(m_Text.at(i));
-            
-            //Safety check the texture frame
-            if(textureFrame != nullptr)
+            //Safety check the character's texture
+            if(m_Font->GetTextureForCharacter(m_Text.at(i)) != nullptr)
             {
                 //Calculate the character position based on the x and y bearing
                 vec2 charPosition = origin;
                 charPosition.x += m_Font->GetBearingXForCharacter(m_Text.at(i));
                 charPosition.y += m_Font->GetBearingYForCharacter(m_Text.at(i)) - m_Font->GetSourceFrameForCharacter(m_Text.at(i)).size.y;
 
-                //Draw the character
-                DrawCharacter(textureFrame, charPosition);
+                //Add the character's quad
+                AddGlyph(m_Text.at(i), charPosition);
                 
                 //Increment the origin
                 origin.x += m_Font->GetAdvanceXForCharacter(m_Text.at(i)) + GetCharacterSpacing();
             }
         }
+        
+        //Are there any quads to upload?
+        if(m_GlyphVertices.size() == 0)
+        {
+            return;
+        }
+        
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //If the VAO hasn't been generated yet, generate it and the buffers
+        if(m_VertexArrayObject == 0)
+        {
+            glGenVertexArrays(1, &m_VertexArrayObject);
+            glGenBuffers(1, &m_VertexBufferObject);
+            glGenBuffers(1, &m_IndexBufferObject);
+        }
+        
+        //Bind the VAO, the index buffer binding is part of the VAO's state
+        graphics->BindVertexArray(m_VertexArrayObject);
+        
+        //Upload the glyph quads
+        unsigned int quadCount = (unsigned int)(m_GlyphVertices.size() / 4);
+        graphics->BindArrayBuffer(m_VertexBufferObject);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(LabelGlyphVertex) * m_GlyphVertices.size(), &m_GlyphVertices[0], GL_STATIC_DRAW);
+        graphics->LabelGlyphBufferRebuilt(quadCount);
+        
+        //The index buffer only needs to grow, the indices are the same for every Label
+        if(quadCount > m_IndexBufferCapacity)
+        {
+            //Create the indices, each quad is made up of two triangles
+            const unsigned int indexCount = quadCount * 6;
+            unsigned int* indices = new unsigned int[indexCount];
+            for(unsigned int i = 0; i < quadCount; i++)
+            {
+                unsigned int vertex = i * 4;
+                unsigned int offset = i * 6;
+                indices[offset] = vertex;
+                indices[offset+1] = vertex + 1;
+                indices[offset+2] = vertex + 2;
+                indices[offset+3] = vertex + 2;
+                indices[offset+4] = vertex + 1;
+                indices[offset+5] = vertex + 3;
+            }
+            
+            //Set the index data, 16-bit indices are used unless there are more glyph vertices than they can address
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+            if(quadCount * 4 > LABEL_MAX_SHORT_INDEXED_VERTICES)
+            {
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indexCount, indices, GL_STATIC_DRAW);
+                m_IndexType = GL_UNSIGNED_INT;
+            }
+            else
+            {
+                //Narrow the indices to 16-bits
+                unsigned short* shortIndices = new unsigned short[indexCount];
+                for(unsigned int i = 0; i < indexCount; i++)
+                {
+                    shortIndices[i] = (unsigned short)indices[i];
+                }
+                
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * indexCount, shortIndices, GL_STATIC_DRAW);
+                m_IndexType = GL_UNSIGNED_SHORT;
+                SafeDeleteArray(shortIndices);
+            }
+            m_IndexBufferCapacity = quadCount;
+            
+            //Delete the indices array
+            SafeDeleteArray(indices);
+        }
+        
+        //The vertex attributes need to be set again for the new vertex buffer data
+        m_AttributeShader = nullptr;
+        
+        //Unbind the VAO
+        graphics->BindVertexArray(0);
+    }
+    
+    void Label::UpdateGlyphBuffer()
+    {
+        //The dirty range is no longer dirty, the bounds contain the glyph quads
+        m_GlyphRangeIsDirty = false;
+        WorldBoundsAreDirty();
+        
+        //Calculate the baseline and origin for the label, the same way BuildGlyphBuffer() does
+        unsigned int baseline = m_Font->GetLineHeight() - m_Font->GetBaseLine();
+        unsigned int lineIndex = 0;
+        vec2 origin(CalculateLineOrigin(lineIndex), baseline + (m_Font->GetLineHeight() * (GetNumberOfLines() - 1)));
+        
+        //Cycle through the characters up to the end of the dirty range, only the quads in the range are rebuilt
+        unsigned int glyphIndex = 0;
+        unsigned int firstGlyph = 0;
+        for(unsigned int i = 0; i <= m_DirtyRangeEnd; i++)
+        {
+            //Did we reach a new line?
+            if(m_Text.at(i) == '\n')
+            {
+                //Increment the line index and calculate the line's origin based on the justification
+                lineIndex++;
+                origin.x = CalculateLineOrigin(lineIndex);
+                
+                //Set the y line origin based on the line height of the font
+                origin.y -= m_Font->GetLineHeight();
+                continue;
+            }
+            
+            //Is this the first character in the dirty range?
+            if(i == m_DirtyRangeStart)
+            {
+                firstGlyph = glyphIndex;
+            }
+            
+            //Only the characters with a texture have a quad
+            if(m_Font->GetTextureForCharacter(m_Text.at(i)) != nullptr)
+            {
+                //Rebuild the character's quad in place, if it is in the dirty range
+                if(i >= m_DirtyRangeStart && (glyphIndex + 1) * 4 <= m_GlyphVertices.size())
+                {
+                    vec2 charPosition = origin;
+                    charPosition.x += m_Font->GetBearingXForCharacter(m_Text.at(i));
+                    charPosition.y += m_Font->GetBearingYForCharacter(m_Text.at(i)) - m_Font->GetSourceFrameForCharacter(m_Text.at(i)).size.y;
+                    CalculateGlyphVertices(m_Text.at(i), charPosition, &m_GlyphVertices[glyphIndex * 4]);
+                }
+                
+                //Increment the glyph index and the origin
+                glyphIndex++;
+                origin.x += m_Font->GetAdvanceXForCharacter(m_Text.at(i)) + GetCharacterSpacing();
+            }
+        }
+        
+        //Safety check the quad count, the glyph buffer is rebuilt if it doesn't match
+        if(glyphIndex * 4 > m_GlyphVertices.size() || glyphIndex <= firstGlyph)
+        {
+            BuildGlyphBuffer();
+            return;
+        }
+        
+        //Upload only the quads that were rebuilt
+        unsigned int glyphCount = glyphIndex - firstGlyph;
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        graphics->BindArrayBuffer(m_VertexBufferObject);
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(LabelGlyphVertex) * firstGlyph * 4, sizeof(LabelGlyphVertex) * glyphCount * 4, &m_GlyphVertices[firstGlyph * 4]);
+        graphics->LabelGlyphBufferUpdated(glyphCount);
     }
     
-    void Label::DrawCharacter(TextureFrame* aTextureFrame, vec2 aPosition)
-    {    
-        //Translate the anchor, then translate the position
+    void Label::AddGlyph(char aCharacter, vec2 aPosition)
+    {
+        //Calculate the vertices for the quad and add them
+        LabelGlyphVertex vertices[4];
+        CalculateGlyphVertices(aCharacter, aPosition, vertices);
+        for(unsigned int i = 0; i < 4; i++)
+        {
+            m_GlyphVertices.push_back(vertices[i]);
+        }
+        
+        //Extend the current run if the character is on the same texture, otherwise start a new run
+        Texture* texture = m_Font->GetTextureForCharacter(aCharacter);
+        if(m_GlyphRuns.size() > 0 && m_GlyphRuns.back().texture == texture)
+        {
+            m_GlyphRuns.back().count++;
+        }
+        else
+        {
+            LabelGlyphRun run;
+            run.texture = texture;
+            run.start = (unsigned int)(m_GlyphVertices.size() / 4) - 1;
+            run.count = 1;
+            m_GlyphRuns.push_back(run);
+        }
+    }
+    
+    void Label::CalculateGlyphVertices(char aCharacter, vec2 aPosition, LabelGlyphVertex* aVertices)
+    {
+        //Get the texture and source frame for the character
+        Texture* texture = m_Font->GetTextureForCharacter(aCharacter);
+        SourceFrame sourceFrame = m_Font->GetSourceFrameForCharacter(aCharacter);
+        vec2 size = sourceFrame.size;
+        
+        //Calculate the character's matrix, the character is rotated around its center
         mat4 viewTranslate = translate(mat4(1.0f), vec3(aPosition.x, aPosition.y, 0.0f));
-
-        //Get the size of the character
-        vec2 size = vec2(aTextureFrame->GetSourceFrame().size.x, aTextureFrame->GetSourceFrame().size.y);
-
-        //Calculate the model matrix
         mat4 halfTranslate = translate(viewTranslate, vec3((size.x / 2.0f), (size.y / 2.0f), 0.0f));
         mat4 viewRotation = rotate(halfTranslate, m_CharacterAngle, vec3(0.0f, 0.0f, 1.0f));
-        mat4 modelMatrix = translate(viewRotation, vec3(-(size.x / 2.0f), -(size.y / 2.0f), 0.0f));
+        mat4 characterMatrix = translate(viewRotation, vec3(-(size.x / 2.0f), -(size.y / 2.0f), 0.0f));
 
-        //Render the character as white
-        Color color = Color::WhiteColor();
+        //Build the UV Coordinates, the same way the TextureFrame does
+        float x1 = sourceFrame.position.x / (float)texture->GetSize().x;
+        float y1 = 1.0f - ((sourceFrame.position.y + sourceFrame.size.y) / (float)texture->GetSize().y);
+        float x2 = (sourceFrame.position.x + sourceFrame.size.x) / (float)texture->GetSize().x;
+        float y2 = 1.0f - (sourceFrame.position.y / (float)texture->GetSize().y);
 
-        //Unless the text has a length of 1, in which case we aren't rendering with the render target
-        if(m_Text.length() <= 1)
+        //The corners of the quad, in the same order as the TextureFrame's triangle strip
+        const vec2 corners[4] = { vec2(0.0f, 0.0f), vec2(size.x, 0.0f), vec2(0.0f, size.y), vec2(size.x, size.y) };
+        const vec2 uvCoordinates[4] = { vec2(x1, y1), vec2(x2, y1), vec2(x1, y2), vec2(x2, y2) };
+        
+        //Set the vertices for the quad
+        for(unsigned int i = 0; i < 4; i++)
         {
-            modelMatrix = m_ModelMatrix * modelMatrix;
-            color = GetColor();
+            vec4 position = characterMatrix * vec4(corners[i].x, corners[i].y, 0.0f, 1.0f);
+            aVertices[i].x = position.x;
+            aVertices[i].y = position.y;
+            aVertices[i].u = uvCoordinates[i].x;
+            aVertices[i].v = uvCoordinates[i].y;
         }
-        
-        //Set the texture frame's shader and color
-        aTextureFrame->SetShader(m_Shader);
-        aTextureFrame->SetColor(color);
-
-        //Draw the character
-        aTextureFrame->Draw(modelMatrix);
     }
-}
+    
+    void Label::SetVertexAttributes()
+    {
+        //The attribute locations only need to be set when the shader or the vertex buffer changes
+        if(m_AttributeShader == m_Shader)
+        {
+            return;
+        }
+        m_AttributeShader = m_Shader;
 
+        //Bind the vertex buffer
+        ServiceLocator::GetGraphics()->BindArrayBuffer(m_VertexBufferObject);
+        
+        //Enable and set the shader's vertices attribute
+        int verticesIndex = m_Shader->GetAttribute("a_vertices");
+        glEnableVertexAttribArray(verticesIndex);
+        long verticesOffset = 0;
+        glVertexAttribPointer(verticesIndex, 2, GL_FLOAT, GL_FALSE, sizeof(LabelGlyphVertex), (const GLvoid*)verticesOffset);
+        
+        //Enable and set the shader's texture coordinates attribute
+        int uvIndex = m_Shader->GetAttribute("a_textureCoordinates");
+        glEnableVertexAttribArray(uvIndex);
+        long uvOffset = 2 * sizeof(float);
+        glVertexAttribPointer(uvIndex, 2, GL_FLOAT, GL_FALSE, sizeof(LabelGlyphVertex), (const GLvoid*)uvOffset);
+        
+        //The color is the same for every character, it is set as a constant attribute when drawing
+        int colorIndex = m_Shader->GetAttribute("a_textureColor");
+        glDisableVertexAttribArray(colorIndex);
+    }
+    
+    void Label::DrawText()
+    {
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        
+        //Any pending render commands for the VAO still need the old glyphs, submit them before the glyph buffer changes
+        if((m_GlyphBufferIsDirty == true || m_GlyphRangeIsDirty == true) && graphics->GetRenderQueue()->HasPendingCommands(m_VertexArrayObject) == true)
+        {
+            graphics->GetRenderQueue()->Submit();
+        }
+        
+        //Rebuild the glyph buffer if it is dirty, otherwise update the characters that changed
+        if(m_GlyphBufferIsDirty == true)
+        {
+            BuildGlyphBuffer();
+        }
+        else if(m_GlyphRangeIsDirty == true)
+        {
+            UpdateGlyphBuffer();
+        }
+        
+        //Are there any characters to render?
+        if(m_GlyphRuns.size() == 0)
+        {
+            return;
+        }
+        
+        //Bind the vertex array object and set the vertex attributes
+        graphics->BindVertexArray(m_VertexArrayObject);
+        SetVertexAttributes();
+        
+        //Setup the render command, the model view projection matrix and the color are the same for every run
+        RenderCommand command = MakeRenderCommand(m_Shader, nullptr, m_VertexArrayObject, GL_TRIANGLES, 0, 0);
+        command.indexType = m_IndexType;
+        command.modelViewProjection = graphics->GetProjectionMatrix() * graphics->GetViewMatrix() * m_ModelMatrix;
+        command.colorAttribute = m_Shader->GetAttribute("a_textureColor");
+        command.color = m_Color;
+        
+        //Add a render command for each run of characters, there is only one run unless a BitmapFont has more than one page
+        for(unsigned int i = 0; i < m_GlyphRuns.size(); i++)
+        {
+            //Set the run's texture and index range, each character has six indices
+            LabelGlyphRun& run = m_GlyphRuns.at(i);
+            command.texture = run.texture;
+            command.first = run.start * 6;
+            command.count = run.count * 6;
+            
+            //Enable blending if the texture has an alpha channel, otherwise disable it
+            if(run.texture->GetFormat() == GL_RGBA || m_Color.a != 1.0f)
+            {
+                command.blending = RenderCommandBlendingAlpha;
+            }
+            else
+            {
+                command.blending = RenderCommandBlendingNone;
+            }
+            
+            //Add the render command, it is submitted by the Graphics service's RenderQueue
+            graphics->GetRenderQueue()->AddCommand(command);
+        }
+        
+        //Unbind the vertex array
+        graphics->BindVertexArray(0);
+    }
+}
\ No newline at end of file
@@ -24,8 +24,7 @@ namespace GameDev2D
 {
     //Forward declarations
     class Shader;
-    class RenderTarget;
-    class TextureFrame;
+    class Texture;
     
     //Label text can be left, center and right justified
     enum LabelJustification
@@ -39,7 +38,8 @@ namespace GameDev2D
     //a BitmapFont or a TrueTypeFont. The anchor points, alpha, character angle and character
     //spacing can all be animated, with easing applied. Label's created with Bitmap fonts must
     //use the 'Glyph Designer' software, see the BitmapFont header file for more info. Internally
-    //the Label renders the text to a render target to ensure there is only 1 draw call instead of several
+    //the Label builds one vertex buffer with a quad for each character, which is only rebuilt when the
+    //text, font, spacing, justification or character angle changes, and renders it with 1 draw call
     class Label : public GameObject
     {
     public:
@@ -78,6 +78,9 @@ namespace GameDev2D
         float GetWidth();
         float GetHeight();
         
+        //Sets the local bounds of the Label's text, used to cull the Label
+        bool GetLocalBounds(BoundingBox& bounds);
+        
         //Sets the anchor point for the Label, can be set to animate over a duration, an easing function can be applied, can be revered and repeated
         void SetAnchorX(float anchorX, double duration = 0.0, EasingFunction easingFunction = Linear::Interpolation, bool reverse = false, int repeatCount = 0);
         void SetAnchorY(float anchorY, double duration = 0.0, EasingFunction easingFunction = Linear::Interpolation, bool reverse = false, int repeatCount = 0);
@@ -124,31 +127,62 @@ namespace GameDev2D
         void CancelTweens();
         
     private:
+        //Interleaved vertex format used to render the characters
+        struct LabelGlyphVertex
+        {
+            float x, y;
+            float u, v;
+        };
+        
+        //A run of consecutive characters that are on the same Texture, rendered with a single draw call
+        struct LabelGlyphRun
+        {
+            Texture* texture;
+            unsigned int start;
+            unsigned int count;
+        };
+        
         //Used to Reset the Model Matrix
         void ResetModelMatrix();
         
-        //Conveniance methods to resize and reset the render target
-        void ResizeRenderTarget();
-        void ResetRenderTarget();
+        //Conveniance methods to resize the Label and to flag the glyph buffer to be rebuilt
+        void ResizeGlyphBuffer();
+        void ResetGlyphBuffer();
         
         //Conveniance method to calculate the size of the Label, based on the text
         vec2 CalculateSize();
         
+        //Conveniance method to calculate the x origin of a line, based on the justification
+        float CalculateLineOrigin(unsigned int lineIndex);
+        
+        //Returns wether the characters between the start and end index can be updated in place, without
+        //re-laying out the rest of the text. The line widths and the character textures can't change
+        bool CanUpdateGlyphRange(const string& previousText, unsigned int start, unsigned int end);
+        
+        //Conveniance method to rebuild the glyph quads and upload them to the vertex buffer
+        void BuildGlyphBuffer();
+        
+        //Conveniance method to rebuild only the glyph quads in the dirty range and upload them to the vertex buffer
+        void UpdateGlyphBuffer();
+        
+        //Conveniance methods to add the quad for an individual character, and to calculate a quad's vertices
+        void AddGlyph(char character, vec2 position);
+        void CalculateGlyphVertices(char character, vec2 position, LabelGlyphVertex* vertices);
+        
+        //Conveniance method to set the shader's vertex attributes for the interleaved vertex format
+        void SetVertexAttributes();
+        
         //Conveniance method to draw the text
         void DrawText();
-        
-        //Conveniance method to draw an individual character
-        void DrawCharacter(TextureFrame* textureFrame, vec2 position);
     
         //Member variables
         Font* m_Font;
         Shader* m_Shader;
-        RenderTarget* m_RenderTarget;
         LabelJustification m_Justification;
         string m_Text;
         vec2 m_Size;
         vec2 m_AnchorPoint;
-        Color m_Color;
+        ColorRGBA m_Color;
         float m_CharacterAngle;
         float m_CharacterSpacing;
         vector<float> m_LineWidth;
@@ -157,6 +191,20 @@ namespace GameDev2D
         Tween m_TweenAlpha;
         Tween m_TweenCharacterAngle;
         Tween m_TweenCharacterSpacing;
+        
+        //Glyph buffer member variables
+        vector<LabelGlyphVertex> m_GlyphVertices;
+        vector<LabelGlyphRun> m_GlyphRuns;
+        bool m_GlyphBufferIsDirty;
+        bool m_GlyphRangeIsDirty;
+        unsigned int m_DirtyRangeStart;
+        unsigned int m_DirtyRangeEnd;
+        Shader* m_AttributeShader;
+        unsigned int m_VertexArrayObject;
+        unsigned int m_VertexBufferObject;
+        unsigned int m_IndexBufferObject;
+        unsigned int m_IndexBufferCapacity;
+        unsigned int m_IndexType;
     };
 }
 
@@ -8,6 +8,7 @@
 
 #include "Sprite.h"
 #include "../../Graphics/Textures/TextureFrame.h"
+#include "../../Graphics/Textures/AnimationClip.h"
 #include "../../Services/ServiceLocator.h"
 #include "../../Platforms/PlatformLayer.h"
 
@@ -21,10 +22,11 @@
 
 namespace GameDev2D
 {
-    Sprite::Sprite(const string& aFilename, const string& aAtlasKey) : GameObject("Sprite"),
+    Sprite::Sprite(const string& aFilename, const string& aAtlasKey, SpriteLoadMode aLoadMode) : GameObject("Sprite"),
+        m_AnimationClip(nullptr),
         m_Shader(nullptr),
         m_AnchorPoint(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_DoesLoop(false),
         m_FrameSpeed(0.0f),
         m_ElapsedTime(0.0),
@@ -32,13 +34,23 @@ namespace GameDev2D
         m_TweenAnchorX(),
         m_TweenAnchorY(),
         m_TweenAlpha(),
-        m_DidDispatchFinishedEvent(false)
+        m_DidDispatchFinishedEvent(false),
+        m_IsWaitingForTexture(false)
     {
         //Get the passthrough texture shader
         SetShader(ServiceLocator::GetShaderManager()->GetPassthroughTextureShader());
     
-        //Create the texture frame object
-        AddFrame(new TextureFrame(aFilename, aAtlasKey, "Images/"));
+        //If the image was packed into a texture atlas, use the atlas frame instead of the image
+        string filename = string(aFilename);
+        string atlasKey = string(aAtlasKey);
+        if(atlasKey == "")
+        {
+            ServiceLocator::GetTextureManager()->GetPackedImage(aFilename, filename, atlasKey);
+        }
+        
+        //Create the texture frame object, if it is loaded asynchronously the Sprite's size changes when the texture is uploaded
+        AddFrame(new TextureFrame(filename, atlasKey, "Images/", aLoadMode == SpriteLoadAsync));
+        m_IsWaitingForTexture = m_Frames.at(0)->IsWaitingForTexture();
         
         //Initialize the frame index
         SetFrameIndex(0);
@@ -47,10 +59,11 @@ namespace GameDev2D
         ModelMatrixIsDirty(true);
     }
     
-    Sprite::Sprite(Shader* aShader, const string& aFilename, const string& aAtlasKey) : GameObject("Sprite"),
+    Sprite::Sprite(Shader* aShader, const string& aFilename, const string& aAtlasKey, SpriteLoadMode aLoadMode) : GameObject("Sprite"),
+        m_AnimationClip(nullptr),
         m_Shader(nullptr),
         m_AnchorPoint(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_DoesLoop(false),
         m_FrameSpeed(0.0f),
         m_ElapsedTime(0.0),
@@ -58,13 +71,23 @@ namespace GameDev2D
         m_TweenAnchorX(),
         m_TweenAnchorY(),
         m_TweenAlpha(),
-        m_DidDispatchFinishedEvent(false)
+        m_DidDispatchFinishedEvent(false),
+        m_IsWaitingForTexture(false)
     {
         //Set the shader
         SetShader(aShader);
     
-        //Create the texture frame object
-        AddFrame(new TextureFrame(aFilename, aAtlasKey, "Images/"));
+        //If the image was packed into a texture atlas, use the atlas frame instead of the image
+        string filename = string(aFilename);
+        string atlasKey = string(aAtlasKey);
+        if(atlasKey == "")
+        {
+            ServiceLocator::GetTextureManager()->GetPackedImage(aFilename, filename, atlasKey);
+        }
+        
+        //Create the texture frame object, if it is loaded asynchronously the Sprite's size changes when the texture is uploaded
+        AddFrame(new TextureFrame(filename, atlasKey, "Images/", aLoadMode == SpriteLoadAsync));
+        m_IsWaitingForTexture = m_Frames.at(0)->IsWaitingForTexture();
         
         //Initialize the frame index
         SetFrameIndex(0);
@@ -74,9 +97,10 @@ namespace GameDev2D
     }
     
     Sprite::Sprite(const string& aImageFile, const string& aJsonFile, bool aDoesLoop, float aFrameSpeed) : GameObject("Sprite"),
+        m_AnimationClip(nullptr),
         m_Shader(nullptr),
         m_AnchorPoint(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_DoesLoop(aDoesLoop),
         m_FrameSpeed(aFrameSpeed),
         m_ElapsedTime(0.0),
@@ -84,7 +108,8 @@ namespace GameDev2D
         m_TweenAnchorX(),
         m_TweenAnchorY(),
         m_TweenAlpha(),
-        m_DidDispatchFinishedEvent(false)
+        m_DidDispatchFinishedEvent(false),
+        m_IsWaitingForTexture(false)
     {
         //Get the passthrough texture shader
         SetShader(ServiceLocator::GetShaderManager()->GetPassthroughTextureShader());
@@ -100,9 +125,10 @@ namespace GameDev2D
     }
     
     Sprite::Sprite(Shader* aShader, const string& aImageFile, const string& aJsonFile, bool aDoesLoop, float aFrameSpeed) : GameObject("Sprite"),
+        m_AnimationClip(nullptr),
         m_Shader(nullptr),
         m_AnchorPoint(0.0f, 0.0f),
-        m_Color(Color::WhiteColor()),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
         m_DoesLoop(aDoesLoop),
         m_FrameSpeed(aFrameSpeed),
         m_ElapsedTime(0.0),
@@ -110,7 +136,8 @@ namespace GameDev2D
         m_TweenAnchorX(),
         m_TweenAnchorY(),
         m_TweenAlpha(),
-        m_DidDispatchFinishedEvent(false)
+        m_DidDispatchFinishedEvent(false),
+        m_IsWaitingForTexture(false)
     {
         //Set the Shader
         SetShader(aShader);
@@ -138,6 +165,13 @@ namespace GameDev2D
         }
         
         m_Frames.clear();
+        
+        //Release the shared animation clip
+        if(m_AnimationClip != nullptr)
+        {
+            ServiceLocator::GetTextureManager()->RemoveAnimationClip(m_AnimationClip);
+            m_AnimationClip = nullptr;
+        }
     }
     
     void Sprite::Update(double aDelta)
@@ -146,7 +180,14 @@ namespace GameDev2D
         UpdateTween(aDelta, &m_TweenAnchorX, static_cast<GameObject::TweenSetMethod>(&Sprite::SetAnchorX));
         UpdateTween(aDelta, &m_TweenAnchorY, static_cast<GameObject::TweenSetMethod>(&Sprite::SetAnchorY));
         UpdateTween(aDelta, &m_TweenAlpha, static_cast<GameObject::TweenSetMethod>(&Sprite::SetAlpha));
-    
+        
+        //If the Sprite's texture was loaded asynchronously and has been uploaded, the Sprite's size has changed
+        if(m_IsWaitingForTexture == true && m_Frames.at(0)->IsWaitingForTexture() == false)
+        {
+            m_IsWaitingForTexture = false;
+            ModelMatrixIsDirty(true);
+        }
+        
         //Is the Sprite animated
         if(IsAnimated() == true)
         {
@@ -188,7 +229,7 @@ namespace GameDev2D
     void Sprite::Draw()
     {
         //Safety check the texture frame
-        if(m_Frames.size() == 0)
+        if(GetFrameCount() == 0)
         {
             Error(false, "Failed to draw sprite, there aren't any frames to draw");
             return;
@@ -201,8 +242,27 @@ namespace GameDev2D
             return;
         }
         
-        //Draw the current frame
-        m_Frames.at(m_FrameIndex)->Draw(m_ModelMatrix);
+        //Draw the current frame, if the SpriteBatch is batching add the frame to the batch instead
+        SpriteBatch* spriteBatch = ServiceLocator::GetGraphics()->GetSpriteBatch();
+        if(m_AnimationClip != nullptr)
+        {
+            if(spriteBatch->IsBatching() == true)
+            {
+                spriteBatch->AddQuad(m_Shader, m_AnimationClip->GetTexture(), m_AnimationClip->GetSourceFrame(m_FrameIndex), m_Color, m_ModelMatrix);
+            }
+            else
+            {
+                m_AnimationClip->Draw(m_FrameIndex, m_ModelMatrix, m_Shader, m_Color);
+            }
+        }
+        else if(spriteBatch->IsBatching() == true)
+        {
+            spriteBatch->AddQuad(m_Frames.at(m_FrameIndex), m_ModelMatrix);
+        }
+        else
+        {
+            m_Frames.at(m_FrameIndex)->Draw(m_ModelMatrix);
+        }
         
         #if DRAW_SPRITE_RECT
         Rect rect(GetWorldPosition().x, GetWorldPosition().y, GetWidth(), GetHeight());
@@ -251,7 +311,11 @@ namespace GameDev2D
     
     float Sprite::GetWidth()
     {
-        if(m_Frames.size() > 0)
+        if(m_AnimationClip != nullptr)
+        {
+            return m_AnimationClip->GetSourceFrame(m_FrameIndex).size.x;
+        }
+        else if(m_Frames.size() > 0)
         {
             return m_Frames.at(m_FrameIndex)->GetSourceFrame().size.x;
         }
@@ -260,13 +324,24 @@ namespace GameDev2D
     
     float Sprite::GetHeight()
     {
-        if(m_Frames.size() > 0)
+        if(m_AnimationClip != nullptr)
+        {
+            return m_AnimationClip->GetSourceFrame(m_FrameIndex).size.y;
+        }
+        else if(m_Frames.size() > 0)
         {
             return m_Frames.at(m_FrameIndex)->GetSourceFrame().size.y;
         }
         return 0.0f;
     }
     
+    bool Sprite::GetLocalBounds(BoundingBox& aBounds)
+    {
+        //The model matrix already factors in the anchor point, scale and angle
+        aBounds = MakeBoundingBox(vec2(0.0f, 0.0f), GetSize());
+        return true;
+    }
+    
     void Sprite::SetAnchorX(float aAnchorX, double aDuration, EasingFunction aEasingFunction, bool aReverse, int aRepeatCount)
     {
         if(aDuration == 0.0)
@@ -320,7 +395,7 @@ namespace GameDev2D
         if(aDuration == 0.0)
         {
             //Set the alpha
-            m_Color.SetAlpha(aAlpha);
+            m_Color.a = fminf(fmaxf(aAlpha, 0.0f), 1.0f);
             
             //And update the color for all the frames
             for(unsigned int i = 0; i < m_Frames.size(); i++)
@@ -330,16 +405,16 @@ namespace GameDev2D
         }
         else
         {
-            if(m_Color.Alpha() != aAlpha)
+            if(m_Color.a != aAlpha)
             {
-                m_TweenAlpha.Set(m_Color.Alpha(), aAlpha, aDuration, aEasingFunction, aReverse, aRepeatCount);
+                m_TweenAlpha.Set(m_Color.a, aAlpha, aDuration, aEasingFunction, aReverse, aRepeatCount);
             }
         }
     }
     
     float Sprite::GetAlpha()
     {
-        return m_Color.Alpha();
+        return m_Color.a;
     }
     
     void Sprite::AddFrame(TextureFrame* aTextureFrame)
@@ -347,8 +422,15 @@ namespace GameDev2D
         assert(aTextureFrame != nullptr);
         if(aTextureFrame != nullptr)
         {
+            //If the Sprite uses a shared animation clip, replace it with texture frames before adding the frame
+            if(m_AnimationClip != nullptr)
+            {
+                ReleaseAnimationClip();
+            }
+            
             //Add a texture frame to the frames vector
             m_Frames.push_back(aTextureFrame);
+            WorldBoundsAreDirty();
             
             //Set the texture frame's shader and color
             if(m_Shader != nullptr)
@@ -361,11 +443,15 @@ namespace GameDev2D
     
     bool Sprite::IsAnimated()
     {
-        return m_Frames.size() > 1;
+        return GetFrameCount() > 1;
     }
 
     unsigned long Sprite::GetFrameCount()
     {
+        if(m_AnimationClip != nullptr)
+        {
+            return m_AnimationClip->GetFrameCount();
+        }
         return m_Frames.size();
     }
 
@@ -381,6 +467,9 @@ namespace GameDev2D
         {
             //Set the frames index.
             m_FrameIndex = aFrameIndex;
+            
+            //The frame's size can be different
+            WorldBoundsAreDirty();
 
             //Is the sprite animated
             if(IsAnimated() == true)
@@ -436,51 +525,29 @@ namespace GameDev2D
     
     void Sprite::LoadFrames(const string& aImageFile, const string& aJsonFile)
     {
-        //Append the filename to the directory
-        string jsonFile = aJsonFile;
+        //Get the shared animation clip from the TextureManager, it is only loaded once for all the Sprites that use it
+        m_AnimationClip = ServiceLocator::GetTextureManager()->AddAnimationClip(aImageFile, aJsonFile);
+    }
     
-        //Was .json appended to the filename? If it was, remove it
-        size_t found = jsonFile.find(".json");
-        if(found != std::string::npos)
+    void Sprite::ReleaseAnimationClip()
+    {
+        //Safety check the animation clip
+        if(m_AnimationClip == nullptr)
         {
-            jsonFile.erase(found, 5);
+            return;
         }
-    
-        //Get the json path
-        string jsonPath = ServiceLocator::GetPlatformLayer()->GetPathForResourceInDirectory(jsonFile.c_str(), "json", "Images");
         
-        //Does the json file exist, if the assert is hit it means the json file doesn't exist
-        bool doesExist = ServiceLocator::GetPlatformLayer()->DoesFileExistAtPath(jsonPath);
-        assert(doesExist == true);
+        //Get the animation clip and set the member to null, so that AddFrame() adds the frames to the frames vector
+        AnimationClip* animationClip = m_AnimationClip;
+        m_AnimationClip = nullptr;
         
-        //Does the file exist, load the json data
-        if(doesExist == true)
+        //Cycle through and add a texture frame for each frame in the animation clip
+        for(unsigned int i = 0; i < animationClip->GetFrameCount(); i++)
         {
-            //Open the input stream
-            std::ifstream inputStream;
-            inputStream.open(jsonPath, std::ifstream::in);
-            
-            //Parse the json file
-            Json::Value root;
-            Json::Reader reader;
-            if(reader.parse(inputStream, root, false) == true)
-            {
-                //Get the frames data
-                const Json::Value frames = root["frames"];
-                
-                //Cycle through and setup each frame in the animation
-                for(unsigned int index = 0; index < frames.size(); index++)
-                {
-                    //Get the atlas key
-                    Json::Value atlasKey = frames[index]["filename"];
-
-                    //Add the frame
-                    AddFrame(new TextureFrame(aImageFile, atlasKey.asString(), "Images"));
-                }
-            }
-            
-            //Close the input stream
-            inputStream.close();
+            AddFrame(new TextureFrame(animationClip->GetImageFile(), animationClip->GetAtlasKey(i), "Images"));
         }
+        
+        //Release the shared animation clip
+        ServiceLocator::GetTextureManager()->RemoveAnimationClip(animationClip);
     }
 }
\ No newline at end of file
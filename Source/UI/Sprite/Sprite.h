@@ -20,25 +20,36 @@ namespace GameDev2D
 {
     //Forward declarations
     class TextureFrame;
+    class AnimationClip;
     class Shader;
     
+    //Sprites loaded from a single image can be loaded synchronously or asynchronously, an asynchronously loaded
+    //Sprite displays the checkerboard texture until its texture is uploaded by the TextureManager
+    enum SpriteLoadMode
+    {
+        SpriteLoadSync = 0,
+        SpriteLoadAsync
+    };
+    
     //The Sprite class inherits from the GameObject class and the EventDispatcher class. It can display a
     //single framed Sprite OR an animated Sprite. It is designed to load animated sprites or sprites from
     //a texture atlas created using the'Texture Packer' software created by Code and Web https://www.codeandweb.com/texturepacker
     //You can add frames after construction from different Textures. The anchor points, and the alpha, can be animated.
+    //Animated Sprites loaded from a json file share an AnimationClip with all the other Sprites that use the
+    //same animation, the Sprite itself only holds the frame index, elapsed time and color.
     //This class dispatches the following events:
     // SPRITE_DID_FINISH_ANIMATING
     class Sprite : public GameObject, public EventDispatcher
     {
     public:
         //Constructs a sprite with a single frame, can be loaded from a single image
-        //or as an optional texture atlas via the atlas key
-        Sprite(const string& filename, const string& atlasKey = "");
+        //or as an optional texture atlas via the atlas key, and optionally loaded asynchronously
+        Sprite(const string& filename, const string& atlasKey = "", SpriteLoadMode loadMode = SpriteLoadSync);
         
         //Constructs a sprite with a single frame, can be loaded from a single image
-        //or as an optional texture atlas via the atlas key. In addition the shader used
-        //can be specified, the Sprite takes ownership of the Shader and will remove it
-        Sprite(Shader* shader, const string& filename, const string& atlasKey = "");
+        //or as an optional texture atlas via the atlas key, and optionally loaded asynchronously.
+        //In addition the shader used can be specified, the Sprite takes ownership of the Shader and will remove it
+        Sprite(Shader* shader, const string& filename, const string& atlasKey = "", SpriteLoadMode loadMode = SpriteLoadSync);
         
         //Constructs an animated sprite from a json file, it can be set to loop and optionally
         //the frame speed can be set. A lower frame speed means the slower the sprite animates
@@ -68,6 +79,9 @@ namespace GameDev2D
         float GetWidth();
         float GetHeight();
         
+        //Sets the local bounds of the Sprite's current frame, used to cull the Sprite
+        bool GetLocalBounds(BoundingBox& bounds);
+        
         //Sets the anchor point for the Sprite, can be set to animate over a duration, an easing function can be applied, can be revered and repeated
         void SetAnchorX(float anchorX, double duration = 0.0, EasingFunction easingFunction = Linear::Interpolation, bool reverse = false, int repeatCount = 0);
         void SetAnchorY(float anchorY, double duration = 0.0, EasingFunction easingFunction = Linear::Interpolation, bool reverse = false, int repeatCount = 0);
@@ -114,11 +128,16 @@ namespace GameDev2D
         //Conveniance method that loads the animated sprite from the json file
         void LoadFrames(const string& imageFile, const string& jsonFile);
         
+        //Conveniance method that replaces the shared AnimationClip with TextureFrames owned by the Sprite,
+        //called when a frame is added to a Sprite that uses an AnimationClip
+        void ReleaseAnimationClip();
+        
         //Member variables
         vector<TextureFrame*> m_Frames;
+        AnimationClip* m_AnimationClip;
         Shader* m_Shader;
         vec2 m_AnchorPoint;
-        Color m_Color;
+        ColorRGBA m_Color;
         bool m_DoesLoop;
         float m_FrameSpeed;
         double m_ElapsedTime;
@@ -127,6 +146,7 @@ namespace GameDev2D
         Tween m_TweenAnchorY;
         Tween m_TweenAlpha;
         bool m_DidDispatchFinishedEvent;
+        bool m_IsWaitingForTexture;
     };
 }
 
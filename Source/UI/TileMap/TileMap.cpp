@@ -0,0 +1,357 @@
+//
+//  TileMap.cpp
+//  GameDev2D
+//
+
+#include "TileMap.h"
+#include "../../Graphics/Textures/Texture.h"
+#include "../../Graphics/Textures/TextureFrame.h"
+#include "../../Services/ServiceLocator.h"
+#include "../../Platforms/PlatformLayer.h"
+
+
+#ifndef TILE_MAP_MAX_PREFETCH_LOADS_PER_FRAME
+#define TILE_MAP_MAX_PREFETCH_LOADS_PER_FRAME 1
+#endif
+
+
+namespace GameDev2D
+{
+    TileMap::TileMap(const string& aFilename, const string& aDirectory, TextureFilter aFilter, bool aGenerateMipmaps) : GameObject("TileMap"),
+        m_Filename(aFilename),
+        m_Directory(aDirectory),
+        m_Shader(nullptr),
+        m_Size(0.0f, 0.0f),
+        m_TileSize(0.0f, 0.0f),
+        m_Columns(0),
+        m_Rows(0),
+        m_IsTiled(false),
+        m_AnchorPoint(0.0f, 0.0f),
+        m_Color(MakeColorRGBA(1.0f, 1.0f, 1.0f, 1.0f)),
+        m_Filter(aFilter),
+        m_GenerateMipmaps(aGenerateMipmaps),
+        m_VisibleTiles(0),
+        m_ResidentTiles(0)
+    {
+        //Get the passthrough texture shader
+        m_Shader = ServiceLocator::GetShaderManager()->GetPassthroughTextureShader();
+        
+        //Load the tile descriptor, if it doesn't exist the image is streamed as a single tile
+        m_IsTiled = LoadDescriptor();
+        if(m_IsTiled == false)
+        {
+            //Stream the image to get its size
+            Texture* texture = ServiceLocator::GetTextureManager()->GetStreamedTexture(m_Filename, m_Directory, true, m_Filter, m_GenerateMipmaps);
+            if(texture != nullptr)
+            {
+                m_Size = vec2(texture->GetSize().x, texture->GetSize().y);
+                m_TileSize = m_Size;
+                m_Columns = 1;
+                m_Rows = 1;
+            }
+        }
+        
+        //Reset the model matrix
+        ModelMatrixIsDirty(true);
+    }
+    
+    TileMap::~TileMap()
+    {
+        //Set the shader to null, the streamed tiles are evicted by the TextureManager
+        m_Shader = nullptr;
+    }
+    
+    void TileMap::Draw()
+    {
+        //Reset the tile counts
+        m_VisibleTiles = 0;
+        m_ResidentTiles = 0;
+        
+        //Safety check the shader
+        if(m_Shader == nullptr)
+        {
+            Error(false, "Failed to draw tile map, the shader is null");
+            return;
+        }
+        
+        //Safety check the tiles
+        if(m_Columns == 0 || m_Rows == 0)
+        {
+            Error(false, "Failed to draw tile map, there aren't any tiles to draw");
+            return;
+        }
+        
+        //By default every tile is visible
+        int firstColumn = 0;
+        int lastColumn = m_Columns - 1;
+        int firstRow = 0;
+        int lastRow = m_Rows - 1;
+        
+        //If there is an active camera, only the tiles that overlap its view are visible
+        Graphics* graphics = ServiceLocator::GetGraphics();
+        Camera* camera = graphics->GetActiveCamera();
+        if(camera != nullptr && IsBoundingBoxEmpty(camera->GetViewBounds()) == false)
+        {
+            //Transform the view bounds into the TileMap's local space, row zero is the top of the image
+            BoundingBox localBounds = TransformBoundingBox(camera->GetViewBounds(), inverse(m_ModelMatrix));
+            
+            //Calculate the visible tiles, clamped to one tile outside the TileMap on each side
+            firstColumn = (int)fminf(fmaxf(floorf(localBounds.min.x / m_TileSize.x), -1.0f), (float)m_Columns);
+            lastColumn = (int)fminf(fmaxf(floorf(localBounds.max.x / m_TileSize.x), -1.0f), (float)m_Columns);
+            firstRow = (int)fminf(fmaxf(floorf((m_Size.y - localBounds.max.y) / m_TileSize.y), -1.0f), (float)m_Rows);
+            lastRow = (int)fminf(fmaxf(floorf((m_Size.y - localBounds.min.y) / m_TileSize.y), -1.0f), (float)m_Rows);
+        }
+        
+        //Begin the SpriteBatch, if it isn't already batching
+        SpriteBatch* spriteBatch = graphics->GetSpriteBatch();
+        bool didBeginBatch = spriteBatch->IsBatching() == false;
+        if(didBeginBatch == true)
+        {
+            spriteBatch->Begin();
+        }
+        
+        //The tiles one tile outside the view are prefetched
+        int prefetchFirstColumn = firstColumn > 0 ? firstColumn - 1 : 0;
+        int prefetchLastColumn = lastColumn < (int)m_Columns - 1 ? lastColumn + 1 : m_Columns - 1;
+        int prefetchFirstRow = firstRow > 0 ? firstRow - 1 : 0;
+        int prefetchLastRow = lastRow < (int)m_Rows - 1 ? lastRow + 1 : m_Rows - 1;
+        
+        //Cycle through the visible and prefetched tiles
+        TextureManager* textureManager = ServiceLocator::GetTextureManager();
+        unsigned int prefetchLoads = 0;
+        for(int row = prefetchFirstRow; row <= prefetchLastRow; row++)
+        {
+            for(int column = prefetchFirstColumn; column <= prefetchLastColumn; column++)
+            {
+                //Get the tile's filename
+                string filename = GetTileFilename(column, row);
+                
+                //Is the tile visible
+                if(column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow)
+                {
+                    //Visible tiles are always requested, they are decoded asynchronously and only the resident tiles are drawn
+                    m_VisibleTiles++;
+                    Texture* texture = textureManager->GetStreamedTextureAsync(filename, m_Directory, true, m_Filter, m_GenerateMipmaps);
+                    if(texture != nullptr)
+                    {
+                        //The tiles in the last row can be shorter than a full tile, so the rows are placed from the top of the image
+                        vec2 offset = vec2(column * m_TileSize.x, fmaxf(m_Size.y - (row + 1) * m_TileSize.y, 0.0f));
+                        SourceFrame sourceFrame(0.0f, 0.0f, (float)texture->GetSize().x, (float)texture->GetSize().y);
+                        
+                        //Add the tile to the SpriteBatch
+                        spriteBatch->AddQuad(m_Shader, texture, sourceFrame, m_Color, translate(m_ModelMatrix, vec3(offset.x, offset.y, 0.0f)));
+                        m_ResidentTiles++;
+                    }
+                }
+                else
+                {
+                    //Prefetch the tile, only a limited number of tiles are requested per frame so the decode queue isn't flooded
+                    bool canLoad = prefetchLoads < TILE_MAP_MAX_PREFETCH_LOADS_PER_FRAME;
+                    if(canLoad == true && textureManager->IsStreamedTextureResident(filename, m_Directory) == false && textureManager->IsStreamedTextureLoading(filename, m_Directory) == false)
+                    {
+                        prefetchLoads++;
+                    }
+                    textureManager->GetStreamedTextureAsync(filename, m_Directory, canLoad, m_Filter, m_GenerateMipmaps);
+                }
+            }
+        }
+        
+        //End the SpriteBatch, if it was begun by the TileMap
+        if(didBeginBatch == true)
+        {
+            spriteBatch->End();
+        }
+        
+        //Draw the GameObject, this will draw any children
+        GameObject::Draw();
+    }
+    
+    vec2 TileMap::GetSize()
+    {
+        return m_Size;
+    }
+    
+    float TileMap::GetWidth()
+    {
+        return GetSize().x;
+    }
+    
+    float TileMap::GetHeight()
+    {
+        return GetSize().y;
+    }
+    
+    vec2 TileMap::GetTileSize()
+    {
+        return m_TileSize;
+    }
+    
+    unsigned int TileMap::GetColumnCount()
+    {
+        return m_Columns;
+    }
+    
+    unsigned int TileMap::GetRowCount()
+    {
+        return m_Rows;
+    }
+    
+    bool TileMap::GetLocalBounds(BoundingBox& aBounds)
+    {
+        //The model matrix already factors in the anchor point, scale and angle
+        aBounds = MakeBoundingBox(vec2(0.0f, 0.0f), GetSize());
+        return true;
+    }
+    
+    void TileMap::SetAnchorPoint(float aAnchorX, float aAnchorY)
+    {
+        m_AnchorPoint.x = fminf(fmaxf(aAnchorX, 0.0f), 1.0f);
+        m_AnchorPoint.y = fminf(fmaxf(aAnchorY, 0.0f), 1.0f);
+        ModelMatrixIsDirty();
+    }
+    
+    void TileMap::SetAnchorPoint(vec2 aAnchorPoint)
+    {
+        SetAnchorPoint(aAnchorPoint.x, aAnchorPoint.y);
+    }
+    
+    vec2 TileMap::GetAnchorPoint()
+    {
+        return m_AnchorPoint;
+    }
+    
+    void TileMap::SetAlpha(float aAlpha)
+    {
+        m_Color.a = fminf(fmaxf(aAlpha, 0.0f), 1.0f);
+    }
+    
+    float TileMap::GetAlpha()
+    {
+        return m_Color.a;
+    }
+    
+    void TileMap::SetFilter(TextureFilter aFilter)
+    {
+        //Is the filter changing?
+        if(m_Filter == aFilter)
+        {
+            return;
+        }
+        
+        //Set the filter, the tiles that are streamed in later are loaded with it
+        m_Filter = aFilter;
+        
+        //Cycle through the tiles and apply the filter to the ones that are already resident
+        TextureManager* textureManager = ServiceLocator::GetTextureManager();
+        for(unsigned int row = 0; row < m_Rows; row++)
+        {
+            for(unsigned int column = 0; column < m_Columns; column++)
+            {
+                Texture* texture = textureManager->GetStreamedTexture(GetTileFilename(column, row), m_Directory, false);
+                if(texture != nullptr)
+                {
+                    texture->SetFilter(m_Filter);
+                }
+            }
+        }
+    }
+    
+    TextureFilter TileMap::GetFilter()
+    {
+        return m_Filter;
+    }
+    
+    bool TileMap::DoesGenerateMipmaps()
+    {
+        return m_GenerateMipmaps;
+    }
+    
+    unsigned int TileMap::GetVisibleTileCount()
+    {
+        return m_VisibleTiles;
+    }
+    
+    unsigned int TileMap::GetResidentTileCount()
+    {
+        return m_ResidentTiles;
+    }
+    
+    void TileMap::ResetModelMatrix()
+    {
+        //Translate the anchor, then translate the position
+        mat4 anchor = translate(mat4(1.0f), vec3(-GetWidth() * GetWorldScale().x * m_AnchorPoint.x, -GetHeight() * GetWorldScale().y * m_AnchorPoint.y, 0.0f));
+        mat4 viewTranslate = translate(anchor, vec3(GetWorldPosition().x, GetWorldPosition().y, 0.0f));
+        
+        //Calculate the rotation based on the anchor point
+        mat4 halfTranslate1 = translate(viewTranslate, vec3(GetWidth() * GetWorldScale().x * m_AnchorPoint.x, GetHeight() * GetWorldScale().y * m_AnchorPoint.y, 0.0f));
+        mat4 viewRotation = rotate(halfTranslate1, GetWorldAngle(), vec3(0.0f, 0.0f, 1.0f));
+        mat4 halfTranslate2 = translate(viewRotation, vec3(-GetWidth() * GetWorldScale().x * m_AnchorPoint.x, -GetHeight() * GetWorldScale().y * m_AnchorPoint.y, 0.0f));
+        
+        //Lastly the scale, the z scale is one so that the model matrix can be inverted to find the visible tiles
+        m_ModelMatrix = scale(halfTranslate2, vec3(GetWorldScale().x, GetWorldScale().y, 1.0f));
+        
+        //Call the GameObject's ResetModelMatrix() method
+        GameObject::ResetModelMatrix();
+    }
+    
+    bool TileMap::LoadDescriptor()
+    {
+        //Get the descriptor's path, it is empty if the descriptor doesn't exist
+        string path = ServiceLocator::GetTextureManager()->GetPathForImage(m_Filename + "-tiles", "json", m_Directory);
+        if(path.length() == 0)
+        {
+            return false;
+        }
+        
+        //Open the input stream
+        std::ifstream inputStream;
+        inputStream.open(path, std::ifstream::in);
+        
+        //Parse the json file
+        Json::Value root;
+        Json::Reader reader;
+        bool didLoad = reader.parse(inputStream, root, false);
+        
+        //Close the input stream
+        inputStream.close();
+        
+        //Safety check the json data
+        if(didLoad == false)
+        {
+            Error(false, "Failed to parse the tile descriptor for the tile map: %s", m_Filename.c_str());
+            return false;
+        }
+        
+        //Get the image and tile sizes
+        m_Size = vec2((float)root["width"].asDouble(), (float)root["height"].asDouble());
+        m_TileSize = vec2((float)root["tileWidth"].asDouble(), (float)root["tileHeight"].asDouble());
+        
+        //Safety check the sizes
+        if(m_Size.x <= 0.0f || m_Size.y <= 0.0f || m_TileSize.x <= 0.0f || m_TileSize.y <= 0.0f)
+        {
+            Error(false, "Failed to load the tile descriptor for the tile map: %s, the sizes are invalid", m_Filename.c_str());
+            m_Size = vec2(0.0f, 0.0f);
+            m_TileSize = vec2(0.0f, 0.0f);
+            return false;
+        }
+        
+        //Calculate the number of columns and rows, the last column and row can be smaller than a full tile
+        m_Columns = (unsigned int)ceilf(m_Size.x / m_TileSize.x);
+        m_Rows = (unsigned int)ceilf(m_Size.y / m_TileSize.y);
+        return true;
+    }
+    
+    string TileMap::GetTileFilename(unsigned int aColumn, unsigned int aRow)
+    {
+        //If the image isn't tiled, there is only one tile
+        if(m_IsTiled == false)
+        {
+            return m_Filename;
+        }
+        
+        //Build the tile's filename
+        stringstream ss;
+        ss << m_Filename << "-tile-" << aColumn << "-" << aRow;
+        return ss.str();
+    }
+}
\ No newline at end of file
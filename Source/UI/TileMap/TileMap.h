@@ -0,0 +1,104 @@
+//
+//  TileMap.h
+//  GameDev2D
+//
+
+#ifndef __GameDev2D__TileMap__
+#define __GameDev2D__TileMap__
+
+#include "../../Core/GameObject.h"
+#include "../../Graphics/Core/Color.h"
+#include "../../Graphics/Textures/Texture.h"
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class Shader;
+    
+    //The TileMap class inherits from the GameObject class and displays an image that is too large to be loaded
+    //as a single texture. The image is split into fixed size tiles by the AtlasPacker's -tiles option, a json descriptor named
+    //'<filename>-tiles.json' contains the image's width, height, tileWidth and tileHeight and each tile is an
+    //image named '<filename>-tile-<column>-<row>.png', row zero is the top of the image. The tiles are build output, they
+    //aren't kept with the Assets, the AtlasPacker is run when the assets are copied to the build directory. Only the tiles that
+    //overlap the active Camera's view are drawn, the tiles are streamed asynchronously through the TextureManager and a tile
+    //is only drawn once it is resident, and the tiles just outside the view are prefetched a few at a time. If the descriptor
+    //doesn't exist, the image is streamed as a single tile, it is loaded synchronously because its size is needed up front.
+    //The filter is applied, and the mipmaps are generated, when each tile is streamed in.
+    class TileMap : public GameObject
+    {
+    public:
+        TileMap(const string& filename, const string& directory = "Images", TextureFilter filter = TEXTURE_DEFAULT_FILTER, bool generateMipmaps = false);
+        ~TileMap();
+        
+        //Draws the visible tiles of the TileMap
+        void Draw();
+        
+        //Returns the size of the whole image
+        vec2 GetSize();
+        float GetWidth();
+        float GetHeight();
+        
+        //Returns the size of a tile and the number of tile columns and rows
+        vec2 GetTileSize();
+        unsigned int GetColumnCount();
+        unsigned int GetRowCount();
+        
+        //Sets the local bounds of the whole image, used to cull the TileMap
+        bool GetLocalBounds(BoundingBox& bounds);
+        
+        //Sets the anchor point for the TileMap
+        void SetAnchorPoint(float anchorX, float anchorY);
+        void SetAnchorPoint(vec2 anchorPoint);
+        
+        //Returns the anchor point of the TileMap
+        vec2 GetAnchorPoint();
+        
+        //Sets the alpha for the TileMap
+        void SetAlpha(float alpha);
+        
+        //Returns the alpha for the TileMap
+        float GetAlpha();
+        
+        //Sets the filter used to sample the tiles, it is applied to the resident tiles and to each tile when it is streamed in
+        void SetFilter(TextureFilter filter);
+        
+        //Returns the filter used to sample the tiles
+        TextureFilter GetFilter();
+        
+        //Returns wether mipmaps are generated for each tile when it is streamed in
+        bool DoesGenerateMipmaps();
+        
+        //Returns the number of tiles that were visible and the number of tiles that were resident, the last time the TileMap was drawn
+        unsigned int GetVisibleTileCount();
+        unsigned int GetResidentTileCount();
+    
+    protected:
+        //Used to Reset the Model Matrix
+        void ResetModelMatrix();
+        
+        //Conveniance method that loads the tile descriptor json file, returns false if it doesn't exist
+        bool LoadDescriptor();
+        
+        //Conveniance method that returns the filename of a tile
+        string GetTileFilename(unsigned int column, unsigned int row);
+        
+        //Member variables
+        string m_Filename;
+        string m_Directory;
+        Shader* m_Shader;
+        vec2 m_Size;
+        vec2 m_TileSize;
+        unsigned int m_Columns;
+        unsigned int m_Rows;
+        bool m_IsTiled;
+        vec2 m_AnchorPoint;
+        ColorRGBA m_Color;
+        TextureFilter m_Filter;
+        bool m_GenerateMipmaps;
+        unsigned int m_VisibleTiles;
+        unsigned int m_ResidentTiles;
+    };
+}
+
+#endif /* defined(__GameDev2D__TileMap__) */
@@ -13,5 +13,6 @@
 #include "Button/ButtonList.h"
 #include "Label/Label.h"
 #include "Sprite/Sprite.h"
+#include "TileMap/TileMap.h"
 
 #endif
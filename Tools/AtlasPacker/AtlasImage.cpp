@@ -0,0 +1,226 @@
+//
+//  AtlasImage.cpp
+//  AtlasPacker
+//
+
+#include "AtlasImage.h"
+#include "png.h"
+#include <cstdio>
+#include <cstring>
+
+
+namespace GameDev2D
+{
+    //AtlasImage constant
+    const unsigned int ATLAS_IMAGE_BYTES_PER_PIXEL = 4;
+    
+    AtlasImage::AtlasImage() :
+        m_Width(0),
+        m_Height(0)
+    {
+    
+    }
+    
+    AtlasImage::AtlasImage(unsigned int aWidth, unsigned int aHeight) :
+        m_Width(aWidth),
+        m_Height(aHeight),
+        m_Pixels(aWidth * aHeight * ATLAS_IMAGE_BYTES_PER_PIXEL, 0)
+    {
+    
+    }
+    
+    bool AtlasImage::LoadFromPath(const string& aPath)
+    {
+        //Open the image file
+        FILE* file = fopen(aPath.c_str(), "rb");
+        if(file == NULL)
+        {
+            return false;
+        }
+        
+        //Create the png read struct and the png info struct
+        png_structp pngPointer = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+        png_infop infoPointer = pngPointer != NULL ? png_create_info_struct(pngPointer) : NULL;
+        if(pngPointer == NULL || infoPointer == NULL)
+        {
+            png_destroy_read_struct(&pngPointer, NULL, NULL);
+            fclose(file);
+            return false;
+        }
+        
+        //If libpng hits an error it jumps back here
+        if(setjmp(png_jmpbuf(pngPointer)))
+        {
+            png_destroy_read_struct(&pngPointer, &infoPointer, NULL);
+            fclose(file);
+            return false;
+        }
+        
+        //Read the whole image, palette and grayscale images are expanded to RGB
+        png_init_io(pngPointer, file);
+        png_read_png(pngPointer, infoPointer, PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING | PNG_TRANSFORM_EXPAND | PNG_TRANSFORM_GRAY_TO_RGB, NULL);
+        
+        //Get the size of the image and wether it has an alpha channel
+        m_Width = png_get_image_width(pngPointer, infoPointer);
+        m_Height = png_get_image_height(pngPointer, infoPointer);
+        unsigned int channels = png_get_channels(pngPointer, infoPointer);
+        png_bytepp rowPointers = png_get_rows(pngPointer, infoPointer);
+        
+        //Copy the pixels, images without an alpha channel are opaque
+        m_Pixels.resize(m_Width * m_Height * ATLAS_IMAGE_BYTES_PER_PIXEL);
+        for(unsigned int y = 0; y < m_Height; y++)
+        {
+            for(unsigned int x = 0; x < m_Width; x++)
+            {
+                unsigned char* pixel = GetPixel(x, y);
+                png_bytep source = rowPointers[y] + x * channels;
+                pixel[0] = source[0];
+                pixel[1] = source[1];
+                pixel[2] = source[2];
+                pixel[3] = channels == ATLAS_IMAGE_BYTES_PER_PIXEL ? source[3] : 255;
+            }
+        }
+        
+        //Clean up
+        png_destroy_read_struct(&pngPointer, &infoPointer, NULL);
+        fclose(file);
+        return true;
+    }
+    
+    bool AtlasImage::SaveToPath(const string& aPath)
+    {
+        //Safety check the image
+        if(m_Width == 0 || m_Height == 0)
+        {
+            return false;
+        }
+        
+        //Open the image file
+        FILE* file = fopen(aPath.c_str(), "wb");
+        if(file == NULL)
+        {
+            return false;
+        }
+        
+        //Create the png write struct and the png info struct
+        png_structp pngPointer = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+        png_infop infoPointer = pngPointer != NULL ? png_create_info_struct(pngPointer) : NULL;
+        if(pngPointer == NULL || infoPointer == NULL)
+        {
+            png_destroy_write_struct(&pngPointer, NULL);
+            fclose(file);
+            return false;
+        }
+        
+        //If libpng hits an error it jumps back here
+        if(setjmp(png_jmpbuf(pngPointer)))
+        {
+            png_destroy_write_struct(&pngPointer, &infoPointer);
+            fclose(file);
+            return false;
+        }
+        
+        //Set the row pointers
+        vector<png_bytep> rowPointers(m_Height);
+        for(unsigned int y = 0; y < m_Height; y++)
+        {
+            rowPointers.at(y) = GetPixel(0, y);
+        }
+        
+        //Write the image as an 8-bit RGBA png
+        png_init_io(pngPointer, file);
+        png_set_IHDR(pngPointer, infoPointer, m_Width, m_Height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(pngPointer, infoPointer);
+        png_write_image(pngPointer, &rowPointers[0]);
+        png_write_end(pngPointer, NULL);
+        
+        //Clean up
+        png_destroy_write_struct(&pngPointer, &infoPointer);
+        fclose(file);
+        return true;
+    }
+    
+    void AtlasImage::Draw(const AtlasImage& aImage, unsigned int aX, unsigned int aY)
+    {
+        //Safety check the position
+        if(aX >= m_Width || aY >= m_Height)
+        {
+            return;
+        }
+        
+        //Copy the image one row at a time, clipped to the bounds of this image
+        for(unsigned int y = 0; y < aImage.GetHeight() && aY + y < m_Height; y++)
+        {
+            unsigned int width = aX + aImage.GetWidth() <= m_Width ? aImage.GetWidth() : m_Width - aX;
+            memcpy(GetPixel(aX, aY + y), aImage.GetPixel(0, y), width * ATLAS_IMAGE_BYTES_PER_PIXEL);
+        }
+    }
+    
+    AtlasImage AtlasImage::Crop(unsigned int aX, unsigned int aY, unsigned int aWidth, unsigned int aHeight) const
+    {
+        //Safety check the position
+        if(aX >= m_Width || aY >= m_Height)
+        {
+            return AtlasImage();
+        }
+        
+        //Clip the rectangle to the bounds of this image
+        unsigned int width = aX + aWidth <= m_Width ? aWidth : m_Width - aX;
+        unsigned int height = aY + aHeight <= m_Height ? aHeight : m_Height - aY;
+        
+        //Copy the rectangle one row at a time
+        AtlasImage image(width, height);
+        for(unsigned int y = 0; y < height; y++)
+        {
+            memcpy(image.GetPixel(0, y), GetPixel(aX, aY + y), width * ATLAS_IMAGE_BYTES_PER_PIXEL);
+        }
+        return image;
+    }
+    
+    void AtlasImage::Extrude(unsigned int aX, unsigned int aY, unsigned int aWidth, unsigned int aHeight, unsigned int aExtrude)
+    {
+        //Safety check the rectangle, it must be inside the image including the extruded pixels
+        if(aWidth == 0 || aHeight == 0 || aX < aExtrude || aY < aExtrude || aX + aWidth + aExtrude > m_Width || aY + aHeight + aExtrude > m_Height)
+        {
+            return;
+        }
+        
+        //Repeat the left and right edge pixels of each row
+        for(unsigned int y = aY; y < aY + aHeight; y++)
+        {
+            for(unsigned int i = 1; i <= aExtrude; i++)
+            {
+                memcpy(GetPixel(aX - i, y), GetPixel(aX, y), ATLAS_IMAGE_BYTES_PER_PIXEL);
+                memcpy(GetPixel(aX + aWidth - 1 + i, y), GetPixel(aX + aWidth - 1, y), ATLAS_IMAGE_BYTES_PER_PIXEL);
+            }
+        }
+        
+        //Repeat the top and bottom rows, including the extruded corners
+        unsigned int rowBytes = (aWidth + aExtrude * 2) * ATLAS_IMAGE_BYTES_PER_PIXEL;
+        for(unsigned int i = 1; i <= aExtrude; i++)
+        {
+            memcpy(GetPixel(aX - aExtrude, aY - i), GetPixel(aX - aExtrude, aY), rowBytes);
+            memcpy(GetPixel(aX - aExtrude, aY + aHeight - 1 + i), GetPixel(aX - aExtrude, aY + aHeight - 1), rowBytes);
+        }
+    }
+    
+    unsigned int AtlasImage::GetWidth() const
+    {
+        return m_Width;
+    }
+    
+    unsigned int AtlasImage::GetHeight() const
+    {
+        return m_Height;
+    }
+    
+    unsigned char* AtlasImage::GetPixel(unsigned int aX, unsigned int aY)
+    {
+        return &m_Pixels[(aY * m_Width + aX) * ATLAS_IMAGE_BYTES_PER_PIXEL];
+    }
+    
+    const unsigned char* AtlasImage::GetPixel(unsigned int aX, unsigned int aY) const
+    {
+        return &m_Pixels[(aY * m_Width + aX) * ATLAS_IMAGE_BYTES_PER_PIXEL];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+//
+//  AtlasImage.h
+//  AtlasPacker
+//
+
+#ifndef __AtlasPacker__AtlasImage__
+#define __AtlasPacker__AtlasImage__
+
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //The AtlasImage class holds 8-bit RGBA pixels, ordered top to bottom the same way as a png image.
+    //Any png image is converted to RGBA when it is loaded, the images are always saved as RGBA.
+    class AtlasImage
+    {
+    public:
+        //Creates an empty image, used to load an image
+        AtlasImage();
+        
+        //Creates a transparent image for a width and height
+        AtlasImage(unsigned int width, unsigned int height);
+        
+        //Loads a png image from a path, returns true if the loading was successful
+        bool LoadFromPath(const string& path);
+        
+        //Saves the image as a png image to a path, returns true if the saving was successful
+        bool SaveToPath(const string& path);
+        
+        //Copies an image into this image, the x and y are the top left corner
+        void Draw(const AtlasImage& image, unsigned int x, unsigned int y);
+        
+        //Copies a rectangle of this image into a new image, the x and y are the top left corner. The rectangle
+        //is clipped to the bounds of this image
+        AtlasImage Crop(unsigned int x, unsigned int y, unsigned int width, unsigned int height) const;
+        
+        //Repeats the edge pixels of a rectangle outwards by a number of pixels, so that texture filtering
+        //at the edge of an atlas frame doesn't sample the neighbouring frames
+        void Extrude(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned int extrude);
+        
+        //Returns the size of the image
+        unsigned int GetWidth() const;
+        unsigned int GetHeight() const;
+    
+    private:
+        //Conveniance methods to access a pixel
+        unsigned char* GetPixel(unsigned int x, unsigned int y);
+        const unsigned char* GetPixel(unsigned int x, unsigned int y) const;
+        
+        //Member variables
+        unsigned int m_Width;
+        unsigned int m_Height;
+        vector<unsigned char> m_Pixels;
+    };
+}
+
+#endif /* defined(__AtlasPacker__AtlasImage__) */
@@ -0,0 +1,369 @@
+//
+//  AtlasPacker.cpp
+//  AtlasPacker
+//
+
+#include "AtlasPacker.h"
+#include "json.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+namespace GameDev2D
+{
+    //Used to sort the images from largest to smallest before packing, the longest side first then the area
+    struct AtlasPackerSortEntry
+    {
+        unsigned int index;
+        unsigned int longSide;
+        unsigned int area;
+        
+        bool operator<(const AtlasPackerSortEntry& other) const
+        {
+            if(longSide != other.longSide)
+            {
+                return longSide > other.longSide;
+            }
+            if(area != other.area)
+            {
+                return area > other.area;
+            }
+            return index < other.index;
+        }
+    };
+    
+    AtlasPacker::AtlasPacker(const string& aAtlasName, const string& aInputDirectory, const string& aOutputDirectory) :
+        m_AtlasName(aAtlasName),
+        m_InputDirectory(aInputDirectory),
+        m_OutputDirectory(aOutputDirectory),
+        m_ManifestPath(""),
+        m_Padding(ATLAS_PACKER_DEFAULT_PADDING),
+        m_Extrude(ATLAS_PACKER_DEFAULT_EXTRUDE),
+        m_MaxSize(ATLAS_PACKER_DEFAULT_MAX_SIZE)
+    {
+    
+    }
+    
+    void AtlasPacker::AddImage(const string& aImageName)
+    {
+        //Was .png appended to the image name? If it was, remove it
+        string imageName = aImageName;
+        size_t found = imageName.find(".png");
+        if(found != std::string::npos)
+        {
+            imageName.erase(found, 4);
+        }
+        
+        m_ImageNames.push_back(imageName);
+    }
+    
+    void AtlasPacker::AddScale(unsigned int aScale)
+    {
+        if(aScale > 0 && find(m_Scales.begin(), m_Scales.end(), aScale) == m_Scales.end())
+        {
+            m_Scales.push_back(aScale);
+        }
+    }
+    
+    void AtlasPacker::SetPadding(unsigned int aPadding)
+    {
+        m_Padding = aPadding;
+    }
+    
+    void AtlasPacker::SetExtrude(unsigned int aExtrude)
+    {
+        m_Extrude = aExtrude;
+    }
+    
+    void AtlasPacker::SetMaxSize(unsigned int aMaxSize)
+    {
+        m_MaxSize = aMaxSize;
+    }
+    
+    void AtlasPacker::SetManifestPath(const string& aManifestPath)
+    {
+        m_ManifestPath = aManifestPath;
+    }
+    
+    bool AtlasPacker::Pack()
+    {
+        //Safety check the images
+        if(m_ImageNames.size() == 0)
+        {
+            cerr << "Failed to pack atlas: " << m_AtlasName << ", there aren't any images to pack" << endl;
+            return false;
+        }
+        
+        //If no scales were added, only the 1x scale is packed
+        if(m_Scales.size() == 0)
+        {
+            m_Scales.push_back(1);
+        }
+        
+        //Pack each scale
+        bool success = true;
+        for(unsigned int i = 0; i < m_Scales.size(); i++)
+        {
+            if(PackScale(m_Scales.at(i)) == false)
+            {
+                success = false;
+            }
+        }
+        
+        //Add the atlas to the manifest
+        if(success == true && m_ManifestPath.length() > 0)
+        {
+            success = AddToManifest();
+        }
+        
+        return success;
+    }
+    
+    bool AtlasPacker::PackScale(unsigned int aScale)
+    {
+        //Load the images for the scale, every image must exist at the scale, otherwise the
+        //TextureManager falls back to a mix of scales that don't match the atlas
+        string suffix = GetScaleSuffix(aScale);
+        vector<AtlasImage> images(m_ImageNames.size());
+        for(unsigned int i = 0; i < m_ImageNames.size(); i++)
+        {
+            string path = m_InputDirectory + "/" + m_ImageNames.at(i) + suffix + ".png";
+            if(images.at(i).LoadFromPath(path) == false)
+            {
+                cerr << "Failed to pack atlas: " << m_AtlasName << suffix << ", the image: " << path << " failed to load" << endl;
+                return false;
+            }
+        }
+        
+        //Pack the images
+        vector<PackedRect> packedRects;
+        unsigned int width = 0;
+        unsigned int height = 0;
+        if(PackImages(images, packedRects, width, height) == false)
+        {
+            cerr << "Failed to pack atlas: " << m_AtlasName << suffix << ", the images don't fit in " << m_MaxSize << "x" << m_MaxSize << endl;
+            return false;
+        }
+        
+        //Draw the images into the atlas and extrude their edges
+        AtlasImage atlas(width, height);
+        for(unsigned int i = 0; i < images.size(); i++)
+        {
+            const PackedRect& packedRect = packedRects.at(i);
+            atlas.Draw(images.at(i), packedRect.x, packedRect.y);
+            atlas.Extrude(packedRect.x, packedRect.y, packedRect.width, packedRect.height, m_Extrude);
+        }
+        
+        //Save the atlas image
+        string imageFile = m_AtlasName + suffix + ".png";
+        if(atlas.SaveToPath(m_OutputDirectory + "/" + imageFile) == false)
+        {
+            cerr << "Failed to save atlas image: " << m_OutputDirectory << "/" << imageFile << endl;
+            return false;
+        }
+        
+        //Save the atlas json
+        string jsonPath = m_OutputDirectory + "/" + m_AtlasName + suffix + ".json";
+        if(SaveJson(jsonPath, imageFile, aScale, images, packedRects, width, height) == false)
+        {
+            cerr << "Failed to save atlas json: " << jsonPath << endl;
+            return false;
+        }
+        
+        cout << "Packed " << images.size() << " images into " << imageFile << " (" << width << "x" << height << ")" << endl;
+        return true;
+    }
+    
+    bool AtlasPacker::PackImages(const vector<AtlasImage>& aImages, vector<PackedRect>& aPackedRects, unsigned int& aWidth, unsigned int& aHeight)
+    {
+        //Each image is surrounded by the extruded pixels, the padding is added to the right and bottom
+        unsigned int border = m_Extrude * 2 + m_Padding;
+        
+        //Sort the images from largest to smallest, and calculate the total area and the largest side
+        vector<AtlasPackerSortEntry> sortedImages;
+        unsigned long long totalArea = 0;
+        unsigned int largestWidth = 0;
+        unsigned int largestHeight = 0;
+        for(unsigned int i = 0; i < aImages.size(); i++)
+        {
+            unsigned int width = aImages.at(i).GetWidth() + border;
+            unsigned int height = aImages.at(i).GetHeight() + border;
+            AtlasPackerSortEntry entry = { i, width > height ? width : height, width * height };
+            sortedImages.push_back(entry);
+            totalArea += entry.area;
+            largestWidth = width > largestWidth ? width : largestWidth;
+            largestHeight = height > largestHeight ? height : largestHeight;
+        }
+        sort(sortedImages.begin(), sortedImages.end());
+        
+        //Start with the smallest power of two that could fit the images
+        aWidth = 1;
+        aHeight = 1;
+        while(aWidth + m_Padding < largestWidth)
+        {
+            aWidth <<= 1;
+        }
+        while(aHeight + m_Padding < largestHeight)
+        {
+            aHeight <<= 1;
+        }
+        while((unsigned long long)(aWidth + m_Padding) * (aHeight + m_Padding) < totalArea)
+        {
+            if(aWidth <= aHeight)
+            {
+                aWidth <<= 1;
+            }
+            else
+            {
+                aHeight <<= 1;
+            }
+        }
+        
+        //Try to pack the images, if they don't fit, grow the smaller side and try again
+        while(aWidth <= m_MaxSize && aHeight <= m_MaxSize)
+        {
+            //The padding of the images along the right and bottom edges can hang off the atlas
+            MaxRectsBinPack binPack(aWidth + m_Padding, aHeight + m_Padding);
+            aPackedRects.assign(aImages.size(), PackedRect());
+            
+            bool didPack = true;
+            for(unsigned int i = 0; i < sortedImages.size() && didPack == true; i++)
+            {
+                unsigned int index = sortedImages.at(i).index;
+                PackedRect packedRect;
+                didPack = binPack.Insert(aImages.at(index).GetWidth() + border, aImages.at(index).GetHeight() + border, packedRect);
+                
+                //The image is inside the extruded pixels
+                packedRect.x += m_Extrude;
+                packedRect.y += m_Extrude;
+                packedRect.width = aImages.at(index).GetWidth();
+                packedRect.height = aImages.at(index).GetHeight();
+                aPackedRects.at(index) = packedRect;
+            }
+            
+            //Did all the images fit?
+            if(didPack == true)
+            {
+                return true;
+            }
+            
+            //Grow the smaller side
+            if(aWidth <= aHeight)
+            {
+                aWidth <<= 1;
+            }
+            else
+            {
+                aHeight <<= 1;
+            }
+        }
+        
+        return false;
+    }
+    
+    bool AtlasPacker::SaveJson(const string& aPath, const string& aImageFile, unsigned int aScale, const vector<AtlasImage>& aImages, const vector<PackedRect>& aPackedRects, unsigned int aWidth, unsigned int aHeight)
+    {
+        //Add a frame for each image
+        Json::Value root;
+        Json::Value frames(Json::arrayValue);
+        for(unsigned int i = 0; i < aImages.size(); i++)
+        {
+            const PackedRect& packedRect = aPackedRects.at(i);
+            
+            Json::Value frame;
+            frame["filename"] = m_ImageNames.at(i);
+            frame["frame"]["x"] = packedRect.x;
+            frame["frame"]["y"] = packedRect.y;
+            frame["frame"]["w"] = packedRect.width;
+            frame["frame"]["h"] = packedRect.height;
+            frame["rotated"] = false;
+            frame["trimmed"] = false;
+            frame["spriteSourceSize"]["x"] = 0;
+            frame["spriteSourceSize"]["y"] = 0;
+            frame["spriteSourceSize"]["w"] = packedRect.width;
+            frame["spriteSourceSize"]["h"] = packedRect.height;
+            frame["sourceSize"]["w"] = packedRect.width;
+            frame["sourceSize"]["h"] = packedRect.height;
+            frames.append(frame);
+        }
+        root["frames"] = frames;
+        
+        //Add the meta data
+        stringstream scale;
+        scale << aScale;
+        root["meta"]["app"] = "AtlasPacker";
+        root["meta"]["image"] = aImageFile;
+        root["meta"]["format"] = "RGBA8888";
+        root["meta"]["size"]["w"] = aWidth;
+        root["meta"]["size"]["h"] = aHeight;
+        root["meta"]["scale"] = scale.str();
+        
+        //Write the json file
+        ofstream outputStream(aPath.c_str());
+        if(outputStream.is_open() == false)
+        {
+            return false;
+        }
+        Json::StyledWriter writer;
+        outputStream << writer.write(root);
+        outputStream.close();
+        return true;
+    }
+    
+    bool AtlasPacker::AddToManifest()
+    {
+        //Read the existing manifest, if there is one
+        Json::Value root;
+        ifstream inputStream(m_ManifestPath.c_str());
+        if(inputStream.is_open() == true)
+        {
+            Json::Reader reader;
+            if(reader.parse(inputStream, root, false) == false)
+            {
+                cerr << "Failed to parse the atlas manifest: " << m_ManifestPath << endl;
+                return false;
+            }
+            inputStream.close();
+        }
+        
+        //Is the atlas already in the manifest?
+        Json::Value atlases = root["atlases"];
+        for(unsigned int i = 0; i < atlases.size(); i++)
+        {
+            if(atlases[i].asString() == m_AtlasName)
+            {
+                return true;
+            }
+        }
+        
+        //Add the atlas to the manifest
+        atlases.append(m_AtlasName);
+        root["atlases"] = atlases;
+        
+        //Write the manifest
+        ofstream outputStream(m_ManifestPath.c_str());
+        if(outputStream.is_open() == false)
+        {
+            cerr << "Failed to save the atlas manifest: " << m_ManifestPath << endl;
+            return false;
+        }
+        Json::StyledWriter writer;
+        outputStream << writer.write(root);
+        outputStream.close();
+        return true;
+    }
+    
+    string AtlasPacker::GetScaleSuffix(unsigned int aScale)
+    {
+        if(aScale <= 1)
+        {
+            return "";
+        }
+        
+        stringstream ss;
+        ss << "@" << aScale << "x";
+        return ss.str();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+//
+//  AtlasPacker.h
+//  AtlasPacker
+//
+
+#ifndef __AtlasPacker__AtlasPacker__
+#define __AtlasPacker__AtlasPacker__
+
+#include "AtlasImage.h"
+#include "MaxRectsBinPack.h"
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //AtlasPacker default settings
+    const unsigned int ATLAS_PACKER_DEFAULT_PADDING = 2;
+    const unsigned int ATLAS_PACKER_DEFAULT_EXTRUDE = 1;
+    const unsigned int ATLAS_PACKER_DEFAULT_MAX_SIZE = 2048;
+    
+    //The AtlasPacker class packs a set of png images into a texture atlas, for each scale (1x, @2x, @3x) it
+    //writes '<atlas>[@Nx].png' and '<atlas>[@Nx].json'. The json file uses the same format as the TexturePacker
+    //'JSON (Array)' format that the TextureManager's LoadAtlasFrame() method parses, the frame's filename is
+    //the image's name without the scale suffix or extension, the frame's position is from the top left corner.
+    //Optionally the atlas is added to a json manifest, which the TextureManager uses to resolve a Sprite's image
+    //to a frame in an atlas.
+    class AtlasPacker
+    {
+    public:
+        AtlasPacker(const string& atlasName, const string& inputDirectory, const string& outputDirectory);
+        
+        //Adds an image to pack, the name doesn't include the scale suffix or the png extension
+        void AddImage(const string& imageName);
+        
+        //Adds a scale to pack, a scale of 1 has no suffix, otherwise the '@Nx' suffix is used
+        void AddScale(unsigned int scale);
+        
+        //Sets the number of transparent pixels between the images in the atlas
+        void SetPadding(unsigned int padding);
+        
+        //Sets the number of times the edge pixels of each image are repeated outwards
+        void SetExtrude(unsigned int extrude);
+        
+        //Sets the maximum width and height of the atlas, the atlas is always a power of two
+        void SetMaxSize(unsigned int maxSize);
+        
+        //Sets the path of the manifest json file to add the atlas to
+        void SetManifestPath(const string& manifestPath);
+        
+        //Packs the atlas for every scale, returns false if any of the scales failed to pack
+        bool Pack();
+    
+    private:
+        //Packs and saves the atlas for a single scale, returns false if it failed
+        bool PackScale(unsigned int scale);
+        
+        //Packs the images into the smallest power of two atlas that fits them, returns false if they don't fit in the maximum size
+        bool PackImages(const vector<AtlasImage>& images, vector<PackedRect>& packedRects, unsigned int& width, unsigned int& height);
+        
+        //Writes the atlas json file for a scale
+        bool SaveJson(const string& path, const string& imageFile, unsigned int scale, const vector<AtlasImage>& images, const vector<PackedRect>& packedRects, unsigned int width, unsigned int height);
+        
+        //Adds the atlas to the manifest json file
+        bool AddToManifest();
+        
+        //Returns the suffix for a scale, empty for a scale of 1
+        static string GetScaleSuffix(unsigned int scale);
+        
+        //Member variables
+        string m_AtlasName;
+        string m_InputDirectory;
+        string m_OutputDirectory;
+        string m_ManifestPath;
+        vector<string> m_ImageNames;
+        vector<unsigned int> m_Scales;
+        unsigned int m_Padding;
+        unsigned int m_Extrude;
+        unsigned int m_MaxSize;
+    };
+}
+
+#endif /* defined(__AtlasPacker__AtlasPacker__) */
@@ -0,0 +1,172 @@
+//
+//  MaxRectsBinPack.cpp
+//  AtlasPacker
+//
+
+#include "MaxRectsBinPack.h"
+#include <climits>
+#include <cstdlib>
+
+
+namespace GameDev2D
+{
+    MaxRectsBinPack::MaxRectsBinPack(int aWidth, int aHeight) :
+        m_Width(aWidth),
+        m_Height(aHeight)
+    {
+        //The whole bin is free
+        PackedRect freeRect = { 0, 0, aWidth, aHeight };
+        m_FreeRects.push_back(freeRect);
+    }
+    
+    bool MaxRectsBinPack::Insert(int aWidth, int aHeight, PackedRect& aPackedRect)
+    {
+        //Find the best position for the rectangle
+        if(FindPosition(aWidth, aHeight, aPackedRect) == false)
+        {
+            return false;
+        }
+        
+        //Split every free rectangle that overlaps the placed rectangle, the split rectangles are added to the end
+        size_t freeRectCount = m_FreeRects.size();
+        for(size_t i = 0; i < freeRectCount; i++)
+        {
+            if(SplitFreeRect(m_FreeRects.at(i), aPackedRect) == true)
+            {
+                m_FreeRects.erase(m_FreeRects.begin() + i);
+                i--;
+                freeRectCount--;
+            }
+        }
+        
+        //Remove the redundant free rectangles
+        PruneFreeRects();
+        
+        //Add the used rectangle
+        m_UsedRects.push_back(aPackedRect);
+        return true;
+    }
+    
+    float MaxRectsBinPack::GetOccupancy()
+    {
+        //Add up the area of the used rectangles
+        unsigned long long usedArea = 0;
+        for(unsigned int i = 0; i < m_UsedRects.size(); i++)
+        {
+            usedArea += (unsigned long long)m_UsedRects.at(i).width * m_UsedRects.at(i).height;
+        }
+        return (float)usedArea / (float)((unsigned long long)m_Width * m_Height);
+    }
+    
+    bool MaxRectsBinPack::FindPosition(int aWidth, int aHeight, PackedRect& aPackedRect)
+    {
+        int bestShortSide = INT_MAX;
+        int bestLongSide = INT_MAX;
+        bool didFind = false;
+        
+        //Cycle through the free rectangles and find the one that leaves the shortest side left over
+        for(unsigned int i = 0; i < m_FreeRects.size(); i++)
+        {
+            const PackedRect& freeRect = m_FreeRects.at(i);
+            if(aWidth <= freeRect.width && aHeight <= freeRect.height)
+            {
+                int leftoverHorizontal = abs(freeRect.width - aWidth);
+                int leftoverVertical = abs(freeRect.height - aHeight);
+                int shortSide = leftoverHorizontal < leftoverVertical ? leftoverHorizontal : leftoverVertical;
+                int longSide = leftoverHorizontal > leftoverVertical ? leftoverHorizontal : leftoverVertical;
+                
+                //Ties on the short side are broken by the long side
+                if(shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+                {
+                    aPackedRect.x = freeRect.x;
+                    aPackedRect.y = freeRect.y;
+                    aPackedRect.width = aWidth;
+                    aPackedRect.height = aHeight;
+                    bestShortSide = shortSide;
+                    bestLongSide = longSide;
+                    didFind = true;
+                }
+            }
+        }
+        
+        return didFind;
+    }
+    
+    bool MaxRectsBinPack::SplitFreeRect(PackedRect aFreeRect, const PackedRect& aUsedRect)
+    {
+        //Do the rectangles overlap?
+        if(aUsedRect.x >= aFreeRect.x + aFreeRect.width || aUsedRect.x + aUsedRect.width <= aFreeRect.x ||
+           aUsedRect.y >= aFreeRect.y + aFreeRect.height || aUsedRect.y + aUsedRect.height <= aFreeRect.y)
+        {
+            return false;
+        }
+        
+        //Add the free rectangles above and below the used rectangle
+        if(aUsedRect.x < aFreeRect.x + aFreeRect.width && aUsedRect.x + aUsedRect.width > aFreeRect.x)
+        {
+            if(aUsedRect.y > aFreeRect.y && aUsedRect.y < aFreeRect.y + aFreeRect.height)
+            {
+                PackedRect freeRect = aFreeRect;
+                freeRect.height = aUsedRect.y - freeRect.y;
+                m_FreeRects.push_back(freeRect);
+            }
+            
+            if(aUsedRect.y + aUsedRect.height < aFreeRect.y + aFreeRect.height)
+            {
+                PackedRect freeRect = aFreeRect;
+                freeRect.y = aUsedRect.y + aUsedRect.height;
+                freeRect.height = aFreeRect.y + aFreeRect.height - (aUsedRect.y + aUsedRect.height);
+                m_FreeRects.push_back(freeRect);
+            }
+        }
+        
+        //Add the free rectangles to the left and right of the used rectangle
+        if(aUsedRect.y < aFreeRect.y + aFreeRect.height && aUsedRect.y + aUsedRect.height > aFreeRect.y)
+        {
+            if(aUsedRect.x > aFreeRect.x && aUsedRect.x < aFreeRect.x + aFreeRect.width)
+            {
+                PackedRect freeRect = aFreeRect;
+                freeRect.width = aUsedRect.x - freeRect.x;
+                m_FreeRects.push_back(freeRect);
+            }
+            
+            if(aUsedRect.x + aUsedRect.width < aFreeRect.x + aFreeRect.width)
+            {
+                PackedRect freeRect = aFreeRect;
+                freeRect.x = aUsedRect.x + aUsedRect.width;
+                freeRect.width = aFreeRect.x + aFreeRect.width - (aUsedRect.x + aUsedRect.width);
+                m_FreeRects.push_back(freeRect);
+            }
+        }
+        
+        return true;
+    }
+    
+    void MaxRectsBinPack::PruneFreeRects()
+    {
+        //Remove any free rectangle that is contained by another free rectangle
+        for(size_t i = 0; i < m_FreeRects.size(); i++)
+        {
+            for(size_t j = i + 1; j < m_FreeRects.size(); j++)
+            {
+                if(IsContainedIn(m_FreeRects.at(i), m_FreeRects.at(j)) == true)
+                {
+                    m_FreeRects.erase(m_FreeRects.begin() + i);
+                    i--;
+                    break;
+                }
+                
+                if(IsContainedIn(m_FreeRects.at(j), m_FreeRects.at(i)) == true)
+                {
+                    m_FreeRects.erase(m_FreeRects.begin() + j);
+                    j--;
+                }
+            }
+        }
+    }
+    
+    bool MaxRectsBinPack::IsContainedIn(const PackedRect& a, const PackedRect& b)
+    {
+        return a.x >= b.x && a.y >= b.y && a.x + a.width <= b.x + b.width && a.y + a.height <= b.y + b.height;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+//
+//  MaxRectsBinPack.h
+//  AtlasPacker
+//
+
+#ifndef __AtlasPacker__MaxRectsBinPack__
+#define __AtlasPacker__MaxRectsBinPack__
+
+#include <vector>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //A rectangle inside the bin, the origin is the top left corner
+    struct PackedRect
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+    
+    //The MaxRectsBinPack class packs rectangles into a fixed size bin using the MaxRects algorithm. It keeps
+    //track of the maximal free rectangles of the bin, each rectangle is placed in the free rectangle that
+    //leaves the shortest side left over (Best Short Side Fit), then every free rectangle that overlaps the
+    //placed rectangle is split and the free rectangles that are contained by another one are pruned.
+    //Rectangles are never rotated, the TextureManager doesn't support rotated atlas frames.
+    class MaxRectsBinPack
+    {
+    public:
+        MaxRectsBinPack(int width, int height);
+        
+        //Inserts a rectangle into the bin, returns false if it doesn't fit
+        bool Insert(int width, int height, PackedRect& packedRect);
+        
+        //Returns the ratio of the bin's area that is used, from zero to one
+        float GetOccupancy();
+    
+    private:
+        //Finds the free rectangle that leaves the shortest side left over, returns false if the rectangle doesn't fit
+        bool FindPosition(int width, int height, PackedRect& packedRect);
+        
+        //Splits a free rectangle around a used rectangle, returns false if they don't overlap
+        bool SplitFreeRect(PackedRect freeRect, const PackedRect& usedRect);
+        
+        //Removes the free rectangles that are contained by another free rectangle
+        void PruneFreeRects();
+        
+        //Returns wether rectangle a is contained by rectangle b
+        static bool IsContainedIn(const PackedRect& a, const PackedRect& b);
+        
+        //Member variables
+        int m_Width;
+        int m_Height;
+        vector<PackedRect> m_FreeRects;
+        vector<PackedRect> m_UsedRects;
+    };
+}
+
+#endif /* defined(__AtlasPacker__MaxRectsBinPack__) */
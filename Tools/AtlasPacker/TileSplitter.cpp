@@ -0,0 +1,162 @@
+//
+//  TileSplitter.cpp
+//  AtlasPacker
+//
+
+#include "TileSplitter.h"
+#include "json.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+namespace GameDev2D
+{
+    TileSplitter::TileSplitter(const string& aInputDirectory, const string& aOutputDirectory) :
+        m_InputDirectory(aInputDirectory),
+        m_OutputDirectory(aOutputDirectory),
+        m_TileSize(TILE_SPLITTER_DEFAULT_TILE_SIZE)
+    {
+    
+    }
+    
+    void TileSplitter::AddImage(const string& aImageName)
+    {
+        //Was .png appended to the image name? If it was, remove it
+        string imageName = aImageName;
+        size_t found = imageName.find(".png");
+        if(found != std::string::npos)
+        {
+            imageName.erase(found, 4);
+        }
+        
+        m_ImageNames.push_back(imageName);
+    }
+    
+    void TileSplitter::AddScale(unsigned int aScale)
+    {
+        if(aScale > 0 && find(m_Scales.begin(), m_Scales.end(), aScale) == m_Scales.end())
+        {
+            m_Scales.push_back(aScale);
+        }
+    }
+    
+    void TileSplitter::SetTileSize(unsigned int aTileSize)
+    {
+        m_TileSize = aTileSize;
+    }
+    
+    bool TileSplitter::Split()
+    {
+        //Safety check the images and the tile size
+        if(m_ImageNames.size() == 0)
+        {
+            cerr << "Failed to split tiles, there aren't any images to split" << endl;
+            return false;
+        }
+        if(m_TileSize == 0)
+        {
+            cerr << "Failed to split tiles, the tile size is zero" << endl;
+            return false;
+        }
+        
+        //If no scales were added, only the 1x scale is split
+        if(m_Scales.size() == 0)
+        {
+            m_Scales.push_back(1);
+        }
+        
+        //Split each image at each scale
+        bool success = true;
+        for(unsigned int i = 0; i < m_ImageNames.size(); i++)
+        {
+            for(unsigned int j = 0; j < m_Scales.size(); j++)
+            {
+                if(SplitImage(m_ImageNames.at(i), m_Scales.at(j)) == false)
+                {
+                    success = false;
+                }
+            }
+        }
+        
+        return success;
+    }
+    
+    bool TileSplitter::SplitImage(const string& aImageName, unsigned int aScale)
+    {
+        //Load the image for the scale
+        string suffix = GetScaleSuffix(aScale);
+        string path = m_InputDirectory + "/" + aImageName + suffix + ".png";
+        AtlasImage image;
+        if(image.LoadFromPath(path) == false)
+        {
+            cerr << "Failed to split tiles, the image: " << path << " failed to load" << endl;
+            return false;
+        }
+        
+        //Calculate the number of columns and rows, the last column and row can be smaller than a full tile
+        unsigned int columns = (image.GetWidth() + m_TileSize - 1) / m_TileSize;
+        unsigned int rows = (image.GetHeight() + m_TileSize - 1) / m_TileSize;
+        
+        //Save each tile, row 0 is the top of the image
+        for(unsigned int row = 0; row < rows; row++)
+        {
+            for(unsigned int column = 0; column < columns; column++)
+            {
+                stringstream tileFile;
+                tileFile << aImageName << "-tile-" << column << "-" << row << suffix << ".png";
+                AtlasImage tile = image.Crop(column * m_TileSize, row * m_TileSize, m_TileSize, m_TileSize);
+                if(tile.SaveToPath(m_OutputDirectory + "/" + tileFile.str()) == false)
+                {
+                    cerr << "Failed to save tile: " << m_OutputDirectory << "/" << tileFile.str() << endl;
+                    return false;
+                }
+            }
+        }
+        
+        //Save the tile descriptor
+        string jsonPath = m_OutputDirectory + "/" + aImageName + "-tiles" + suffix + ".json";
+        if(SaveJson(jsonPath, image.GetWidth(), image.GetHeight()) == false)
+        {
+            cerr << "Failed to save tile descriptor: " << jsonPath << endl;
+            return false;
+        }
+        
+        cout << "Split " << aImageName << suffix << ".png (" << image.GetWidth() << "x" << image.GetHeight() << ") into " << columns << "x" << rows << " tiles" << endl;
+        return true;
+    }
+    
+    bool TileSplitter::SaveJson(const string& aPath, unsigned int aWidth, unsigned int aHeight)
+    {
+        //The image and tile sizes, the TileMap calculates the columns and rows from them
+        Json::Value root;
+        root["width"] = aWidth;
+        root["height"] = aHeight;
+        root["tileWidth"] = m_TileSize;
+        root["tileHeight"] = m_TileSize;
+        
+        //Write the json file
+        ofstream outputStream(aPath.c_str());
+        if(outputStream.is_open() == false)
+        {
+            return false;
+        }
+        Json::StyledWriter writer;
+        outputStream << writer.write(root);
+        outputStream.close();
+        return true;
+    }
+    
+    string TileSplitter::GetScaleSuffix(unsigned int aScale)
+    {
+        if(aScale <= 1)
+        {
+            return "";
+        }
+        
+        stringstream ss;
+        ss << "@" << aScale << "x";
+        return ss.str();
+    }
+}
\ No newline at end of file
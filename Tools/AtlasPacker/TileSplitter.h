@@ -0,0 +1,61 @@
+//
+//  TileSplitter.h
+//  AtlasPacker
+//
+
+#ifndef __AtlasPacker__TileSplitter__
+#define __AtlasPacker__TileSplitter__
+
+#include "AtlasImage.h"
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //TileSplitter default settings
+    const unsigned int TILE_SPLITTER_DEFAULT_TILE_SIZE = 1024;
+    
+    //The TileSplitter class splits large png images into tiles that a TileMap streams in, so that a single texture never has
+    //to fit the whole image within the streaming budget. For each image and scale (1x, @2x, @3x) it writes the tiles as
+    //'<image>-tile-<column>-<row>[@Nx].png', row 0 is the top row, and the '<image>-tiles[@Nx].json' descriptor with the
+    //image's width and height and the tile width and height in pixels. The last column and row can be smaller than a tile.
+    class TileSplitter
+    {
+    public:
+        TileSplitter(const string& inputDirectory, const string& outputDirectory);
+        
+        //Adds an image to split, the name doesn't include the scale suffix or the png extension
+        void AddImage(const string& imageName);
+        
+        //Adds a scale to split, a scale of 1 has no suffix, otherwise the '@Nx' suffix is used
+        void AddScale(unsigned int scale);
+        
+        //Sets the width and height of the tiles, in pixels at every scale
+        void SetTileSize(unsigned int tileSize);
+        
+        //Splits every image at every scale, returns false if any of them failed to split
+        bool Split();
+    
+    private:
+        //Splits and saves the tiles and the descriptor of a single image at a single scale, returns false if it failed
+        bool SplitImage(const string& imageName, unsigned int scale);
+        
+        //Writes the tile descriptor json file
+        bool SaveJson(const string& path, unsigned int width, unsigned int height);
+        
+        //Returns the suffix for a scale, empty for a scale of 1
+        static string GetScaleSuffix(unsigned int scale);
+        
+        //Member variables
+        string m_InputDirectory;
+        string m_OutputDirectory;
+        vector<string> m_ImageNames;
+        vector<unsigned int> m_Scales;
+        unsigned int m_TileSize;
+    };
+}
+
+#endif /* defined(__AtlasPacker__TileSplitter__) */
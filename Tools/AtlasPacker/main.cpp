@@ -0,0 +1,156 @@
+//
+//  main.cpp
+//  AtlasPacker
+//
+
+#include "AtlasPacker.h"
+#include "TileSplitter.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+
+using namespace GameDev2D;
+
+//Prints how to use the AtlasPacker
+void PrintUsage()
+{
+    cout << "Usage: AtlasPacker [options] <atlas name> <image directory> <image> [<image> ...]" << endl;
+    cout << "       AtlasPacker -tiles <pixels> [options] <image directory> <image> [<image> ...]" << endl;
+    cout << "Packs png images into a texture atlas that the TextureManager can load, the images are" << endl;
+    cout << "named without the scale suffix or the png extension, for example: CharHead Sword" << endl;
+    cout << "With the -tiles option each image is split into tiles that a TileMap streams in instead" << endl;
+    cout << "Options:" << endl;
+    cout << "  -output <directory>   The directory the atlas is saved in, the image directory by default" << endl;
+    cout << "  -padding <pixels>     The transparent pixels between the images, " << ATLAS_PACKER_DEFAULT_PADDING << " by default" << endl;
+    cout << "  -extrude <pixels>     The edge pixels repeated around the images, " << ATLAS_PACKER_DEFAULT_EXTRUDE << " by default" << endl;
+    cout << "  -maxsize <pixels>     The maximum width and height of the atlas, " << ATLAS_PACKER_DEFAULT_MAX_SIZE << " by default" << endl;
+    cout << "  -scales <list>        The comma separated scales to pack, 1,2,3 by default" << endl;
+    cout << "  -manifest <file>      The json manifest to add the atlas to, so Sprites resolve to the atlas" << endl;
+    cout << "  -tiles <pixels>       Splits the images into tiles of this width and height, " << TILE_SPLITTER_DEFAULT_TILE_SIZE << " is recommended" << endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    //Parse the options
+    string outputDirectory = "";
+    string manifestPath = "";
+    string scales = "1,2,3";
+    unsigned int padding = ATLAS_PACKER_DEFAULT_PADDING;
+    unsigned int extrude = ATLAS_PACKER_DEFAULT_EXTRUDE;
+    unsigned int maxSize = ATLAS_PACKER_DEFAULT_MAX_SIZE;
+    unsigned int tileSize = 0;
+    int index = 1;
+    while(index < argc && argv[index][0] == '-')
+    {
+        //Every option has a value
+        string option = argv[index];
+        if(index + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+        string value = argv[index + 1];
+        index += 2;
+        
+        if(option == "-output")
+        {
+            outputDirectory = value;
+        }
+        else if(option == "-padding")
+        {
+            padding = (unsigned int)atoi(value.c_str());
+        }
+        else if(option == "-extrude")
+        {
+            extrude = (unsigned int)atoi(value.c_str());
+        }
+        else if(option == "-maxsize")
+        {
+            maxSize = (unsigned int)atoi(value.c_str());
+        }
+        else if(option == "-scales")
+        {
+            scales = value;
+        }
+        else if(option == "-manifest")
+        {
+            manifestPath = value;
+        }
+        else if(option == "-tiles")
+        {
+            tileSize = (unsigned int)atoi(value.c_str());
+        }
+        else
+        {
+            cerr << "Unknown option: " << option << endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+    
+    //Split the images into tiles, there must be an image directory and at least one image
+    if(tileSize > 0)
+    {
+        if(argc - index < 2)
+        {
+            PrintUsage();
+            return 1;
+        }
+        
+        //Create the tile splitter
+        string imageDirectory = argv[index];
+        TileSplitter tileSplitter(imageDirectory, outputDirectory.length() > 0 ? outputDirectory : imageDirectory);
+        tileSplitter.SetTileSize(tileSize);
+        
+        //Add the scales
+        stringstream scaleStream(scales);
+        string scale;
+        while(getline(scaleStream, scale, ','))
+        {
+            tileSplitter.AddScale((unsigned int)atoi(scale.c_str()));
+        }
+        
+        //Add the images
+        for(int i = index + 1; i < argc; i++)
+        {
+            tileSplitter.AddImage(argv[i]);
+        }
+        
+        //Split the images
+        return tileSplitter.Split() == true ? 0 : 1;
+    }
+    
+    //There must be an atlas name, an image directory and at least one image
+    if(argc - index < 3)
+    {
+        PrintUsage();
+        return 1;
+    }
+    
+    //Create the atlas packer
+    string atlasName = argv[index];
+    string imageDirectory = argv[index + 1];
+    AtlasPacker atlasPacker(atlasName, imageDirectory, outputDirectory.length() > 0 ? outputDirectory : imageDirectory);
+    atlasPacker.SetPadding(padding);
+    atlasPacker.SetExtrude(extrude);
+    atlasPacker.SetMaxSize(maxSize);
+    atlasPacker.SetManifestPath(manifestPath);
+    
+    //Add the scales
+    stringstream scaleStream(scales);
+    string scale;
+    while(getline(scaleStream, scale, ','))
+    {
+        atlasPacker.AddScale((unsigned int)atoi(scale.c_str()));
+    }
+    
+    //Add the images
+    for(int i = index + 2; i < argc; i++)
+    {
+        atlasPacker.AddImage(argv[i]);
+    }
+    
+    //Pack the atlas
+    return atlasPacker.Pack() == true ? 0 : 1;
+}
\ No newline at end of file
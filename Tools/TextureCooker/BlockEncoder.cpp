@@ -0,0 +1,550 @@
+//
+//  BlockEncoder.cpp
+//  TextureCooker
+//
+
+#include "BlockEncoder.h"
+#include "TextureContainer.h"
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+
+namespace GameDev2D
+{
+    //The ETC1 intensity modifiers, the same as the TextureCompression decoder's
+    const int BLOCK_ENCODER_ETC_MODIFIERS[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+    
+    //The EAC alpha modifiers, the same as the TextureCompression decoder's
+    const int BLOCK_ENCODER_EAC_MODIFIERS[16][8] =
+    {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+    
+    //Clamps a value to the 0 to 255 range
+    inline int BlockEncoderClamp(int aValue)
+    {
+        return aValue < 0 ? 0 : (aValue > 255 ? 255 : aValue);
+    }
+    
+    //Returns the squared distance between two colors
+    inline int BlockEncoderDistance(const int aColor[3], const unsigned char aTexel[4])
+    {
+        int red = aColor[0] - aTexel[0];
+        int green = aColor[1] - aTexel[1];
+        int blue = aColor[2] - aTexel[2];
+        return red * red + green * green + blue * blue;
+    }
+    
+    //Quantizes a color channel to a number of bits, rounding to the closest value
+    inline unsigned int BlockEncoderQuantize(float aValue, unsigned int aBits)
+    {
+        unsigned int maximum = (1 << aBits) - 1;
+        int value = (int)floorf(aValue * maximum / 255.0f + 0.5f);
+        return value < 0 ? 0 : (value > (int)maximum ? maximum : (unsigned int)value);
+    }
+    
+    bool BlockEncoder::Encode(unsigned int aFormat, const unsigned char* aPixels, unsigned int aWidth, unsigned int aHeight, unsigned int aBytesPerPixel, vector<unsigned char>& aBlocks)
+    {
+        //Safety check the format
+        unsigned int bytesPerBlock = GetTextureContainerBytesPerBlock(aFormat);
+        if(bytesPerBlock == 0)
+        {
+            return false;
+        }
+        
+        unsigned char texels[16][4];
+        for(unsigned int blockY = 0; blockY < aHeight; blockY += 4)
+        {
+            for(unsigned int blockX = 0; blockX < aWidth; blockX += 4)
+            {
+                //Gather the block's texels, repeating the edge pixels
+                for(unsigned int y = 0; y < 4; y++)
+                {
+                    for(unsigned int x = 0; x < 4; x++)
+                    {
+                        unsigned int pixelX = blockX + x < aWidth ? blockX + x : aWidth - 1;
+                        unsigned int pixelY = blockY + y < aHeight ? blockY + y : aHeight - 1;
+                        const unsigned char* pixel = aPixels + (pixelY * aWidth + pixelX) * aBytesPerPixel;
+                        texels[y * 4 + x][0] = pixel[0];
+                        texels[y * 4 + x][1] = pixel[1];
+                        texels[y * 4 + x][2] = pixel[2];
+                        texels[y * 4 + x][3] = aBytesPerPixel == 4 ? pixel[3] : 255;
+                    }
+                }
+                
+                //Compress the block, the alpha block comes first
+                size_t offset = aBlocks.size();
+                aBlocks.resize(offset + bytesPerBlock);
+                unsigned char* block = &aBlocks[offset];
+                if(aFormat == TextureContainerFormatBC1)
+                {
+                    EncodeBCColorBlock(texels, block);
+                }
+                else if(aFormat == TextureContainerFormatBC3)
+                {
+                    EncodeBC3AlphaBlock(texels, block);
+                    EncodeBCColorBlock(texels, block + 8);
+                }
+                else if(aFormat == TextureContainerFormatETC2RGB8)
+                {
+                    EncodeETC1ColorBlock(texels, block);
+                }
+                else
+                {
+                    EncodeEACAlphaBlock(texels, block);
+                    EncodeETC1ColorBlock(texels, block + 8);
+                }
+            }
+        }
+        
+        return true;
+    }
+    
+    void BlockEncoder::EncodeBCColorBlock(const unsigned char aTexels[16][4], unsigned char* aBlock)
+    {
+        //Calculate the mean color and the covariance of the colors
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            for(unsigned int c = 0; c < 3; c++)
+            {
+                mean[c] += aTexels[i][c] / 16.0f;
+            }
+        }
+        float covariance[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            for(unsigned int a = 0; a < 3; a++)
+            {
+                for(unsigned int b = 0; b < 3; b++)
+                {
+                    covariance[a][b] += (aTexels[i][a] - mean[a]) * (aTexels[i][b] - mean[b]);
+                }
+            }
+        }
+        
+        //Find the principal axis with a few power iterations
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for(unsigned int iteration = 0; iteration < 8; iteration++)
+        {
+            float result[3];
+            float length = 0.0f;
+            for(unsigned int a = 0; a < 3; a++)
+            {
+                result[a] = covariance[a][0] * axis[0] + covariance[a][1] * axis[1] + covariance[a][2] * axis[2];
+                length = fabsf(result[a]) > length ? fabsf(result[a]) : length;
+            }
+            
+            //A block of a single color has no axis
+            if(length < 0.0001f)
+            {
+                break;
+            }
+            for(unsigned int a = 0; a < 3; a++)
+            {
+                axis[a] = result[a] / length;
+            }
+        }
+        
+        //The endpoints are the colors furthest along the axis in each direction
+        unsigned int minimumIndex = 0;
+        unsigned int maximumIndex = 0;
+        float minimum = 0.0f;
+        float maximum = 0.0f;
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            float projection = aTexels[i][0] * axis[0] + aTexels[i][1] * axis[1] + aTexels[i][2] * axis[2];
+            if(i == 0 || projection < minimum)
+            {
+                minimum = projection;
+                minimumIndex = i;
+            }
+            if(i == 0 || projection > maximum)
+            {
+                maximum = projection;
+                maximumIndex = i;
+            }
+        }
+        
+        //Quantize the endpoints to 565, color0 has to be greater than color1 to use the 4 color mode
+        unsigned int color0 = (BlockEncoderQuantize(aTexels[maximumIndex][0], 5) << 11) | (BlockEncoderQuantize(aTexels[maximumIndex][1], 6) << 5) | BlockEncoderQuantize(aTexels[maximumIndex][2], 5);
+        unsigned int color1 = (BlockEncoderQuantize(aTexels[minimumIndex][0], 5) << 11) | (BlockEncoderQuantize(aTexels[minimumIndex][1], 6) << 5) | BlockEncoderQuantize(aTexels[minimumIndex][2], 5);
+        if(color0 < color1)
+        {
+            unsigned int swap = color0;
+            color0 = color1;
+            color1 = swap;
+        }
+        
+        //Setup the palette, the same way the decoder does
+        int palette[4][3];
+        palette[0][0] = (((color0 >> 11) & 31) << 3) | (((color0 >> 11) & 31) >> 2);
+        palette[0][1] = (((color0 >> 5) & 63) << 2) | (((color0 >> 5) & 63) >> 4);
+        palette[0][2] = ((color0 & 31) << 3) | ((color0 & 31) >> 2);
+        palette[1][0] = (((color1 >> 11) & 31) << 3) | (((color1 >> 11) & 31) >> 2);
+        palette[1][1] = (((color1 >> 5) & 63) << 2) | (((color1 >> 5) & 63) >> 4);
+        palette[1][2] = ((color1 & 31) << 3) | ((color1 & 31) >> 2);
+        for(unsigned int c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        }
+        
+        //Pick the closest palette color for each texel, if both endpoints are the same only the first one is used
+        unsigned int indices = 0;
+        if(color0 != color1)
+        {
+            for(unsigned int i = 0; i < 16; i++)
+            {
+                unsigned int bestIndex = 0;
+                int bestDistance = INT_MAX;
+                for(unsigned int index = 0; index < 4; index++)
+                {
+                    int distance = BlockEncoderDistance(palette[index], aTexels[i]);
+                    if(distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = index;
+                    }
+                }
+                indices |= bestIndex << (i * 2);
+            }
+        }
+        
+        //Write the block, it is little endian
+        aBlock[0] = (unsigned char)(color0 & 255);
+        aBlock[1] = (unsigned char)(color0 >> 8);
+        aBlock[2] = (unsigned char)(color1 & 255);
+        aBlock[3] = (unsigned char)(color1 >> 8);
+        for(unsigned int i = 0; i < 4; i++)
+        {
+            aBlock[4 + i] = (unsigned char)((indices >> (i * 8)) & 255);
+        }
+    }
+    
+    void BlockEncoder::EncodeBC3AlphaBlock(const unsigned char aTexels[16][4], unsigned char* aBlock)
+    {
+        //The endpoints are the minimum and maximum alpha, using the 8 value mode
+        int alpha0 = 0;
+        int alpha1 = 255;
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            alpha0 = aTexels[i][3] > alpha0 ? aTexels[i][3] : alpha0;
+            alpha1 = aTexels[i][3] < alpha1 ? aTexels[i][3] : alpha1;
+        }
+        
+        //Setup the palette, the same way the decoder does
+        int palette[8];
+        palette[0] = alpha0;
+        palette[1] = alpha1;
+        for(int i = 1; i < 7; i++)
+        {
+            palette[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+        }
+        
+        //Pick the closest palette value for each texel, if both endpoints are the same only the first one is used
+        unsigned long long indices = 0;
+        if(alpha0 != alpha1)
+        {
+            for(unsigned int i = 0; i < 16; i++)
+            {
+                unsigned long long bestIndex = 0;
+                int bestDistance = INT_MAX;
+                for(unsigned int index = 0; index < 8; index++)
+                {
+                    int distance = abs(palette[index] - aTexels[i][3]);
+                    if(distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = index;
+                    }
+                }
+                indices |= bestIndex << (i * 3);
+            }
+        }
+        
+        //Write the block, it is little endian
+        aBlock[0] = (unsigned char)alpha0;
+        aBlock[1] = (unsigned char)alpha1;
+        for(unsigned int i = 0; i < 6; i++)
+        {
+            aBlock[2 + i] = (unsigned char)((indices >> (i * 8)) & 255);
+        }
+    }
+    
+    void BlockEncoder::EncodeETC1ColorBlock(const unsigned char aTexels[16][4], unsigned char* aBlock)
+    {
+        unsigned int bestHigh = 0;
+        unsigned int bestLow = 0;
+        int bestError = INT_MAX;
+        
+        //Try the sub blocks side by side and on top of each other
+        for(unsigned int flip = 0; flip < 2; flip++)
+        {
+            bool isFlipped = flip == 1;
+            
+            //Calculate the average color of each sub block
+            float averages[2][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+            for(unsigned int y = 0; y < 4; y++)
+            {
+                for(unsigned int x = 0; x < 4; x++)
+                {
+                    unsigned int subBlock = isFlipped == true ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+                    for(unsigned int c = 0; c < 3; c++)
+                    {
+                        averages[subBlock][c] += aTexels[y * 4 + x][c] / 8.0f;
+                    }
+                }
+            }
+            
+            //Use the differential mode if the sub block colors are close enough, otherwise use the individual mode
+            unsigned int quantized[2][3];
+            bool isDifferential = true;
+            for(unsigned int c = 0; c < 3; c++)
+            {
+                quantized[0][c] = BlockEncoderQuantize(averages[0][c], 5);
+                quantized[1][c] = BlockEncoderQuantize(averages[1][c], 5);
+                int difference = (int)quantized[1][c] - (int)quantized[0][c];
+                if(difference < -4 || difference > 3)
+                {
+                    isDifferential = false;
+                }
+            }
+            
+            int baseColors[2][3];
+            for(unsigned int s = 0; s < 2; s++)
+            {
+                for(unsigned int c = 0; c < 3; c++)
+                {
+                    if(isDifferential == true)
+                    {
+                        baseColors[s][c] = (quantized[s][c] << 3) | (quantized[s][c] >> 2);
+                    }
+                    else
+                    {
+                        quantized[s][c] = BlockEncoderQuantize(averages[s][c], 4);
+                        baseColors[s][c] = (quantized[s][c] << 4) | quantized[s][c];
+                    }
+                }
+            }
+            
+            //Find the best modifier table for each sub block
+            unsigned int tables[2];
+            unsigned int modifierIndices[16];
+            int error = FindETC1Table(aTexels, baseColors[0], isFlipped, 0, tables[0], modifierIndices);
+            error += FindETC1Table(aTexels, baseColors[1], isFlipped, 1, tables[1], modifierIndices);
+            if(error >= bestError)
+            {
+                continue;
+            }
+            
+            //Pack the base colors, the tables and the flags
+            unsigned int high = 0;
+            if(isDifferential == true)
+            {
+                high = (quantized[0][0] << 27) | ((((int)quantized[1][0] - (int)quantized[0][0]) & 7) << 24);
+                high |= (quantized[0][1] << 19) | ((((int)quantized[1][1] - (int)quantized[0][1]) & 7) << 16);
+                high |= (quantized[0][2] << 11) | ((((int)quantized[1][2] - (int)quantized[0][2]) & 7) << 8);
+                high |= 1 << 1;
+            }
+            else
+            {
+                high = (quantized[0][0] << 28) | (quantized[1][0] << 24) | (quantized[0][1] << 20) | (quantized[1][1] << 16) | (quantized[0][2] << 12) | (quantized[1][2] << 8);
+            }
+            high |= (tables[0] << 5) | (tables[1] << 2) | flip;
+            
+            //Pack the modifier indices, the sign is the most significant bit and the ETC pixel indices are ordered column by column
+            unsigned int low = 0;
+            for(unsigned int x = 0; x < 4; x++)
+            {
+                for(unsigned int y = 0; y < 4; y++)
+                {
+                    unsigned int pixel = x * 4 + y;
+                    unsigned int modifierIndex = modifierIndices[y * 4 + x];
+                    low |= ((modifierIndex >> 1) << (16 + pixel)) | ((modifierIndex & 1) << pixel);
+                }
+            }
+            
+            bestHigh = high;
+            bestLow = low;
+            bestError = error;
+        }
+        
+        //Write the block, it is big endian
+        for(unsigned int i = 0; i < 4; i++)
+        {
+            aBlock[i] = (unsigned char)((bestHigh >> (24 - i * 8)) & 255);
+            aBlock[4 + i] = (unsigned char)((bestLow >> (24 - i * 8)) & 255);
+        }
+    }
+    
+    int BlockEncoder::FindETC1Table(const unsigned char aTexels[16][4], const int aBaseColor[3], bool aIsFlipped, unsigned int aSubBlock, unsigned int& aTable, unsigned int aModifierIndices[16])
+    {
+        int bestError = INT_MAX;
+        for(unsigned int table = 0; table < 8; table++)
+        {
+            //The modifier indices are +small, +large, -small and -large
+            int colors[4][3];
+            for(unsigned int index = 0; index < 4; index++)
+            {
+                int modifier = BLOCK_ENCODER_ETC_MODIFIERS[table][index & 1] * ((index >> 1) != 0 ? -1 : 1);
+                for(unsigned int c = 0; c < 3; c++)
+                {
+                    colors[index][c] = BlockEncoderClamp(aBaseColor[c] + modifier);
+                }
+            }
+            
+            //Pick the closest color for each texel in the sub block
+            int error = 0;
+            unsigned int modifierIndices[16];
+            for(unsigned int y = 0; y < 4; y++)
+            {
+                for(unsigned int x = 0; x < 4; x++)
+                {
+                    unsigned int subBlock = aIsFlipped == true ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+                    if(subBlock != aSubBlock)
+                    {
+                        continue;
+                    }
+                    
+                    int bestDistance = INT_MAX;
+                    for(unsigned int index = 0; index < 4; index++)
+                    {
+                        int distance = BlockEncoderDistance(colors[index], aTexels[y * 4 + x]);
+                        if(distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            modifierIndices[y * 4 + x] = index;
+                        }
+                    }
+                    error += bestDistance;
+                }
+            }
+            
+            //Keep the table with the lowest error
+            if(error < bestError)
+            {
+                bestError = error;
+                aTable = table;
+                for(unsigned int y = 0; y < 4; y++)
+                {
+                    for(unsigned int x = 0; x < 4; x++)
+                    {
+                        unsigned int subBlock = aIsFlipped == true ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+                        if(subBlock == aSubBlock)
+                        {
+                            aModifierIndices[y * 4 + x] = modifierIndices[y * 4 + x];
+                        }
+                    }
+                }
+            }
+        }
+        return bestError;
+    }
+    
+    void BlockEncoder::EncodeEACAlphaBlock(const unsigned char aTexels[16][4], unsigned char* aBlock)
+    {
+        int minimum = 255;
+        int maximum = 0;
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            minimum = aTexels[i][3] < minimum ? aTexels[i][3] : minimum;
+            maximum = aTexels[i][3] > maximum ? aTexels[i][3] : maximum;
+        }
+        
+        //A block with a single alpha value uses the table that has a zero modifier
+        int bestBase = minimum;
+        unsigned int bestMultiplier = 1;
+        unsigned int bestTable = 13;
+        unsigned int bestIndices[16];
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            bestIndices[i] = 4;
+        }
+        
+        //Otherwise try every table, with the multipliers and base that best fit the alpha range
+        if(minimum != maximum)
+        {
+            int bestError = INT_MAX;
+            for(unsigned int table = 0; table < 16; table++)
+            {
+                const int* modifiers = BLOCK_ENCODER_EAC_MODIFIERS[table];
+                int span = modifiers[7] - modifiers[3];
+                int multiplier = (maximum - minimum + span / 2) / span;
+                for(int m = multiplier - 1; m <= multiplier + 1; m++)
+                {
+                    if(m < 1 || m > 15)
+                    {
+                        continue;
+                    }
+                    
+                    //Center the modifiers on the alpha range
+                    int base = BlockEncoderClamp((int)floorf((minimum + maximum) / 2.0f - (modifiers[7] + modifiers[3]) * m / 2.0f + 0.5f));
+                    int error = 0;
+                    unsigned int indices[16];
+                    for(unsigned int i = 0; i < 16; i++)
+                    {
+                        int bestDistance = INT_MAX;
+                        for(unsigned int index = 0; index < 8; index++)
+                        {
+                            int difference = BlockEncoderClamp(base + modifiers[index] * m) - aTexels[i][3];
+                            if(difference * difference < bestDistance)
+                            {
+                                bestDistance = difference * difference;
+                                indices[i] = index;
+                            }
+                        }
+                        error += bestDistance;
+                    }
+                    
+                    if(error < bestError)
+                    {
+                        bestError = error;
+                        bestBase = base;
+                        bestMultiplier = (unsigned int)m;
+                        bestTable = table;
+                        for(unsigned int i = 0; i < 16; i++)
+                        {
+                            bestIndices[i] = indices[i];
+                        }
+                    }
+                }
+            }
+        }
+        
+        //Pack the 3 bit indices, big endian and ordered column by column
+        unsigned long long indices = 0;
+        for(unsigned int x = 0; x < 4; x++)
+        {
+            for(unsigned int y = 0; y < 4; y++)
+            {
+                unsigned int pixel = x * 4 + y;
+                indices |= (unsigned long long)bestIndices[y * 4 + x] << (45 - pixel * 3);
+            }
+        }
+        
+        //Write the block
+        aBlock[0] = (unsigned char)bestBase;
+        aBlock[1] = (unsigned char)((bestMultiplier << 4) | bestTable);
+        for(unsigned int i = 0; i < 6; i++)
+        {
+            aBlock[2 + i] = (unsigned char)((indices >> (40 - i * 8)) & 255);
+        }
+    }
+}
\ No newline at end of file
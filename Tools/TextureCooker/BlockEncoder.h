@@ -0,0 +1,40 @@
+//
+//  BlockEncoder.h
+//  TextureCooker
+//
+
+#ifndef __TextureCooker__BlockEncoder__
+#define __TextureCooker__BlockEncoder__
+
+#include <vector>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //The BlockEncoder class compresses pixels into the block compressed texture container formats, see TextureContainer.h.
+    //BC1 and BC3 are used on desktop OpenGL, ETC2 RGB8 and ETC2 RGBA8 on OpenGL ES 3. The encoders favour speed over
+    //quality: the BC endpoints are the extremes along the principal axis of each block's colors, the ETC2 color blocks
+    //only use the individual and differential modes (ETC1) and the alpha blocks pick the closest fitting palette
+    class BlockEncoder
+    {
+    public:
+        //Compresses one mipmap level of tightly packed RGB or RGBA pixels, the blocks are appended in the same row order
+        //as the pixels. The edge pixels are repeated to fill the blocks that are partially outside the level. Returns false
+        //if the format isn't compressed
+        static bool Encode(unsigned int format, const unsigned char* pixels, unsigned int width, unsigned int height, unsigned int bytesPerPixel, vector<unsigned char>& blocks);
+    
+    private:
+        //Compresses a block of 16 RGBA texels, the texels are indexed by y * 4 + x
+        static void EncodeBCColorBlock(const unsigned char texels[16][4], unsigned char* block);
+        static void EncodeBC3AlphaBlock(const unsigned char texels[16][4], unsigned char* block);
+        static void EncodeETC1ColorBlock(const unsigned char texels[16][4], unsigned char* block);
+        static void EncodeEACAlphaBlock(const unsigned char texels[16][4], unsigned char* block);
+        
+        //Returns the error of the best ETC1 modifier table for a sub block, the table and the texels' modifier indices are set
+        static int FindETC1Table(const unsigned char texels[16][4], const int baseColor[3], bool isFlipped, unsigned int subBlock, unsigned int& table, unsigned int modifierIndices[16]);
+    };
+}
+
+#endif /* defined(__TextureCooker__BlockEncoder__) */
@@ -0,0 +1,422 @@
+//
+//  TextureCooker.cpp
+//  TextureCooker
+//
+
+#include "TextureCooker.h"
+#include "BlockEncoder.h"
+#include "TextureContainer.h"
+#include "TextureCompression.h"
+#include "png.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+namespace GameDev2D
+{
+    //Maps a file into memory as read only, the same way the PlatformLayer does
+    const unsigned char* TextureCookerMapFile(const string& aPath, unsigned int& aSize)
+    {
+        aSize = 0;
+#ifdef _WIN32
+        HANDLE file = CreateFileA(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+        DWORD fileSize = GetFileSize(file, NULL);
+        HANDLE mapping = fileSize != INVALID_FILE_SIZE && fileSize > 0 ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+        const void* data = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+        if(mapping != NULL)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        if(data == NULL)
+        {
+            return nullptr;
+        }
+        aSize = (unsigned int)fileSize;
+        return (const unsigned char*)data;
+#else
+        int file = open(aPath.c_str(), O_RDONLY);
+        if(file == -1)
+        {
+            return nullptr;
+        }
+        struct stat fileStat;
+        if(fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(file);
+            return nullptr;
+        }
+        void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(data == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        aSize = (unsigned int)fileStat.st_size;
+        return (const unsigned char*)data;
+#endif
+    }
+    
+    //Unmaps a file that was mapped with TextureCookerMapFile()
+    void TextureCookerUnmapFile(const unsigned char* aData, unsigned int aSize)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(aData);
+#else
+        munmap((void*)aData, aSize);
+#endif
+    }
+    
+    TextureCooker::TextureCooker(const string& aOutputDirectory) :
+        m_OutputDirectory(aOutputDirectory),
+        m_Premultiply(false),
+        m_Compression(TextureCookerCompressionNone),
+        m_GenerateMipmaps(false)
+    {
+    
+    }
+    
+    void TextureCooker::SetPremultiply(bool aPremultiply)
+    {
+        m_Premultiply = aPremultiply;
+    }
+    
+    void TextureCooker::SetCompression(TextureCookerCompression aCompression)
+    {
+        m_Compression = aCompression;
+    }
+    
+    void TextureCooker::SetGenerateMipmaps(bool aGenerateMipmaps)
+    {
+        m_GenerateMipmaps = aGenerateMipmaps;
+    }
+    
+    bool TextureCooker::Cook(const string& aImagePath)
+    {
+        //Decode the png image
+        vector<unsigned char> pixels;
+        unsigned int width = 0;
+        unsigned int height = 0;
+        unsigned int bytesPerPixel = 0;
+        if(DecodePng(aImagePath, pixels, width, height, bytesPerPixel) == false)
+        {
+            cerr << "Failed to cook texture: " << aImagePath << ", the png image failed to load" << endl;
+            return false;
+        }
+        
+        //Premultiply the color by the alpha, only images with an alpha channel are premultiplied
+        bool premultiply = m_Premultiply == true && bytesPerPixel == 4;
+        if(premultiply == true)
+        {
+            for(unsigned int i = 0; i < pixels.size(); i += 4)
+            {
+                unsigned int alpha = pixels[i + 3];
+                pixels[i] = (unsigned char)((pixels[i] * alpha + 127) / 255);
+                pixels[i + 1] = (unsigned char)((pixels[i + 1] * alpha + 127) / 255);
+                pixels[i + 2] = (unsigned char)((pixels[i + 2] * alpha + 127) / 255);
+            }
+        }
+        
+        //Determine the format of the texture container
+        unsigned int format = bytesPerPixel == 4 ? TextureContainerFormatRGBA8 : TextureContainerFormatRGB8;
+        if(m_Compression == TextureCookerCompressionBC)
+        {
+            format = bytesPerPixel == 4 ? TextureContainerFormatBC3 : TextureContainerFormatBC1;
+        }
+        else if(m_Compression == TextureCookerCompressionETC2)
+        {
+            format = bytesPerPixel == 4 ? TextureContainerFormatETC2RGBA8 : TextureContainerFormatETC2RGB8;
+        }
+        
+        //Generate the mipmap levels, each level is box filtered from the previous level down to 1x1
+        vector<vector<unsigned char> > levels(1, pixels);
+        if(m_GenerateMipmaps == true)
+        {
+            unsigned int levelWidth = width;
+            unsigned int levelHeight = height;
+            while(levelWidth > 1 || levelHeight > 1)
+            {
+                vector<unsigned char> level;
+                DownsampleLevel(levels.back(), levelWidth, levelHeight, bytesPerPixel, bytesPerPixel == 4 && premultiply == false, level);
+                levels.push_back(level);
+                levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+                levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+            }
+        }
+        
+        //Append the levels to the texture container's data, block compressing them if the format is compressed
+        vector<unsigned char> data;
+        string compressionInfo = "";
+        for(unsigned int i = 0; i < levels.size(); i++)
+        {
+            unsigned int levelWidth = (width >> i) > 0 ? (width >> i) : 1;
+            unsigned int levelHeight = (height >> i) > 0 ? (height >> i) : 1;
+            if(IsTextureContainerFormatCompressed(format) == true)
+            {
+                vector<unsigned char> blocks;
+                BlockEncoder::Encode(format, &levels[i][0], levelWidth, levelHeight, bytesPerPixel, blocks);
+            
+                //Measure the compression error of the first level, by decompressing the blocks the same way the Texture class does
+                if(i == 0)
+                {
+                    vector<unsigned char> decompressed(pixels.size());
+                    DecompressTextureBlocks(format, &blocks[0], width, height, &decompressed[0]);
+                    double squaredError = 0.0;
+                    for(unsigned int j = 0; j < pixels.size(); j++)
+                    {
+                        double difference = (double)pixels[j] - (double)decompressed[j];
+                        squaredError += difference * difference;
+                    }
+                    double meanSquaredError = squaredError / pixels.size();
+            
+                    char info[64];
+                    snprintf(info, sizeof(info), ", %.1f:1, PSNR %.1f dB", (double)pixels.size() / blocks.size(), meanSquaredError > 0.0 ? 10.0 * log10(255.0 * 255.0 / meanSquaredError) : 99.0);
+                    compressionInfo = info;
+                }
+                
+                data.insert(data.end(), blocks.begin(), blocks.end());
+            }
+            else
+            {
+                data.insert(data.end(), levels[i].begin(), levels[i].end());
+            }
+        }
+        
+        //Setup the header
+        TextureContainerHeader header;
+        header.magic = TEXTURE_CONTAINER_MAGIC;
+        header.version = TEXTURE_CONTAINER_VERSION;
+        header.width = width;
+        header.height = height;
+        header.format = format;
+        header.mipmapCount = (unsigned int)levels.size();
+        header.flags = premultiply == true ? TextureContainerFlagPremultiplied : 0;
+        header.dataSize = (unsigned int)data.size();
+        
+        //Write the texture container
+        string containerPath = GetContainerPath(aImagePath);
+        FILE* file = fopen(containerPath.c_str(), "wb");
+        if(file == NULL)
+        {
+            cerr << "Failed to save texture container: " << containerPath << endl;
+            return false;
+        }
+        bool success = fwrite(&header, sizeof(TextureContainerHeader), 1, file) == 1 && fwrite(&data[0], data.size(), 1, file) == 1;
+        fclose(file);
+        
+        if(success == false)
+        {
+            cerr << "Failed to save texture container: " << containerPath << endl;
+            return false;
+        }
+        
+        cout << "Cooked " << aImagePath << " into " << containerPath << " (" << width << "x" << height << compressionInfo << (levels.size() > 1 ? ", " + to_string(levels.size()) + " mipmaps" : "") << (premultiply == true ? ", premultiplied)" : ")") << endl;
+        return true;
+    }
+    
+    void TextureCooker::Benchmark(const vector<string>& aImagePaths)
+    {
+        double pngTime = 0.0;
+        double containerTime = 0.0;
+        unsigned long long pngBytes = 0;
+        unsigned long long containerBytes = 0;
+        unsigned int count = 0;
+        
+        for(unsigned int i = 0; i < aImagePaths.size(); i++)
+        {
+            //Load the png image
+            vector<unsigned char> pixels;
+            unsigned int width = 0;
+            unsigned int height = 0;
+            unsigned int bytesPerPixel = 0;
+            chrono::high_resolution_clock::time_point start = chrono::high_resolution_clock::now();
+            bool didLoadPng = DecodePng(aImagePaths.at(i), pixels, width, height, bytesPerPixel);
+            double pngElapsed = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+            
+            //Load the texture container
+            vector<unsigned char> containerPixels;
+            start = chrono::high_resolution_clock::now();
+            bool didLoadContainer = ReadContainer(GetContainerPath(aImagePaths.at(i)), containerPixels);
+            double containerElapsed = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count();
+            
+            //Both have to load to be compared
+            if(didLoadPng == false || didLoadContainer == false)
+            {
+                cerr << "Skipped benchmarking: " << aImagePaths.at(i) << ", the png image or texture container failed to load" << endl;
+                continue;
+            }
+            
+            pngTime += pngElapsed;
+            containerTime += containerElapsed;
+            pngBytes += pixels.size();
+            containerBytes += containerPixels.size();
+            count++;
+            cout << aImagePaths.at(i) << ": png " << pngElapsed << " ms, container " << containerElapsed << " ms" << endl;
+        }
+        
+        //Log the totals
+        cout << "Loaded " << count << " images, png: " << pngTime << " ms (" << pngBytes << " bytes), container: " << containerTime << " ms (" << containerBytes << " bytes)";
+        if(containerTime > 0.0)
+        {
+            cout << ", " << pngTime / containerTime << "x faster";
+        }
+        cout << endl;
+    }
+    
+    string TextureCooker::GetContainerPath(const string& aImagePath)
+    {
+        //Remove the png extension
+        string path = aImagePath;
+        size_t found = path.rfind(".png");
+        if(found != std::string::npos)
+        {
+            path.erase(found);
+        }
+        
+        //Use the output directory, if one was set
+        if(m_OutputDirectory.length() > 0)
+        {
+            size_t separator = path.find_last_of("/\\");
+            path = m_OutputDirectory + "/" + (separator != std::string::npos ? path.substr(separator + 1) : path);
+        }
+        
+        return path + "." + TEXTURE_CONTAINER_EXTENSION;
+    }
+    
+    bool TextureCooker::DecodePng(const string& aPath, vector<unsigned char>& aPixels, unsigned int& aWidth, unsigned int& aHeight, unsigned int& aBytesPerPixel)
+    {
+        //Open the image file
+        FILE* file = fopen(aPath.c_str(), "rb");
+        if(file == NULL)
+        {
+            return false;
+        }
+        
+        //Create the png read struct and the png info struct
+        png_structp pngPointer = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+        png_infop infoPointer = pngPointer != NULL ? png_create_info_struct(pngPointer) : NULL;
+        if(pngPointer == NULL || infoPointer == NULL)
+        {
+            png_destroy_read_struct(&pngPointer, NULL, NULL);
+            fclose(file);
+            return false;
+        }
+        
+        //If libpng hits an error it jumps back here
+        if(setjmp(png_jmpbuf(pngPointer)))
+        {
+            png_destroy_read_struct(&pngPointer, &infoPointer, NULL);
+            fclose(file);
+            return false;
+        }
+        
+        //Read the whole image with the same transforms as the Texture class, grayscale images are expanded to RGB
+        png_init_io(pngPointer, file);
+        png_read_png(pngPointer, infoPointer, PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING | PNG_TRANSFORM_EXPAND | PNG_TRANSFORM_GRAY_TO_RGB, NULL);
+        
+        //Get the size of the image and the number of bytes per pixel
+        aWidth = png_get_image_width(pngPointer, infoPointer);
+        aHeight = png_get_image_height(pngPointer, infoPointer);
+        aBytesPerPixel = png_get_channels(pngPointer, infoPointer);
+        png_size_t rowBytes = png_get_rowbytes(pngPointer, infoPointer);
+        png_bytepp rowPointers = png_get_rows(pngPointer, infoPointer);
+        
+        //The png image is ordered top to bottom, but OpenGL expects it bottom to top so the order is swapped
+        aPixels.resize(rowBytes * aHeight);
+        for(unsigned int i = 0; i < aHeight; i++)
+        {
+            memcpy(&aPixels[rowBytes * (aHeight - 1 - i)], rowPointers[i], rowBytes);
+        }
+        
+        //Clean up
+        png_destroy_read_struct(&pngPointer, &infoPointer, NULL);
+        fclose(file);
+        return aBytesPerPixel == 3 || aBytesPerPixel == 4;
+    }
+    
+    void TextureCooker::DownsampleLevel(const vector<unsigned char>& aPixels, unsigned int aWidth, unsigned int aHeight, unsigned int aBytesPerPixel, bool aWeightByAlpha, vector<unsigned char>& aLevel)
+    {
+        unsigned int width = aWidth > 1 ? aWidth / 2 : 1;
+        unsigned int height = aHeight > 1 ? aHeight / 2 : 1;
+        aLevel.resize(width * height * aBytesPerPixel);
+        
+        for(unsigned int y = 0; y < height; y++)
+        {
+            for(unsigned int x = 0; x < width; x++)
+            {
+                //Add up the 2x2 box of pixels, the last row and column are repeated when the size is odd
+                unsigned int colorSum[3] = {0, 0, 0};
+                unsigned int weightedColorSum[3] = {0, 0, 0};
+                unsigned int alphaSum = 0;
+                for(unsigned int i = 0; i < 4; i++)
+                {
+                    unsigned int sourceX = x * 2 + (i & 1) < aWidth ? x * 2 + (i & 1) : aWidth - 1;
+                    unsigned int sourceY = y * 2 + (i >> 1) < aHeight ? y * 2 + (i >> 1) : aHeight - 1;
+                    const unsigned char* pixel = &aPixels[(sourceY * aWidth + sourceX) * aBytesPerPixel];
+                    unsigned int alpha = aBytesPerPixel == 4 ? pixel[3] : 255;
+                    for(unsigned int j = 0; j < 3; j++)
+                    {
+                        colorSum[j] += pixel[j];
+                        weightedColorSum[j] += pixel[j] * alpha;
+                    }
+                    alphaSum += alpha;
+                }
+                
+                //Average the box, if the whole box is transparent the color isn't weighted
+                unsigned char* level = &aLevel[(y * width + x) * aBytesPerPixel];
+                for(unsigned int j = 0; j < 3; j++)
+                {
+                    level[j] = (unsigned char)(aWeightByAlpha == true && alphaSum > 0 ? (weightedColorSum[j] + alphaSum / 2) / alphaSum : (colorSum[j] + 2) / 4);
+                }
+                if(aBytesPerPixel == 4)
+                {
+                    level[3] = (unsigned char)((alphaSum + 2) / 4);
+                }
+            }
+        }
+    }
+    
+    bool TextureCooker::ReadContainer(const string& aPath, vector<unsigned char>& aPixels)
+    {
+        //Map the texture container
+        unsigned int size = 0;
+        const unsigned char* data = TextureCookerMapFile(aPath, size);
+        if(data == nullptr)
+        {
+            return false;
+        }
+        
+        //Validate the header and read the pixels
+        TextureContainerHeader header;
+        bool success = size >= sizeof(TextureContainerHeader);
+        if(success == true)
+        {
+            memcpy(&header, data, sizeof(TextureContainerHeader));
+            success = header.magic == TEXTURE_CONTAINER_MAGIC && header.version == TEXTURE_CONTAINER_VERSION && size - sizeof(TextureContainerHeader) >= header.dataSize;
+        }
+        if(success == true)
+        {
+            aPixels.assign(data + sizeof(TextureContainerHeader), data + sizeof(TextureContainerHeader) + header.dataSize);
+        }
+        
+        //Unmap the texture container
+        TextureCookerUnmapFile(data, size);
+        return success;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+//
+//  TextureCooker.h
+//  TextureCooker
+//
+
+#ifndef __TextureCooker__TextureCooker__
+#define __TextureCooker__TextureCooker__
+
+#include <string>
+#include <vector>
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //Block compression used by the TextureCooker
+    enum TextureCookerCompression
+    {
+        TextureCookerCompressionNone = 0,
+        TextureCookerCompressionBC,
+        TextureCookerCompressionETC2
+    };
+    
+    //The TextureCooker class converts png images into texture containers (.gdtex), see TextureContainer.h. The pixels
+    //are decoded, flipped bottom to top and optionally premultiplied by their alpha once, offline, so the Texture class
+    //only has to memory map the container and upload it. The pixels can also be block compressed, BC1/BC3 for desktop
+    //OpenGL or ETC2 for OpenGL ES 3, which take 4 to 8 times less memory on the GPU, and the mipmap levels can be generated
+    //offline so the Texture class doesn't have to generate them at load time. The container is saved next to the png image by default, with
+    //the same name and scale suffix, that way the TextureManager picks it up instead of the png image.
+    class TextureCooker
+    {
+    public:
+        TextureCooker(const string& outputDirectory);
+        
+        //Sets wether the color of images with an alpha channel is premultiplied by the alpha
+        void SetPremultiply(bool premultiply);
+        
+        //Sets the block compression, images with an alpha channel use BC3 or ETC2 RGBA8, the others BC1 or ETC2 RGB8
+        void SetCompression(TextureCookerCompression compression);
+        
+        //Sets wether the mipmap levels are generated, each level is box filtered from the previous level down to 1x1
+        void SetGenerateMipmaps(bool generateMipmaps);
+        
+        //Cooks a png image into a texture container, returns false if it failed
+        bool Cook(const string& imagePath);
+        
+        //Compares the time it takes to load each png image and its texture container, the images must be cooked first. The
+        //png image is decoded and flipped, the texture container is memory mapped and its pixels are read, both end with the
+        //pixels that are uploaded to OpenGL. The upload itself is the same for both and isn't included
+        void Benchmark(const vector<string>& imagePaths);
+        
+        //Returns the path of the texture container for a png image
+        string GetContainerPath(const string& imagePath);
+    
+    private:
+        //Decodes a png image, the pixels are ordered bottom to top. Returns false if the decoding failed
+        static bool DecodePng(const string& path, vector<unsigned char>& pixels, unsigned int& width, unsigned int& height, unsigned int& bytesPerPixel);
+        
+        //Reads the pixels of a texture container, returns false if the reading failed
+        static bool ReadContainer(const string& path, vector<unsigned char>& pixels);
+        
+        //Box filters a mipmap level into the next level, half its size. The color of images with an alpha channel that
+        //isn't premultiplied is weighted by the alpha, so that transparent pixels don't bleed into the visible ones
+        static void DownsampleLevel(const vector<unsigned char>& pixels, unsigned int width, unsigned int height, unsigned int bytesPerPixel, bool weightByAlpha, vector<unsigned char>& level);
+        
+        //Member variables
+        string m_OutputDirectory;
+        bool m_Premultiply;
+        TextureCookerCompression m_Compression;
+        bool m_GenerateMipmaps;
+    };
+}
+
+#endif /* defined(__TextureCooker__TextureCooker__) */
@@ -0,0 +1,101 @@
+//
+//  main.cpp
+//  TextureCooker
+//
+
+#include "TextureCooker.h"
+#include <iostream>
+
+
+using namespace GameDev2D;
+
+//Prints how to use the TextureCooker
+void PrintUsage()
+{
+    cout << "Usage: TextureCooker [options] <image.png> [<image.png> ...]" << endl;
+    cout << "Cooks png images into texture containers (.gdtex) that the Texture class memory maps and uploads directly" << endl;
+    cout << "Options:" << endl;
+    cout << "  -output <directory>   The directory the texture containers are saved in, next to the images by default" << endl;
+    cout << "  -premultiply          Premultiplies the color of images with an alpha channel by the alpha" << endl;
+    cout << "  -compress <bc|etc2>   Block compresses the pixels, bc (BC1/BC3) for desktop OpenGL, etc2 for OpenGL ES 3" << endl;
+    cout << "  -mipmaps              Generates the mipmap levels down to 1x1, used by the trilinear and anisotropic filters" << endl;
+    cout << "  -benchmark            Compares the load time of the png images and the texture containers after cooking" << endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    //Parse the options
+    string outputDirectory = "";
+    bool premultiply = false;
+    TextureCookerCompression compression = TextureCookerCompressionNone;
+    bool generateMipmaps = false;
+    bool benchmark = false;
+    int index = 1;
+    while(index < argc && argv[index][0] == '-')
+    {
+        string option = argv[index];
+        index++;
+        
+        if(option == "-output" && index < argc)
+        {
+            outputDirectory = argv[index];
+            index++;
+        }
+        else if(option == "-premultiply")
+        {
+            premultiply = true;
+        }
+        else if(option == "-compress" && index < argc && (string(argv[index]) == "bc" || string(argv[index]) == "etc2"))
+        {
+            compression = string(argv[index]) == "bc" ? TextureCookerCompressionBC : TextureCookerCompressionETC2;
+            index++;
+        }
+        else if(option == "-mipmaps")
+        {
+            generateMipmaps = true;
+        }
+        else if(option == "-benchmark")
+        {
+            benchmark = true;
+        }
+        else
+        {
+            cerr << "Unknown option: " << option << endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+    
+    //There must be at least one image
+    if(index >= argc)
+    {
+        PrintUsage();
+        return 1;
+    }
+    
+    //Create the texture cooker
+    TextureCooker textureCooker(outputDirectory);
+    textureCooker.SetPremultiply(premultiply);
+    textureCooker.SetCompression(compression);
+    textureCooker.SetGenerateMipmaps(generateMipmaps);
+    
+    //Cook the images
+    bool success = true;
+    vector<string> imagePaths;
+    for(int i = index; i < argc; i++)
+    {
+        imagePaths.push_back(argv[i]);
+        if(textureCooker.Cook(argv[i]) == false)
+        {
+            success = false;
+        }
+    }
+    
+    //Compare the load times
+    if(benchmark == true)
+    {
+        textureCooker.Benchmark(imagePaths);
+    }
+    
+    return success == true ? 0 : 1;
+}
\ No newline at end of file